@@ -24,7 +24,7 @@ class BoundVector : public vector<type> {
 
       using vector<type>::vector;
 
-      type operator[](int index) const {
+      const type& operator[](int index) const {
          const vector<type>& data = *this;
          if ((index < 0) || (index >= data.size())) {
             cerr << "Error: vector index out of range: " << index << endl;
@@ -14,8 +14,10 @@
 #define _DATABASEANALYSIS_H_INCLUDED
 
 #include <map>
+#include <set>
 #include <list>
 #include <string>
+#include <vector>
 #include <iostream>
 
 using namespace std;
@@ -25,6 +27,11 @@ class _AnalysisGraph {
       int*   data;
       list<string> children;
       list<string> parents;
+
+      // scope: the staves which need to be analyzed again when the
+      // analysis is only invalid for part of the page.  If *data is 0
+      // and scope is empty, the whole page needs to be analyzed again.
+      set<int> scope;
 };
 
 
@@ -37,13 +44,23 @@ class DatabaseAnalysis {
       void    addChild          (const string& nodename, const string& child,
                                  int* cstate);
       void    invalidateNode    (const string& nodename);
+      void    invalidateNode    (const string& nodename, int staff);
       void    validateNode      (const string& nodename);
+      int     getInvalidScope   (const string& nodename, set<int>& staves);
+      void    clearScopes       (void);
+      void    copyScopes        (const DatabaseAnalysis& database);
+      int     isValid           (const string& nodename);
+      void    getDependencyOrder(const vector<string>& nodenames,
+                                 vector<string>& order);
 
       ostream& print            (ostream& out = cout);
 
    private:
       map<string, _AnalysisGraph> nodes;
 
+      void    addDependencies   (const string& nodename,
+                                 vector<string>& order);
+
 };
 
 
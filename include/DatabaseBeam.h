@@ -29,12 +29,11 @@ using namespace std;
    using vectorVVSIp = BoundVector<BoundVector<BoundVector<ScoreItem*>>>;
 #endif
 
-#include <map>
-#include <list>
 #include <vector>
 #include <string>
 #include <iostream>
 
+class AnalysisTable;
 
 
 class BeamGroup {
@@ -53,17 +52,31 @@ class DatabaseBeam {
                         ~DatabaseBeam  ();
 
       void               clear          (void);
+      void               setItemIndex   (AnalysisTable* table);
+      void               prepareStaves  (int staffcount);
+      int                getStaffCount  (void) const;
       int                size           (void);
       BeamGroup*         beamInfo       (ScoreItem*);
       BeamGroup*         linkItems      (ScoreItem* note1, ScoreItem* note2);
       ostream&           printDatabase  (ostream& out = cout);
+      const vector<BeamGroup*>& getGroups  (int staff) const;
+      void               restoreGroup   (int staff, const vectorSIp& beams,
+                                         const vectorSIp& notes);
 
    protected:
       void               insertItem     (BeamGroup* list, ScoreItem* note);
+      void               storeGroup     (ScoreItem* item, BeamGroup* group);
 
    private:
-      map<ScoreItem*, BeamGroup*> interface;
-      list<BeamGroup*> database;
+      // item_index gives the dense index of each item on the page, and
+      // interface is the beam group containing each item index (or NULL
+      // if the item is not in a group).
+      AnalysisTable*     item_index;
+      vector<BeamGroup*>   interface;
+
+      // database is the list of beam groups for each staff, so that the
+      // groups on separate staves can be linked at the same time.
+      vector<vector<BeamGroup*>> database;
 };
 
 
@@ -15,27 +15,42 @@
 
 #include "ScoreItem.h"
 
-#include <map>
-#include <list>
+#include <deque>
+#include <vector>
 #include <string>
 
 using namespace std;
 
+class AnalysisTable;
+
 class DatabaseChord {
    public:
                          DatabaseChord  (void);
                         ~DatabaseChord  ();
 
       void               clear          (void);
+      void               setItemIndex   (AnalysisTable* table);
+      void               prepareStaves  (int staffcount);
+      int                getStaffCount  (void) const;
       vectorSIp*         notelist       (ScoreItem*);
       vectorSIp*         linkNotes      (ScoreItem* note1, ScoreItem* note2);
+      const deque<vectorSIp>& getChords (int staff) const;
+      void               restoreChord   (int staff, const vectorSIp& notes);
 
    protected:
       void               insertNote     (vectorSIp* list, ScoreItem* note);
+      void               storeChord     (ScoreItem* note, vectorSIp* chord);
 
    private:
-      map<ScoreItem*, vectorSIp*> interface;
-      list<vectorSIp> database;
+      // item_index gives the dense index of each note on the page, and
+      // interface is the chord containing each note index (or NULL if
+      // the note is not in a chord).
+      AnalysisTable*      item_index;
+      vector<vectorSIp*>  interface;
+
+      // database is the list of chords for each staff, so that the
+      // chords on separate staves can be linked at the same time.
+      deque<deque<vectorSIp>> database;
 };
 
 
@@ -29,6 +29,8 @@ class DatabaseLyrics {
       void              clear           (void);
       vectorSIp*        lyricslist      (ScoreItem*);
       vectorSIp*        link            (ScoreItem* item1, ScoreItem* item2);
+      const list<vectorSIp>& getLists   (void) const;
+      void              restoreList     (const vectorSIp& items);
 
    protected:
       void              insert          (vectorSIp* list, ScoreItem* item);
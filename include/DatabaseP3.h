@@ -9,7 +9,10 @@
 // Description:   Keep track of SCORE items by horizontal position.  Either
 // 		  staves or systems can be stored in the database as long
 // 		  as all duration items are aligned by P3 positions across
-// 		  the system staves/staff layers.
+// 		  the system staves/staff layers.  Items are grouped into
+// 		  vertical slices (columns) stored in a sorted array, which
+// 		  is searched by P3 value or by staff duration offset
+// 		  (which is compared as an integer number of ticks).
 //
 
 #ifndef _DATABASEP3_H_INCLUDED
@@ -17,8 +20,6 @@
 
 #include "ScoreItem.h"
 
-#include <map>
-#include <list>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -44,30 +45,57 @@ class P3VerticalItems : public vectorSIp {
 class DatabaseP3 {
    public:
                        DatabaseP3        (void);
+                       DatabaseP3        (const DatabaseP3& database);
                       ~DatabaseP3        ();
 
+      DatabaseP3&      operator=         (const DatabaseP3& database);
+
       void             clear             (void);
+      void             setTicksPerQuarter(int ticks);
+      int              getTicksPerQuarter(void) const;
       int              size              (void);
       ostream&         printDatabase     (ostream& out = cout);
       void             addItem           (ScoreItem* item);
-      P3VerticalItems* getScoreItemsByP3 (SCORE_FLOAT p3);
+      int              getColumnCount    (void);
+      P3VerticalItems& getColumn         (int index);
+      P3VerticalItems* getScoreItemsByP3 (SCORE_FLOAT p3,
+                                          SCORE_FLOAT tolerance = 0.0);
       P3VerticalItems* getScoreItemsByStaffDurationOffset (SCORE_FLOAT offset);
+      P3VerticalItems* getScoreItemsByStaffOffsetTicks (int ticks);
       SCORE_FLOAT      getP3OfStaffDurationOffset(SCORE_FLOAT offset);
       SCORE_FLOAT      getStaffDurationOffsetOfP3(SCORE_FLOAT p3);
 
    protected:
-      P3VerticalItems* storeItem         (ScoreItem* item);
       void             prepare           (void);
+      void             prepareOffsets    (void);
+      int              findColumn        (SCORE_FLOAT p3,
+                                          SCORE_FLOAT tolerance);
 
    private:
       int preparedQ;
-      list<P3VerticalItems*>                database;
-      map<SCORE_FLOAT, P3VerticalItems*>    interface_byP3;
-      map<SCORE_FLOAT, P3VerticalItems*>    interface_byOffset;
+      int offsetsQ;
 
-};
+      // ticks_per_quarter is the tick resolution of the staff offsets
+      // of the system (see ScorePage::getSystemTicksPerQuarter()).
+      int ticks_per_quarter;
+
+      // entries are the items in the order that they were added, and
+      // entry_p3 is the P3 value of each entry.  entry_column is the
+      // index of the column containing each entry (set by prepare()).
+      vector<ScoreItem*>              entries;
+      vector<SCORE_FLOAT>             entry_p3;
+      vector<int>                     entry_column;
 
-bool DatabaseP3_sortP3(P3VerticalItems* a, P3VerticalItems* b);
+      // columns are the items grouped by P3 value, sorted from left to
+      // right, with column_p3 the P3 value of each column for searching.
+      vector<P3VerticalItems>         columns;
+      vector<SCORE_FLOAT>             column_p3;
+
+      // offset_index is the first column for each staff offset in ticks,
+      // sorted by offset (set by prepareOffsets()).
+      vector<pair<int, int>>          offset_index;
+
+};
 
 #endif  /* _DATABASEP3_H_INCLUDED */
 
@@ -30,12 +30,11 @@ using namespace std;
    using vectorVVSIp = BoundVector<BoundVector<BoundVector<ScoreItem*>>>;
 #endif
 
-#include <map>
-#include <list>
 #include <vector>
 #include <string>
 #include <iostream>
 
+class AnalysisTable;
 
 
 class TupletGroup {
@@ -55,17 +54,32 @@ class DatabaseTuplet {
                         ~DatabaseTuplet  ();
 
       void               clear          (void);
+      void               setItemIndex   (AnalysisTable* table);
+      void               prepareStaves  (int staffcount);
+      int                getStaffCount  (void) const;
       int                size           (void);
       TupletGroup*       tupletInfo     (ScoreItem*);
       TupletGroup*       linkItems      (ScoreItem* note1, ScoreItem* note2);
       ostream&           printDatabase  (ostream& out = cout);
+      const vector<TupletGroup*>& getGroups  (int staff) const;
+      void               restoreGroup   (int staff, const vectorSIp& brackets,
+                                         const vectorSIp& notes,
+                                         const vectorSIp& linked);
 
    protected:
       void               insertItem     (TupletGroup* list, ScoreItem* note);
+      void               storeGroup     (ScoreItem* item, TupletGroup* group);
 
    private:
-      map<ScoreItem*, TupletGroup*> interface;
-      list<TupletGroup*> database;
+      // item_index gives the dense index of each item on the page, and
+      // interface is the tuplet group containing each item index (or NULL
+      // if the item is not in a group).
+      AnalysisTable*     item_index;
+      vector<TupletGroup*> interface;
+
+      // database is the list of tuplet groups for each staff, so that the
+      // groups on separate staves can be linked at the same time.
+      vector<vector<TupletGroup*>> database;
 };
 
 
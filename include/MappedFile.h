@@ -0,0 +1,60 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 10:12:41 PDT 2026
+// Last Modified: Sat Oct 17 10:12:44 PDT 2026
+// Filename:      MappedFile.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/MappedFile.h
+// Syntax:        C++11
+//
+// Description:   Read-only view of the contents of a file.  The file is
+//                memory-mapped when possible, otherwise its contents are
+//                copied into an internal buffer.
+//
+
+#ifndef _MAPPEDFILE_H_INCLUDED
+#define _MAPPEDFILE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class MappedFile {
+   public:
+                     MappedFile       (void);
+                     MappedFile       (const string& filename);
+                     MappedFile       (const char* filename);
+                    ~MappedFile       ();
+
+      int            open             (const string& filename);
+      int            open             (const char* filename);
+      void           close            (void);
+      int            isOpen           (void) const;
+      const char*    data             (void) const;
+      size_t         size             (void) const;
+      const char*    begin            (void) const;
+      const char*    end              (void) const;
+      int            isBinaryScore    (void) const;
+
+   private:
+      // Disallow copying since the mapping is owned by the object.
+                     MappedFile       (const MappedFile& afile);
+      MappedFile&    operator=        (const MappedFile& afile);
+
+   private:
+      const char*    contents;   // start of file contents
+      size_t         length;     // number of bytes in file
+      void*          mapping;    // non-NULL when contents are memory-mapped
+      int            openQ;      // true if a file was successfully opened
+
+      // buffer is used when the file cannot be mapped (empty files and
+      // systems without mmap).
+      vector<char>   buffer;
+};
+
+
+#endif  /* _MAPPEDFILE_H_INCLUDED */
+
+
+
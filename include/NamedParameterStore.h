@@ -0,0 +1,103 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 22:10:26 PDT 2026
+// Last Modified: Sat Oct 17 22:10:29 PDT 2026
+// Filename:      NamedParameterStore.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/NamedParameterStore.h
+// Syntax:        C++11
+//
+// Description:   Compact storage for the named parameters of a ScoreItem.
+//                Namespace and key strings are interned into integer IDs
+//                (the official names in ScoreNamedParameters.h have fixed
+//                IDs), and the parameters are stored in a small flat list.
+//                Integer, floating-point and pointer versions of each
+//                value are calculated when the value is set, so that they
+//                do not have to be parsed from the string each time that
+//                they are accessed.
+//
+
+#ifndef _NAMEDPARAMETERSTORE_H_INCLUDED
+#define _NAMEDPARAMETERSTORE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class NamedParameterStore {
+   public:
+                     NamedParameterStore   (void);
+                    ~NamedParameterStore   ();
+
+      void           clear                 (void);
+      int            empty                 (void) const;
+      int            getParameterCount     (void) const;
+      int            getParameterCount     (int nsid) const;
+      int            getNamespaceCount     (void) const;
+      void           getNamespaces         (vector<int>& output) const;
+      void           getSortedParameters   (vector<int>& output,
+                                            int nsid = -1) const;
+      void           eraseNamespace        (int nsid);
+      int            erase                 (int nsid, int keyid);
+
+      int            find                  (int nsid, int keyid) const;
+      int            isDefined             (int nsid, int keyid) const;
+      const string&  getString             (int nsid, int keyid) const;
+      int            getInt                (int nsid, int keyid) const;
+      double         getDouble             (int nsid, int keyid) const;
+      void*          getPointer            (int nsid, int keyid) const;
+
+      void           setString             (int nsid, int keyid,
+                                            const string& value);
+      void           setString             (int nsid, int keyid,
+                                            const char* value,
+                                            const char* end);
+      void           setInt                (int nsid, int keyid, int value);
+      void           setPointer            (int nsid, int keyid,
+                                            void* pointer);
+
+      // Access to entries by index (from find() or getSortedParameters()):
+      int            getNamespaceId        (int index) const;
+      int            getKeyId              (int index) const;
+      const string&  getNamespace          (int index) const;
+      const string&  getKey                (int index) const;
+      const string&  getValue              (int index) const;
+      void*          getPointer            (int index) const;
+      int            isPointer             (int index) const;
+
+      // Name interning:
+      static int     getNameId             (const string& name);
+      static int     findNameId            (const string& name);
+      static const string& getName         (int id);
+
+   protected:
+      int            create                (int nsid, int keyid);
+      static void    cacheNumbers          (int& intvalue, double& doublevalue,
+                                            int& flags, const string& text);
+
+   private:
+      // Entry flags:
+      static constexpr int INT_VALID     = 1;  // intvalue matches stoi(text)
+      static constexpr int POINTER_VALUE = 2;  // pointer was set directly
+
+      struct Entry {
+         int     nsid;
+         int     keyid;
+         int     flags;
+         int     intvalue;
+         double  doublevalue;
+         void*   pointer;
+         string  text;
+      };
+
+      // entries is the list of named parameters, in the order that
+      // they were first set.
+      vector<Entry> entries;
+};
+
+
+#endif  /* _NAMEDPARAMETERSTORE_H_INCLUDED */
+
+
+
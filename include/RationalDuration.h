@@ -94,6 +94,9 @@ class RationalDuration {
        int                   powerOfTwoDuration (RationalDuration& rd,
                                                  double basedur);
        int                   ceilingPowerOfTwo  (double value);
+       int                   setDottedDuration  (double duration,
+                                                 int dcount,
+                                                 int tupletQ = 1);
 
 };
 
@@ -0,0 +1,125 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 00:31:08 PDT 2026
+// Last Modified: Sun Oct 18 00:31:11 PDT 2026
+// Filename:      ScoreBatch.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreBatch.h
+// Syntax:        C++11
+//
+// Description:   Convert a list of works in one process.  Each work is a
+//                list of input files which are read into a ScorePageSet
+//                of their own and converted to one output file by a
+//                function given by the conversion program.  Works are
+//                converted on several threads at once, and the time
+//                taken by each work and any failures are reported.
+//
+//                The list of works can be read from a manifest file, with
+//                one work per line: the input files of the work separated
+//                by spaces, optionally followed by "=" and the output
+//                file.  Blank lines and lines starting with "#" are
+//                ignored.  The list can also be made from the data files
+//                in a directory (and its subdirectories), one work for
+//                each file (or for each name, if the same music is stored
+//                in files with different extensions).
+//
+
+#ifndef _SCOREBATCH_H_INCLUDED
+#define _SCOREBATCH_H_INCLUDED
+
+#include "ScorePageSet.h"
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+
+class ScoreBatch {
+   public:
+      enum { WORK_PENDING = 0, WORK_DONE = 1, WORK_FAILED = -1 };
+
+      // Work is one work to convert and the results of its conversion.
+      class Work {
+         public:
+            vector<string>  inputs;
+            string          output;
+
+            // Results of the conversion:
+            int             status   = WORK_PENDING;
+            string          error;
+            double          ms       = 0.0;
+            int             pages    = 0;
+            int             segments = 0;
+      };
+
+      // ConvertFunction converts the pages of a work to the output
+      // stream.  It returns false (and can set the error message) if the
+      // work cannot be converted.
+      typedef function<int(ScorePageSet& infiles, ostream& out,
+            string& error)> ConvertFunction;
+
+                         ScoreBatch          (void);
+                        ~ScoreBatch          ();
+
+      void               clear               (void);
+      int                readManifest        (const string& filename);
+      int                readDirectory       (const string& directory);
+      int                read                (const string& name);
+      void               addWork             (const vector<string>& inputs,
+                                              const string& output = "");
+
+      void               setOutputExtension  (const string& extension);
+      int                setOutputDirectory  (const string& directory);
+      void               setThreadCount      (int count);
+      void               setCacheName        (const string& name);
+      void               setReport           (ostream& out);
+
+      int                run                 (const ConvertFunction& convert);
+      void               printSummary        (ostream& out);
+
+      int                getWorkCount        (void);
+      Work&              getWork             (int index);
+      int                getFailureCount     (void);
+
+      static int         isDataFile          (const string& filename);
+      static int         getExtensionRank    (const string& filename);
+
+   protected:
+      void               convertWork         (Work& work,
+                                              const ConvertFunction& convert);
+      string             getOutputFilename   (const vector<string>& inputs);
+      void               reportWork          (Work& work);
+
+   private:
+      vector<Work>       works;
+
+      // output_extension replaces the extension of the first input file
+      // of a work to make its output filename (if it is not given), and
+      // output_directory is where the output files are written (next to
+      // the input files if empty).
+      string             output_extension;
+      string             output_directory;
+
+      // thread_count is the number of works converted at the same time
+      // (0 for one per processor core).
+      int                thread_count;
+
+      // cache_name is the name of the analysis cache files for the works
+      // (see ScorePageSet::appendReadCached()).  No cache files are used
+      // if it is empty.
+      string             cache_name;
+
+      // report is where each work is reported as soon as it has been
+      // converted (or NULL for no report).  report_lock is held while
+      // writing to it.
+      ostream*           report;
+      mutex              report_lock;
+
+      // wall_ms is the time taken by run().
+      double             wall_ms;
+};
+
+
+#endif  /* _SCOREBATCH_H_INCLUDED */
+
+
+
@@ -0,0 +1,227 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:31 PDT 2026
+// Last Modified: Sat Oct 17 23:59:34 PDT 2026
+// Filename:      ScoreCache.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreCache.h
+// Syntax:        C++11
+//
+// Description:   Binary cache files for a ScorePageSet.  A cache file
+//                stores the items of the pages, the segment and part
+//                tables and the analysis results, so that the pages can
+//                be restored without parsing and analyzing the input
+//                files again.  The file is keyed by a hash of the input
+//                files and is read with a single memory mapping.
+//
+//                The file starts with a Header giving the offset and size
+//                of each section, and each section is an array of one of
+//                the record types below.  Links between items are stored
+//                as indexes into the list of all items in the set (in the
+//                order of the pages), and text is stored as indexes into
+//                a table of strings.  Sections are aligned to 8 bytes.
+//
+
+#ifndef _SCORECACHE_H_INCLUDED
+#define _SCORECACHE_H_INCLUDED
+
+#include "ScorePageSet.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+
+class ScoreCache {
+   public:
+                       ScoreCache          (void);
+                      ~ScoreCache          ();
+
+      void             clear               (void);
+      int              read                (ScorePageSet& pageset,
+                                            const string& filename,
+                                            uint64_t hash);
+      int              write               (ScorePageSet& pageset,
+                                            const string& filename,
+                                            uint64_t hash);
+
+      static uint64_t  getSourceHash       (const vector<string>& filenames);
+
+   protected:
+      // Sections of the file:
+      enum {
+         SECTION_STRINGOFFSETS = 0,  // uint32_t: start of each string
+         SECTION_STRINGDATA,         // char: contents of the strings
+         SECTION_PAGES,              // PageRecord
+         SECTION_ITEMS,              // ItemRecord
+         SECTION_NAMED,              // NamedRecord
+         SECTION_NUMBERS,            // SCORE_FLOAT: fixed parameters, trailers
+         SECTION_ROWS,               // RowRecord
+         SECTION_GROUPS,             // GroupRecord
+         SECTION_INDEXES,            // int32_t: group items, part maps
+         SECTION_SEGMENTS,           // SegmentRecord
+         SECTION_ANALYSES,           // int32_t: completed analysis names
+         SECTION_COUNT
+      };
+
+      // Types of item groups:
+      enum {
+         GROUP_CHORD  = 0,
+         GROUP_BEAM   = 1,
+         GROUP_TUPLET = 2,
+         GROUP_LYRICS = 3
+      };
+
+      struct Section {
+         uint64_t    offset;       // bytes from start of file
+         uint64_t    size;         // size in bytes
+      };
+
+      struct Header {
+         char        magic[8];     // "SCORELIB"
+         uint32_t    version;      // CACHE_VERSION
+         uint32_t    byteorder;    // 0x01020304 in the writer's byte order
+         uint64_t    hash;         // hash of the input files
+         uint32_t    floatsize;    // sizeof(SCORE_FLOAT)
+         uint32_t    sectioncount; // SECTION_COUNT
+         Section     sections[SECTION_COUNT];
+      };
+
+      struct PageRecord {
+         int32_t     overlay;      // true if an overlay of the previous page
+         int32_t     filepath;     // string index
+         int32_t     filebase;     // string index
+         int32_t     fileext;      // string index
+         int32_t     pagestyle;    // PPMX_PAGE_MARKER_RS or _COMMENT
+         uint32_t    valid;        // bit for each of PageAnalyses valid
+         int32_t     itemstart;
+         int32_t     itemcount;
+         int32_t     trailerstart; // in SECTION_NUMBERS
+         int32_t     trailercount;
+         int32_t     rowstart;
+         int32_t     rowcount;
+         int32_t     groupstart;
+         int32_t     groupcount;
+         int32_t     partstart;    // segmentpart_map in SECTION_INDEXES
+         int32_t     partcount;
+      };
+
+      struct ItemRecord {
+         int32_t     fixedstart;   // in SECTION_NUMBERS
+         int32_t     fixedcount;
+         int32_t     namedstart;
+         int32_t     namedcount;
+         int32_t     text;         // string index of the fixed text
+         int32_t     reserved;
+      };
+
+      struct NamedRecord {
+         int32_t     nspace;       // string index
+         int32_t     key;          // string index
+         int32_t     value;        // string index
+         int32_t     item;         // item index if the value is an item
+      };
+
+      struct RowRecord {
+         int32_t     item;
+         uint16_t    fields;
+         uint16_t    unexported;
+         int32_t     base40;
+         int32_t     layer;
+         double      staffoffset;
+         double      staffduration;
+         int32_t     tiednext;     // item index or -1
+         int32_t     tiedlast;     // item index or -1
+         int32_t     chordid;
+         int32_t     beamid;
+         int32_t     tupletid;
+         int32_t     staffticks;
+      };
+
+      struct GroupRecord {
+         int32_t     type;         // GROUP_CHORD, _BEAM, _TUPLET, _LYRICS
+         int32_t     staff;
+         int32_t     start;        // item indexes in SECTION_INDEXES
+         int32_t     headcount;    // beams or brackets at start of list
+         int32_t     count;        // total number of items in list
+         int32_t     linkcount;    // linked-only items at end of list
+      };
+
+      struct SegmentRecord {
+         int32_t     start[4];     // page, overlay, system, systemstaff
+         int32_t     end[4];
+      };
+
+   protected:
+      // Writing:
+      int              addString           (const string& text);
+      int              getItemIndex        (const void* item);
+      void             storePage           (ScorePage& page, int overlay);
+      void             storeItem           (ScoreItem* item);
+      void             storeRows           (ScorePage& page);
+      void             storeGroups         (ScorePage& page);
+      void             storeGroup          (int type, int staff,
+                                            const vectorSIp& head,
+                                            const vectorSIp& items,
+                                            const vectorSIp& linked);
+
+      // Reading:
+      int              readSections        (const char* data, size_t size,
+                                            uint64_t hash);
+      int              checkRecords        (void);
+      string           getString           (int index);
+      int              getNameId           (int index);
+      ScorePage*       createPage          (const PageRecord& record);
+      void             restoreParameters   (const PageRecord& record);
+      void             restoreAnalyses     (ScorePage& page,
+                                            const PageRecord& record);
+      void             restoreGroups       (ScorePage& page,
+                                            const PageRecord& record);
+
+   private:
+      // Contents of a file being written:
+      vector<uint32_t>       stringoffsets;
+      vector<char>           stringdata;
+      vector<PageRecord>     pages;
+      vector<ItemRecord>     items;
+      vector<NamedRecord>    named;
+      vector<SCORE_FLOAT>    numbers;
+      vector<RowRecord>      rows;
+      vector<GroupRecord>    groups;
+      vector<int32_t>        indexes;
+      vector<SegmentRecord>  segments;
+      vector<int32_t>        analyses;
+
+      // strings gives the string index of each string in the table, and
+      // itemindex the item index of each item, when writing a file.
+      unordered_map<string, int>       strings;
+      unordered_map<const void*, int>  itemindex;
+
+      // Sections of a file being read (which point into the mapped file):
+      const Header*          header;
+      const uint32_t*        instringoffsets;
+      const char*            instringdata;
+      const PageRecord*      inpages;
+      const ItemRecord*      initems;
+      const NamedRecord*     innamed;
+      const SCORE_FLOAT*     innumbers;
+      const RowRecord*       inrows;
+      const GroupRecord*     ingroups;
+      const int32_t*         inindexes;
+      const SegmentRecord*   insegments;
+      const int32_t*         inanalyses;
+      int                    counts[SECTION_COUNT];
+
+      // itemlist is the list of all items in the set, and nameids the
+      // NamedParameterStore ID for each string index (or -1 if not
+      // looked up yet), when reading a file.
+      vector<ScoreItem*>     itemlist;
+      vector<int>            nameids;
+};
+
+
+#endif  /* _SCORECACHE_H_INCLUDED */
+
+
+
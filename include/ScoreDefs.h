@@ -16,7 +16,12 @@
 
 // When UseBoundVector is defined, use out-of-bounds checking
 // on scorelib data types derived typedefed from the vector class.
-#define UseBoundVector
+// Release builds ("make library-release") define SCORELIB_RELEASE
+// to use unchecked vectors instead.  Programs must be compiled with
+// the same setting as the library that they link to.
+#ifndef SCORELIB_RELEASE
+   #define UseBoundVector
+#endif
 
 #include <map>
 #include <vector>
@@ -0,0 +1,80 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 01:02:16 PDT 2026
+// Last Modified: Sun Oct 18 01:02:19 PDT 2026
+// Filename:      ScoreFileType.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreFileType.h
+// Syntax:        C++11
+//
+// Description:   Identify the type of SCORE data files without reading
+//                them completely: binary SCORE files are identified by the
+//                last four bytes of the file, and PMX files by the first
+//                lines of the file.  Directory trees can be searched for
+//                files on several threads at once.
+//
+
+#ifndef _SCOREFILETYPE_H_INCLUDED
+#define _SCOREFILETYPE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class ScoreFileType {
+   public:
+      enum {
+         FILE_UNREADABLE = -1,  // file cannot be opened
+         FILE_OTHER      = 0,   // not SCORE data
+         FILE_BINARY     = 1,   // binary SCORE page (.mus or .pag)
+         FILE_PMX        = 2,   // PMX data
+         FILE_PPMX       = 3    // PMX data starting with a page marker
+      };
+
+      static int         classify            (const string& filename);
+      static int         classify            (const char* data,
+                                              size_t size);
+      static int         hasBinaryTrailer    (const char* data,
+                                              size_t size);
+      static const char* getTypeName         (int type);
+
+      static void        findFiles           (const string& directory,
+                                              vector<string>& files,
+                                              int threads = 1);
+      static void        classifyFiles       (const vector<string>& files,
+                                              vector<int>& types,
+                                              int threads = 1);
+
+   protected:
+      static int         classifyLine        (const char* line,
+                                              const char* lineend);
+      static int         isNumber            (const char* text,
+                                              const char* textend);
+      static int         classifyText        (const char* data,
+                                              size_t size, size_t& used,
+                                              int lastQ);
+
+   private:
+      // DirectoryEntry is a directory found by findFiles().  children
+      // is the index of its first subdirectory in the next level of the
+      // search, and childcount is the number of subdirectories.
+      struct DirectoryEntry {
+         string          name;
+         vector<string>  files;
+         vector<string>  subdirs;
+         int             children;
+         int             childcount;
+      };
+
+      static void        listDirectory       (DirectoryEntry& entry);
+      static void        addTreeFiles        (vector<vector<DirectoryEntry>>&
+                                              levels, int level, int index,
+                                              vector<string>& files);
+};
+
+
+#endif  /* _SCOREFILETYPE_H_INCLUDED */
+
+
+
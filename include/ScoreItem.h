@@ -26,6 +26,7 @@ using namespace std;
 
 class ScoreItem;
 class ScorePage;
+class AnalysisTable;
 
 // ScoreItem typedefs:
 using listSIp     = list<ScoreItem*>;
@@ -143,6 +144,8 @@ using listSIp     = list<ScoreItem*>;
       // Duration processing
       void         setStaffOffsetDuration       (SCORE_FLOAT duration);
       SCORE_FLOAT  getStaffOffsetDuration       (void);
+      void         setStaffOffsetTicks          (int ticks);
+      int          getStaffOffsetTicks          (void);
       bool         hasDuration                  (void);
       SCORE_FLOAT  getDuration                  (void);
       RationalDuration getRationalDuration      (void);
@@ -353,6 +356,26 @@ using listSIp     = list<ScoreItem*>;
       // Chord analysis dependent functions:
       string       getHumdrumPitch                (void);
 
+      // Analysis results stored in the page's AnalysisTable (defined in
+      // ScoreItem_analysis.cpp).  Items which are not on a page store
+      // the results in the auto namespace instead.
+      void         setBase40Pitch                 (int base40);
+      int          getBase40Pitch                 (void);
+      void         setLayer                       (int layer);
+      int          getLayer                       (void);
+      void         setStaffDuration               (SCORE_FLOAT duration);
+      SCORE_FLOAT  getStaffDuration               (void);
+      void         setTiedNextNote                (ScoreItem* item);
+      ScoreItem*   getTiedNextNote                (void);
+      void         setTiedLastNote                (ScoreItem* item);
+      ScoreItem*   getTiedLastNote                (void);
+      int          getChordId                     (void);
+      int          getBeamId                      (void);
+      int          getTupletId                    (void);
+
+   protected:
+      AnalysisTable* getAnalysisTable             (void);
+
 
 };
 
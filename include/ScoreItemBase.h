@@ -19,6 +19,7 @@
 
 #include "ScoreDefs.h"
 #include "ScoreItemEdit_ParameterHistory.h"
+#include "NamedParameterStore.h"
 
 #include <list>
 #include <iostream>
@@ -32,6 +33,9 @@ class ScoreItemBase {
 
    friend class ScorePageBase;
    friend class ScoreItem;
+   friend class AnalysisTable;
+   friend class ScoreCache;
+   friend class ScorePmxWriter;
 
    public:
                     ScoreItemBase     (void);
@@ -153,6 +157,8 @@ class ScoreItemBase {
       bool          getParameterBoolean(const string& key);
       double        getParameterDouble(const string& key);
       double        getParameterDouble(const string& nspace, const string& key);
+      void*         getParameterPointer(const string& nspace,
+                                        const string& key);
       const string& getFixedText      (void) const;
       SCORE_FLOAT   getParameterFraction(int pindex);
 
@@ -351,6 +357,8 @@ class ScoreItemBase {
                                             const string& nspace,
                                             int indentcount,
                                             const string& indentstring);
+     int           findNamedParameter      (const string& nspace,
+                                            const string& key) const;
    protected:
       // Page-related interface functions
       void         notifyPageOfChange      (const string& message);
@@ -360,9 +368,14 @@ class ScoreItemBase {
    public:
       // Binary read/write functions
       int           writeBinary           (ostream& out);
+      int           getBinaryWordCount    (void);
+      int           encodeBinary          (char* bytes);
       double        readLittleEndianFloat (istream& instream);
       void          writeLittleEndianFloat(ostream& out, double number);
       void          readBinary            (istream& instream, int pcount);
+      int           readBinary            (const SCORE_FLOAT* values,
+                                           const char* bytes, int pcount,
+                                           int available);
       void          readPmx               (istream& instream, int verboseQ = 0);
       static double roundFractionDigits   (double number, int digits);
 
@@ -370,7 +383,7 @@ class ScoreItemBase {
 
    protected:
       vectorSF     fixed_parameters;
-      mapNamespace named_parameters;
+      NamedParameterStore named_parameters;
       string       fixed_text;  // used for P1=15 and P1=16 SCORE items.
       // fixed_text for P1=15 is an EPS graphic file to include.
       // fixed_text for P1=16 is a text string.
@@ -386,6 +399,10 @@ class ScoreItemBase {
       // of the item.
       SCORE_FLOAT staff_duration_offset;
 
+      // analysis_row is the row of the page's AnalysisTable which
+      // contains the analysis results for the item (or -1 if none).
+      int analysis_row;
+
       // Used by ScoreItemEdit class to store parameter history:
       HistoryList history_list;
 
@@ -405,6 +422,15 @@ class ScoreItemBase {
       
       // extract a named parameter from an input PMX line:
       static void readNamedParameter (mapNamespace& np, char* input);
+      static void readNamedParameter (mapNamespace& np, const char* input,
+                                      const char* end);
+      static void readNamedParameter (NamedParameterStore& np,
+                                      const char* input, const char* end);
+
+   protected:
+      static int  parseNamedParameter(const char* input, const char* end,
+                                      string& nspace, string& key,
+                                      const char*& value, const char*& vend);
 };
 
 
@@ -0,0 +1,65 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 21:22:09 PDT 2026
+// Last Modified: Sat Oct 17 21:22:12 PDT 2026
+// Filename:      ScoreItemPool.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreItemPool.h
+// Syntax:        C++11
+//
+// Description:   Slab allocator for the ScoreItems owned by a page.  Items
+//                are constructed in large blocks of memory rather than
+//                being allocated one at a time, and all of the items are
+//                released together when the pool is cleared.
+//
+
+#ifndef _SCOREITEMPOOL_H_INCLUDED
+#define _SCOREITEMPOOL_H_INCLUDED
+
+#include "ScoreItem.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class ScoreItemPool {
+   public:
+                     ScoreItemPool    (void);
+                    ~ScoreItemPool    ();
+
+      ScoreItem*     create           (void);
+      ScoreItem*     create           (const ScoreItem& anItem);
+      ScoreItem*     create           (const string& itemstring);
+      void           clear            (void);
+      int            size             (void) const;
+
+   protected:
+      void*          allocate         (void);
+
+   private:
+      // Disallow copying since the items are owned by the pool.
+                     ScoreItemPool    (const ScoreItemPool& apool);
+      ScoreItemPool& operator=        (const ScoreItemPool& apool);
+
+   private:
+      // slabs are the blocks of memory which contain the items.  Each
+      // slab is twice as large as the previous one, up to a maximum
+      // of MAX_SLAB_ITEMS.
+      vector<ScoreItem*> slabs;
+      vector<int>        slab_sizes;
+
+      // used is the number of items constructed in the last slab.
+      int used;
+
+      // count is the total number of items constructed in the pool.
+      int count;
+
+      static constexpr int MIN_SLAB_ITEMS = 32;
+      static constexpr int MAX_SLAB_ITEMS = 256;
+};
+
+
+#endif  /* _SCOREITEMPOOL_H_INCLUDED */
+
+
+
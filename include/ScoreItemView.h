@@ -0,0 +1,71 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 03:41:26 PDT 2026
+// Last Modified: Sun Oct 18 03:41:29 PDT 2026
+// Filename:      ScoreItemView.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreItemView.h
+// Syntax:        C++11
+//
+// Description:   A view of a ScoreItem owned by a page, which shares the
+//                item's data and stores only the fixed parameters which
+//                have been changed in the view.  This is used to print
+//                a modified version of an item (such as a staff shortened
+//                to the width of an extracted measure) without copying
+//                the item's named parameters, text and edit history, and
+//                without changing the item on the page.
+//
+
+#ifndef _SCOREITEMVIEW_H_INCLUDED
+#define _SCOREITEMVIEW_H_INCLUDED
+
+#include "ScoreItem.h"
+#include <ostream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+
+class ScoreItemView {
+   public:
+                      ScoreItemView         (void);
+                      ScoreItemView         (ScoreItem* item);
+                     ~ScoreItemView         ();
+
+      void            setItem               (ScoreItem* item);
+      ScoreItem*      getItem               (void);
+      void            clear                 (void);
+      int             getChangeCount        (void) const;
+
+      SCORE_FLOAT     getParameter          (int pindex);
+      SCORE_FLOAT     getP                  (int pindex);
+      void            setParameter          (int pindex, SCORE_FLOAT value);
+      void            setP                  (int pindex, SCORE_FLOAT value);
+
+      int             getFixedParameters    (SCORE_FLOAT* values);
+      const string&   getFixedText          (void) const;
+      void            copyItem              (ScoreItem& output);
+
+      ostream&        printPmx              (ostream& out, int autoQ = 1);
+      ostream&        printPmxFixedParameters(ostream& out);
+
+   private:
+      // item is the item on the page which is being viewed.
+      ScoreItem*      item;
+
+      // changes are the fixed parameters which have been set in the
+      // view, as pairs of the parameter index and its value.  Items
+      // typically have one or two changes, so a search through an
+      // unsorted vector is used rather than a map.
+      vector<pair<int, SCORE_FLOAT>> changes;
+};
+
+
+ostream& operator<<(ostream& out, ScoreItemView& view);
+ostream& printNoAuto(ostream& out, ScoreItemView& view);
+
+
+#endif  /* _SCOREITEMVIEW_H_INCLUDED */
+
+
+
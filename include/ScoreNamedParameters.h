@@ -190,5 +190,46 @@ const string np_barnum = "barnum";
 // @footnote: indicates the text of a footnote related to an item.
 const string np_footnote = "footnote";
 
+
+/////////////////////////////////////////////////////////////////////////////
+//
+// SCORE_OFFICIAL_NAMES -- The official namespaces and parameter names
+//     above, in the order of their fixed IDs in NamedParameterStore (after
+//     the empty namespace, which is ID 0).  Add new names to the end of
+//     the list so that the IDs of the other names do not change.
+//
+
+#define SCORE_OFFICIAL_NAMES(NAME)  \
+   NAME(ns_auto)                    \
+   NAME(np_staffOffsetDuration)     \
+   NAME(np_segmentOffsetDuration)   \
+   NAME(np_pagesetOffsetDuration)   \
+   NAME(np_staffDuration)           \
+   NAME(np_layer)                   \
+   NAME(np_staffOffsetLeft)         \
+   NAME(np_staffOffsetRight)        \
+   NAME(np_slurDuration)            \
+   NAME(np_tie)                     \
+   NAME(np_tiedNextNote)            \
+   NAME(np_tiedLastNote)            \
+   NAME(np_tieLast)                 \
+   NAME(np_tieNext)                 \
+   NAME(np_hangLeft)                \
+   NAME(np_hangRight)               \
+   NAME(np_tiedNextSlur)            \
+   NAME(np_tiedLastSlur)            \
+   NAME(np_address)                 \
+   NAME(np_base40Pitch)             \
+   NAME(np_courtesy)                \
+   NAME(np_function)                \
+   NAME(ns_lyrics)                  \
+   NAME(np_verseLine)               \
+   NAME(np_hyphenAfter)             \
+   NAME(np_hyphenBefore)            \
+   NAME(np_lyricsHyphen)            \
+   NAME(np_wordExtension)           \
+   NAME(np_barnum)                  \
+   NAME(np_footnote)
+
 #endif /* _SCORENAMEDPARAMETER_H_INCLUDED */
 
@@ -52,6 +52,13 @@ class ScorePage : public ScorePageBase {
 //      void getSystemP3Database             (int sysindex, DatabaseP3& list);
 
 
+      // Analysis scheduling functions (defined in ScorePage_analysis.cpp):
+      void         analyze                    (const vector<string>& analyses);
+      void         analyze                    (const string& analysis);
+   private:
+      void         runAnalysis                (const string& analysis);
+   public:
+
       // Staff Analysis functions (defined in ScorePage_staff.cpp):
       void         analyzeStaves              (void);
       int          getMaxStaff                (void);
@@ -90,8 +97,12 @@ class ScorePage : public ScorePageBase {
       SCORE_FLOAT getStaffDuration       (int staffnum);
       void        setStaffDuration       (int staffnum, SCORE_FLOAT duration);
       SCORE_FLOAT getSystemDuration      (int sysindex);
+      int         getSystemTicksPerQuarter(int sysindex);
    private:
-      SCORE_FLOAT calculateStaffDuration(vectorSIp& staffitems);
+      SCORE_FLOAT calculateStaffDuration(vectorSIp& staffitems,
+                                         int ticksperquarter);
+      int         calculateTicksPerQuarter(vectorSIp& items);
+      void        prepareSystemTicks     (void);
    public:
 
       // Layer analysis functions (defined in ScorePage_layer.cpp):
@@ -136,6 +147,7 @@ class ScorePage : public ScorePageBase {
    private:
       void        analyzeBeamsOnStaff   (int p2index,
                                          SCORE_FLOAT tolerance = 0.001);
+      void        storeBeamIds          (void);
    public:
 
       // Tuplet analysis functions (defined in ScorePage_tuplet.cpp):
@@ -145,6 +157,7 @@ class ScorePage : public ScorePageBase {
    private:
       void        analyzeTupletsOnStaff  (int p2index,
                                          SCORE_FLOAT tolerance = 0.001);
+      void        storeTupletIds         (void);
    public:
 
       // P3 analysis functions (defined in ScorePage_p3.cpp):
@@ -179,6 +192,7 @@ class ScorePage : public ScorePageBase {
       // private chord analysis functions:
       void        analyzeChordsOnStaff  (int p2index);
       void        analyzeVerticalNoteSet(vectorSIp& data);
+      void        storeChordIds         (void);
 
 
 };
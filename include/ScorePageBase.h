@@ -15,7 +15,10 @@
 #define _SCOREPAGEBASE_H_INCLUDED
 
 #include "ScoreItem.h"
+#include "ScoreItemPool.h"
+#include "ScoreProfile.h"
 #include "ScorePageBase_AnalysisInfo.h"
+#include "ScorePageBase_AnalysisTable.h"
 #include "ScorePageBase_PrintInfo.h"
 #include "ScorePageBase_StaffInfo.h"
 #include "DatabaseChord.h"
@@ -24,6 +27,7 @@
 #include "DatabaseTuplet.h"
 #include "DatabaseP3.h"
 #include "SystemMeasure.h"
+#include <functional>
 
 #define PPMX_PAGE_MARKER_RS      1
 #define PPMX_PAGE_MARKER_COMMENT 2
@@ -34,6 +38,7 @@ class ScorePageBase {
 
    friend class ScoreItemBase;
    friend class ScorePageSet;
+   friend class ScoreCache;
 
    public:
                      ScorePageBase            (void);
@@ -55,6 +60,12 @@ class ScorePageBase {
                                                const string& oldspace,
                                                const string& parameter,
                                                int itemtype);
+      AnalysisTable& getAnalysisTable         (void);
+      void           exportAnalysisParameters (void);
+      void           exportAnalysisParameters (ScoreItemBase* item);
+      void           setThreadCount           (int count);
+      int            getThreadCount           (void);
+      int            getChangeCount           (void);
 
       // File name functions:
       string&        getFilename              (string& output);
@@ -103,11 +114,19 @@ class ScorePageBase {
       void           readStream      (istream& instream, int verboseQ = 0);
       void           readPmx         (const char* filename, int verboseQ = 0);
       void           readPmx         (istream& infile, int verboseQ = 0);
+      void           readPmx         (const char* data, size_t size,
+                                      int verboseQ = 0);
       ScoreItem*     readPmxScoreLine(istream& infile, int verboseQ = 0);
+      ScoreItem*     readPmxScoreLine(const char*& data, const char* end,
+                                      int verboseQ = 0);
       void           readBinary      (const char* filename, int verboseQ = 0);
       void           readBinary      (istream& infile, int verboseQ = 0);
+      void           readBinary      (const char* data, size_t size,
+                                      int verboseQ = 0);
       void           addPmxData      (istream& data);
       void           addPmxData      (const string& data);
+      void           addPmxData      (const char* data, size_t size,
+                                      int verboseQ = 0);
       void           setMultipageRs  (void);
       void           setMultipageComment (void);
 
@@ -115,6 +134,7 @@ class ScorePageBase {
       void           writeBinary     (const char* filename);
       void           writeBinary     (const string& filename);
       ostream&       writeBinary     (ostream& outfile);
+      void           encodeBinary    (vector<char>& output);
       ostream&       writeLittleFloat(ostream& out, SCORE_FLOAT number);
       ostream&       printPmx        (ostream& out, int roundQ = 1,
                                       int verboseQ = 0);
@@ -131,14 +151,25 @@ class ScorePageBase {
    protected:
       SCORE_FLOAT    readLittleFloat (istream& instream);
       int            readLittleShort (istream& input);
+      static void    decodeLittleFloats(const char* bytes, int count,
+                                      SCORE_FLOAT* output);
+      static void    encodeLittleFloats(const SCORE_FLOAT* values, int count,
+                                      char* bytes);
+      static const char* findPmxLineEnd(const char* ptr, const char* end);
+      static int     nextPmxToken    (const char*& ptr, const char* end,
+                                      const char*& tok, const char*& tokend);
 
    protected:
       // Variable "item_storage" contains pointers to all SCORE items on the
-      // page.  It is the responsibility of an instance of this class to
-      // delete these items (unless they are transfered to another page
-      // before this one is destroyed).
+      // page.  The items are owned by item_pool, so they must not be
+      // deleted individually: they are all released when the page is
+      // cleared or destroyed.
       listSIp item_storage;
 
+      // Variable "item_pool" contains the memory for the items in
+      // item_storage.
+      ScoreItemPool item_pool;
+
       // Various horizontally sorted organizations of the item_storage data.
       vectorSIp   itemlist_P3sorted;
       vectorVSIp  itemlist_staffsorted;
@@ -192,6 +223,11 @@ class ScorePageBase {
       // data on the page.
       AnalysisInfo analysis_info;
 
+      // analysis_table contains the results of analyses for items on
+      // the page, which are copied into the auto namespace of the items
+      // by exportAnalysisParameters() when needed.
+      AnalysisTable analysis_table;
+
       // print_info contains variable needed to print or process page
       // data as a bitmap.
       PrintInfo print_info;
@@ -213,7 +249,24 @@ class ScorePageBase {
       // system.  Dimension of p3_database is the system count on the page.
       vector<DatabaseP3> p3_database;
 
-      static constexpr bool monitor_P3 = 0;
+      // system_ticks is the number of ticks per quarter note used for the
+      // integer staff offsets of each system (set by the duration analysis).
+      vectorI system_ticks;
+
+      // monitor_P3: keep the sorted item lists up to date when the
+      // horizontal position of an item changes, rather than sorting
+      // the page again.
+      static constexpr bool monitor_P3 = 1;
+
+      // thread_count is the number of threads used to run the per-staff
+      // and per-system passes of the page analyses.  The default of 1
+      // runs them serially, and 0 uses one thread for each processor core.
+      int thread_count;
+
+      // change_count is incremented whenever items are added to or
+      // removed from the page, or a fixed parameter or the text of an
+      // item changes (see getChangeCount()).
+      int change_count;
 
       void* pageset_owner;
 
@@ -230,6 +283,11 @@ class ScorePageBase {
                                        const string& message, int index,
                                        SCORE_FLOAT oldp, SCORE_FLOAT newp);
       void    clearAnalysisStates     (void);
+      int     repositionItem          (vectorSIp& list, ScoreItem* item,
+                                       bool (*compare)(ScoreItem*,
+                                                       ScoreItem*));
+      void    runAnalysisPasses       (int count,
+                                       const function<void(int)>& pass);
 
 };
 
@@ -32,6 +32,8 @@ class AnalysisInfo {
       void          clear                    (void);
 
       void          invalidateModified       (void);
+      void          invalidateStaffContents  (int staff);
+      int           hasAnalysis              (void);
       ostream&      print                    (ostream& out = cout);
 
       // Tests to see if various analyses have been done.
@@ -54,7 +56,13 @@ class AnalysisInfo {
       void          setValid                 (const string& node);
       void          setInvalid               (const string& node);
       void          invalidate               (const string& node);
+      void          invalidate               (const string& node, int staff);
       void          validate                 (const string& node);
+      int           getInvalidStaves         (const string& node,
+                                              set<int>& staves);
+      int           isValid                  (const string& node);
+      void          getDependencyOrder       (const vector<string>& nodes,
+                                              vector<string>& order);
 
    private:
       // notmodified: true if data has not been modified
@@ -73,7 +81,7 @@ class AnalysisInfo {
       int staves;
 
       // duration: true if duration analysis has been done for each staff.
-      // Dependencies for duration: staves (sorted, notmodified)
+      // Dependencies for duration: staves, systems (sorted, notmodified)
       int duration;
 
       // systems: true if system identification has been done.
@@ -0,0 +1,143 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:50 PDT 2026
+// Last Modified: Sat Oct 17 23:59:53 PDT 2026
+// Filename:      ScorePageBase_AnalysisTable.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScorePageBase_AnalysisTable.h
+// Syntax:        C++11
+//
+// Description:   Support class for storing the results of page analyses
+//                in ScorePageBase.  Each analyzed item is given a row in
+//                the table, and each type of result is stored in its own
+//                array of native values.  The results are copied into the
+//                auto namespace of the items only when they are needed as
+//                named parameters (such as when printing the page).
+//
+
+#ifndef _SCOREPAGEBASE_ANALYSISTABLE_H_INCLUDED
+#define _SCOREPAGEBASE_ANALYSISTABLE_H_INCLUDED
+
+#include "ScoreItem.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class AnalysisTable {
+
+   friend class ScoreCache;
+
+   public:
+                    AnalysisTable           (void);
+                   ~AnalysisTable           ();
+
+      void          clear                   (void);
+      int           getRowCount             (void) const;
+      int           getItemIndex            (ScoreItem* item);
+      int           findItemIndex           (ScoreItem* item) const;
+      void          copyRow                 (ScoreItem* item,
+                                             const AnalysisTable& table,
+                                             ScoreItem* olditem);
+
+      // Analysis results.  The get functions return false if the
+      // result has not been stored for the item.
+      void          setBase40Pitch          (ScoreItem* item, int value);
+      bool          getBase40Pitch          (ScoreItem* item,
+                                             int& value) const;
+      void          setStaffOffsetDuration  (ScoreItem* item,
+                                             SCORE_FLOAT value);
+      bool          getStaffOffsetDuration  (ScoreItem* item,
+                                             SCORE_FLOAT& value) const;
+      void          setStaffOffsetTicks     (ScoreItem* item, int value);
+      bool          getStaffOffsetTicks     (ScoreItem* item,
+                                             int& value) const;
+      void          setStaffDuration        (ScoreItem* item,
+                                             SCORE_FLOAT value);
+      bool          getStaffDuration        (ScoreItem* item,
+                                             SCORE_FLOAT& value) const;
+      void          setLayer                (ScoreItem* item, int value);
+      bool          getLayer                (ScoreItem* item,
+                                             int& value) const;
+      void          setTiedNextNote         (ScoreItem* item,
+                                             ScoreItem* value);
+      bool          getTiedNextNote         (ScoreItem* item,
+                                             ScoreItem*& value) const;
+      void          setTiedLastNote         (ScoreItem* item,
+                                             ScoreItem* value);
+      bool          getTiedLastNote         (ScoreItem* item,
+                                             ScoreItem*& value) const;
+      void          setChordId              (ScoreItem* item, int value);
+      bool          getChordId              (ScoreItem* item,
+                                             int& value) const;
+      void          setBeamId               (ScoreItem* item, int value);
+      bool          getBeamId               (ScoreItem* item,
+                                             int& value) const;
+      void          setTupletId             (ScoreItem* item, int value);
+      bool          getTupletId             (ScoreItem* item,
+                                             int& value) const;
+
+      // Copying results into the auto namespace of the items:
+      bool          isExportPending         (void) const;
+      void          exportParameters        (void);
+      void          exportParameters        (ScoreItem* item);
+
+      static string      formatDuration     (SCORE_FLOAT value);
+      static SCORE_FLOAT roundDuration      (SCORE_FLOAT value);
+
+   protected:
+      void          exportRow               (int row);
+      int           findRow                 (ScoreItem* item) const;
+      int           getRow                  (ScoreItem* item);
+      bool          hasField                (int row, int field) const;
+      void          markField               (int row, int field);
+
+   private:
+      // Bit flags for the analysis fields of a row:
+      enum {
+         FIELD_BASE40         = 0x0001,
+         FIELD_STAFFOFFSET    = 0x0002,
+         FIELD_STAFFDURATION  = 0x0004,
+         FIELD_LAYER          = 0x0008,
+         FIELD_TIEDNEXT       = 0x0010,
+         FIELD_TIEDLAST       = 0x0020,
+         FIELD_CHORD          = 0x0040,
+         FIELD_BEAM           = 0x0080,
+         FIELD_TUPLET         = 0x0100,
+         FIELD_STAFFTICKS     = 0x0200,
+         // Fields which have an equivalent auto namespace parameter:
+         FIELD_EXPORTED       = 0x003f
+      };
+
+      // items is the item for each row of the table.
+      vector<ScoreItem*>     items;
+
+      // fields are the analysis results which have been stored for each
+      // row, and unexported are the results which have not yet been
+      // copied into the named parameters of the item.
+      vector<uint16_t>       fields;
+      vector<uint16_t>       unexported;
+
+      vector<int>            base40;
+      vector<SCORE_FLOAT>    staffoffset;
+      vector<int>            staffticks;
+      vector<SCORE_FLOAT>    staffduration;
+      vector<int>            layer;
+      vector<ScoreItem*>     tiednext;
+      vector<ScoreItem*>     tiedlast;
+      vector<int>            chordid;
+      vector<int>            beamid;
+      vector<int>            tupletid;
+
+      // pending is true if any row has unexported results.  Atomic
+      // since separate staves may be analyzed in parallel.
+      atomic<bool>           pending;
+};
+
+
+#endif  /* _SCOREPAGEBASE_ANALYSISTABLE_H_INCLUDED */
+
+
+
@@ -15,15 +15,21 @@
 #include "ScorePageOverlay.h"
 #include "ScoreSegment.h"
 #include "Options.h"
+#include <cstdint>
 
 using namespace std;
 
+class MappedFile;
+
 typedef vector<ScorePageOverlay*> vectorSPOp;
 typedef list<ScorePageOverlay*>   listSPOp;
 typedef vector<ScoreSegment*>     vectorSSp;
 
 class ScorePageSet {
 
+   friend class ScoreCache;
+   friend class ScorePageStream;
+
    public:
                   ScorePageSet                  (void);
                   ScorePageSet                  (Options& opts);
@@ -41,14 +47,22 @@ class ScorePageSet {
       void        appendReadFromOptionArguments (Options& opts);
       void        read                          (Options& opts);
       void        appendRead                    (const string& filename);
+      void        appendRead                    (const vector<string>&
+                                                       filenames);
       void        appendRead                    (istream& instream,
                                                    const string& filename);
       void        appendReadBinary              (istream& instream,
                                                  const string& filename);
+      void        appendReadBinary              (const char* data, size_t size,
+                                                 const string& filename);
       void        appendReadPmx                 (istream& instream,
                                                  const string& filename,
                                                  const string& pagetype="page",
                                                  int informat =0);
+      void        appendReadPmx                 (const char* data, size_t size,
+                                                 const string& filename,
+                                                 const string& pagetype="page",
+                                                 int informat =0);
       void        appendReadStandardInput       (void);
       void        appendOverlay                 (ScorePage* page);
       void        appendOverlay                 (ScorePage* page, int pindex);
@@ -56,6 +70,27 @@ class ScorePageSet {
                                                  SCORE_FLOAT threshold2 = 40.0);
       void        analyzeSingleSegment          (void);
       void        setPageOwnerships             (void);
+      void        setThreadCount                (int count);
+      int         getThreadCount                (void);
+
+      // Profiling of the analyses (see ScoreProfile.h)
+      void        setProfiling                  (int state = 1);
+      int         isProfiling                   (void);
+      void        clearProfile                  (void);
+      ostream&    printProfile                  (ostream& out = cerr);
+
+      // Scheduled analyses (defined in ScorePageSet_analysis.cpp):
+      void        analyze                       (const vector<string>&
+                                                       analyses);
+      void        analyze                       (const string& analysis);
+
+      // Analysis cache files (defined in ScorePageSet_cache.cpp):
+      int         appendReadCached              (const vector<string>&
+                                                       filenames,
+                                                 const string& cachename = "");
+      int         updateCache                   (void);
+      static string getCacheFilename            (const string& filename,
+                                                 const string& cachename = "");
 
       // Page-related functions
       void        analyzePitch                  (void);
@@ -78,6 +113,7 @@ class ScorePageSet {
                                            const string& oldnamespace,
                                            const string& parameter);
       void         deleteNamespace         (const string& nspace);
+      void         exportAnalysisParameters(void);
 
 
       // Segmentation functions (defined in ScorePageSet_segment.cpp):
@@ -100,6 +136,43 @@ class ScorePageSet {
       void          analyzeLyrics               (int segmentindex,
                                                  int partindex);
    private:
+      // PageSource is the location of the data for one page or overlay
+      // in the contents of an input file.  The pages are parsed
+      // separately from finding page boundaries so that they can be
+      // read in parallel.
+      struct PageSource {
+         string      filename;
+         int         overlayQ;  // true if the page is an overlay
+         int         binaryQ;   // true if binary SCORE data
+         int         format;    // PPMX_PAGE_MARKER_RS or _COMMENT
+         ScorePage*  page;      // page created from the data
+         vector<pair<const char*, const char*>> ranges;
+      };
+
+      // Parallel page reading (defined in ScorePageSet_read.cpp):
+      static void   splitFilePages              (vector<PageSource>& sources,
+                                                 MappedFile& infile,
+                                                 const string& filename);
+      static void   splitPmxPages               (vector<PageSource>& sources,
+                                                 const char* data, size_t size,
+                                                 const string& filename,
+                                                 const string& pagetype,
+                                                 int informat);
+      void          parsePageSources            (vector<PageSource>& sources);
+      void          appendPageSources           (vector<PageSource>& sources);
+      static void   parsePageSource             (PageSource& source);
+
+      // PPMX page boundary parsing (defined in ScorePageSet_read.cpp):
+      static int    isPmxDataLine               (const char* line,
+                                                 const char* lineend);
+      static const char* findMarker             (const char* line,
+                                                 const char* lineend,
+                                                 const char* marker);
+      static string& getMarkerName              (string& output,
+                                                 const char* line,
+                                                 const char* lineend,
+                                                 const char* marker);
+
       void          linkLyricsToNotes           (int segmentindex,
                                                  int partindex);
       int           identifyExtraVerses         (vectorVSIp& text,
@@ -138,6 +211,10 @@ class ScorePageSet {
       void          adjustHyphenInfo            (vectorSIp& items,
                                                  int staffnum);
 
+      // Analysis state (defined in ScorePageSet_analysis.cpp):
+      void          getPageStates               (vector<pair<ScorePage*,
+                                                 int>>& states);
+
    protected:
       // page_storage contains all of the data for SCORE pages.
       // This is the primary storage for page data, and it must
@@ -155,6 +232,29 @@ class ScorePageSet {
       // segments are destroyed when the object is deconstructed.
       vectorSSp segment_storage;
 
+      // thread_count is the number of threads used to parse pages
+      // when reading multiple files or multi-page PMX files, and to
+      // analyze separate pages in analyze().  A value of 0 will use
+      // one thread for each processor core.
+      int thread_count;
+
+      // completed_analyses is the list of analyses which have been done
+      // by analyze().  The page-set analyses in the list are not done
+      // again while analyzed_pages is current: analyzed_pages is the list
+      // of pages (with their change counts) when analyze() last finished.
+      vector<string> completed_analyses;
+      vector<pair<ScorePage*, int>> analyzed_pages;
+
+      // cache_filename is the analysis cache file for the pages read by
+      // appendReadCached() (see ScoreCache.h), or empty if there is no
+      // cache file.  cache_hash is the hash of the input files, and
+      // cache_pages is the number of pages read from them.  cache_current
+      // is true if the cache file contains all of the completed analyses.
+      string   cache_filename;
+      uint64_t cache_hash;
+      int      cache_pages;
+      int      cache_current;
+
 };
 
 
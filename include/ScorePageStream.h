@@ -0,0 +1,107 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:57 PDT 2026
+// Last Modified: Sat Oct 17 23:59:59 PDT 2026
+// Filename:      ScorePageStream.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScorePageStream.h
+// Syntax:        C++11
+//
+// Description:   Read the pages of a list of input files one at a time.
+//                Each page (with its overlays) is parsed and analyzed when
+//                it is needed, and is deleted when the stream moves past
+//                it, so that programs which process one page at a time do
+//                not need to store all of the pages of their input.  A
+//                window of pages before and after the current page can be
+//                kept for processing which needs the neighbouring pages.
+//
+
+#ifndef _SCOREPAGESTREAM_H_INCLUDED
+#define _SCOREPAGESTREAM_H_INCLUDED
+
+#include "ScorePageSet.h"
+#include "MappedFile.h"
+#include <deque>
+
+using namespace std;
+
+
+class ScorePageStream {
+   public:
+                         ScorePageStream      (void);
+                         ScorePageStream      (Options& opts);
+                        ~ScorePageStream      ();
+
+      void               clear                (void);
+      void               open                 (const string& filename);
+      void               open                 (const vector<string>& filenames);
+      void               openStandardInput    (void);
+      void               openFromOptionArguments(Options& opts);
+      void               setWindow            (int before, int after);
+      void               setAnalyses          (const vector<string>& analyses);
+      void               setAnalyses          (const string& analysis);
+      void               setThreadCount       (int count);
+
+      int                next                 (void);
+      int                hasNext              (void);
+      int                getPageIndex         (void);
+      ScorePageOverlay&  getCurrent           (void);
+      ScorePageOverlay*  getPage              (int offset);
+
+   private:
+      // StreamFile is an input file whose pages have been found but not
+      // all parsed.  The file is closed when its last page is parsed.
+      struct StreamFile {
+         MappedFile   file;
+         string       contents;  // data read from standard input
+         int          pending;   // number of pages not parsed yet
+      };
+
+      // StreamSource is a page or overlay which has not been parsed yet.
+      struct StreamSource {
+         ScorePageSet::PageSource  source;
+         StreamFile*               file;
+      };
+
+      int                splitNextFile        (void);
+      void               addFile              (StreamFile* infile,
+                                               vector<ScorePageSet::PageSource>&
+                                                     pages);
+      int                loadPages            (int count);
+      void               closeFiles           (void);
+
+   private:
+      // filenames is the list of input files, and next_file is the index
+      // of the next file to be split into pages.
+      vector<string>          filenames;
+      int                     next_file;
+
+      // files are the input files which have unparsed pages in sources.
+      deque<StreamFile*>      files;
+      deque<StreamSource>     sources;
+
+      // window contains the pages before and after the current page,
+      // which is at window_current in the window.  window_before and
+      // window_after are the number of pages to keep before and to read
+      // ahead of the current page.
+      deque<ScorePageOverlay*> window;
+      int                     window_current;
+      int                     window_before;
+      int                     window_after;
+
+      // page_index is the index of the current page in the stream, or -1
+      // if next() has not been called.
+      int                     page_index;
+
+      // analyses are done on each page (and overlay) when it is read.
+      vector<string>          analyses;
+
+      // thread_count is the number of threads used to parse and analyze
+      // the pages which are read at the same time.
+      int                     thread_count;
+};
+
+
+#endif  /* _SCOREPAGESTREAM_H_INCLUDED */
+
+
+
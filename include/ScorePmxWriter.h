@@ -0,0 +1,71 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 02:05:37 PDT 2026
+// Last Modified: Sun Oct 18 02:05:40 PDT 2026
+// Filename:      ScorePmxWriter.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScorePmxWriter.h
+// Syntax:        C++11
+//
+// Description:   Write SCORE items as PMX text into a memory buffer which
+//                is given to an output stream in one write.  The buffer
+//                keeps its memory after being written, so that a writer
+//                can be reused for many pages without allocating.
+//                Numbers are either rounded to six significant digits,
+//                which gives the same text as printing them to an
+//                ostream, or written with the shortest text which reads
+//                back as the same number (see ScoreUtility::formatNumber).
+//
+
+#ifndef _SCOREPMXWRITER_H_INCLUDED
+#define _SCOREPMXWRITER_H_INCLUDED
+
+#include "ScoreItem.h"
+#include "ScoreItemView.h"
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+
+class ScorePmxWriter {
+   public:
+                      ScorePmxWriter        (void);
+                      ScorePmxWriter        (int roundQ);
+                     ~ScorePmxWriter        ();
+
+      void            clear                 (void);
+      void            setRounding           (int roundQ);
+      int             getRounding           (void) const;
+
+      void            appendItem            (ScoreItem* item, int autoQ = 1);
+      void            appendItems           (vectorSIp& items, int autoQ = 1);
+      void            appendItems           (listSIp& items, int autoQ = 1);
+      void            appendFixedParameters (ScoreItemBase& item);
+      void            appendFixedParameters (ScoreItemView& view);
+      void            appendNamedParameters (ScoreItemBase& item,
+                                             int autoQ = 1);
+      void            appendNumber          (SCORE_FLOAT value);
+      void            appendText            (const string& text);
+      void            appendText            (const char* text, size_t length);
+
+      const char*     data                  (void) const;
+      size_t          size                  (void) const;
+      ostream&        write                 (ostream& out);
+
+   protected:
+      void            appendFixedValues     (const SCORE_FLOAT* values,
+                                             int count, const string& text);
+
+   private:
+      string          buffer;
+
+      // rounding is true if numbers are rounded to six significant
+      // digits, and false if they are written in full.
+      int             rounding;
+};
+
+
+#endif  /* _SCOREPMXWRITER_H_INCLUDED */
+
+
+
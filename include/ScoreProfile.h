@@ -0,0 +1,89 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:40 PDT 2026
+// Last Modified: Sat Oct 17 23:59:43 PDT 2026
+// Filename:      ScoreProfile.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/ScoreProfile.h
+// Syntax:        C++11
+//
+// Description:   Timing and event counters for the analysis and reading
+//                functions of the library.  The counters are only compiled
+//                into the library when SCORELIB_PROFILE is defined (make
+//                library PROFILE=1), and are only recorded after profiling
+//                has been turned on with ScorePageSet::setProfiling() or
+//                the --profile option of the programs.
+//
+
+#ifndef _SCOREPROFILE_H_INCLUDED
+#define _SCOREPROFILE_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+
+class ScoreProfile {
+   public:
+      // Event counters:
+      enum {
+         ItemsAllocated = 0,   // ScoreItems created in page item pools
+         SlabsAllocated,       // memory blocks allocated by item pools
+         ParameterHits,        // numeric named parameters read from cache
+         ParameterMisses,      // numeric named parameters parsed from text
+         PartialAnalyses,      // analyses redone for only some staves
+         CounterCount
+      };
+
+      static int      isCompiled      (void);
+      static void     setEnabled      (int state);
+      static int      isEnabled       (void);
+      static void     clear           (void);
+      static void     addTime         (const char* name, double milliseconds,
+                                       long items);
+      static void     count           (int counter, long amount = 1);
+      static ostream& print           (ostream& out = cerr);
+      static void     printOnExit     (void);
+
+   protected:
+      static atomic<bool> enabled;
+};
+
+
+
+//////////////////////////////
+//
+// ScoreProfileTimer -- Adds the time between its construction and
+//    destruction to the profile entry with the given name.  Times of
+//    nested timers are included in the times of the enclosing timers.
+//
+
+class ScoreProfileTimer {
+   public:
+                     ScoreProfileTimer  (const char* aName, long itemcount);
+                    ~ScoreProfileTimer  ();
+
+   private:
+      const char*    name;
+      long           items;
+      bool           active;
+      chrono::steady_clock::time_point start;
+};
+
+
+#ifdef SCORELIB_PROFILE
+   #define SCORE_PROFILE_SCOPE(name, items) \
+      ScoreProfileTimer scoreprofiletimer_(name, items)
+   #define SCORE_PROFILE_COUNT(counter, amount) \
+      ScoreProfile::count(ScoreProfile::counter, amount)
+#else
+   #define SCORE_PROFILE_SCOPE(name, items)
+   #define SCORE_PROFILE_COUNT(counter, amount)
+#endif
+
+
+#endif  /* _SCOREPROFILE_H_INCLUDED */
+
+
+
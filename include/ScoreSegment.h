@@ -15,6 +15,7 @@
 
 #include "AddressSystem.h"
 #include "ScoreItem.h"
+#include "SegmentSystem.h"
 #include <vector>
 
 class ScorePageSet;
@@ -40,6 +41,9 @@ class ScoreSegment {
       const AddressSystem& getSystemAddress (int index);
       vectorSIp& getSystemItems      (const AddressSystem& address);
       vectorSIp& getSystemItems      (int sysindex);
+      SegmentSystem& getSystem       (int sysindex);
+      vector<SegmentSystem>& getSystems (void);
+      int        getTicksPerQuarter  (void);
 
       const vectorVASp& getSystemAddresses (int partindex);
       ostream&   printInfo           (ostream& out) const;
@@ -72,6 +76,11 @@ class ScoreSegment {
       vector<SegmentPart*> part_storage;
       ScorePageSet*        pageset_owner;
 
+      // system_table stores the page and the page staff numbers of the
+      // parts for each system in the segment.  It is made when first
+      // needed and is cleared when the parts of the segment change.
+      vector<SegmentSystem> system_table;
+
 
    private:
       void        prepareParts       (ScorePageSet& page);
@@ -82,6 +91,7 @@ class ScoreSegment {
       string      extractPartName    (ScorePageSet& pageset,
                                       AddressSystem& startsys, int partnum);
       static void identifyPreAndPostSlurs(int staffnum, vectorSIp& items);
+      void        prepareSystemTable (void);
 
 };
 
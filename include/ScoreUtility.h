@@ -16,6 +16,7 @@
 #include "ScoreDefs.h"
 #include "ScoreItem.h"
 #include "ScoreItemEdit_ParameterHistory.h"
+#include <functional>
 #include <set>
 
 class ScoreItem;
@@ -41,6 +42,12 @@ namespace ScoreUtility {
    bool   sortP3P2P1P4        (ScoreItem* a, ScoreItem* b);
    bool   sortP3P1P2P4        (ScoreItem* a, ScoreItem* b);
 
+   // Key-extraction versions of the above functions for sorting long
+   // lists of items (defined in ScoreUtility_sort.cpp):
+   void   sortItemsP3         (vectorSIp& items);
+   void   sortItemsP3P4P1     (vectorSIp& items);
+   void   sortItemsP3P2P1P4   (vectorSIp& items);
+
    // ScoreItem comparison functions (defined in ScoreUtility_compare.cpp):
    bool   equalClefs          (ScoreItem* a, ScoreItem* b);
    bool   equalClef           (ScoreItem* a, ScoreItem* b);
@@ -55,13 +62,20 @@ namespace ScoreUtility {
    bool   equalKeySig         (ScoreItem* a, ScoreItem* b);
    bool   equalKeySigs        (ScoreItem* a, ScoreItem* b);
 
+   // parallel processing functions (defined in ScoreUtility_thread.cpp):
+   int    getThreadCount      (int requested, int tasks);
+   void   runParallel         (int count, int threads,
+                               const function<void(int)>& task);
+
    // math-related functions (defined in ScoreUtility_math.cpp):
    int    gcd                 (int x, int y);
    int    lcm                 (int x, int y);
    int    lcm                 (set<int>& numbers);
 
-   // rhythm-related functions
-   double increaseDurationPrecision(double duration);
+   // rhythm-related functions (defined in ScoreUtility_rhythm.cpp):
+   int    getDurationDenominator(double duration);
+   int    getDurationTicks    (double duration, int ticksperquarter);
+   int    getTicksPerQuarter  (int ticksperquarter, double duration);
 
    // Tie/Slur differentiation functions (defined in ScoreUtility_ties.cpp):
    void   analyzeStaffTies    (int staffnum, vectorSIp& items,
@@ -79,6 +93,11 @@ namespace ScoreUtility {
                                vectorSIp& leftnotes, ScoreItem* endslur,
                                vectorSIp& rightnotes);
 
+   // number-related functions (defined in ScoreUtility_number.cpp):
+   double   parseNumber               (const char* start, const char* end);
+   int      formatNumber              (char* output, double value,
+                                       int roundQ = 1);
+
    // text-related functions (defined in ScoreUtility_text.cpp):
    ostream& printXmlTextEscapedUTF8      (ostream& out, const string& text);
    string   getTextNoFontXmlEscapedUTF8  (const string& text);
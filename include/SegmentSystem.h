@@ -0,0 +1,58 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 04:31:08 PDT 2026
+// Last Modified: Sun Oct 18 04:31:11 PDT 2026
+// Filename:      SegmentSystem.h
+// URL:           https://github.com/craigsapp/scorelib/blob/master/include/SegmentSystem.h
+// Syntax:        C++11
+//
+// Description:   One system of a ScoreSegment, with the page which
+//                contains it and the page staff number (P2) of each part
+//                on the system already looked up, so that the items of a
+//                segment can be walked system by system without resolving
+//                an AddressSystem for every access.
+//
+
+#ifndef _SEGMENTSYSTEM_H_INCLUDED
+#define _SEGMENTSYSTEM_H_INCLUDED
+
+#include "ScoreItem.h"
+#include <vector>
+
+class ScorePage;
+
+using namespace std;
+
+
+class SegmentSystem {
+   public:
+                         SegmentSystem       (void);
+                         SegmentSystem       (ScorePage* page, int sysindex);
+                        ~SegmentSystem       ();
+
+      void               clear               (void);
+      ScorePage*         getPage             (void) const;
+      int                getSystemIndex      (void) const;
+      vectorSIp&         getItems            (void);
+      int                getTicksPerQuarter  (void);
+      int                getPartCount        (void) const;
+      int                getPageStaffIndex   (int partindex) const;
+      void               appendPageStaffIndex(int p2);
+
+   protected:
+      // page is the page (overlay) which contains the system.
+      ScorePage*    page;
+
+      // system_index is the index of the system on the page.
+      int           system_index;
+
+      // page_staves is the P2 staff number of the first staff of each
+      // part on the system, or -1 if the part is not on the system.
+      vectorI       page_staves;
+};
+
+
+#endif  /* _SEGMENTSYSTEM_H_INCLUDED */
+
+
+
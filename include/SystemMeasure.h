@@ -20,6 +20,7 @@ class SystemMeasure {
 
    public:
                      SystemMeasure             (void);
+                     SystemMeasure             (int ticksperquarter);
                     ~SystemMeasure             (void);
       void           clear                     (void);
       void           addItem                   (ScoreItem* item);
@@ -41,6 +42,9 @@ class SystemMeasure {
       SCORE_FLOAT    getSystemOffsetDuration   (void);
       SCORE_FLOAT    getMeasureDuration        (void);
       SCORE_FLOAT    getDuration               (void);
+      int            getSystemOffsetTicks      (void);
+      int            getMeasureTicks           (void);
+      int            getTicksPerQuarter        (void);
       vectorSIp&     getStartBarlines          (void);
       vectorSIp&     getEndBarlines            (void);
       ScoreItem*     operator[]                (int index);
@@ -49,8 +53,9 @@ class SystemMeasure {
    protected:
       vectorSIp   start_bars;
       vectorSIp   end_bars;
-      SCORE_FLOAT measure_duration; // duration of the measure
-      SCORE_FLOAT system_offset;    // start duration of measure within system
+      int         measure_ticks;    // duration of the measure
+      int         system_offset;    // start of measure within system
+      int         ticks_per_quarter; // tick resolution of the system
       vectorSIp measure_items;
 };
 
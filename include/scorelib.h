@@ -12,7 +12,12 @@
 #ifndef _SCORELIB_H_INCLUDED
 #define _SCORELIB_H_INCLUDED
 
+#include "ScoreBatch.h"
+#include "ScoreFileType.h"
+#include "ScoreItemView.h"
 #include "ScorePageSet.h"
+#include "ScorePageStream.h"
+#include "ScorePmxWriter.h"
 #include "ScoreUtility.h"
 
 #endif  /* _SCORELIB_INCLUDED */
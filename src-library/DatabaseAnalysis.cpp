@@ -11,6 +11,7 @@
 //
 
 #include "DatabaseAnalysis.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -78,6 +79,7 @@ void DatabaseAnalysis::invalidateNode(const string& nodename) {
       exit(1);
    }
    *(entry->second.data) = 0;
+   entry->second.scope.clear();
 
    for (auto& it : entry->second.children) {
       invalidateNode(it);
@@ -86,6 +88,35 @@ void DatabaseAnalysis::invalidateNode(const string& nodename) {
 
 
 
+//////////////////////////////
+//
+// DatabaseAnalysis::invalidateNode -- Invalidate a node and all of
+//    its children for a single staff on the page.  Nodes which are
+//    already invalid for the entire page are not changed.
+//
+
+void DatabaseAnalysis::invalidateNode(const string& nodename, int staff) {
+   auto entry = nodes.find(nodename);
+   if (entry == nodes.end()) {
+      cerr << "Searching for an undefined node: " << nodename << endl;
+      exit(1);
+   }
+   _AnalysisGraph& node = entry->second;
+   if (*(node.data)) {
+      *(node.data) = 0;
+      node.scope.clear();
+      node.scope.insert(staff);
+   } else if (!node.scope.empty()) {
+      node.scope.insert(staff);
+   }
+
+   for (auto& it : node.children) {
+      invalidateNode(it, staff);
+   }
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseAnalysis::validateNode --  Set data for this node
@@ -93,7 +124,123 @@ void DatabaseAnalysis::invalidateNode(const string& nodename) {
 //
 
 void DatabaseAnalysis::validateNode(const string& nodename) {
-   *(nodes[nodename].data) = 1;
+   _AnalysisGraph& node = nodes[nodename];
+   *(node.data) = 1;
+   node.scope.clear();
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::getInvalidScope -- Returns true if the node is only
+//    invalid for some staves on the page, which are stored in the second
+//    parameter.  Returns false if the node is valid, or if it is invalid
+//    for the entire page.
+//
+
+int DatabaseAnalysis::getInvalidScope(const string& nodename,
+      set<int>& staves) {
+   _AnalysisGraph& node = nodes[nodename];
+   if (*(node.data) || node.scope.empty()) {
+      staves.clear();
+      return 0;
+   }
+   staves = node.scope;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::clearScopes -- Forget about partial invalidations.
+//    Used when the node states are set directly by the owner.
+//
+
+void DatabaseAnalysis::clearScopes(void) {
+   for (auto& it : nodes) {
+      it.second.scope.clear();
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::copyScopes -- Copy the partial invalidation
+//    information from another database with the same nodes.
+//
+
+void DatabaseAnalysis::copyScopes(const DatabaseAnalysis& database) {
+   for (auto& it : nodes) {
+      auto entry = database.nodes.find(it.first);
+      if (entry == database.nodes.end()) {
+         it.second.scope.clear();
+      } else {
+         it.second.scope = entry->second.scope;
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::isValid -- Returns true if the analysis for the
+//    node is valid for the entire page.
+//
+
+int DatabaseAnalysis::isValid(const string& nodename) {
+   auto entry = nodes.find(nodename);
+   if (entry == nodes.end()) {
+      cerr << "Searching for an undefined node: " << nodename << endl;
+      exit(1);
+   }
+   return *(entry->second.data);
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::getDependencyOrder -- Return the given nodes and
+//    all of the nodes which they depend on, ordered so that each node
+//    comes after all of its parents.  Running the analyses in this order
+//    will not invalidate an analysis which has already been run.
+//
+
+void DatabaseAnalysis::getDependencyOrder(const vector<string>& nodenames,
+      vector<string>& order) {
+   order.clear();
+   for (auto& it : nodenames) {
+      addDependencies(it, order);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseAnalysis::addDependencies -- Add the parents of a node to the
+//    dependency order (if they are not already in it), followed by the
+//    node itself.
+//
+
+void DatabaseAnalysis::addDependencies(const string& nodename,
+      vector<string>& order) {
+   if (find(order.begin(), order.end(), nodename) != order.end()) {
+      return;
+   }
+   auto entry = nodes.find(nodename);
+   if (entry == nodes.end()) {
+      cerr << "Searching for an undefined node: " << nodename << endl;
+      exit(1);
+   }
+   for (auto& it : entry->second.parents) {
+      addDependencies(it, order);
+   }
+   order.push_back(nodename);
 }
 
 
@@ -12,8 +12,10 @@
 
 #include "DatabaseBeam.h"
 #include "ScoreItem.h"
+#include "ScorePageBase_AnalysisTable.h"
 #include "ScoreUtility.h"
 #include <algorithm>
+#include <cstdlib>
 
 using namespace std;
 
@@ -24,7 +26,7 @@ using namespace std;
 //
 
 DatabaseBeam::DatabaseBeam(void) {
-   // do nothing
+   item_index = NULL;
 }
 
 
@@ -46,9 +48,11 @@ DatabaseBeam::~DatabaseBeam() {
 //
 
 void DatabaseBeam::clear(void) {
-   for (auto& it : database) {
-      delete it;
-      it = NULL;
+   for (auto& staff : database) {
+      for (auto& it : staff) {
+         delete it;
+         it = NULL;
+      }
    }
    database.clear();
    interface.clear();
@@ -56,13 +60,102 @@ void DatabaseBeam::clear(void) {
 
 
 
+//////////////////////////////
+//
+// DatabaseBeam::setItemIndex -- Set the table which gives the dense
+//     index of each item on the page.
+//
+
+void DatabaseBeam::setItemIndex(AnalysisTable* table) {
+   clear();
+   item_index = table;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseBeam::prepareStaves -- Create the group lists for staves up to
+//     the given count, and entries for all items which have an item
+//     index, so that items on separate staves can then be linked in
+//     parallel.
+//
+
+void DatabaseBeam::prepareStaves(int staffcount) {
+   if ((int)database.size() < staffcount) {
+      database.resize(staffcount);
+   }
+   if (item_index == NULL) {
+      return;
+   }
+   int count = item_index->getRowCount();
+   if ((int)interface.size() < count) {
+      interface.resize(count, NULL);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseBeam::getStaffCount -- Return the number of staves which have
+//     group lists (including empty lists).
+//
+
+int DatabaseBeam::getStaffCount(void) const {
+   return (int)database.size();
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseBeam::size -- Return the number of beam groups in the database.
 //
 
 int DatabaseBeam::size(void) {
-   return database.size();
+   int output = 0;
+   for (auto& staff : database) {
+      output += (int)staff.size();
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseBeam::getGroups -- Return the list of beam groups on a staff.
+//
+
+const vector<BeamGroup*>& DatabaseBeam::getGroups(int staff) const {
+   return database[staff];
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseBeam::restoreGroup -- Add a beam group to the end of the list
+//     of groups on a staff, keeping the order of the items.  Used to
+//     restore a beam analysis which was stored in a cache file.
+//
+
+void DatabaseBeam::restoreGroup(int staff, const vectorSIp& beams,
+      const vectorSIp& notes) {
+   if (staff >= (int)database.size()) {
+      database.resize(staff + 1);
+   }
+   BeamGroup* group = new BeamGroup;
+   group->beams = beams;
+   group->notes = notes;
+   database[staff].push_back(group);
+   for (auto& it : group->beams) {
+      storeGroup(it, group);
+   }
+   for (auto& it : group->notes) {
+      storeGroup(it, group);
+   }
 }
 
 
@@ -74,12 +167,14 @@ int DatabaseBeam::size(void) {
 //
 
 BeamGroup* DatabaseBeam::beamInfo(ScoreItem* item) {
-   auto result = interface.find(item);
-   if (result == interface.end()) {
+   if (item_index == NULL) {
+      return NULL;
+   }
+   int index = item_index->findItemIndex(item);
+   if ((index < 0) || (index >= (int)interface.size())) {
       return NULL;
-   } else {
-      return result->second;
    }
+   return interface[index];
 }
 
 
@@ -98,17 +193,21 @@ BeamGroup* DatabaseBeam::linkItems(ScoreItem* item1, ScoreItem* item2) {
          // Case 1: neither item is in the beam database. Create entries
          // for both items.
          BeamGroup *bg = new BeamGroup;
-         database.push_back(bg);
-         insertItem(database.back(), item1);
-         insertItem(database.back(), item2);
-         interface[item1] = database.back();
-         interface[item2] = database.back();
-         return database.back();
+         int staff = item1->getStaffNumber();
+         if (staff >= (int)database.size()) {
+            database.resize(staff + 1);
+         }
+         database[staff].push_back(bg);
+         insertItem(bg, item1);
+         insertItem(bg, item2);
+         storeGroup(item1, bg);
+         storeGroup(item2, bg);
+         return bg;
       } else {
          // Case 2: item1 is not in the database, but item2 is.  Add item1
          // to item2's list.
          insertItem(info2, item1);
-         interface[item1] = info2;
+         storeGroup(item1, info2);
          return info2;
       }
    } else {
@@ -116,7 +215,7 @@ BeamGroup* DatabaseBeam::linkItems(ScoreItem* item1, ScoreItem* item2) {
          // Case 3: note1 is in the database, but note2 is not.  Add item2
          // to item1's list and return info1.
          insertItem(info1, item2);
-         interface[item2] = info1;
+         storeGroup(item2, info1);
          return info1;
       } else {
          // Case 4: Both items are already in the database.  Presumably
@@ -137,17 +236,19 @@ BeamGroup* DatabaseBeam::linkItems(ScoreItem* item1, ScoreItem* item2) {
 //
 
 ostream& DatabaseBeam::printDatabase(ostream& out) {
-   for (auto& it : database) {
-      out << "\n# BEAM GROUP START\n";
-      out << "# BEAMS:\n";
-      for (auto& beam : it->beams) {
-         out << beam;
+   for (auto& staff : database) {
+      for (auto& it : staff) {
+         out << "\n# BEAM GROUP START\n";
+         out << "# BEAMS:\n";
+         for (auto& beam : it->beams) {
+            out << beam;
+         }
+         out << "# NOTES/RESTS:\n";
+         for (auto& note : it->notes) {
+            out << note;
+         }
+         out << "\n# BEAM GROUP END\n";
       }
-      out << "# NOTES/RESTS:\n";
-      for (auto& note : it->notes) {
-         out << note;
-      }
-      out << "\n# BEAM GROUP END\n";
    }
    return out;
 }
@@ -178,3 +279,22 @@ void DatabaseBeam::insertItem(BeamGroup* info, ScoreItem* item) {
 
 
 
+//////////////////////////////
+//
+// DatabaseBeam::storeGroup -- Store the beam group which contains an item.
+//
+
+void DatabaseBeam::storeGroup(ScoreItem* item, BeamGroup* group) {
+   if (item_index == NULL) {
+      cerr << "Error: beam database has no item index" << endl;
+      exit(1);
+   }
+   int index = item_index->getItemIndex(item);
+   if (index >= (int)interface.size()) {
+      interface.resize(index + 1, NULL);
+   }
+   interface[index] = group;
+}
+
+
+
@@ -10,6 +10,9 @@
 //
 
 #include "DatabaseChord.h"
+#include "ScorePageBase_AnalysisTable.h"
+#include <cstdlib>
+#include <iostream>
 
 using namespace std;
 
@@ -20,7 +23,7 @@ using namespace std;
 //
 
 DatabaseChord::DatabaseChord(void) {
-   // do nothing
+   item_index = NULL;
 }
 
 
@@ -48,6 +51,85 @@ void DatabaseChord::clear(void) {
 
 
 
+//////////////////////////////
+//
+// DatabaseChord::setItemIndex -- Set the table which gives the dense
+//     index of each note on the page.
+//
+
+void DatabaseChord::setItemIndex(AnalysisTable* table) {
+   clear();
+   item_index = table;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseChord::prepareStaves -- Create the chord lists for staves up
+//     to the given count, and entries for all notes which have an item
+//     index, so that notes on separate staves can then be linked in
+//     parallel.
+//
+
+void DatabaseChord::prepareStaves(int staffcount) {
+   if ((int)database.size() < staffcount) {
+      database.resize(staffcount);
+   }
+   if (item_index == NULL) {
+      return;
+   }
+   int count = item_index->getRowCount();
+   if ((int)interface.size() < count) {
+      interface.resize(count, NULL);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseChord::getStaffCount -- Return the number of staves which have
+//     chord lists (including empty lists).
+//
+
+int DatabaseChord::getStaffCount(void) const {
+   return (int)database.size();
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseChord::getChords -- Return the list of chords on a staff.
+//
+
+const deque<vectorSIp>& DatabaseChord::getChords(int staff) const {
+   return database[staff];
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseChord::restoreChord -- Add a chord to the end of the list of
+//     chords on a staff, keeping the order of the notes.  Used to restore
+//     a chord analysis which was stored in a cache file.
+//
+
+void DatabaseChord::restoreChord(int staff, const vectorSIp& notes) {
+   if (staff >= (int)database.size()) {
+      database.resize(staff + 1);
+   }
+   database[staff].push_back(notes);
+   vectorSIp* chord = &database[staff].back();
+   for (auto& it : *chord) {
+      storeChord(it, chord);
+   }
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseChord::linkNotes -- merge two notes into a chord.  Will create a
@@ -63,23 +145,28 @@ vectorSIp* DatabaseChord::linkNotes(ScoreItem* note1, ScoreItem* note2) {
    if (lista == NULL) {
       if (listb == NULL) {
          // create entries for both notes
-         database.emplace_back();
-         insertNote(&database.back(), note1);
-         insertNote(&database.back(), note2);
-         interface[note1] = &database.back();
-         interface[note2] = &database.back();
-         return &database.back();
+         int staff = note1->getStaffNumber();
+         if (staff >= (int)database.size()) {
+            database.resize(staff + 1);
+         }
+         database[staff].emplace_back();
+         vectorSIp* chord = &database[staff].back();
+         insertNote(chord, note1);
+         insertNote(chord, note2);
+         storeChord(note1, chord);
+         storeChord(note2, chord);
+         return chord;
       } else {
          // note2 in a chord already, so add note1 to its list.
          insertNote(listb, note1);
-         interface[note1] = listb;
+         storeChord(note1, listb);
          return listb;
       }
    } else {
       if (listb == NULL) {
          // note1 in a chord already, so add note2 to its list.
          insertNote(lista, note2);
-         interface[note2] = lista;
+         storeChord(note2, lista);
          return lista;
       } else {
          // both notes are in the database.  They should be attached to the
@@ -100,12 +187,14 @@ vectorSIp* DatabaseChord::linkNotes(ScoreItem* note1, ScoreItem* note2) {
 //
 
 vectorSIp* DatabaseChord::notelist(ScoreItem* item) {
-   auto result = interface.find(item);
-   if (result == interface.end()) {
+   if (item_index == NULL) {
+      return NULL;
+   }
+   int index = item_index->findItemIndex(item);
+   if ((index < 0) || (index >= (int)interface.size())) {
       return NULL;
-   } else {
-      return result->second;
    }
+   return interface[index];
 }
 
 
@@ -136,3 +225,22 @@ void DatabaseChord::insertNote(vectorSIp* list, ScoreItem* note) {
 
 
 
+//////////////////////////////
+//
+// DatabaseChord::storeChord -- Store the chord which contains a note.
+//
+
+void DatabaseChord::storeChord(ScoreItem* note, vectorSIp* chord) {
+   if (item_index == NULL) {
+      cerr << "Error: chord database has no item index" << endl;
+      exit(1);
+   }
+   int index = item_index->getItemIndex(note);
+   if (index >= (int)interface.size()) {
+      interface.resize(index + 1, NULL);
+   }
+   interface[index] = chord;
+}
+
+
+
@@ -94,6 +94,34 @@ vectorSIp* DatabaseLyrics::link(ScoreItem* item1, ScoreItem* item2) {
 
 
 
+//////////////////////////////
+//
+// DatabaseLyrics::getLists -- Return the lists of linked notes and
+//    lyrics.
+//
+
+const list<vectorSIp>& DatabaseLyrics::getLists(void) const {
+   return database;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseLyrics::restoreList -- Add a list of linked items, keeping the
+//    order of the items.  Used to restore lyrics links which were stored
+//    in a cache file.
+//
+
+void DatabaseLyrics::restoreList(const vectorSIp& items) {
+   database.push_back(items);
+   for (auto& it : database.back()) {
+      interface[it] = &database.back();
+   }
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseLyrics::lyricslist -- Return a vector of notes to which the
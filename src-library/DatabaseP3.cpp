@@ -9,7 +9,9 @@
 // Description:   Keep track of SCORE items by horizontal position.  Either
 // 		  staves or systems can be stored in the database as long
 // 		  as all duration items are aligned by P3 positions across
-// 		  the system staves/staff layers.
+// 		  the system staves/staff layers.  Items are grouped into
+// 		  vertical slices (columns) stored in a sorted array, which
+// 		  is searched by P3 value or by staff duration offset.
 //
 
 #include "DatabaseP3.h"
@@ -26,7 +28,14 @@ using namespace std;
 //
 
 DatabaseP3::DatabaseP3(void) {
-   // do nothing
+   preparedQ = 0;
+   offsetsQ  = 0;
+   ticks_per_quarter = 1;
+}
+
+
+DatabaseP3::DatabaseP3(const DatabaseP3& database) {
+   *this = database;
 }
 
 
@@ -42,49 +51,101 @@ DatabaseP3::~DatabaseP3() {
 
 
 
+//////////////////////////////
+//
+// DatabaseP3::operator= -- Copy the items of another database.  The
+//     columns are rebuilt when the database is next searched, since the
+//     columns are linked to each other.
+//
+
+DatabaseP3& DatabaseP3::operator=(const DatabaseP3& database) {
+   if (this == &database) {
+      return *this;
+   }
+   clear();
+   entries  = database.entries;
+   entry_p3 = database.entry_p3;
+   ticks_per_quarter = database.ticks_per_quarter;
+   return *this;
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseP3::clear -- Delete contents of database.
 //
 
 void DatabaseP3::clear(void) {
-   for (auto& it : database) {
-      delete it;
-      it = NULL;
+   entries.clear();
+   entry_p3.clear();
+   entry_column.clear();
+   columns.clear();
+   column_p3.clear();
+   offset_index.clear();
+   preparedQ = 0;
+   offsetsQ  = 0;
+   ticks_per_quarter = 1;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseP3::setTicksPerQuarter -- Set the tick resolution used to
+//     compare staff duration offsets.  This should be done after clear().
+//
+
+void DatabaseP3::setTicksPerQuarter(int ticks) {
+   if (ticks < 1) {
+      ticks = 1;
    }
-   database.clear();
-   interface_byP3.clear();
-   interface_byOffset.clear();
+   if (ticks != ticks_per_quarter) {
+      offsetsQ = 0;
+   }
+   ticks_per_quarter = ticks;
 }
 
 
 
 //////////////////////////////
 //
-// DatabaseP3::size -- Return the number of beam groups in the database.
+// DatabaseP3::getTicksPerQuarter --
+//
+
+int DatabaseP3::getTicksPerQuarter(void) const {
+   return ticks_per_quarter;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseP3::size -- Return the number of P3 columns in the database.
 //
 
 int DatabaseP3::size(void) {
-   return database.size();
+   prepare();
+   return (int)columns.size();
 }
 
 
 
 //////////////////////////////
 //
-// DatabaseP3::printDatabase -- Print a list of the beams/notes in the
-//     beam database.
+// DatabaseP3::printDatabase -- Print a list of the P3 columns in the
+//     database.
 //
 
 ostream& DatabaseP3::printDatabase(ostream& out) {
    prepare();
    out << "\n# P3 MAPPING BEGIN\n";
    int size;
-   for (auto it : database) {
-      size = it->size();
+   for (auto& it : columns) {
+      size = it.size();
       if (size > 0) {
-         out << "# P3=" << ((*it)[0])->getHPos()
-             << "\tstoff=" << ((*it)[0])->getStaffOffsetDuration()
+         out << "# P3=" << (it[0])->getHPos()
+             << "\tstoff=" << (it[0])->getStaffOffsetDuration()
              << "\t" << size << "item";
          if (size != 1) {
             out << "s";
@@ -100,27 +161,41 @@ ostream& DatabaseP3::printDatabase(ostream& out) {
 
 //////////////////////////////
 //
-// DatabaseP3::addItem --
+// DatabaseP3::addItem -- Add an item to the database.  The columns are
+//     rebuilt when the database is next searched.
 //
 
 void DatabaseP3::addItem(ScoreItem* item) {
    preparedQ = 0;
+   offsetsQ  = 0;
+   entries.push_back(item);
+   entry_p3.push_back(item->getHPos());
+}
 
-   SCORE_FLOAT offset = item->getStaffOffsetDuration();
-   SCORE_FLOAT p3     = item->getHPos();
 
-   auto it1 = interface_byP3.find(p3);
-   if (it1 == interface_byP3.end()) {
-      // create an entry in the map for the given item's P3.
-      interface_byP3[p3] = storeItem(item);
-   } else {
-      it1->second->push_back(item);
-   }
 
-   auto it2 = interface_byOffset.find(offset);
-   if (it2 == interface_byOffset.end()) {
-      interface_byOffset[offset] = interface_byP3[p3];
-   }
+//////////////////////////////
+//
+// DatabaseP3::getColumnCount -- Return the number of P3 columns in the
+//     database.
+//
+
+int DatabaseP3::getColumnCount(void) {
+   return size();
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseP3::getColumn -- Return the items in a P3 column.  Columns
+//     are indexed from left to right, and the items in a column are in
+//     the order that they were added to the database.
+//
+
+P3VerticalItems& DatabaseP3::getColumn(int index) {
+   prepare();
+   return columns[index];
 }
 
 
@@ -132,17 +207,13 @@ void DatabaseP3::addItem(ScoreItem* item) {
 //
 
 SCORE_FLOAT DatabaseP3::getP3OfStaffDurationOffset(SCORE_FLOAT offset) {
-   prepare();
-   auto it = interface_byOffset.find(offset);
-   if (it == interface_byOffset.end()) {
+   P3VerticalItems* column = getScoreItemsByStaffDurationOffset(offset);
+   if ((column == NULL) || (column->size() == 0)) {
       // Have to decide on what to do with undefined offsets.  Returning
       // right margin on page for now...
       return 200.0;
-   } else if (it->second->size() > 0) {
-      return (*((*it).second))[0]->getHPos();
-   } else {
-      return 200.0;
    }
+   return (*column)[0]->getHPos();
 }
 
 
@@ -154,48 +225,69 @@ SCORE_FLOAT DatabaseP3::getP3OfStaffDurationOffset(SCORE_FLOAT offset) {
 //
 
 SCORE_FLOAT DatabaseP3::getStaffDurationOffsetOfP3(SCORE_FLOAT p3) {
-   prepare();
-   auto it = interface_byP3.find(p3);
-   if (it == interface_byP3.end()) {
+   P3VerticalItems* column = getScoreItemsByP3(p3);
+   if ((column == NULL) || (column->size() == 0)) {
       // Have to decide on what to do with undefined offsets.  Returning
       // left margin time offset for now...
       return 0.0;
-   } else if (it->second->size() > 0) {
-      return (*(it->second))[0]->getStaffOffsetDuration();
-   } else {
-      return 0.0;
    }
+   return (*column)[0]->getStaffOffsetDuration();
 }
 
 
 
 //////////////////////////////
 //
-// DatabaseP3::getScoreItemsByP3 --
+// DatabaseP3::getScoreItemsByP3 -- Return the column at the given P3
+//     value, or NULL if there is no column there.  If the tolerance is
+//     greater than zero, the closest column within the tolerance of the
+//     P3 value is returned.
 //
 
-P3VerticalItems* DatabaseP3::getScoreItemsByP3(SCORE_FLOAT p3) {
-   auto it = interface_byP3.find(p3);
-   if (it == interface_byP3.end()) {
+P3VerticalItems* DatabaseP3::getScoreItemsByP3(SCORE_FLOAT p3,
+      SCORE_FLOAT tolerance) {
+   prepare();
+   int index = findColumn(p3, tolerance);
+   if (index < 0) {
       return NULL;
    }
-   return it->second;
+   return &columns[index];
 }
 
 
 
 //////////////////////////////
 //
-// DatabaseP3::getScoreItemsByStaffDurationOffset --
+// DatabaseP3::getScoreItemsByStaffDurationOffset -- Return the first
+//     column (from the left) containing an item at the given staff
+//     duration offset, or NULL if there is none.  The offset is
+//     converted to ticks, so a sum of rounded tuplet durations will
+//     still find the column at the exact offset.
 //
 
 P3VerticalItems* DatabaseP3::getScoreItemsByStaffDurationOffset(
       SCORE_FLOAT offset) {
-   auto it = interface_byOffset.find(offset);
-   if (it == interface_byOffset.end()) {
+   return getScoreItemsByStaffOffsetTicks(SU::getDurationTicks(offset,
+         ticks_per_quarter));
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseP3::getScoreItemsByStaffOffsetTicks -- Return the first column
+//     (from the left) containing an item at the given staff offset in
+//     ticks, or NULL if there is none.
+//
+
+P3VerticalItems* DatabaseP3::getScoreItemsByStaffOffsetTicks(int ticks) {
+   prepareOffsets();
+   auto it = lower_bound(offset_index.begin(), offset_index.end(),
+         make_pair(ticks, -1));
+   if ((it == offset_index.end()) || (it->first != ticks)) {
       return NULL;
    }
-   return it->second;
+   return &columns[it->second];
 }
 
 
@@ -207,40 +299,77 @@ P3VerticalItems* DatabaseP3::getScoreItemsByStaffDurationOffset(
 
 //////////////////////////////
 //
-// DatabaseP3::storeItem --  Both beams and notes/rest items are sorted
-//     from left to right (P3 value).
+// DatabaseP3::findColumn -- Return the index of the column closest to
+//     the given P3 value (within the tolerance), or -1 if none.
 //
 
-P3VerticalItems* DatabaseP3::storeItem(ScoreItem* item) {
-   preparedQ = 0;
-   P3VerticalItems* newentry = new P3VerticalItems;
-   newentry->push_back(item);
-   database.push_back(newentry);
-   return newentry;
+int DatabaseP3::findColumn(SCORE_FLOAT p3, SCORE_FLOAT tolerance) {
+   int index = lower_bound(column_p3.begin(), column_p3.end(), p3) -
+         column_p3.begin();
+   int output = -1;
+   SCORE_FLOAT diff;
+   SCORE_FLOAT mindiff = tolerance;
+   if (index < (int)column_p3.size()) {
+      diff = column_p3[index] - p3;
+      if (diff <= mindiff) {
+         output  = index;
+         mindiff = diff;
+      }
+   }
+   if ((tolerance > 0.0) && (index > 0)) {
+      diff = p3 - column_p3[index-1];
+      if (diff < mindiff) {
+         output = index - 1;
+      }
+   }
+   return output;
 }
 
 
 
 //////////////////////////////
 //
-// DatabaseP3::prepare -- Set up linked list P3 values.
+// DatabaseP3::prepare -- Group the items into columns by P3 value.
+//     Items in a column are kept in the order in which they were added
+//     to the database.
 //
 
 void DatabaseP3::prepare(void) {
    if (preparedQ) {
       return;
    }
-   preparedQ = 0;
 
-   database.sort(DatabaseP3_sortP3);
+   int count = (int)entries.size();
+   vector<int> order(count);
+   int i;
+   for (i=0; i<count; i++) {
+      order[i] = i;
+   }
+   stable_sort(order.begin(), order.end(),
+      [this](int a, int b) { return entry_p3[a] < entry_p3[b]; });
+
+   columns.clear();
+   columns.reserve(count);
+   column_p3.clear();
+   entry_column.resize(count);
+   for (i=0; i<count; i++) {
+      int entry = order[i];
+      if (columns.empty() || (entry_p3[entry] != column_p3.back())) {
+         columns.emplace_back();
+         column_p3.push_back(entry_p3[entry]);
+      }
+      columns.back().push_back(entries[entry]);
+      entry_column[entry] = (int)columns.size() - 1;
+   }
 
    P3VerticalItems* last = NULL;
-   for (auto& it : database) {
-      it->next     = NULL;
-      it->previous = last;
+   for (auto& it : columns) {
+      it.next     = NULL;
+      it.previous = last;
       if (last != NULL) {
-         last->next = it;
+         last->next = &it;
       }
+      last = &it;
    }
 
    preparedQ = 1;
@@ -250,29 +379,41 @@ void DatabaseP3::prepare(void) {
 
 //////////////////////////////
 //
-// DatabaseP3_sortP3 -- Sort by P3 then P2 then P1.
+// DatabaseP3::prepareOffsets -- Index the columns by the staff offsets
+//     of their items in ticks.  An offset is mapped to the column of the
+//     first item added to the database at that offset.  Items without
+//     offsets in ticks (which are not on an analyzed page) have their
+//     staff duration offsets converted to ticks.
 //
 
-bool DatabaseP3_sortP3(P3VerticalItems* a, P3VerticalItems* b) {
-   SCORE_FLOAT A, B;
-
-   if (a->size() == 0) {
-      A = -1.0;
-   } else {
-      A = (*a)[0]->getHorizontalPosition();
-   }
-
-   if (b->size() == 0) {
-      B = -1.0;
-   } else {
-      B = (*b)[0]->getHorizontalPosition();
+void DatabaseP3::prepareOffsets(void) {
+   prepare();
+   if (offsetsQ) {
+      return;
    }
 
-   if (A < B) {
-      return true;
+   int count = (int)entries.size();
+   offset_index.resize(count);
+   for (int i=0; i<count; i++) {
+      int ticks = entries[i]->getStaffOffsetTicks();
+      if (ticks < 0) {
+         ticks = SU::getDurationTicks(entries[i]->getStaffOffsetDuration(),
+               ticks_per_quarter);
+      }
+      offset_index[i].first  = ticks;
+      offset_index[i].second = entry_column[i];
    }
-
-   return false;
+   stable_sort(offset_index.begin(), offset_index.end(),
+      [](const pair<int, int>& a, const pair<int, int>& b) {
+         return a.first < b.first;
+      });
+   auto last = unique(offset_index.begin(), offset_index.end(),
+      [](const pair<int, int>& a, const pair<int, int>& b) {
+         return a.first == b.first;
+      });
+   offset_index.erase(last, offset_index.end());
+
+   offsetsQ = 1;
 }
 
 
@@ -12,8 +12,10 @@
 
 #include "DatabaseTuplet.h"
 #include "ScoreItem.h"
+#include "ScorePageBase_AnalysisTable.h"
 #include "ScoreUtility.h"
 #include <algorithm>
+#include <cstdlib>
 
 using namespace std;
 
@@ -24,7 +26,7 @@ using namespace std;
 //
 
 DatabaseTuplet::DatabaseTuplet(void) {
-   // do nothing
+   item_index = NULL;
 }
 
 
@@ -46,9 +48,11 @@ DatabaseTuplet::~DatabaseTuplet() {
 //
 
 void DatabaseTuplet::clear(void) {
-   for (auto& it : database) {
-      delete it;
-      it = NULL;
+   for (auto& staff : database) {
+      for (auto& it : staff) {
+         delete it;
+         it = NULL;
+      }
    }
    database.clear();
    interface.clear();
@@ -56,13 +60,107 @@ void DatabaseTuplet::clear(void) {
 
 
 
+//////////////////////////////
+//
+// DatabaseTuplet::setItemIndex -- Set the table which gives the dense
+//     index of each item on the page.
+//
+
+void DatabaseTuplet::setItemIndex(AnalysisTable* table) {
+   clear();
+   item_index = table;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseTuplet::prepareStaves -- Create the group lists for staves up to
+//     the given count, and entries for all items which have an item
+//     index, so that items on separate staves can then be linked in
+//     parallel.
+//
+
+void DatabaseTuplet::prepareStaves(int staffcount) {
+   if ((int)database.size() < staffcount) {
+      database.resize(staffcount);
+   }
+   if (item_index == NULL) {
+      return;
+   }
+   int count = item_index->getRowCount();
+   if ((int)interface.size() < count) {
+      interface.resize(count, NULL);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseTuplet::getStaffCount -- Return the number of staves which have
+//     group lists (including empty lists).
+//
+
+int DatabaseTuplet::getStaffCount(void) const {
+   return (int)database.size();
+}
+
+
+
 //////////////////////////////
 //
 // DatabaseTuplet::size -- Return the number of tuplet groups in the database.
 //
 
 int DatabaseTuplet::size(void) {
-   return database.size();
+   int output = 0;
+   for (auto& staff : database) {
+      output += (int)staff.size();
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseTuplet::getGroups -- Return the list of tuplet groups on a staff.
+//
+
+const vector<TupletGroup*>& DatabaseTuplet::getGroups(int staff) const {
+   return database[staff];
+}
+
+
+
+//////////////////////////////
+//
+// DatabaseTuplet::restoreGroup -- Add a tuplet group to the end of the list
+//     of groups on a staff, keeping the order of the items.  The linked
+//     items (such as beams with tuplet markings) are linked to the group
+//     without being added to its lists.  Used to restore a tuplet analysis
+//     which was stored in a cache file.
+//
+
+void DatabaseTuplet::restoreGroup(int staff, const vectorSIp& brackets,
+      const vectorSIp& notes, const vectorSIp& linked) {
+   if (staff >= (int)database.size()) {
+      database.resize(staff + 1);
+   }
+   TupletGroup* group = new TupletGroup;
+   group->brackets = brackets;
+   group->notes = notes;
+   database[staff].push_back(group);
+   for (auto& it : group->brackets) {
+      storeGroup(it, group);
+   }
+   for (auto& it : group->notes) {
+      storeGroup(it, group);
+   }
+   for (auto& it : linked) {
+      storeGroup(it, group);
+   }
 }
 
 
@@ -74,12 +172,14 @@ int DatabaseTuplet::size(void) {
 //
 
 TupletGroup* DatabaseTuplet::tupletInfo(ScoreItem* item) {
-   auto result = interface.find(item);
-   if (result == interface.end()) {
+   if (item_index == NULL) {
+      return NULL;
+   }
+   int index = item_index->findItemIndex(item);
+   if ((index < 0) || (index >= (int)interface.size())) {
       return NULL;
-   } else {
-      return result->second;
    }
+   return interface[index];
 }
 
 
@@ -98,17 +198,21 @@ TupletGroup* DatabaseTuplet::linkItems(ScoreItem* item1, ScoreItem* item2) {
          // Case 1: neither item is in the tuplet database. Create entries
          // for both items.
          TupletGroup *bg = new TupletGroup;
-         database.push_back(bg);
-         insertItem(database.back(), item1);
-         insertItem(database.back(), item2);
-         interface[item1] = database.back();
-         interface[item2] = database.back();
-         return database.back();
+         int staff = item1->getStaffNumber();
+         if (staff >= (int)database.size()) {
+            database.resize(staff + 1);
+         }
+         database[staff].push_back(bg);
+         insertItem(bg, item1);
+         insertItem(bg, item2);
+         storeGroup(item1, bg);
+         storeGroup(item2, bg);
+         return bg;
       } else {
          // Case 2: item1 is not in the database, but item2 is.  Add item1
          // to item2's list.
          insertItem(info2, item1);
-         interface[item1] = info2;
+         storeGroup(item1, info2);
          return info2;
       }
    } else {
@@ -116,7 +220,7 @@ TupletGroup* DatabaseTuplet::linkItems(ScoreItem* item1, ScoreItem* item2) {
          // Case 3: note1 is in the database, but note2 is not.  Add item2
          // to item1's list and return info1.
          insertItem(info1, item2);
-         interface[item2] = info1;
+         storeGroup(item2, info1);
          return info1;
       } else {
          // Case 4: Both items are already in the database.  Presumably
@@ -137,17 +241,19 @@ TupletGroup* DatabaseTuplet::linkItems(ScoreItem* item1, ScoreItem* item2) {
 //
 
 ostream& DatabaseTuplet::printDatabase(ostream& out) {
-   for (auto& it : database) {
-      out << "\n# TUPLET GROUP START\n";
-      out << "# TUPLETS:\n";
-      for (auto& bracket : it->brackets) {
-         out << bracket;
-      }
-      out << "# NOTES/RESTS:\n";
-      for (auto& note : it->notes) {
-         out << note;
+   for (auto& staff : database) {
+      for (auto& it : staff) {
+         out << "\n# TUPLET GROUP START\n";
+         out << "# TUPLETS:\n";
+         for (auto& bracket : it->brackets) {
+            out << bracket;
+         }
+         out << "# NOTES/RESTS:\n";
+         for (auto& note : it->notes) {
+            out << note;
+         }
+         out << "\n# TUPLET GROUP END\n";
       }
-      out << "\n# TUPLET GROUP END\n";
    }
    return out;
 }
@@ -178,3 +284,22 @@ void DatabaseTuplet::insertItem(TupletGroup* info, ScoreItem* item) {
 
 
 
+//////////////////////////////
+//
+// DatabaseTuplet::storeGroup -- Store the tuplet group which contains an item.
+//
+
+void DatabaseTuplet::storeGroup(ScoreItem* item, TupletGroup* group) {
+   if (item_index == NULL) {
+      cerr << "Error: tuplet database has no item index" << endl;
+      exit(1);
+   }
+   int index = item_index->getItemIndex(item);
+   if (index >= (int)interface.size()) {
+      interface.resize(index + 1, NULL);
+   }
+   interface[index] = group;
+}
+
+
+
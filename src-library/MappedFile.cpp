@@ -0,0 +1,214 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 10:12:41 PDT 2026
+// Last Modified: Sat Oct 17 10:12:44 PDT 2026
+// Filename:      MappedFile.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/MappedFile.cpp
+// Syntax:        C++11
+//
+// Description:   Read-only view of the contents of a file.  The file is
+//                memory-mapped when possible, otherwise its contents are
+//                copied into an internal buffer.
+//
+
+#include "MappedFile.h"
+#include "ScoreFileType.h"
+#include <fstream>
+
+#ifndef VISUAL
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+#endif
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// MappedFile::MappedFile -- Constructor.
+//
+
+MappedFile::MappedFile(void) {
+   contents = NULL;
+   length   = 0;
+   mapping  = NULL;
+   openQ    = 0;
+}
+
+
+MappedFile::MappedFile(const string& filename) {
+   contents = NULL;
+   length   = 0;
+   mapping  = NULL;
+   openQ    = 0;
+   open(filename.c_str());
+}
+
+
+MappedFile::MappedFile(const char* filename) {
+   contents = NULL;
+   length   = 0;
+   mapping  = NULL;
+   openQ    = 0;
+   open(filename);
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::~MappedFile -- Destructor.
+//
+
+MappedFile::~MappedFile() {
+   close();
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::open -- Map the contents of a file into memory.  Returns
+//     true if the file could be opened; otherwise returns false.
+//
+
+int MappedFile::open(const string& filename) {
+   return open(filename.c_str());
+}
+
+
+int MappedFile::open(const char* filename) {
+   close();
+
+   #ifndef VISUAL
+      int fd = ::open(filename, O_RDONLY);
+      if (fd < 0) {
+         return 0;
+      }
+      struct stat info;
+      if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode)) {
+         ::close(fd);
+         return 0;
+      }
+      length = (size_t)info.st_size;
+      if (length > 0) {
+         void* ptr = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (ptr != MAP_FAILED) {
+            mapping  = ptr;
+            contents = (const char*)ptr;
+            #ifdef MADV_SEQUENTIAL
+               madvise(ptr, length, MADV_SEQUENTIAL);
+            #endif
+         }
+      }
+      ::close(fd);
+      if (mapping != NULL) {
+         openQ = 1;
+         return openQ;
+      }
+   #endif
+
+   // Fallback: copy the file contents into memory.
+   ifstream infile(filename, ios::in | ios::binary);
+   if (!infile.is_open()) {
+      length = 0;
+      return 0;
+   }
+   infile.seekg(0, ios::end);
+   length = (size_t)infile.tellg();
+   infile.seekg(0, ios::beg);
+   buffer.resize(length);
+   if (length > 0) {
+      infile.read(buffer.data(), length);
+   }
+   contents = buffer.data();
+   openQ = 1;
+   return openQ;
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::close -- Release the file contents.
+//
+
+void MappedFile::close(void) {
+   #ifndef VISUAL
+      if (mapping != NULL) {
+         munmap(mapping, length);
+      }
+   #endif
+   mapping  = NULL;
+   contents = NULL;
+   length   = 0;
+   openQ    = 0;
+   buffer.clear();
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::isOpen -- Returns true if a file has been opened.
+//
+
+int MappedFile::isOpen(void) const {
+   return openQ;
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::data -- Return a pointer to the first byte of the file.
+//    An empty file may return NULL.
+//
+
+const char* MappedFile::data(void) const {
+   return contents;
+}
+
+
+const char* MappedFile::begin(void) const {
+   return contents;
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::end -- Return a pointer to one byte after the end of the file.
+//
+
+const char* MappedFile::end(void) const {
+   return contents + length;
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::size -- Return the number of bytes in the file.
+//
+
+size_t MappedFile::size(void) const {
+   return length;
+}
+
+
+
+//////////////////////////////
+//
+// MappedFile::isBinaryScore -- Returns true if the file ends with the
+//     binary SCORE trailer (see ScoreFileType::hasBinaryTrailer()).
+//
+
+int MappedFile::isBinaryScore(void) const {
+   return ScoreFileType::hasBinaryTrailer(contents, length);
+}
+
+
+
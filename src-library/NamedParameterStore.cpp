@@ -0,0 +1,651 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 22:10:26 PDT 2026
+// Last Modified: Sat Oct 17 22:10:29 PDT 2026
+// Filename:      NamedParameterStore.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/NamedParameterStore.cpp
+// Syntax:        C++11
+//
+// Description:   Compact storage for the named parameters of a ScoreItem.
+//                Namespace and key strings are interned into integer IDs
+//                (the official names in ScoreNamedParameters.h have fixed
+//                IDs), and the parameters are stored in a small flat list.
+//                Integer, floating-point and pointer versions of each
+//                value are calculated when the value is set, so that they
+//                do not have to be parsed from the string each time that
+//                they are accessed.
+//
+
+#include "NamedParameterStore.h"
+#include "ScoreNamedParameters.h"
+#include "ScoreUtility.h"
+#include "ScoreProfile.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
+using namespace std;
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Name interning.  The names are stored in two tables: the official
+// namespace and parameter names from ScoreNamedParameters.h, which are
+// entered when the table is created and never change, and any other
+// names found in the data, which are added as needed.  The official
+// names can be looked up without locking, so threads analyzing separate
+// pages do not block each other.
+//
+
+// The empty namespace is always ID 0, and "auto" is always ID 1.  The
+// rest of the official names are listed in ScoreNamedParameters.h.
+#define OFFICIAL_NAME(name) name,
+static const string official_names[] = {
+   "",
+   SCORE_OFFICIAL_NAMES(OFFICIAL_NAME)
+};
+#undef OFFICIAL_NAME
+
+class NameTable {
+   public:
+      NameTable(void) {
+         int count = sizeof(official_names) / sizeof(official_names[0]);
+         official.reserve(count);
+         for (int i=0; i<count; i++) {
+            official.push_back(official_names[i]);
+            official_ids[official.back()] = i;
+         }
+      }
+
+      vector<string>              official;
+      unordered_map<string, int>  official_ids;
+
+      // Names which are not official (access with lock held):
+      deque<string>               other;
+      unordered_map<string, int>  other_ids;
+      mutex                       lock;
+};
+
+
+static NameTable& getNameTable(void) {
+   static NameTable table;
+   return table;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::NamedParameterStore -- Constructor.
+//
+
+NamedParameterStore::NamedParameterStore(void) {
+   // do nothing
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::~NamedParameterStore -- Deconstructor.
+//
+
+NamedParameterStore::~NamedParameterStore() {
+   // do nothing
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::clear -- Remove all parameters.
+//
+
+void NamedParameterStore::clear(void) {
+   entries.clear();
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::empty -- Returns true if there are no parameters.
+//
+
+int NamedParameterStore::empty(void) const {
+   return entries.empty();
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getParameterCount -- Return the number of
+//     parameters, either in total or in a particular namespace.
+//
+
+int NamedParameterStore::getParameterCount(void) const {
+   return entries.size();
+}
+
+
+int NamedParameterStore::getParameterCount(int nsid) const {
+   int output = 0;
+   for (auto& it : entries) {
+      if (it.nsid == nsid) {
+         output++;
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getNamespaceCount -- Return the number of
+//     namespaces which contain parameters.
+//
+
+int NamedParameterStore::getNamespaceCount(void) const {
+   vector<int> nsids;
+   getNamespaces(nsids);
+   return nsids.size();
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getNamespaces -- Return the IDs of the namespaces
+//     which contain parameters, sorted alphabetically by namespace name.
+//
+
+void NamedParameterStore::getNamespaces(vector<int>& output) const {
+   output.clear();
+   for (auto& it : entries) {
+      if (std::find(output.begin(), output.end(), it.nsid) == output.end()) {
+         output.push_back(it.nsid);
+      }
+   }
+   std::sort(output.begin(), output.end(), [](int a, int b) {
+      return getName(a) < getName(b);
+   });
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getSortedParameters -- Return the indexes of the
+//     parameters sorted alphabetically by namespace and then by key.  If
+//     nsid is not negative, then only parameters in that namespace are
+//     returned.
+//
+//     Default value: nsid = -1
+//
+
+void NamedParameterStore::getSortedParameters(vector<int>& output,
+      int nsid) const {
+   output.clear();
+   output.reserve(entries.size());
+   for (int i=0; i<(int)entries.size(); i++) {
+      if ((nsid < 0) || (entries[i].nsid == nsid)) {
+         output.push_back(i);
+      }
+   }
+   const vector<Entry>& e = entries;
+   std::sort(output.begin(), output.end(), [&e](int a, int b) {
+      if (e[a].nsid != e[b].nsid) {
+         return getName(e[a].nsid) < getName(e[b].nsid);
+      }
+      return getName(e[a].keyid) < getName(e[b].keyid);
+   });
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::eraseNamespace -- Remove all parameters in
+//     a namespace.
+//
+
+void NamedParameterStore::eraseNamespace(int nsid) {
+   entries.erase(std::remove_if(entries.begin(), entries.end(),
+         [nsid](const Entry& entry) { return entry.nsid == nsid; }),
+         entries.end());
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::erase -- Remove a parameter.  Returns true if
+//     the parameter was found.
+//
+
+int NamedParameterStore::erase(int nsid, int keyid) {
+   int index = find(nsid, keyid);
+   if (index < 0) {
+      return 0;
+   }
+   entries.erase(entries.begin() + index);
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::find -- Return the index of a parameter, or -1
+//     if the parameter is not defined.
+//
+
+int NamedParameterStore::find(int nsid, int keyid) const {
+   for (int i=0; i<(int)entries.size(); i++) {
+      if ((entries[i].keyid == keyid) && (entries[i].nsid == nsid)) {
+         return i;
+      }
+   }
+   return -1;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::isDefined -- Returns true if the parameter exists.
+//
+
+int NamedParameterStore::isDefined(int nsid, int keyid) const {
+   return find(nsid, keyid) >= 0;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getString -- Return the value of a parameter
+//     (or an empty string if it is not defined).
+//
+
+const string& NamedParameterStore::getString(int nsid, int keyid) const {
+   static const string empty;
+   int index = find(nsid, keyid);
+   return index < 0 ? empty : entries[index].text;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getInt -- Return the integer value of a parameter,
+//     equivalent to stoi() of the string value.  Returns 0 if the value
+//     is not defined or not a number.
+//
+
+int NamedParameterStore::getInt(int nsid, int keyid) const {
+   int index = find(nsid, keyid);
+   if (index < 0) {
+      return 0;
+   }
+   const Entry& entry = entries[index];
+   if (entry.flags & INT_VALID) {
+      SCORE_PROFILE_COUNT(ParameterHits, 1);
+      return entry.intvalue;
+   }
+   SCORE_PROFILE_COUNT(ParameterMisses, 1);
+   // Value is out of range for an int: let stoi() report the error.
+   return stoi(entry.text);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getDouble -- Return the floating-point value of
+//     a parameter, equivalent to stod() of the string value.  Returns 0.0
+//     if the value is not defined, not a number or out of range.
+//
+
+double NamedParameterStore::getDouble(int nsid, int keyid) const {
+   int index = find(nsid, keyid);
+   if (index < 0) {
+      return 0.0;
+   }
+   SCORE_PROFILE_COUNT(ParameterHits, 1);
+   return entries[index].doublevalue;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getPointer -- Return the value of a parameter
+//     which stores the address of an object.  Returns NULL if the
+//     parameter is not defined.
+//
+
+void* NamedParameterStore::getPointer(int nsid, int keyid) const {
+   int index = find(nsid, keyid);
+   if (index < 0) {
+      return NULL;
+   }
+   const Entry& entry = entries[index];
+   if (entry.flags & POINTER_VALUE) {
+      return entry.pointer;
+   }
+   return (void*)(uintptr_t)strtoull(entry.text.c_str(), NULL, 10);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::setString -- Set the value of a parameter from
+//     a string.
+//
+
+void NamedParameterStore::setString(int nsid, int keyid,
+      const string& value) {
+   Entry& entry = entries[create(nsid, keyid)];
+   entry.text = value;
+   entry.pointer = NULL;
+   cacheNumbers(entry.intvalue, entry.doublevalue, entry.flags, entry.text);
+}
+
+
+void NamedParameterStore::setString(int nsid, int keyid,
+      const char* value, const char* end) {
+   Entry& entry = entries[create(nsid, keyid)];
+   entry.text.assign(value, end);
+   entry.pointer = NULL;
+   cacheNumbers(entry.intvalue, entry.doublevalue, entry.flags, entry.text);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::setInt -- Set the value of a parameter from an
+//     integer.
+//
+
+void NamedParameterStore::setInt(int nsid, int keyid, int value) {
+   Entry& entry = entries[create(nsid, keyid)];
+   entry.text        = to_string(value);
+   entry.intvalue    = value;
+   entry.doublevalue = value;
+   entry.flags       = INT_VALID;
+   entry.pointer     = NULL;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::setPointer -- Set the value of a parameter to
+//     the address of an object.  The string value is the address as
+//     a decimal number.
+//
+
+void NamedParameterStore::setPointer(int nsid, int keyid, void* pointer) {
+   Entry& entry = entries[create(nsid, keyid)];
+   entry.text = to_string((uint64_t)pointer);
+   cacheNumbers(entry.intvalue, entry.doublevalue, entry.flags, entry.text);
+   entry.flags  |= POINTER_VALUE;
+   entry.pointer = pointer;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getNamespaceId -- Return the namespace ID of the
+//     parameter at the given index.
+//
+
+int NamedParameterStore::getNamespaceId(int index) const {
+   return entries[index].nsid;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getKeyId -- Return the key ID of the parameter
+//     at the given index.
+//
+
+int NamedParameterStore::getKeyId(int index) const {
+   return entries[index].keyid;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getNamespace -- Return the namespace of the
+//     parameter at the given index.
+//
+
+const string& NamedParameterStore::getNamespace(int index) const {
+   return getName(entries[index].nsid);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getKey -- Return the key of the parameter at
+//     the given index.
+//
+
+const string& NamedParameterStore::getKey(int index) const {
+   return getName(entries[index].keyid);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getValue -- Return the string value of the
+//     parameter at the given index.
+//
+
+const string& NamedParameterStore::getValue(int index) const {
+   return entries[index].text;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getPointer -- Return the pointer value of the
+//     parameter at the given index.
+//
+
+void* NamedParameterStore::getPointer(int index) const {
+   return getPointer(entries[index].nsid, entries[index].keyid);
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::isPointer -- Return true if the value of the
+//     parameter at the given index was set with setPointer().
+//
+
+int NamedParameterStore::isPointer(int index) const {
+   return (entries[index].flags & POINTER_VALUE) ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getNameId -- Return the ID for a namespace or
+//     key name, adding the name to the list of known names if necessary.
+//
+
+int NamedParameterStore::getNameId(const string& name) {
+   NameTable& table = getNameTable();
+   auto it = table.official_ids.find(name);
+   if (it != table.official_ids.end()) {
+      return it->second;
+   }
+
+   lock_guard<mutex> guard(table.lock);
+   auto it2 = table.other_ids.find(name);
+   if (it2 != table.other_ids.end()) {
+      return it2->second;
+   }
+   int id = table.official.size() + table.other.size();
+   table.other.push_back(name);
+   table.other_ids[name] = id;
+   return id;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::findNameId -- Return the ID for a namespace or
+//     key name, or -1 if the name has never been used (in which case no
+//     parameter can have that name).
+//
+
+int NamedParameterStore::findNameId(const string& name) {
+   NameTable& table = getNameTable();
+   auto it = table.official_ids.find(name);
+   if (it != table.official_ids.end()) {
+      return it->second;
+   }
+
+   lock_guard<mutex> guard(table.lock);
+   auto it2 = table.other_ids.find(name);
+   if (it2 != table.other_ids.end()) {
+      return it2->second;
+   }
+   return -1;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::getName -- Return the name for a namespace or
+//     key ID.
+//
+
+const string& NamedParameterStore::getName(int id) {
+   NameTable& table = getNameTable();
+   if (id < (int)table.official.size()) {
+      return table.official[id];
+   }
+   lock_guard<mutex> guard(table.lock);
+   return table.other[id - table.official.size()];
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::create -- Return the index of a parameter, adding
+//     it if it does not exist.
+//
+
+int NamedParameterStore::create(int nsid, int keyid) {
+   int index = find(nsid, keyid);
+   if (index >= 0) {
+      return index;
+   }
+   entries.resize(entries.size() + 1);
+   Entry& entry      = entries.back();
+   entry.nsid        = nsid;
+   entry.keyid       = keyid;
+   entry.flags       = 0;
+   entry.intvalue    = 0;
+   entry.doublevalue = 0.0;
+   entry.pointer     = NULL;
+   return entries.size() - 1;
+}
+
+
+
+//////////////////////////////
+//
+// NamedParameterStore::cacheNumbers -- Calculate the integer and
+//     floating-point values of a string in the same way as stoi() and
+//     stod() do, but without throwing exceptions.  A string which is not
+//     a number has the value 0.  Floating-point values which are out of
+//     range have the value 0.0.  Integers which are out of range are
+//     marked as not valid.
+//
+
+void NamedParameterStore::cacheNumbers(int& intvalue, double& doublevalue,
+      int& flags, const string& text) {
+   const char* start = text.c_str();
+
+   // Most values are short decimal numbers which are written by
+   // to_string(), so check for those first:
+   const char* ptr = start;
+   if ((*ptr == '-') || (*ptr == '+')) {
+      ptr++;
+   }
+   const char* digits = ptr;
+   long whole = 0;
+   while ((*ptr >= '0') && (*ptr <= '9')) {
+      whole = whole * 10 + (*ptr - '0');
+      ptr++;
+   }
+   int wholedigits = (int)(ptr - digits);
+   if (*ptr == '.') {
+      ptr++;
+      while ((*ptr >= '0') && (*ptr <= '9')) {
+         ptr++;
+      }
+   }
+   if ((wholedigits > 0) && (wholedigits <= 9) && (*ptr == '\0')) {
+      intvalue    = (*start == '-') ? -(int)whole : (int)whole;
+      doublevalue = ScoreUtility::parseNumber(start, ptr);
+      flags       = INT_VALID;
+      return;
+   }
+
+   char* end;
+   int olderrno = errno;
+
+   flags = 0;
+   errno = 0;
+   long lvalue = strtol(start, &end, 10);
+   if (end == start) {
+      intvalue = 0;
+      flags |= INT_VALID;
+   } else if ((errno == ERANGE) || (lvalue < INT_MIN) || (lvalue > INT_MAX)) {
+      intvalue = 0;
+   } else {
+      intvalue = (int)lvalue;
+      flags |= INT_VALID;
+   }
+
+   errno = 0;
+   double dvalue = strtod(start, &end);
+   if ((end == start) || (errno == ERANGE)) {
+      doublevalue = 0.0;
+   } else {
+      doublevalue = dvalue;
+   }
+
+   errno = olderrno;
+}
+
+
+
@@ -15,7 +15,10 @@
 //
 
 #include "RationalDuration.h"
+#include "ScoreUtility.h"
 #include <cmath>
+#include <sstream>
+#include <stdexcept>
 
 //////////////////////////////
 //
@@ -438,6 +441,79 @@ void RationalDuration::setDurationQuarterNoteUnits(double duration,
       dcount = 0;
    }
 
+   if (setDottedDuration(duration, dcount)) {
+      return;
+   }
+
+   // 3. At this point the duration is not a power of two, and it is not
+   // a simple tuplet of a power of two.   It is a rational duration which
+   // consists of a tuplet ratio not based on a power of two, such as five
+   // quarter notes in the time of three (a 5:3 tuplet, where the second
+   // number is not a power of two).  Figure out how to calculate this sort
+   // of case here...
+
+
+   // 3b. Another possibility is that dcount is invalid.  In some music
+   // (particularly Baroque), the dot does not have an exact arithmetic
+   // interpretation.  Another example are the augmentation dots in Chopin's
+   // Op. 28, No. 1 prelude.
+
+   if (fabs(duration - 6.0) < threshold) {
+      // dot is missing from note.  Add one for a dotted whole note
+      setDuration(4, 1, 1);
+      return;
+   }
+
+   // 3c. The dot count may also not match the duration at all, such as
+   // a triplet sixteenth (0.167) with a dot, or a dotted eighth note
+   // (0.75) without one.  Try the duration without dots, and then as a
+   // power of two with up to three dots.
+
+   if ((dcount != 0) && setDottedDuration(duration, 0)) {
+      return;
+   }
+   for (int i=1; i<=3; i++) {
+      if ((i != dcount) && setDottedDuration(duration, i, 0)) {
+         return;
+      }
+   }
+
+
+   // 4. Use the simplest fraction which matches the duration, in the same
+   // way as the integer ticks of the staff offsets (see
+   // ScoreUtility::getDurationDenominator()), without any dots.
+
+   int denominator = SU::getDurationDenominator(duration);
+   int numerator   = (int)(duration * denominator + 0.5);
+   if (numerator > 0) {
+      dotcount = 0;
+      setValue(numerator, denominator);
+      tupletfactors.clear();
+      return;
+   }
+
+   // 5. Give up: don't know what the duration is, so set to -1 and
+   // throw an error which a program converting many files can catch
+   // (see ScoreBatch::convertWork()).
+   zero();
+   primaryvalue = -1;
+   stringstream message;
+   message << "unknown duration: " << duration;
+   throw runtime_error(message.str());
+}
+
+
+
+//////////////////////////////
+//
+// RationalDuration::setDottedDuration -- Set the duration if it is a
+//     power of two or a simple tuplet (if tupletQ is true) after removing
+//     the given number of augmentation dots.  Returns false if it is
+//     neither.
+//
+
+int RationalDuration::setDottedDuration(double duration, int dcount,
+      int tupletQ) {
    // Remove dots from duration:
    //
    // # dots    adding factor                removing factor
@@ -463,7 +539,10 @@ void RationalDuration::setDurationQuarterNoteUnits(double duration,
    if (powerOfTwoDuration(testrd, basedur)) {
       *this = testrd;
       dotcount = dcount;
-      return;
+      return 1;
+   }
+   if (!tupletQ) {
+      return 0;
    }
 
    // 2. Check to see if it is a simple tuplet where there is
@@ -500,36 +579,11 @@ void RationalDuration::setDurationQuarterNoteUnits(double duration,
          setValue(top, bottom);
          // set tupletfactors later...
          tupletfactors.clear();
-         return;
+         return 1;
       }
    }
 
-
-   // 3. At this point the duration is not a power of two, and it is not
-   // a simple tuplet of a power of two.   It is a rational duration which
-   // consists of a tuplet ratio not based on a power of two, such as five
-   // quarter notes in the time of three (a 5:3 tuplet, where the second
-   // number is not a power of two).  Figure out how to calculate this sort
-   // of case here...
-
-
-   // 3b. Another possibility is that dcount is invalid.  In some music
-   // (particularly Baroque), the dot does not have an exact arithmetic
-   // interpretation.  Another example are the augmentation dots in Chopin's
-   // Op. 28, No. 1 prelude.
-
-   if (fabs(duration - 6.0) < threshold) {
-      // dot is missing from note.  Add one for a dotted whole note
-      setDuration(4, 1, 1);
-      return;
-   }
-
-
-   // 4. Give up: don't know what the duration is, so set to -1
-   zero();
-cerr << "UNKNOWN DURATION: " << duration << endl;
-exit(1);
-   primaryvalue = -1;
+   return 0;
 }
 
 
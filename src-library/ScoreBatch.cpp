@@ -0,0 +1,573 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 00:31:08 PDT 2026
+// Last Modified: Sun Oct 18 00:31:11 PDT 2026
+// Filename:      ScoreBatch.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreBatch.cpp
+// Syntax:        C++11
+//
+// Description:   Convert a list of works in one process (see ScoreBatch.h).
+//
+
+#include "ScoreBatch.h"
+#include "ScoreFileType.h"
+#include "ScoreUtility.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <dirent.h>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace std::chrono;
+
+
+//////////////////////////////
+//
+// ScoreBatch::ScoreBatch -- Constructor.
+//
+
+ScoreBatch::ScoreBatch(void) {
+   thread_count = 1;
+   report       = NULL;
+   wall_ms      = 0.0;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::~ScoreBatch -- Deconstructor.
+//
+
+ScoreBatch::~ScoreBatch() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::clear -- Remove all works.  The output and thread settings
+//     are not changed.
+//
+
+void ScoreBatch::clear(void) {
+   works.clear();
+   wall_ms = 0.0;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::readManifest -- Add the works listed in a manifest file
+//     (see ScoreBatch.h for the format).  Returns false if the file
+//     cannot be read.
+//
+
+int ScoreBatch::readManifest(const string& filename) {
+   ifstream infile(filename);
+   if (!infile.is_open()) {
+      return 0;
+   }
+   string line;
+   while (getline(infile, line)) {
+      size_t start = line.find_first_not_of(" \t\r");
+      if ((start == string::npos) || (line[start] == '#')) {
+         continue;
+      }
+      string output;
+      size_t equals = line.find('=');
+      if (equals != string::npos) {
+         stringstream outstream(line.substr(equals + 1));
+         outstream >> output;
+         line.resize(equals);
+      }
+      stringstream instream(line);
+      vector<string> inputs;
+      string name;
+      while (instream >> name) {
+         inputs.push_back(name);
+      }
+      if (!inputs.empty()) {
+         addWork(inputs, output);
+      }
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::readDirectory -- Add one work for each data file in the
+//     directory and its subdirectories (see isDataFile()), in
+//     alphabetical order.  If there are several data files with the same
+//     name and different extensions (such as "name.mus" and "name.pmx"),
+//     only one of them is converted, preferring binary files to PMX files
+//     (see getExtensionRank()).  Returns false if the directory cannot be
+//     read.
+//
+
+int ScoreBatch::readDirectory(const string& directory) {
+   DIR* dir = opendir(directory.c_str());
+   if (dir == NULL) {
+      return 0;
+   }
+   closedir(dir);
+   vector<string> files;
+   ScoreFileType::findFiles(directory, files, thread_count);
+   sort(files.begin(), files.end());
+
+   // Keep the preferred data file for each filename without extension:
+   map<string, string> names;
+   for (auto& it : files) {
+      if (!isDataFile(it)) {
+         continue;
+      }
+      string name = it.substr(0, it.rfind('.'));
+      auto found = names.find(name);
+      if ((found == names.end()) ||
+            (getExtensionRank(it) < getExtensionRank(found->second))) {
+         names[name] = it;
+      }
+   }
+   for (auto& it : names) {
+      addWork(vector<string>(1, it.second));
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::read -- Add the works in a directory or manifest file.
+//     Returns false if it cannot be read.
+//
+
+int ScoreBatch::read(const string& name) {
+   struct stat info;
+   if ((stat(name.c_str(), &info) == 0) && S_ISDIR(info.st_mode)) {
+      return readDirectory(name);
+   }
+   return readManifest(name);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::addWork -- Add a work to convert.  If the output filename
+//     is empty, it is made from the first input file, the output
+//     extension and the output directory.
+//
+
+void ScoreBatch::addWork(const vector<string>& inputs, const string& output) {
+   Work work;
+   work.inputs = inputs;
+   work.output = output.empty() ? getOutputFilename(inputs) : output;
+   works.push_back(work);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::setOutputExtension -- Set the extension of the output
+//     files (such as ".xml"), which is used for works added after this
+//     function is called.
+//
+
+void ScoreBatch::setOutputExtension(const string& extension) {
+   output_extension = extension;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::setOutputDirectory -- Set the directory where the output
+//     files are written (for works added after this function is called
+//     without an output filename).  By default the output files are
+//     written next to the input files.  The directory (and any missing
+//     parent directories) is created if it does not exist.  Returns
+//     false if it cannot be created.
+//
+
+int ScoreBatch::setOutputDirectory(const string& directory) {
+   output_directory = directory;
+   if (directory.empty()) {
+      return 1;
+   }
+   struct stat info;
+   size_t slash = 0;
+   while (slash != string::npos) {
+      slash = directory.find('/', slash + 1);
+      string path = directory.substr(0, slash);
+      if (stat(path.c_str(), &info) != 0) {
+         mkdir(path.c_str(), 0777);
+      }
+   }
+   return (stat(directory.c_str(), &info) == 0) && S_ISDIR(info.st_mode);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::setThreadCount -- Set the number of works which are
+//     converted at the same time.  A count of 0 will use one thread for
+//     each processor core.  Each work is read and analyzed on a single
+//     thread.
+//
+
+void ScoreBatch::setThreadCount(int count) {
+   if (count < 0) {
+      count = 1;
+   }
+   thread_count = count;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::setCacheName -- Read the works with analysis cache files
+//     of the given name (see ScorePageSet::appendReadCached()).  The
+//     conversion function should call ScorePageSet::updateCache() after
+//     analyzing the pages.
+//
+
+void ScoreBatch::setCacheName(const string& name) {
+   cache_name = name;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::setReport -- Write a line for each work to the stream as
+//     soon as it has been converted: the status ("ok" or "failed"), the
+//     time taken in milliseconds, the number of pages and segments, the
+//     output file and the input files (or the error message if it
+//     failed), separated by tabs.  Works are reported in the order in
+//     which they finish.
+//
+
+void ScoreBatch::setReport(ostream& out) {
+   report = &out;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::run -- Convert all of the works which have not been
+//     converted yet.  A work fails without being converted if its output
+//     file is the same as the output file of an earlier work (such as
+//     for "name.mus" and "name.pmx" in the same directory of a manifest).
+//     Returns the number of works which failed.
+//
+
+int ScoreBatch::run(const ConvertFunction& convert) {
+   auto start = steady_clock::now();
+   if (report) {
+      lock_guard<mutex> guard(report_lock);
+      *report << "#status\tms\tpages\tsegments\toutput\tinputs\n";
+   }
+
+   map<string, Work*> outputs;
+   vector<Work*> pending;
+   for (auto& it : works) {
+      auto found = outputs.find(it.output);
+      if (found == outputs.end()) {
+         outputs[it.output] = &it;
+      } else if (it.status == WORK_PENDING) {
+         it.status = WORK_FAILED;
+         it.error  = "output file is also written for " +
+               found->second->inputs[0];
+         reportWork(it);
+      }
+      if (it.status == WORK_PENDING) {
+         pending.push_back(&it);
+      }
+   }
+   SU::runParallel((int)pending.size(), thread_count, [&](int index) {
+      convertWork(*pending[index], convert);
+   });
+   auto stop = steady_clock::now();
+   wall_ms += duration<double, milli>(stop - start).count();
+   return getFailureCount();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::printSummary -- Print the number of works converted and
+//     failed, the total time taken by the works and the time taken by
+//     run().
+//
+
+void ScoreBatch::printSummary(ostream& out) {
+   int done = 0;
+   int failed = 0;
+   double worktime = 0.0;
+   for (auto& it : works) {
+      if (it.status == WORK_DONE) {
+         done++;
+      } else if (it.status == WORK_FAILED) {
+         failed++;
+      }
+      worktime += it.ms;
+   }
+   out << "works:\t\t"     << works.size() << "\n";
+   out << "converted:\t"   << done         << "\n";
+   out << "failed:\t\t"    << failed       << "\n";
+   out << "work ms:\t"     << worktime     << "\n";
+   out << "wall ms:\t"     << wall_ms      << "\n";
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::getWorkCount -- Return the number of works.
+//
+
+int ScoreBatch::getWorkCount(void) {
+   return (int)works.size();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::getWork -- Return a work and the results of its
+//     conversion.
+//
+
+ScoreBatch::Work& ScoreBatch::getWork(int index) {
+   return works.at(index);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::getFailureCount -- Return the number of works which could
+//     not be converted.
+//
+
+int ScoreBatch::getFailureCount(void) {
+   int output = 0;
+   for (auto& it : works) {
+      if (it.status == WORK_FAILED) {
+         output++;
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::isDataFile -- Returns true if the file has the extension
+//     of a PMX (.pmx, .ppmx) or binary SCORE (.mus, .pag) file, in upper
+//     or lower case.
+//
+
+int ScoreBatch::isDataFile(const string& filename) {
+   size_t dot = filename.rfind('.');
+   size_t slash = filename.rfind('/');
+   if ((dot == string::npos) || ((slash != string::npos) && (dot < slash))) {
+      return 0;
+   }
+   string extension = filename.substr(dot + 1);
+   for (auto& it : extension) {
+      it = tolower(it);
+   }
+   return (extension == "pmx") || (extension == "ppmx") ||
+         (extension == "mus") || (extension == "pag");
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::getExtensionRank -- Return the order in which data files
+//     with the same name are preferred by readDirectory(): binary SCORE
+//     files (.mus, then .pag) first, since they store the parameters at
+//     full precision, and then PMX files (.pmx, then .ppmx).
+//
+
+int ScoreBatch::getExtensionRank(const string& filename) {
+   string extension = filename.substr(filename.rfind('.') + 1);
+   for (auto& it : extension) {
+      it = tolower(it);
+   }
+   vector<string> order = {"mus", "pag", "pmx", "ppmx"};
+   for (int i=0; i<(int)order.size(); i++) {
+      if (extension == order[i]) {
+         return i;
+      }
+   }
+   return (int)order.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Protected functions:
+//
+
+//////////////////////////////
+//
+// ScoreBatch::convertWork -- Read the input files of a work into a new
+//     page set and convert it to the output file.  The work fails if an
+//     input file cannot be read, the output file cannot be written, or
+//     the conversion function fails (or throws an exception, such as for
+//     a duration which cannot be converted to a RationalDuration).  The
+//     conversion is written to a temporary file which replaces the output
+//     file only if the work succeeds, so a failed or interrupted work
+//     never leaves a partial output file.  Errors in the input data which
+//     exit the program will still stop the batch.
+//
+
+void ScoreBatch::convertWork(Work& work, const ConvertFunction& convert) {
+   auto start = steady_clock::now();
+   work.status = WORK_DONE;
+   work.error.clear();
+
+   for (auto& it : work.inputs) {
+      struct stat info;
+      ifstream test(it);
+      if ((stat(it.c_str(), &info) != 0) || !S_ISREG(info.st_mode) ||
+            !test.is_open()) {
+         work.status = WORK_FAILED;
+         work.error  = "cannot read " + it;
+         break;
+      }
+   }
+
+   ScorePageSet infiles;
+   ofstream outfile;
+   string tempname = work.output + ".tmp";
+   if (work.status == WORK_DONE) {
+      outfile.open(tempname);
+      if (!outfile.is_open()) {
+         work.status = WORK_FAILED;
+         work.error  = "cannot write " + work.output;
+      }
+   }
+
+   if (work.status == WORK_DONE) {
+      try {
+         if (cache_name.empty()) {
+            infiles.appendRead(work.inputs);
+         } else {
+            infiles.appendReadCached(work.inputs, cache_name);
+         }
+         if (!convert(infiles, outfile, work.error)) {
+            work.status = WORK_FAILED;
+         }
+      } catch (const exception& error) {
+         work.status = WORK_FAILED;
+         work.error  = error.what();
+      }
+      outfile.close();
+      if ((work.status == WORK_DONE) && (outfile.fail() ||
+            (rename(tempname.c_str(), work.output.c_str()) != 0))) {
+         work.status = WORK_FAILED;
+         work.error  = "cannot write " + work.output;
+      }
+      if (work.status == WORK_FAILED) {
+         remove(tempname.c_str());
+      }
+   }
+
+   if ((work.status == WORK_FAILED) && work.error.empty()) {
+      work.error = "conversion failed";
+   }
+   work.pages    = infiles.getPageCount();
+   work.segments = infiles.getSegmentCount();
+   auto stop = steady_clock::now();
+   work.ms = duration<double, milli>(stop - start).count();
+   reportWork(work);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::getOutputFilename -- Return the output filename for a work
+//     which was not given one: the first input file with its extension
+//     replaced by the output extension, in the output directory if one
+//     has been set.
+//
+
+string ScoreBatch::getOutputFilename(const vector<string>& inputs) {
+   if (inputs.empty()) {
+      return "";
+   }
+   string output = inputs[0];
+   size_t slash = output.rfind('/');
+   size_t dot = output.rfind('.');
+   if ((dot != string::npos) && ((slash == string::npos) || (dot > slash))) {
+      output.resize(dot);
+   }
+   output += output_extension;
+   if (!output_directory.empty()) {
+      if (slash != string::npos) {
+         output = output.substr(slash + 1);
+      }
+      if (output_directory.back() == '/') {
+         output = output_directory + output;
+      } else {
+         output = output_directory + "/" + output;
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreBatch::reportWork -- Write the results of a work to the report
+//     (see setReport()).
+//
+
+void ScoreBatch::reportWork(Work& work) {
+   if (report == NULL) {
+      return;
+   }
+   stringstream line;
+   line << (work.status == WORK_DONE ? "ok" : "failed") << "\t";
+   line << work.ms << "\t" << work.pages << "\t" << work.segments << "\t";
+   line << work.output << "\t";
+   if (work.status == WORK_DONE) {
+      for (int i=0; i<(int)work.inputs.size(); i++) {
+         if (i > 0) {
+            line << " ";
+         }
+         line << work.inputs[i];
+      }
+   } else {
+      line << work.error;
+   }
+   line << "\n";
+   lock_guard<mutex> guard(report_lock);
+   *report << line.str() << flush;
+}
+
+
+
@@ -0,0 +1,975 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:36 PDT 2026
+// Last Modified: Sat Oct 17 23:59:39 PDT 2026
+// Filename:      ScoreCache.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreCache.cpp
+// Syntax:        C++11
+//
+// Description:   Binary cache files for a ScorePageSet.  See ScoreCache.h
+//                for a description of the file format.
+//
+
+#include "ScoreCache.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+
+#define CACHE_VERSION 2
+
+static const char     CacheMagic[8]  = {'S','C','O','R','E','L','I','B'};
+static const uint32_t CacheByteOrder = 0x01020304;
+
+// Page analyses for which the validity is stored in PageRecord::valid.
+// The first StructureCount are the sorted item lists of the page, which
+// are rebuilt when the cache is read.  The results of the analyses after
+// them, up to RestoreCount, are read from the cache.  The barlines and
+// p3 databases are not stored, so they are analyzed again when needed.
+static const vector<string> PageAnalyses = {
+   "sorted", "staves", "systems", "duration", "systempitches",
+   "staffslursties", "chords", "beams", "tuplets", "layers",
+   "barlines", "p3"
+};
+static const int StructureCount = 3;
+static const int RestoreCount   = 10;
+
+static void     hashBytes    (uint64_t& hash, const char* data, size_t size);
+static int      inRange      (int start, int count, int size);
+static uint64_t alignSection (uint64_t offset);
+
+
+
+//////////////////////////////
+//
+// ScoreCache::ScoreCache -- Constructor.
+//
+
+ScoreCache::ScoreCache(void) {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::~ScoreCache -- Deconstructor.
+//
+
+ScoreCache::~ScoreCache() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::clear -- Remove the contents of the last file read or
+//     written.
+//
+
+void ScoreCache::clear(void) {
+   stringoffsets.clear();
+   stringdata.clear();
+   pages.clear();
+   items.clear();
+   named.clear();
+   numbers.clear();
+   rows.clear();
+   groups.clear();
+   indexes.clear();
+   segments.clear();
+   analyses.clear();
+   strings.clear();
+   itemindex.clear();
+
+   header           = NULL;
+   instringoffsets  = NULL;
+   instringdata     = NULL;
+   inpages          = NULL;
+   initems          = NULL;
+   innamed          = NULL;
+   innumbers        = NULL;
+   inrows           = NULL;
+   ingroups         = NULL;
+   inindexes        = NULL;
+   insegments       = NULL;
+   inanalyses       = NULL;
+   for (int i=0; i<SECTION_COUNT; i++) {
+      counts[i] = 0;
+   }
+   itemlist.clear();
+   nameids.clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::getSourceHash -- Return a hash (64-bit FNV-1a) of the
+//     names, sizes and contents of the input files.  Returns 0 if any
+//     of the files cannot be read.
+//
+
+uint64_t ScoreCache::getSourceHash(const vector<string>& filenames) {
+   uint64_t hash = 14695981039346656037ULL;
+   uint32_t version = CACHE_VERSION;
+   hashBytes(hash, (const char*)&version, sizeof(version));
+   for (auto& it : filenames) {
+      MappedFile infile(it);
+      if (!infile.isOpen()) {
+         return 0;
+      }
+      uint64_t size = infile.size();
+      hashBytes(hash, it.c_str(), it.size() + 1);
+      hashBytes(hash, (const char*)&size, sizeof(size));
+      hashBytes(hash, infile.data(), infile.size());
+   }
+   return hash;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::write -- Store the pages of the set with their analysis
+//     results in a cache file.  The file is written under a temporary
+//     name and then renamed, so that a partly written file is never
+//     read.  Returns true if the file was written.
+//
+
+int ScoreCache::write(ScorePageSet& pageset, const string& filename,
+      uint64_t hash) {
+   SCORE_PROFILE_SCOPE("ScoreCache::write", 0);
+   clear();
+
+   // Number all of the items first, since items can be linked to items
+   // on later pages.
+   int index = 0;
+   for (auto& overlay : pageset.page_sequence) {
+      for (int i=0; i<overlay->getOverlayCount(); i++) {
+         for (auto& it : (*overlay)[i].item_storage) {
+            itemindex[it] = index++;
+         }
+      }
+   }
+
+   for (auto& overlay : pageset.page_sequence) {
+      for (int i=0; i<overlay->getOverlayCount(); i++) {
+         storePage((*overlay)[i], i > 0);
+      }
+   }
+
+   for (int i=0; i<pageset.getSegmentCount(); i++) {
+      ScoreSegment& segment = pageset.getSegment(i);
+      const AddressSystem& start = segment.getStartSystem();
+      const AddressSystem& end   = segment.getEndSystem();
+      SegmentRecord record;
+      record.start[0] = start.getPageIndex();
+      record.start[1] = start.getOverlayIndex();
+      record.start[2] = start.getSystemIndex();
+      record.start[3] = start.getSystemStaffIndex();
+      record.end[0]   = end.getPageIndex();
+      record.end[1]   = end.getOverlayIndex();
+      record.end[2]   = end.getSystemIndex();
+      record.end[3]   = end.getSystemStaffIndex();
+      segments.push_back(record);
+   }
+
+   for (auto& it : pageset.completed_analyses) {
+      analyses.push_back(addString(it));
+   }
+   stringoffsets.push_back((uint32_t)stringdata.size());
+
+   Header output;
+   memset(&output, 0, sizeof(output));
+   memcpy(output.magic, CacheMagic, sizeof(output.magic));
+   output.version      = CACHE_VERSION;
+   output.byteorder    = CacheByteOrder;
+   output.hash         = hash;
+   output.floatsize    = sizeof(SCORE_FLOAT);
+   output.sectioncount = SECTION_COUNT;
+
+   const char* data[SECTION_COUNT];
+   data[SECTION_STRINGOFFSETS] = (const char*)stringoffsets.data();
+   data[SECTION_STRINGDATA]    = stringdata.data();
+   data[SECTION_PAGES]         = (const char*)pages.data();
+   data[SECTION_ITEMS]         = (const char*)items.data();
+   data[SECTION_NAMED]         = (const char*)named.data();
+   data[SECTION_NUMBERS]       = (const char*)numbers.data();
+   data[SECTION_ROWS]          = (const char*)rows.data();
+   data[SECTION_GROUPS]        = (const char*)groups.data();
+   data[SECTION_INDEXES]       = (const char*)indexes.data();
+   data[SECTION_SEGMENTS]      = (const char*)segments.data();
+   data[SECTION_ANALYSES]      = (const char*)analyses.data();
+
+   Section* sections = output.sections;
+   sections[SECTION_STRINGOFFSETS].size = stringoffsets.size() * 4;
+   sections[SECTION_STRINGDATA].size    = stringdata.size();
+   sections[SECTION_PAGES].size    = pages.size()    * sizeof(PageRecord);
+   sections[SECTION_ITEMS].size    = items.size()    * sizeof(ItemRecord);
+   sections[SECTION_NAMED].size    = named.size()    * sizeof(NamedRecord);
+   sections[SECTION_NUMBERS].size  = numbers.size()  * sizeof(SCORE_FLOAT);
+   sections[SECTION_ROWS].size     = rows.size()     * sizeof(RowRecord);
+   sections[SECTION_GROUPS].size   = groups.size()   * sizeof(GroupRecord);
+   sections[SECTION_INDEXES].size  = indexes.size()  * sizeof(int32_t);
+   sections[SECTION_SEGMENTS].size = segments.size() * sizeof(SegmentRecord);
+   sections[SECTION_ANALYSES].size = analyses.size() * sizeof(int32_t);
+
+   uint64_t offset = alignSection(sizeof(Header));
+   for (int i=0; i<SECTION_COUNT; i++) {
+      sections[i].offset = offset;
+      offset = alignSection(offset + sections[i].size);
+   }
+
+   string tempname = filename + ".tmp";
+   ofstream outfile(tempname, ios::binary);
+   if (!outfile.is_open()) {
+      cerr << "Warning: cannot write cache file " << filename << endl;
+      return 0;
+   }
+   const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+   outfile.write((const char*)&output, sizeof(output));
+   uint64_t position = sizeof(output);
+   for (int i=0; i<SECTION_COUNT; i++) {
+      outfile.write(padding, sections[i].offset - position);
+      outfile.write(data[i], sections[i].size);
+      position = sections[i].offset + sections[i].size;
+   }
+   outfile.close();
+   if (!outfile || (rename(tempname.c_str(), filename.c_str()) != 0)) {
+      cerr << "Warning: cannot write cache file " << filename << endl;
+      remove(tempname.c_str());
+      return 0;
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::read -- Restore the pages of a set and their analysis
+//     results from a cache file.  The pages are appended to the set,
+//     which should be empty.  Returns false without changing the set if
+//     the file does not exist, is not a cache file for this version of
+//     the library or does not have the given hash of the input files.
+//
+
+int ScoreCache::read(ScorePageSet& pageset, const string& filename,
+      uint64_t hash) {
+   SCORE_PROFILE_SCOPE("ScoreCache::read", 0);
+   clear();
+   MappedFile infile(filename);
+   if (!infile.isOpen()) {
+      return 0;
+   }
+   if (!readSections(infile.data(), infile.size(), hash) || !checkRecords()) {
+      clear();
+      return 0;
+   }
+
+   // Create the pages and items, then set the named parameters (which
+   // can link to items on later pages).
+   int pagecount = counts[SECTION_PAGES];
+   vector<ScorePage*> pagelist(pagecount, NULL);
+   itemlist.reserve(counts[SECTION_ITEMS]);
+   nameids.resize(counts[SECTION_STRINGOFFSETS] - 1, -1);
+   for (int i=0; i<pagecount; i++) {
+      pagelist[i] = createPage(inpages[i]);
+   }
+   for (int i=0; i<pagecount; i++) {
+      restoreParameters(inpages[i]);
+   }
+   for (int i=0; i<pagecount; i++) {
+      if (inpages[i].overlay) {
+         pageset.appendOverlay(pagelist[i]);
+      } else {
+         pageset.appendPage(pagelist[i]);
+      }
+   }
+   pageset.setPageOwnerships();
+
+   for (int i=0; i<pagecount; i++) {
+      restoreAnalyses(*pagelist[i], inpages[i]);
+   }
+
+   for (int i=0; i<counts[SECTION_SEGMENTS]; i++) {
+      const SegmentRecord& record = insegments[i];
+      AddressSystem start(record.start[0], record.start[1], record.start[2],
+            record.start[3]);
+      AddressSystem end(record.end[0], record.end[1], record.end[2],
+            record.end[3]);
+      pageset.createSegment(start, end);
+   }
+
+   pageset.completed_analyses.clear();
+   for (int i=0; i<counts[SECTION_ANALYSES]; i++) {
+      pageset.completed_analyses.push_back(getString(inanalyses[i]));
+   }
+   pageset.getPageStates(pageset.analyzed_pages);
+
+   clear();
+   return 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Protected functions:
+//
+
+//////////////////////////////
+//
+// ScoreCache::addString -- Return the index of a string in the string
+//     table, adding it to the table if it is not already there.
+//
+
+int ScoreCache::addString(const string& text) {
+   auto it = strings.find(text);
+   if (it != strings.end()) {
+      return it->second;
+   }
+   int index = (int)stringoffsets.size();
+   stringoffsets.push_back((uint32_t)stringdata.size());
+   stringdata.insert(stringdata.end(), text.begin(), text.end());
+   strings[text] = index;
+   return index;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::getItemIndex -- Return the index of an item in the list of
+//     all items of the page set, or -1 if the item is not in the set.
+//
+
+int ScoreCache::getItemIndex(const void* item) {
+   auto it = itemindex.find(item);
+   if (it == itemindex.end()) {
+      return -1;
+   }
+   return it->second;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::storePage -- Store the items of a page, the analysis
+//     results and which of the analyses are valid.
+//
+
+void ScoreCache::storePage(ScorePage& page, int overlay) {
+   PageRecord record;
+   memset(&record, 0, sizeof(record));
+   record.overlay   = overlay;
+   record.filepath  = addString(page.filename_path);
+   record.filebase  = addString(page.filename_base);
+   record.fileext   = addString(page.filename_extension);
+   record.pagestyle = page.ppmx_page_style;
+   for (int i=0; i<(int)PageAnalyses.size(); i++) {
+      if (page.analysis_info.isValid(PageAnalyses[i])) {
+         record.valid |= 1 << i;
+      }
+   }
+
+   record.itemstart = (int)items.size();
+   for (auto& it : page.item_storage) {
+      storeItem(it);
+   }
+   record.itemcount = (int)items.size() - record.itemstart;
+
+   record.trailerstart = (int)numbers.size();
+   for (int i=0; i<(int)page.trailer.size(); i++) {
+      numbers.push_back(page.trailer[i]);
+   }
+   record.trailercount = (int)page.trailer.size();
+
+   record.rowstart = (int)rows.size();
+   storeRows(page);
+   record.rowcount = (int)rows.size() - record.rowstart;
+
+   record.groupstart = (int)groups.size();
+   storeGroups(page);
+   record.groupcount = (int)groups.size() - record.groupstart;
+
+   record.partstart = (int)indexes.size();
+   for (int i=0; i<(int)page.segmentpart_map.size(); i++) {
+      indexes.push_back(page.segmentpart_map[i]);
+   }
+   record.partcount = (int)page.segmentpart_map.size();
+
+   pages.push_back(record);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::storeItem -- Store the fixed parameters, text and named
+//     parameters of an item.  Named parameters which point to other
+//     items are stored as item indexes.
+//
+
+void ScoreCache::storeItem(ScoreItem* item) {
+   ItemRecord record;
+   memset(&record, 0, sizeof(record));
+
+   record.fixedstart = (int)numbers.size();
+   record.fixedcount = (int)item->fixed_parameters.size();
+   for (int i=0; i<record.fixedcount; i++) {
+      numbers.push_back(item->fixed_parameters[i]);
+   }
+
+   NamedParameterStore& store = item->named_parameters;
+   record.namedstart = (int)named.size();
+   record.namedcount = store.getParameterCount();
+   for (int i=0; i<record.namedcount; i++) {
+      NamedRecord entry;
+      entry.nspace = addString(store.getNamespace(i));
+      entry.key    = addString(store.getKey(i));
+      entry.value  = addString(store.getValue(i));
+      entry.item   = -1;
+      if (store.isPointer(i)) {
+         entry.item = getItemIndex(store.getPointer(i));
+      }
+      named.push_back(entry);
+   }
+
+   record.text = item->fixed_text.empty() ? -1 : addString(item->fixed_text);
+   items.push_back(record);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::storeRows -- Store the rows of the page's analysis table.
+//
+
+void ScoreCache::storeRows(ScorePage& page) {
+   AnalysisTable& table = page.analysis_table;
+   for (int i=0; i<table.getRowCount(); i++) {
+      RowRecord record;
+      memset(&record, 0, sizeof(record));
+      record.item          = getItemIndex(table.items[i]);
+      record.fields        = table.fields[i];
+      record.unexported    = table.unexported[i];
+      record.base40        = table.base40[i];
+      record.layer         = table.layer[i];
+      record.staffoffset   = table.staffoffset[i];
+      record.staffduration = table.staffduration[i];
+      record.tiednext      = getItemIndex(table.tiednext[i]);
+      record.tiedlast      = getItemIndex(table.tiedlast[i]);
+      record.chordid       = table.chordid[i];
+      record.beamid        = table.beamid[i];
+      record.tupletid      = table.tupletid[i];
+      record.staffticks    = table.staffticks[i];
+      rows.push_back(record);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::storeGroups -- Store the chord, beam, tuplet and lyrics
+//     databases of the page.
+//
+
+void ScoreCache::storeGroups(ScorePage& page) {
+   vectorSIp empty;
+   for (int i=0; i<page.chord_database.getStaffCount(); i++) {
+      for (auto& it : page.chord_database.getChords(i)) {
+         storeGroup(GROUP_CHORD, i, empty, it, empty);
+      }
+   }
+   for (int i=0; i<page.beam_database.getStaffCount(); i++) {
+      for (auto& it : page.beam_database.getGroups(i)) {
+         storeGroup(GROUP_BEAM, i, it->beams, it->notes, empty);
+      }
+   }
+
+   // Beams with tuplet markings are linked to the tuplet group of their
+   // notes without being added to the brackets of the group.
+   unordered_map<TupletGroup*, vectorSIp> linked;
+   if (page.analysis_info.tupletsIsValid()) {
+      for (auto& it : page.item_storage) {
+         TupletGroup* group = page.tuplet_database.tupletInfo(it);
+         if (group && !it->isNoteOrRestItem() && !it->isTupletBracket()) {
+            linked[group].push_back(it);
+         }
+      }
+   }
+   for (int i=0; i<page.tuplet_database.getStaffCount(); i++) {
+      for (auto& it : page.tuplet_database.getGroups(i)) {
+         auto found = linked.find(it);
+         storeGroup(GROUP_TUPLET, i, it->brackets, it->notes,
+               found == linked.end() ? empty : found->second);
+      }
+   }
+
+   for (auto& it : page.lyrics_database.getLists()) {
+      storeGroup(GROUP_LYRICS, 0, empty, it, empty);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::storeGroup -- Store a group of items.  The head items
+//     (beams or tuplet brackets) are stored before the other items, and
+//     items which are linked to the group without being in its lists
+//     are stored after them.
+//
+
+void ScoreCache::storeGroup(int type, int staff, const vectorSIp& head,
+      const vectorSIp& list, const vectorSIp& linked) {
+   GroupRecord record;
+   memset(&record, 0, sizeof(record));
+   record.type      = type;
+   record.staff     = staff;
+   record.start     = (int)indexes.size();
+   record.headcount = (int)head.size();
+   record.count     = (int)(head.size() + list.size() + linked.size());
+   record.linkcount = (int)linked.size();
+   for (auto& it : head) {
+      indexes.push_back(getItemIndex(it));
+   }
+   for (auto& it : list) {
+      indexes.push_back(getItemIndex(it));
+   }
+   for (auto& it : linked) {
+      indexes.push_back(getItemIndex(it));
+   }
+   groups.push_back(record);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::readSections -- Check the header of a cache file and find
+//     the sections.  Returns false if the data is not a cache file with
+//     the given hash for this version of the library.
+//
+
+int ScoreCache::readSections(const char* data, size_t size, uint64_t hash) {
+   if (size < sizeof(Header)) {
+      return 0;
+   }
+   header = (const Header*)data;
+   if ((memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) != 0) ||
+         (header->version      != CACHE_VERSION) ||
+         (header->byteorder    != CacheByteOrder) ||
+         (header->hash         != hash) ||
+         (header->floatsize    != sizeof(SCORE_FLOAT)) ||
+         (header->sectioncount != SECTION_COUNT)) {
+      return 0;
+   }
+
+   const size_t recordsize[SECTION_COUNT] = {
+      sizeof(uint32_t), sizeof(char), sizeof(PageRecord), sizeof(ItemRecord),
+      sizeof(NamedRecord), sizeof(SCORE_FLOAT), sizeof(RowRecord),
+      sizeof(GroupRecord), sizeof(int32_t), sizeof(SegmentRecord),
+      sizeof(int32_t)
+   };
+   const char* start[SECTION_COUNT];
+   for (int i=0; i<SECTION_COUNT; i++) {
+      const Section& section = header->sections[i];
+      if ((section.offset % 8 != 0) || (section.offset > size) ||
+            (section.size > size - section.offset) ||
+            (section.size % recordsize[i] != 0) ||
+            (section.size / recordsize[i] > 0x7fffffff)) {
+         return 0;
+      }
+      start[i]  = data + section.offset;
+      counts[i] = (int)(section.size / recordsize[i]);
+   }
+
+   instringoffsets = (const uint32_t*)start[SECTION_STRINGOFFSETS];
+   instringdata    = start[SECTION_STRINGDATA];
+   inpages         = (const PageRecord*)start[SECTION_PAGES];
+   initems         = (const ItemRecord*)start[SECTION_ITEMS];
+   innamed         = (const NamedRecord*)start[SECTION_NAMED];
+   innumbers       = (const SCORE_FLOAT*)start[SECTION_NUMBERS];
+   inrows          = (const RowRecord*)start[SECTION_ROWS];
+   ingroups        = (const GroupRecord*)start[SECTION_GROUPS];
+   inindexes       = (const int32_t*)start[SECTION_INDEXES];
+   insegments      = (const SegmentRecord*)start[SECTION_SEGMENTS];
+   inanalyses      = (const int32_t*)start[SECTION_ANALYSES];
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::checkRecords -- Check that all of the indexes in the
+//     records are within the sections that they refer to, so that a
+//     damaged file cannot cause reading outside of the file.
+//
+
+int ScoreCache::checkRecords(void) {
+   int stringcount = counts[SECTION_STRINGOFFSETS] - 1;
+   if (stringcount < 0) {
+      return 0;
+   }
+   for (int i=0; i<stringcount; i++) {
+      if ((instringoffsets[i] > instringoffsets[i+1])) {
+         return 0;
+      }
+   }
+   if (instringoffsets[stringcount] > (uint32_t)counts[SECTION_STRINGDATA]) {
+      return 0;
+   }
+   auto isString = [&](int index) {
+      return (index >= 0) && (index < stringcount);
+   };
+   int itemcount = counts[SECTION_ITEMS];
+   auto isItem = [&](int index) {
+      return (index >= 0) && (index < itemcount);
+   };
+
+   int pagecount = counts[SECTION_PAGES];
+   if ((pagecount > 0) && inpages[0].overlay) {
+      return 0;
+   }
+   int nextitem = 0;
+   for (int i=0; i<pagecount; i++) {
+      const PageRecord& page = inpages[i];
+      if (!isString(page.filepath) || !isString(page.filebase) ||
+            !isString(page.fileext) || (page.itemstart != nextitem) ||
+            !inRange(page.itemstart, page.itemcount, itemcount) ||
+            !inRange(page.trailerstart, page.trailercount,
+                  counts[SECTION_NUMBERS]) ||
+            !inRange(page.rowstart, page.rowcount, counts[SECTION_ROWS]) ||
+            !inRange(page.groupstart, page.groupcount,
+                  counts[SECTION_GROUPS]) ||
+            !inRange(page.partstart, page.partcount,
+                  counts[SECTION_INDEXES])) {
+         return 0;
+      }
+      nextitem += page.itemcount;
+
+      // Rows and groups are only for items on the same page:
+      int itemend = page.itemstart + page.itemcount;
+      for (int j=page.rowstart; j<page.rowstart + page.rowcount; j++) {
+         const RowRecord& row = inrows[j];
+         if ((row.item < page.itemstart) || (row.item >= itemend) ||
+               ((row.tiednext != -1) && !isItem(row.tiednext)) ||
+               ((row.tiedlast != -1) && !isItem(row.tiedlast))) {
+            return 0;
+         }
+      }
+      for (int j=page.groupstart; j<page.groupstart + page.groupcount; j++) {
+         const GroupRecord& group = ingroups[j];
+         if ((group.type < GROUP_CHORD) || (group.type > GROUP_LYRICS) ||
+               (group.staff < 0) || (group.staff > 1000) ||
+               (group.headcount < 0) || (group.linkcount < 0) ||
+               (group.headcount + group.linkcount > group.count) ||
+               !inRange(group.start, group.count, counts[SECTION_INDEXES])) {
+            return 0;
+         }
+         for (int k=group.start; k<group.start + group.count; k++) {
+            if ((inindexes[k] < page.itemstart) || (inindexes[k] >= itemend)) {
+               return 0;
+            }
+         }
+      }
+   }
+   if (nextitem != itemcount) {
+      return 0;
+   }
+
+   for (int i=0; i<itemcount; i++) {
+      const ItemRecord& item = initems[i];
+      if (!inRange(item.fixedstart, item.fixedcount, counts[SECTION_NUMBERS]) ||
+            !inRange(item.namedstart, item.namedcount, counts[SECTION_NAMED]) ||
+            ((item.text != -1) && !isString(item.text))) {
+         return 0;
+      }
+   }
+   for (int i=0; i<counts[SECTION_NAMED]; i++) {
+      const NamedRecord& entry = innamed[i];
+      if (!isString(entry.nspace) || !isString(entry.key) ||
+            !isString(entry.value) ||
+            ((entry.item != -1) && !isItem(entry.item))) {
+         return 0;
+      }
+   }
+
+   for (int i=0; i<counts[SECTION_SEGMENTS]; i++) {
+      const SegmentRecord& segment = insegments[i];
+      for (const int32_t* address : {segment.start, segment.end}) {
+         if ((address[0] < 0) || (address[1] < 0) || (address[2] < 0) ||
+               (address[3] < 0)) {
+            return 0;
+         }
+      }
+   }
+   for (int i=0; i<counts[SECTION_ANALYSES]; i++) {
+      if (!isString(inanalyses[i])) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::getString -- Return a string from the string table of the
+//     file being read.
+//
+
+string ScoreCache::getString(int index) {
+   return string(instringdata + instringoffsets[index],
+         instringdata + instringoffsets[index+1]);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::getNameId -- Return the NamedParameterStore ID for a
+//     namespace or key in the string table of the file being read.
+//
+
+int ScoreCache::getNameId(int index) {
+   if (nameids[index] < 0) {
+      nameids[index] = NamedParameterStore::getNameId(getString(index));
+   }
+   return nameids[index];
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::createPage -- Create a page with the items and file
+//     information of a page record.  The named parameters are set later
+//     by restoreParameters().
+//
+
+ScorePage* ScoreCache::createPage(const PageRecord& record) {
+   ScorePage* page = new ScorePage;
+   page->filename_path      = getString(record.filepath);
+   page->filename_base      = getString(record.filebase);
+   page->filename_extension = getString(record.fileext);
+   page->ppmx_page_style    = record.pagestyle;
+
+   page->trailer.clear();
+   for (int i=0; i<record.trailercount; i++) {
+      page->trailer.push_back((float)innumbers[record.trailerstart + i]);
+   }
+
+   for (int i=0; i<record.itemcount; i++) {
+      const ItemRecord& itemrecord = initems[record.itemstart + i];
+      ScoreItem* item = page->item_pool.create();
+      item->fixed_parameters.resize(itemrecord.fixedcount);
+      for (int j=0; j<itemrecord.fixedcount; j++) {
+         item->fixed_parameters[j] = innumbers[itemrecord.fixedstart + j];
+      }
+      if (itemrecord.text >= 0) {
+         item->fixed_text = getString(itemrecord.text);
+      }
+      item->setPageOwner(page);
+      page->item_storage.push_back(item);
+      itemlist.push_back(item);
+   }
+   return page;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::restoreParameters -- Set the named parameters of the items
+//     on a page, in the order that they were originally set.
+//
+
+void ScoreCache::restoreParameters(const PageRecord& record) {
+   for (int i=record.itemstart; i<record.itemstart + record.itemcount; i++) {
+      const ItemRecord& itemrecord = initems[i];
+      NamedParameterStore& store = itemlist[i]->named_parameters;
+      for (int j=0; j<itemrecord.namedcount; j++) {
+         const NamedRecord& entry = innamed[itemrecord.namedstart + j];
+         int nsid  = getNameId(entry.nspace);
+         int keyid = getNameId(entry.key);
+         if (entry.item >= 0) {
+            store.setPointer(nsid, keyid, itemlist[entry.item]);
+         } else {
+            store.setString(nsid, keyid,
+                  instringdata + instringoffsets[entry.value],
+                  instringdata + instringoffsets[entry.value+1]);
+         }
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::restoreAnalyses -- Rebuild the sorted item lists of a page,
+//     then restore the analysis table, the page databases and the part
+//     map, and mark the restored analyses as valid.
+//
+
+void ScoreCache::restoreAnalyses(ScorePage& page, const PageRecord& record) {
+   vector<string> structure;
+   for (int i=0; i<StructureCount; i++) {
+      if (record.valid & (1 << i)) {
+         structure.push_back(PageAnalyses[i]);
+      }
+   }
+   if (!structure.empty()) {
+      page.analyze(structure);
+   }
+
+   AnalysisTable& table = page.analysis_table;
+   for (int i=record.rowstart; i<record.rowstart + record.rowcount; i++) {
+      const RowRecord& rowrecord = inrows[i];
+      ScoreItem* item = itemlist[rowrecord.item];
+      int row = table.getRow(item);
+      table.fields[row]        = rowrecord.fields;
+      table.unexported[row]    = rowrecord.unexported;
+      table.base40[row]        = rowrecord.base40;
+      table.layer[row]         = rowrecord.layer;
+      table.staffoffset[row]   = rowrecord.staffoffset;
+      table.staffduration[row] = rowrecord.staffduration;
+      table.tiednext[row] = rowrecord.tiednext < 0 ? NULL :
+            itemlist[rowrecord.tiednext];
+      table.tiedlast[row] = rowrecord.tiedlast < 0 ? NULL :
+            itemlist[rowrecord.tiedlast];
+      table.chordid[row]       = rowrecord.chordid;
+      table.beamid[row]        = rowrecord.beamid;
+      table.tupletid[row]      = rowrecord.tupletid;
+      table.staffticks[row]    = rowrecord.staffticks;
+      if (rowrecord.unexported) {
+         table.pending = true;
+      }
+      if (rowrecord.fields & AnalysisTable::FIELD_STAFFDURATION) {
+         page.setStaffDuration(item->getStaffNumber(), rowrecord.staffduration);
+      }
+   }
+
+   restoreGroups(page, record);
+
+   page.segmentpart_map.resize(record.partcount);
+   for (int i=0; i<record.partcount; i++) {
+      page.segmentpart_map[i] = inindexes[record.partstart + i];
+   }
+
+   uint32_t structuremask = (1 << StructureCount) - 1;
+   if ((record.valid & structuremask) != structuremask) {
+      return;
+   }
+   for (int i=StructureCount; i<RestoreCount; i++) {
+      if (record.valid & (1 << i)) {
+         page.analysis_info.setValid(PageAnalyses[i]);
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreCache::restoreGroups -- Restore the chord, beam, tuplet and lyrics
+//     databases of a page.
+//
+
+void ScoreCache::restoreGroups(ScorePage& page, const PageRecord& record) {
+   vectorSIp head;
+   vectorSIp list;
+   vectorSIp linked;
+   for (int i=record.groupstart; i<record.groupstart + record.groupcount; i++) {
+      const GroupRecord& group = ingroups[i];
+      head.clear();
+      list.clear();
+      linked.clear();
+      int liststop = group.count - group.linkcount;
+      for (int j=0; j<group.count; j++) {
+         ScoreItem* item = itemlist[inindexes[group.start + j]];
+         if (j < group.headcount) {
+            head.push_back(item);
+         } else if (j < liststop) {
+            list.push_back(item);
+         } else {
+            linked.push_back(item);
+         }
+      }
+      switch (group.type) {
+         case GROUP_CHORD:
+            page.chord_database.restoreChord(group.staff, list);
+            break;
+         case GROUP_BEAM:
+            page.beam_database.restoreGroup(group.staff, head, list);
+            break;
+         case GROUP_TUPLET:
+            page.tuplet_database.restoreGroup(group.staff, head, list,
+                  linked);
+            break;
+         case GROUP_LYRICS:
+            page.lyrics_database.restoreList(list);
+            break;
+      }
+   }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Static functions:
+//
+
+//////////////////////////////
+//
+// hashBytes -- Add bytes to a 64-bit FNV-1a hash.
+//
+
+static void hashBytes(uint64_t& hash, const char* data, size_t size) {
+   const unsigned char* bytes = (const unsigned char*)data;
+   for (size_t i=0; i<size; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// inRange -- Returns true if the records from start to start+count-1
+//     are within a section with the given number of records.
+//
+
+static int inRange(int start, int count, int size) {
+   return (start >= 0) && (count >= 0) && (start <= size) &&
+         (count <= size - start);
+}
+
+
+
+//////////////////////////////
+//
+// alignSection -- Round a file offset up to a multiple of 8 bytes.
+//
+
+static uint64_t alignSection(uint64_t offset) {
+   return (offset + 7) & ~(uint64_t)7;
+}
+
+
+
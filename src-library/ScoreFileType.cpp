@@ -0,0 +1,410 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 01:02:16 PDT 2026
+// Last Modified: Sun Oct 18 01:02:19 PDT 2026
+// Filename:      ScoreFileType.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreFileType.cpp
+// Syntax:        C++11
+//
+// Description:   Identify the type of SCORE data files without reading
+//                them completely (see ScoreFileType.h).
+//
+
+#include "ScoreFileType.h"
+#include "ScoreUtility.h"
+#include <algorithm>
+#include <string.h>
+#include <ctype.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// FILE_UNDECIDED is returned by classifyLine() and classifyText() when
+// more of the file has to be read to know its type.
+#define FILE_UNDECIDED -2
+
+// CLASSIFY_BLOCK_SIZE is the number of bytes read at a time from the
+// start of a file.  Usually the first block is enough.
+#define CLASSIFY_BLOCK_SIZE 4096
+
+
+//////////////////////////////
+//
+// ScoreFileType::classify -- Return the type of a file or of data in
+//     memory: FILE_BINARY if it ends with the binary SCORE trailer,
+//     FILE_PPMX if its first line which is not blank or a comment is a
+//     page marker ("RS" or "###ScorePage:"), FILE_PMX if that line is
+//     PMX data, and FILE_OTHER otherwise.  Files which cannot be opened
+//     are FILE_UNREADABLE.  Only the last four bytes and the first lines
+//     of a file are read (with pread(), so no stream is set up), but a
+//     PMX file with a page marker after its first page is not identified
+//     as FILE_PPMX.
+//
+
+int ScoreFileType::classify(const string& filename) {
+   int fd = ::open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      return FILE_UNREADABLE;
+   }
+   struct stat info;
+   if ((fstat(fd, &info) != 0) || !S_ISREG(info.st_mode)) {
+      ::close(fd);
+      return FILE_OTHER;
+   }
+   off_t filesize = info.st_size;
+
+   char trailer[4];
+   if ((filesize >= 4) && (pread(fd, trailer, 4, filesize - 4) == 4) &&
+         hasBinaryTrailer(trailer, 4)) {
+      ::close(fd);
+      return FILE_BINARY;
+   }
+
+   // Read blocks from the start of the file until a line gives the type.
+   // Lines which continue past the end of a block are kept for the next
+   // block.
+   vector<char> buffer;
+   off_t offset = 0;
+   int output = FILE_OTHER;
+   while (1) {
+      size_t kept = buffer.size();
+      buffer.resize(kept + CLASSIFY_BLOCK_SIZE);
+      ssize_t count = pread(fd, buffer.data() + kept, CLASSIFY_BLOCK_SIZE,
+            offset);
+      if (count < 0) {
+         count = 0;
+      }
+      buffer.resize(kept + count);
+      offset += count;
+      int lastQ = (count == 0) || (offset >= filesize);
+      size_t used = 0;
+      output = classifyText(buffer.data(), buffer.size(), used, lastQ);
+      if (output != FILE_UNDECIDED) {
+         break;
+      }
+      if (lastQ) {
+         output = FILE_OTHER;
+         break;
+      }
+      buffer.erase(buffer.begin(), buffer.begin() + used);
+   }
+   ::close(fd);
+   return output;
+}
+
+
+int ScoreFileType::classify(const char* data, size_t size) {
+   if (hasBinaryTrailer(data, size)) {
+      return FILE_BINARY;
+   }
+   size_t used = 0;
+   int output = classifyText(data, size, used, 1);
+   return output == FILE_UNDECIDED ? FILE_OTHER : output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::hasBinaryTrailer -- Returns true if the data ends with
+//     the bytes 00 3c 1c c6 (the float -9999.0) which is the last number
+//     of a binary SCORE file.
+//
+
+int ScoreFileType::hasBinaryTrailer(const char* data, size_t size) {
+   if (size < 4) {
+      return 0;
+   }
+   const unsigned char* ptr = (const unsigned char*)(data + size - 4);
+   return (ptr[0] == 0x00) && (ptr[1] == 0x3c) && (ptr[2] == 0x1c) &&
+         (ptr[3] == 0xc6);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::getTypeName -- Return a short name for a file type.
+//
+
+const char* ScoreFileType::getTypeName(int type) {
+   switch (type) {
+      case FILE_UNREADABLE: return "unreadable";
+      case FILE_BINARY:     return "binary";
+      case FILE_PMX:        return "pmx";
+      case FILE_PPMX:       return "ppmx";
+   }
+   return "other";
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::findFiles -- Add the files in a directory and its
+//     subdirectories to the list.  Files and directories whose names
+//     start with "." are skipped.  The directories on each level of the
+//     tree are read in parallel with the given number of threads (0 for
+//     one per processor core).  The files are listed in the order of a
+//     serial search: the files in a directory (sorted by name) followed
+//     by the files of each of its subdirectories.
+//
+
+void ScoreFileType::findFiles(const string& directory, vector<string>& files,
+      int threads) {
+   vector<vector<DirectoryEntry>> levels(1);
+   levels[0].resize(1);
+   levels[0][0].name = directory;
+
+   for (int i=0; !levels[i].empty(); i++) {
+      vector<DirectoryEntry>& level = levels[i];
+      SU::runParallel((int)level.size(), threads, [&](int index) {
+         listDirectory(level[index]);
+      });
+
+      vector<DirectoryEntry> nextlevel;
+      for (auto& it : level) {
+         it.children   = (int)nextlevel.size();
+         it.childcount = (int)it.subdirs.size();
+         for (auto& name : it.subdirs) {
+            nextlevel.push_back(DirectoryEntry());
+            nextlevel.back().name = name;
+         }
+         it.subdirs.clear();
+      }
+      levels.push_back(std::move(nextlevel));
+   }
+
+   addTreeFiles(levels, 0, 0, files);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::classifyFiles -- Classify a list of files (see
+//     classify()) using the given number of threads (0 for one per
+//     processor core).
+//
+
+void ScoreFileType::classifyFiles(const vector<string>& files,
+      vector<int>& types, int threads) {
+   types.resize(files.size());
+   SU::runParallel((int)files.size(), threads, [&](int index) {
+      types[index] = classify(files[index]);
+   });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Protected functions:
+//
+
+//////////////////////////////
+//
+// ScoreFileType::classifyLine -- Return the type of file given by a
+//     line of text: FILE_PPMX for a page marker, FILE_PMX for PMX data,
+//     FILE_UNDECIDED for blank lines and comments, and FILE_OTHER for
+//     anything else.  The page markers are the ones recognized by
+//     ScorePageSet::appendReadPmx().
+//
+
+int ScoreFileType::classifyLine(const char* line, const char* lineend) {
+   for (const char* ptr = line; ptr < lineend; ptr++) {
+      unsigned char ch = *ptr;
+      if ((ch < 0x20) && !isspace(ch)) {
+         // control characters (and nulls) are not found in text files.
+         return FILE_OTHER;
+      }
+   }
+
+   if ((lineend - line >= 2) && ((line[0] == 'R') || (line[0] == 'r')) &&
+         ((line[1] == 'S') || (line[1] == 's'))) {
+      return FILE_PPMX;
+   }
+   while ((line < lineend) && isspace((unsigned char)*line)) {
+      line++;
+   }
+   if (line >= lineend) {
+      return FILE_UNDECIDED;
+   }
+   if (*line == '#') {
+      if ((lineend - line >= 12) && (strncmp(line, "###ScorePage", 12) == 0)) {
+         return FILE_PPMX;
+      }
+      return FILE_UNDECIDED;
+   }
+
+   // A PMX data line is either a text item ("t" followed by numbers on
+   // the line and the text on the next line), or an item given as a list
+   // of numbers.
+   const char* token = line;
+   while ((line < lineend) && !isspace((unsigned char)*line)) {
+      line++;
+   }
+   if ((line - token == 1) && ((*token == 't') || (*token == 'T'))) {
+      return FILE_PMX;
+   }
+   if (!isNumber(token, line)) {
+      return FILE_OTHER;
+   }
+   while ((line < lineend) && isspace((unsigned char)*line)) {
+      line++;
+   }
+   token = line;
+   while ((line < lineend) && !isspace((unsigned char)*line)) {
+      line++;
+   }
+   if ((token < line) && !isNumber(token, line)) {
+      return FILE_OTHER;
+   }
+   return FILE_PMX;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::isNumber -- Returns true if the text is a number in
+//     the form used for PMX parameters: digits with an optional sign and
+//     decimal point.
+//
+
+int ScoreFileType::isNumber(const char* text, const char* textend) {
+   if ((text < textend) && ((*text == '-') || (*text == '+'))) {
+      text++;
+   }
+   int digits = 0;
+   int points = 0;
+   for ( ; text < textend; text++) {
+      if (isdigit((unsigned char)*text)) {
+         digits++;
+      } else if ((*text == '.') && (points == 0)) {
+         points++;
+      } else {
+         return 0;
+      }
+   }
+   return digits > 0;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::classifyText -- Return the type given by the first line
+//     of the text which is not blank or a comment (see classifyLine()),
+//     or FILE_UNDECIDED if there is no such line.  used is set to the
+//     number of bytes in the complete lines which were checked.  If
+//     lastQ is false, then the text is the start of a longer file, and
+//     a line at the end of the text without a newline is not checked.
+//
+
+int ScoreFileType::classifyText(const char* data, size_t size, size_t& used,
+      int lastQ) {
+   const char* ptr = data;
+   const char* end = data + size;
+   used = 0;
+   while (ptr < end) {
+      const char* lineend = (const char*)memchr(ptr, '\n', end - ptr);
+      if (lineend == NULL) {
+         if (!lastQ) {
+            break;
+         }
+         lineend = end;
+      }
+      int output = classifyLine(ptr, lineend);
+      if (output != FILE_UNDECIDED) {
+         return output;
+      }
+      ptr = lineend < end ? lineend + 1 : end;
+      used = ptr - data;
+   }
+   return FILE_UNDECIDED;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Private functions:
+//
+
+//////////////////////////////
+//
+// ScoreFileType::listDirectory -- Find the files and subdirectories of a
+//     directory, sorted by name.  Directories which cannot be read have
+//     no entries.
+//
+
+void ScoreFileType::listDirectory(DirectoryEntry& entry) {
+   DIR* dir = opendir(entry.name.c_str());
+   if (dir == NULL) {
+      return;
+   }
+   string prefix = entry.name;
+   if (prefix.empty() || (prefix.back() != '/')) {
+      prefix += "/";
+   }
+   struct dirent* item;
+   while ((item = readdir(dir)) != NULL) {
+      if (item->d_name[0] == '.') {
+         continue;
+      }
+      string name = prefix + item->d_name;
+      int fileQ = 0;
+      int dirQ  = 0;
+      #ifdef _DIRENT_HAVE_D_TYPE
+         // The entry type avoids a stat() of each file, except for
+         // symbolic links and filesystems which do not give it.
+         if (item->d_type == DT_REG) {
+            fileQ = 1;
+         } else if (item->d_type == DT_DIR) {
+            dirQ = 1;
+         } else if ((item->d_type == DT_LNK) || (item->d_type == DT_UNKNOWN)) {
+      #endif
+            struct stat info;
+            if (stat(name.c_str(), &info) == 0) {
+               fileQ = S_ISREG(info.st_mode);
+               dirQ  = S_ISDIR(info.st_mode);
+            }
+      #ifdef _DIRENT_HAVE_D_TYPE
+         }
+      #endif
+      if (fileQ) {
+         entry.files.push_back(name);
+      } else if (dirQ) {
+         entry.subdirs.push_back(name);
+      }
+   }
+   closedir(dir);
+   sort(entry.files.begin(), entry.files.end());
+   sort(entry.subdirs.begin(), entry.subdirs.end());
+}
+
+
+
+//////////////////////////////
+//
+// ScoreFileType::addTreeFiles -- Add the files of a directory found by
+//     findFiles() and then the files of its subdirectories to the list.
+//
+
+void ScoreFileType::addTreeFiles(vector<vector<DirectoryEntry>>& levels,
+      int level, int index, vector<string>& files) {
+   DirectoryEntry& entry = levels[level][index];
+   files.insert(files.end(), entry.files.begin(), entry.files.end());
+   entry.files.clear();
+   for (int i=0; i<entry.childcount; i++) {
+      addTreeFiles(levels, level + 1, entry.children + i, files);
+   }
+}
+
+
+
@@ -13,6 +13,7 @@
 //
 
 #include "ScoreItem.h"
+#include "ScorePageBase_AnalysisTable.h"
 #include <math.h>
 
 using namespace std;
@@ -652,7 +653,11 @@ RationalNumber ScoreItem::getDurationIncludingDots(void) {
 //
 
 void ScoreItem::setStaffOffsetDuration(SCORE_FLOAT duration) {
-//   staff_duration_offset = duration;
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setStaffOffsetDuration(this, duration);
+      return;
+   }
    setParameterNoisy(ns_auto, np_staffOffsetDuration, duration);
 }
 
@@ -667,12 +672,50 @@ void ScoreItem::setStaffOffsetDuration(SCORE_FLOAT duration) {
 //
 
 SCORE_FLOAT ScoreItem::getStaffOffsetDuration(void) {
-//   return staff_duration_offset;
+   AnalysisTable* table = getAnalysisTable();
+   SCORE_FLOAT output;
+   if ((table != NULL) && table->getStaffOffsetDuration(this, output)) {
+      return output;
+   }
    return getParameterDouble(ns_auto, np_staffOffsetDuration);
 }
 
 
 
+//////////////////////////////
+//
+// ScoreItem::setStaffOffsetTicks -- Set the durational offset from the
+//    start of the owning staff as an integer number of ticks (in units of
+//    ScorePage::getSystemTicksPerQuarter() for the system of the item).
+//    The value is only stored when the item is on a page.
+//
+
+void ScoreItem::setStaffOffsetTicks(int ticks) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setStaffOffsetTicks(this, ticks);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getStaffOffsetTicks -- Returns the durational offset of the
+//    ScoreItem in ticks, or -1 if it has not been analyzed.
+//
+
+int ScoreItem::getStaffOffsetTicks(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getStaffOffsetTicks(this, output)) {
+      return output;
+   }
+   return -1;
+}
+
+
+
 //////////////////////////////
 //
 // ScoreItem::operator== -- Returns true if the objects have the same values
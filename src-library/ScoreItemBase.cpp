@@ -11,7 +11,9 @@
 //
 
 #include "ScorePageBase.h"
+#include "ScorePmxWriter.h"
 #include "ScoreUtility.h"
+#include "NamedParameterStore.h"
 #include <stdlib.h>
 #include <string>
 #include <cstdint>
@@ -34,15 +36,22 @@ string ScoreItemBase::emptyString("");
 ScoreItemBase::ScoreItemBase(void) {
    page_owner       = NULL;
    staff_duration_offset = -1;
+   analysis_row     = -1;
 }
 
 
 ScoreItemBase::ScoreItemBase(const ScoreItemBase& anItem) {
+   if (anItem.page_owner != NULL) {
+      // Include any analysis results of the item in the copy.
+      ((ScorePageBase*)anItem.page_owner)->exportAnalysisParameters(
+            (ScoreItemBase*)&anItem);
+   }
    fixed_parameters = anItem.fixed_parameters;
    named_parameters = anItem.named_parameters;
    fixed_text       = anItem.fixed_text;
    page_owner       = NULL;
    staff_duration_offset = -1;
+   analysis_row     = -1;
 }
 
 
@@ -53,12 +62,14 @@ ScoreItemBase::ScoreItemBase(const vectorSF& parameters) {
          parameters.begin(), parameters.end());
    page_owner       = NULL;
    staff_duration_offset = -1;
+   analysis_row     = -1;
 }
 
 
 ScoreItemBase::ScoreItemBase(const string& stringitem) {
    page_owner = NULL;
    staff_duration_offset = -1;
+   analysis_row = -1;
    stringstream ss;
    ss << stringitem;
    readPmx(ss);
@@ -87,11 +98,16 @@ ScoreItemBase& ScoreItemBase::operator=(const ScoreItemBase& anItem) {
       return *this;
    }
 
+   if (anItem.page_owner != NULL) {
+      ((ScorePageBase*)anItem.page_owner)->exportAnalysisParameters(
+            (ScoreItemBase*)&anItem);
+   }
    fixed_parameters = anItem.fixed_parameters;
    named_parameters = anItem.named_parameters;
    fixed_text       = anItem.fixed_text;
    page_owner       = NULL;
    staff_duration_offset = -1;
+   analysis_row     = -1;
 
    return *this;
 }
@@ -126,18 +142,11 @@ void ScoreItemBase::clear(void) {
 
 const string& ScoreItemBase::getParameter(const string& nspace,
       const string& key) {
-   auto it = named_parameters.find(nspace);
-   if (it == named_parameters.end()) {
-      return emptyString;
-   }
-   auto it2 = it->second.find(key);
-   if (it2 == it->second.end()) {
+   int index = findNamedParameter(nspace, key);
+   if (index < 0) {
       return emptyString;
    }
-   return it2->second;
-
-   // This one-line version will create an empty value in the map:
-   // return named_parameters[nspace][key];
+   return named_parameters.getValue(index);
 }
 
 
@@ -147,34 +156,30 @@ const string& ScoreItemBase::getParameter(const string& key) {
 
 
 int ScoreItemBase::getParameterInt(const string& key) {
-   int value;
-   try {
-      value = stoi(getParameter(key));
-   } catch (invalid_argument& e) {
-      value = 0;
-   }
-   return value;
+   return getParameterInt("", key);
 }
 
 
 int ScoreItemBase::getParameterInt(const string& nspace, const string& key) {
-   int value;
-   try {
-      value = stoi(getParameter(nspace, key));
-   } catch (invalid_argument& e) {
-      value = 0;
+   // The integer value was calculated when the parameter was set.
+   int nsid = NamedParameterStore::findNameId(nspace);
+   int keyid = NamedParameterStore::findNameId(key);
+   if ((nsid < 0) || (keyid < 0)) {
+      return 0;
    }
-   return value;
+   return named_parameters.getInt(nsid, keyid);
 }
 
 
 bool ScoreItemBase::getParameterBool(const string& nspace, const string& key) {
-   if (!isDefined(nspace, key)) {
+   int index = findNamedParameter(nspace, key);
+   if (index < 0) {
       return false;
    }
-   if (getParameter(nspace, key) == "false") {
+   const string& value = named_parameters.getValue(index);
+   if (value == "false") {
       return false;
-   } else if (getParameter(nspace, key) == "0") {
+   } else if (value == "0") {
       return false;
    }
 
@@ -198,31 +203,55 @@ bool ScoreItemBase::getParameterBoolean(const string& key) {
 
 
 double ScoreItemBase::getParameterDouble(const string& key) {
-   double value;
-   try {
-      value = stod(getParameter(key));
-   } catch (invalid_argument& e) {
-      value = 0.0;
-   } catch (const std::out_of_range& e) {
-      // this is a case where there is an exponent such as e-312, so set to 0:
-      value = 0.0;
-   }
-   return value;
+   return getParameterDouble("", key);
 }
 
 
 double ScoreItemBase::getParameterDouble(const string& nspace,
       const string& key) {
-   double value;
-   try {
-      value = stod(getParameter(nspace, key));
-   } catch (invalid_argument& e) {
-      value = 0.0;
-   } catch (const std::out_of_range& e) {
-      // this is a case where there is an exponent such as e-312, so set to 0:
-      value = 0.0;
+   // The floating-point value was calculated when the parameter was set
+   // (values out of range, such as an exponent of e-312, are set to 0).
+   int nsid = NamedParameterStore::findNameId(nspace);
+   int keyid = NamedParameterStore::findNameId(key);
+   if ((nsid < 0) || (keyid < 0)) {
+      return 0.0;
+   }
+   return named_parameters.getDouble(nsid, keyid);
+}
+
+
+void* ScoreItemBase::getParameterPointer(const string& nspace,
+      const string& key) {
+   int nsid = NamedParameterStore::findNameId(nspace);
+   int keyid = NamedParameterStore::findNameId(key);
+   if ((nsid < 0) || (keyid < 0)) {
+      return NULL;
+   }
+   return named_parameters.getPointer(nsid, keyid);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemBase::findNamedParameter -- Return the index of a named
+//     parameter in named_parameters, or -1 if it is not defined.
+//
+
+int ScoreItemBase::findNamedParameter(const string& nspace,
+      const string& key) const {
+   if (named_parameters.empty()) {
+      return -1;
    }
-   return value;
+   int nsid = NamedParameterStore::findNameId(nspace);
+   if (nsid < 0) {
+      return -1;
+   }
+   int keyid = NamedParameterStore::findNameId(key);
+   if (keyid < 0) {
+      return -1;
+   }
+   return named_parameters.find(nsid, keyid);
 }
 
 
@@ -408,25 +437,28 @@ SCORE_FLOAT ScoreItemBase::getParameterFraction(int pindex) {
 
 void ScoreItemBase::setParameterQuiet(const string& nspace, const string& key,
       const string& value) {
-   named_parameters[nspace][key] = value;
+   named_parameters.setString(NamedParameterStore::getNameId(nspace),
+         NamedParameterStore::getNameId(key), value);
 }
 
 
 void ScoreItemBase::setParameterQuiet(const string& nspace, const string& key,
       int value) {
-   named_parameters[nspace][key] = to_string(value);
+   named_parameters.setInt(NamedParameterStore::getNameId(nspace),
+         NamedParameterStore::getNameId(key), value);
 }
 
 
 void ScoreItemBase::setParameterQuiet(const string& nspace, const string& key,
       SCORE_FLOAT value) {
-   named_parameters[nspace][key] = to_string(value);
+   setParameterQuiet(nspace, key, to_string(value));
 }
 
 
 void ScoreItemBase::setParameterQuiet(const string& nspace, const string& key,
       void* pointer) {
-   named_parameters[nspace][key] = to_string((uint64_t)pointer);
+   named_parameters.setPointer(NamedParameterStore::getNameId(nspace),
+         NamedParameterStore::getNameId(key), pointer);
 }
 
 
@@ -446,7 +478,8 @@ void ScoreItemBase::setParameterNoisy(const string& nspace, const string& key,
 
 void ScoreItemBase::setParameterNoisy(const string& nspace, const string& key,
       int value) {
-   setParameterNoisy(nspace, key, to_string(value));
+   setParameterQuiet(nspace, key, value);
+   notifyPageOfChange("named");
 }
 
 
@@ -465,7 +498,7 @@ void ScoreItemBase::setParameterNoisy(const string& key, const string& value) {
 
 
 void ScoreItemBase::setParameterNoisy(const string& key, int value) {
-   setParameterNoisy("", key, to_string(value));
+   setParameterNoisy("", key, value);
 }
 
 
@@ -500,7 +533,7 @@ void ScoreItemBase::setParameterNoisy(int index, SCORE_FLOAT value) {
 
 void ScoreItemBase::setParameterNoisy(const string& nspace, const string& key,
       void* pointer) {
-   named_parameters[nspace][key] = to_string((uint64_t)pointer);
+   setParameterQuiet(nspace, key, pointer);
    notifyPageOfChange("named");
 }
 
@@ -640,8 +673,10 @@ void ScoreItemBase::addNamedParameters(mapNamespace& input) {
    mapNamespace::iterator it;
    mapSS::iterator its;
    for (it = input.begin(); it != input.end(); it++) {
+      int nsid = NamedParameterStore::getNameId(it->first);
       for (its = it->second.begin(); its != it->second.end(); its++) {
-         named_parameters[it->first][its->first] = its->second;
+         named_parameters.setString(nsid,
+               NamedParameterStore::getNameId(its->first), its->second);
       }
    }
 }
@@ -657,7 +692,7 @@ void ScoreItemBase::addNamedParameters(mapNamespace& input) {
 
 int ScoreItemBase::hasParameter(const string& nspace,
       const string& testkey) {
-   return named_parameters[nspace].count(testkey);
+   return findNamedParameter(nspace, testkey) >= 0;
 }
 
 
@@ -687,7 +722,10 @@ int ScoreItemBase::isDefined(const string& testkey) {
 //
 
 void ScoreItemBase::deleteNamespace(const string& nspace) {
-   named_parameters.erase(nspace);
+   int nsid = NamedParameterStore::findNameId(nspace);
+   if (nsid >= 0) {
+      named_parameters.eraseNamespace(nsid);
+   }
    notifyPageOfChange("named");
 }
 
@@ -728,7 +766,11 @@ int ScoreItemBase::changeNamespace(const string& newspace,
 //
 
 void ScoreItemBase::deleteParameter(const string& nspace, const string& key) {
-   named_parameters[nspace].erase(key);
+   int nsid = NamedParameterStore::findNameId(nspace);
+   int keyid = NamedParameterStore::findNameId(key);
+   if ((nsid >= 0) && (keyid >= 0)) {
+      named_parameters.erase(nsid, keyid);
+   }
    notifyPageOfChange("named");
 }
 
@@ -788,7 +830,7 @@ int ScoreItemBase::getCompactFixedParameterCount(void) {
 //
 
 int ScoreItemBase::getNamespaceCount(void) const {
-   return named_parameters.size();
+   return named_parameters.getNamespaceCount();
 }
 
 
@@ -799,12 +841,16 @@ int ScoreItemBase::getNamespaceCount(void) const {
 //
 
 int ScoreItemBase::getNamedParameterCount(const string& nspace) {
-   return named_parameters[nspace].size();
+   int nsid = NamedParameterStore::findNameId(nspace);
+   if (nsid < 0) {
+      return 0;
+   }
+   return named_parameters.getParameterCount(nsid);
 }
 
 
 int ScoreItemBase::getNamedParameterCount(void) {
-   return named_parameters[""].size();
+   return getNamedParameterCount("");
 }
 
 
@@ -827,15 +873,7 @@ int ScoreItemBase::getNamedParameterSize(void) {
 //
 
 int ScoreItemBase::countAllNamedParameters(void) {
-   int output = 0;
-
-   mapNamespace& np = named_parameters;
-   mapNamespace::iterator it;
-   for (it = np.begin(); it != np.end(); it++) {
-      output += it->second.size();
-   }
-
-   return output;
+   return named_parameters.getParameterCount();
 }
 
 
@@ -881,85 +919,43 @@ void ScoreItemBase::notifyPageOfChange(const string& message, int index,
 // ScoreItemBase writing functions.
 //
 
+// PmxWriter holds the PMX text of an item until it is written (one buffer
+// for each thread, so that its memory is reused).
+static thread_local ScorePmxWriter PmxWriter;
+
 
 //////////////////////////////
 //
 // ScoreItemBase::printPmx -- print the ScoreItemBase as ASCII PMX text.  The
 //     fixed parameters are listed on a single line as floats (doubles).  The
 //     named parameters are given one on each following line prefixed with @
-//     and separated by a colon and space(s) after the key name.
+//     and separated by a colon and space(s) after the key name.  The
+//     text is made with a ScorePmxWriter and written to the stream in
+//     one write.
 //
 
 ostream& ScoreItemBase::printPmx(ostream& out) {
-   printPmxFixedParameters(out);
-   printPmxNamedParameters(out);
-   return out;
+   PmxWriter.appendFixedParameters(*this);
+   PmxWriter.appendNamedParameters(*this, 1);
+   return PmxWriter.write(out);
 }
 
 
 ostream& ScoreItemBase::printPmxFixedParameters(ostream& out) {
-   int count = getCompactFixedParameterCount();
-   // print the first number, using "t" if P1
-   SCORE_FLOAT p1 = getP1();
-   if (((int)p1) == 16) {
-      out << 't';
-   } else {
-      out << p1;
-   }
-   int i;
-   SCORE_FLOAT value;
-   for (i=P2; i<=count; i++) {
-      value = getParameter(i);
-      if (fabs(value) < 0.000001) {
-         value = 0.0;
-      }
-      out << ' ' << value;
-   }
-   out << '\n';
-   // if P1==15|16, then print the text associated with it here.
-   if ((p1 == 16) | (p1 == 15)) {
-      out << getFixedText() << '\n';
-   }
-   return out;
+   PmxWriter.appendFixedParameters(*this);
+   return PmxWriter.write(out);
 }
 
 
 ostream& ScoreItemBase::printPmxNamedParameters(ostream& out) {
-   mapNamespace& np = named_parameters;
-   mapNamespace::iterator it;
-   mapSS::iterator its;
-   for (it = np.begin(); it != np.end(); it++) {
-      for (its = it->second.begin(); its != it->second.end(); its++) {
-         if (it->first == "") {
-            out << '@' << its->first << ":\t" << its->second << endl;
-         } else {
-            out << '@' << it->first << "@" << its->first
-                << ":\t" << its->second << endl;
-         }
-      }
-   }
-   return out;
+   PmxWriter.appendNamedParameters(*this, 1);
+   return PmxWriter.write(out);
 }
 
 
 ostream& ScoreItemBase::printPmxNamedParametersNoAuto(ostream& out) {
-   mapNamespace& np = named_parameters;
-   mapNamespace::iterator it;
-   mapSS::iterator its;
-   for (it = np.begin(); it != np.end(); it++) {
-      if (it->first == ns_auto) {
-         continue;
-      }
-      for (its = it->second.begin(); its != it->second.end(); its++) {
-         if (it->first == "") {
-            out << '@' << its->first << ":\t" << its->second << endl;
-         } else {
-            out << '@' << it->first << "@" << its->first
-                << ":\t" << its->second << endl;
-         }
-      }
-   }
-   return out;
+   PmxWriter.appendNamedParameters(*this, 0);
+   return PmxWriter.write(out);
 }
 
 
@@ -974,6 +970,10 @@ ostream& ScoreItemBase::printPmxNamedParametersNoAuto(ostream& out) {
 
 ostream& ScoreItemBase::printXml(ostream& out, int indentcount,
       const string& indentstring) {
+   if (page_owner != NULL) {
+      // Copy any analysis results of the page into the auto namespace.
+      ((ScorePageBase*)page_owner)->exportAnalysisParameters();
+   }
 
    printIndent(out, indentcount, indentstring);
    printFixedListPieceXml(out);
@@ -989,22 +989,18 @@ ostream& ScoreItemBase::printXml(ostream& out, int indentcount,
       printIndent(out, indentcount+1, indentstring);
       out << "<named-parameters>\n";
 
-      mapNamespace& np = named_parameters;
-      mapNamespace::iterator it;
-      int npcount;
-      for (it = np.begin(); it != np.end(); it++) {
-         npcount = getNamedParameterCount(it->first);
-         if (npcount > 0) {
-            printIndent(out, indentcount+2, indentstring);
-            out << "<namespace scope=\"";
-            out << it->first;
-            out << "\">\n";
-               printNamedParametersXml(out, it->first, indentcount+3,
-                  indentstring);
-            printIndent(out, indentcount+2, indentstring);
-            out << "</namespace>\n";
-         }
-
+      vector<int> nsids;
+      named_parameters.getNamespaces(nsids);
+      for (int nsid : nsids) {
+         const string& nspace = NamedParameterStore::getName(nsid);
+         printIndent(out, indentcount+2, indentstring);
+         out << "<namespace scope=\"";
+         out << nspace;
+         out << "\">\n";
+            printNamedParametersXml(out, nspace, indentcount+3,
+               indentstring);
+         printIndent(out, indentcount+2, indentstring);
+         out << "</namespace>\n";
       }
 
       printIndent(out, indentcount+1, indentstring);
@@ -1061,14 +1057,19 @@ ostream& ScoreItemBase::printFixedListPieceXml(ostream& out) {
 ostream& ScoreItemBase::printNamedParametersXml(ostream& out,
       const string& nspace, int indentcount, const string& indentstring) {
 
-   mapSS& np = named_parameters[nspace];
-   mapSS::iterator it;
-   for (it = np.begin(); it != np.end(); it++) {
+   int nsid = NamedParameterStore::findNameId(nspace);
+   if (nsid < 0) {
+      return out;
+   }
+   NamedParameterStore& np = named_parameters;
+   vector<int> order;
+   np.getSortedParameters(order, nsid);
+   for (int i : order) {
       printIndent(out, indentcount, indentstring);
       out << "<parameter name=\"";
-      SU::printXmlTextEscapedUTF8(out, it->first);
+      SU::printXmlTextEscapedUTF8(out, np.getKey(i));
       out << "\" value=\"";
-      SU::printXmlTextEscapedUTF8(out, it->second);
+      SU::printXmlTextEscapedUTF8(out, np.getValue(i));
       out << "\" />";
       out << endl;
    }
@@ -1219,6 +1220,79 @@ void ScoreItemBase::readBinary(istream& instream, int pcount) {
 
 
 
+//////////////////////////////
+//
+// ScoreItemBase::readBinary -- Read one item from a block of binary SCORE
+//    data which is already in memory.  The values array contains the
+//    4-byte numbers of the item already converted to floating-point values
+//    (see ScorePageBase::decodeLittleFloats), and bytes points to the
+//    same data in its raw form, needed for the text of P1=16 items.
+//    The available parameter is the number of 4-byte values remaining in
+//    the data block.  Returns the number of 4-byte values occupied by the
+//    item's data.
+//
+
+int ScoreItemBase::readBinary(const SCORE_FLOAT* values, const char* bytes,
+      int pcount, int available) {
+   int i;
+   if ((pcount < 1) || (pcount > available)) {
+      cout << "Error: invalid parameter count: " << pcount << endl;
+      exit(1);
+   }
+
+   SCORE_FLOAT value;
+   vectorSF& fp = fixed_parameters;
+   if (((int)values[0] == P1_Text) && (available >= P13)) {
+      fp.assign(P13+1, 0.0);
+      for (i=P1; i<P14; i++) {
+         value = values[i-1];
+         if ((value < 0.0001) && (value > -0.0001)) {
+            value = 0;
+         }
+         fp[i] = value;
+      }
+      int count = (int)fp[P12];
+      if (count < 0) {
+         count = 0;
+      }
+      int words = (count + 3) / 4;
+      if (words > available - P13) {
+         words = available - P13;
+      }
+      if (count > 4 * words) {
+         count = 4 * words;
+      }
+      if (count > 1000) {
+         count = 1000;
+      }
+      const char* text = bytes + 4 * (P14-1);
+      int length = 0;
+      while ((length < count) && (text[length] != '\0')) {
+         length++;
+      }
+      fixed_text.assign(text, length);
+      return P13 + words;
+   }
+
+   // non-text data parameters
+   if (pcount > SCORE_MAX_FIXED_PARAMETERS) {
+      cerr << "ERROR: too large an index: " << pcount << endl;
+      exit(1);
+   }
+   fp.resize(pcount+1);
+   fp[0] = 0.0;
+   for (i=P1; i<=pcount; i++) {
+      value = values[i-1];
+      if ((value < 0.0001) && (value > -0.0001)) {
+         value = 0;
+      }
+      fp[i] = value;
+   }
+   return pcount;
+}
+
+
+
 ///////////////////////////////
 //
 // ScoreItemBase::readLittleEndianFloat --
@@ -1286,6 +1360,49 @@ double ScoreItemBase::roundFractionDigits(double number, int digits) {
 //
 
 int ScoreItemBase::writeBinary(ostream& out) {
+   static thread_local vector<char> buffer;
+   buffer.resize(4 * getBinaryWordCount());
+   int output = encodeBinary(buffer.data());
+   out.write(buffer.data(), 4 * output);
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemBase::getBinaryWordCount -- Return the number of four-byte
+//    units which writeBinary() will write for the item.
+//
+
+int ScoreItemBase::getBinaryWordCount(void) {
+   int fixedcount = getCompactFixedParameterCount();
+   if (fixedcount < 1) {
+      return 0;
+   }
+   if ((getPInt(P1) == P1_ImportedEPSGraphic) || (getPInt(P1) == P1_Text)) {
+      // 13 parameters and the filename/text padded to a multiple of four
+      // bytes:
+      return 13 + ((int)getFixedText().size() + 3) / 4 + 1;
+   }
+   // WinScore can't understand data fields smaller than 3
+   if (fixedcount < 3) {
+      fixedcount = 3;
+   }
+   return fixedcount + 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemBase::encodeBinary -- Store the binary data of the item (see
+//    writeBinary()) in bytes, which must have room for the number of
+//    four-byte units given by getBinaryWordCount().  Returns the number
+//    of four-byte units stored.
+//
+
+int ScoreItemBase::encodeBinary(char* bytes) {
    int fixedcount = getCompactFixedParameterCount();
    if (fixedcount < 1) {
       return 0;
@@ -1296,8 +1413,11 @@ int ScoreItemBase::writeBinary(ostream& out) {
       fixedcount = 3;
    }
 
-   int i;
-   if ((getPInt(P1) == P1_ImportedEPSGraphic) || (getPInt(P1) == P1_Text)) {
+   int textQ = (getPInt(P1) == P1_ImportedEPSGraphic) ||
+               (getPInt(P1) == P1_Text);
+   int wordsize = fixedcount;
+   int pad = 0;
+   if (textQ) {
       // process a EPS file item or Text item.
 
       // There must be 13 parameters before the name of the file or the text.
@@ -1306,37 +1426,67 @@ int ScoreItemBase::writeBinary(ostream& out) {
       // text is stored in fixed_text, but need to add extra spaces after
       // filename/text to make the length of the filename/text be a multiple
       // of four bytes
-      int pad = getFixedText().size() % 4;
+      pad = getFixedText().size() % 4;
       if (pad > 0) {
          pad = 4 - pad;
       }
+      wordsize = fixedcount + (getFixedText().size() + pad) / 4;
+   }
 
-      float wordsize = fixedcount + (getFixedText().size() + pad) / 4;
+   // The total number of 4-byte words to follow in item, and then the
+   // fixed parameters.
+   SCORE_FLOAT values[SCORE_MAX_FIXED_PARAMETERS + 1];
+   values[0] = wordsize;
+   for (int i=1; i<=fixedcount; i++) {
+      values[i] = getP(i);
+   }
+   ScorePageBase::encodeLittleFloats(values, fixedcount + 1, bytes);
+
+   if (textQ) {
+      // write filename/text string and padding after it:
+      char* ptr = bytes + 4 * (fixedcount + 1);
+      const string& text = getFixedText();
+      memcpy(ptr, text.data(), text.size());
+      memset(ptr + text.size(), ' ', pad);
+   }
+   return wordsize + 1;
+}
 
-      // write the total number of 4-byte words to follow in item:
-      writeLittleEndianFloat(out, wordsize);
 
-      for (i=1; i<=fixedcount; i++) {
-         writeLittleEndianFloat(out, getP(i));
-      }
 
-      // write filename/text string:
-      out << getFixedText();
+//////////////////////////////
+//
+// ScoreItemBase::readNamedParameter -- Read input lines such as:
+//    @namespace@key: value
+// For PMX data named parameters.
+//
+
+void ScoreItemBase::readNamedParameter(mapNamespace& np, char* input) {
+   readNamedParameter(np, input, input + strlen(input));
+}
 
-      // write padding after filename/text string:
-      for (i=0; i<pad; i++) {
-         out << ' ';
-      }
-      return wordsize + 1;
 
-   } else {
-      // SCORE items which do not include a text field:
-      writeLittleEndianFloat(out, fixedcount);
+void ScoreItemBase::readNamedParameter(mapNamespace& np, const char* input,
+      const char* end) {
+   string nspace;
+   string key;
+   const char* value;
+   const char* vend;
+   if (parseNamedParameter(input, end, nspace, key, value, vend)) {
+      np[nspace][key].assign(value, vend);
+   }
+}
 
-      for (i=1; i<=fixedcount; i++) {
-         writeLittleEndianFloat(out, getP(i));
-      }
-      return fixedcount + 1;
+
+void ScoreItemBase::readNamedParameter(NamedParameterStore& np,
+      const char* input, const char* end) {
+   string nspace;
+   string key;
+   const char* value;
+   const char* vend;
+   if (parseNamedParameter(input, end, nspace, key, value, vend)) {
+      np.setString(NamedParameterStore::getNameId(nspace),
+            NamedParameterStore::getNameId(key), value, vend);
    }
 }
 
@@ -1344,130 +1494,74 @@ int ScoreItemBase::writeBinary(ostream& out) {
 
 //////////////////////////////
 //
-// ScoreItemBase::readNamedParameter -- Read input lines such as:
-//    @namespace@key: value
-// For PMX data named parameters.
+// ScoreItemBase::parseNamedParameter -- Split a named parameter line
+//     into its namespace, key and value.  Returns false if the line
+//     is not a valid named parameter.
 //
 
-void ScoreItemBase::readNamedParameter(mapNamespace& np, char* input) {
-   int len = strlen(input);
-   char* buf1 = new char[len+4];
-   char* buf2 = new char[len+4];
-   char* buf3 = new char[len+4];
-   const char* nspace = NULL;
-   const char* key = NULL;
-   const char* value = NULL;
-   int i1 = 0;  // write index for namespace string
-   int i2 = 0;  // write index for key string
-   int i3 = 0;  // write index for value string
-
-   buf1[i1] = '\0';
-   buf2[i2] = '\0';
-   buf3[i3] = '\0';
-
+int ScoreItemBase::parseNamedParameter(const char* input, const char* end,
+      string& nspace, string& key, const char*& value, const char*& vend) {
+   string part1;  // text after first at-sign (namespace or key)
+   string part2;  // text after second at-sign (key)
    int atcount = 0;
-   int atloc[2];
-   atloc[0] = -1;
-   atloc[1] = -1;
-   int temps = atloc[0];  // prevent invalid warning in compiler
-   atloc[0] = temps;      // prevent invalid warning in compiler
 
    // find first two at-signs:
-   int i;
-   for (i=0; i<len; i++) {
-      if (input[i] == ':') {
-         // Either the end of the @namespace@key: sequence, or not 
+   const char* ptr;
+   for (ptr = input; ptr < end; ptr++) {
+      if (*ptr == ':') {
+         // Either the end of the @namespace@key: sequence, or not
          // allowed to have colon in namespace string (or key):
          break;
       }
-      if (input[i] == '@') {
-         atloc[atcount++] = i;
-         if (atcount > 2) {
+      if (*ptr == '@') {
+         if (++atcount > 2) {
             // can't have @ sign in namespace or key, ignore parameter:
-            delete [] buf1;
-            delete [] buf2;
-            delete [] buf3;
-            return;
+            return 0;
          }
          continue;
       }
-      if (std::isspace(input[i])) {
+      if (std::isspace(*ptr)) {
          // ignore spaces in namespace or key:
          continue;
       }
-
       if (atcount == 1) {
-         buf1[i1++] = input[i];
-         buf1[i1] = '\0';
+         part1.push_back(*ptr);
       } else if (atcount == 2) {
-         buf2[i2++] = input[i];
-         buf2[i2] = '\0';
+         part2.push_back(*ptr);
       }
    }
 
    if (atcount == 0) {
       // Not a named parameter; do nothing.
-      delete [] buf1;
-      delete [] buf2;
-      delete [] buf3;
-      return;
+      return 0;
    }
 
    // should pointing to colon, exit function if not:
-   if (input[i] != ':') {
-      delete [] buf1;
-      delete [] buf2;
-      delete [] buf3;
-      return;
+   if ((ptr >= end) || (*ptr != ':')) {
+      return 0;
    }
 
    // skip any whitespace at start of value:
-   while (++i<len) {
-      if (!std::isspace(input[i])) {
-         break;
-      }
-   }
-
-   // copy value into buf3:
-   while (i<len) {
-      buf3[i3++] = input[i];
-      buf3[i3] = '\0';
-      i++;
+   while ((++ptr < end) && std::isspace(*ptr)) {
+      // do nothing
    }
 
    // trim space off of end of value
-   while (--i3 > 0) {
-      if (std::isspace(buf3[i3])) {
-         buf3[i3] = '\0';
-      } else {
-         break;
-      }
+   value = ptr;
+   vend  = end;
+   while ((vend - ptr > 1) && std::isspace(vend[-1])) {
+      vend--;
    }
 
-   if (atcount == 1) {
-      // global namespace (empty string):
-      nspace = buf2;
-      key = buf1;
-   } else {
-      nspace = buf1;
-      key = buf2;
-   }
-   value = buf3;
+   nspace = (atcount == 1) ? part2 : part1;
+   key    = (atcount == 1) ? part1 : part2;
 
-   if (key[0] == '\0') {
+   if (key.empty()) {
       // Don't allow a null key string
-      delete [] buf1;
-      delete [] buf2;
-      delete [] buf3;
-      return;
+      return 0;
    }
 
-   // Store the parameter:
-   np[nspace][key] = value;
-
-   delete [] buf1;
-   delete [] buf2;
-   delete [] buf3;
+   return 1;
 }
 
 
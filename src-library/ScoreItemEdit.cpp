@@ -93,12 +93,17 @@ void ScoreItemEdit::clearHistory(void) {
 //
 
 void ScoreItemEdit::deleteNamespace(const string& nspace) {
-   mapSS& params = named_parameters[nspace];
-   for (auto& it : params) {
-      history_list.emplace_back(nspace, it.first, it.second,
-            SCOREITEM_DELETED, history_index);
+   int nsid = NamedParameterStore::findNameId(nspace);
+   if (nsid < 0) {
+      return;
+   }
+   vector<int> params;
+   named_parameters.getSortedParameters(params, nsid);
+   for (int i : params) {
+      history_list.emplace_back(nspace, named_parameters.getKey(i),
+            named_parameters.getValue(i), SCOREITEM_DELETED, history_index);
    }
-   named_parameters.erase(nspace);
+   named_parameters.eraseNamespace(nsid);
 }
 
 // Aliases for above function:
@@ -344,21 +349,18 @@ ostream& ScoreItemEdit::printXmlWithEdits(ostream& out, int indentcount,
       printIndent(out, indentcount+1, indentstring);
       out << "<named-parameters>\n";
 
-      mapNamespace& np = named_parameters;
-      int npcount;
-      for (auto &it : np) {
-         npcount = getNamedParameterCount(it.first);
-         if (npcount > 0) {
-            printIndent(out, indentcount+2, indentstring);
-            out << "<namespace scope=\"";
-            out << it.first;
-            out << "\">\n";
-               printNamedParametersXml(out, it.first, indentcount+3,
-                  indentstring);
-            printIndent(out, indentcount+2, indentstring);
-            out << "</namespace>\n";
-         }
-
+      vector<int> nsids;
+      named_parameters.getNamespaces(nsids);
+      for (int nsid : nsids) {
+         const string& nspace = NamedParameterStore::getName(nsid);
+         printIndent(out, indentcount+2, indentstring);
+         out << "<namespace scope=\"";
+         out << nspace;
+         out << "\">\n";
+            printNamedParametersXml(out, nspace, indentcount+3,
+               indentstring);
+         printIndent(out, indentcount+2, indentstring);
+         out << "</namespace>\n";
       }
 
       printIndent(out, indentcount+1, indentstring);
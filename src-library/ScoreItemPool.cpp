@@ -0,0 +1,137 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 21:22:09 PDT 2026
+// Last Modified: Sat Oct 17 21:22:12 PDT 2026
+// Filename:      ScoreItemPool.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreItemPool.cpp
+// Syntax:        C++11
+//
+// Description:   Slab allocator for the ScoreItems owned by a page.  Items
+//                are constructed in large blocks of memory rather than
+//                being allocated one at a time, and all of the items are
+//                released together when the pool is cleared.
+//
+
+#include "ScoreItemPool.h"
+#include "ScoreProfile.h"
+#include <new>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScoreItemPool::ScoreItemPool -- Constructor.
+//
+
+ScoreItemPool::ScoreItemPool(void) {
+   used  = 0;
+   count = 0;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemPool::~ScoreItemPool -- Deconstructor.
+//
+
+ScoreItemPool::~ScoreItemPool() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemPool::create -- Construct a new item in the pool.  The item
+//    must not be deleted: it will be destroyed when the pool is cleared.
+//
+
+ScoreItem* ScoreItemPool::create(void) {
+   ScoreItem* sip = new (allocate()) ScoreItem;
+   used++;
+   count++;
+   return sip;
+}
+
+
+ScoreItem* ScoreItemPool::create(const ScoreItem& anItem) {
+   ScoreItem* sip = new (allocate()) ScoreItem(anItem);
+   used++;
+   count++;
+   return sip;
+}
+
+
+ScoreItem* ScoreItemPool::create(const string& itemstring) {
+   ScoreItem* sip = new (allocate()) ScoreItem(itemstring);
+   used++;
+   count++;
+   return sip;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemPool::clear -- Destroy all items in the pool and release
+//    the slab memory.
+//
+
+void ScoreItemPool::clear(void) {
+   for (int i=0; i<(int)slabs.size(); i++) {
+      int slabcount = (i == (int)slabs.size() - 1) ? used : slab_sizes[i];
+      ScoreItem* slab = slabs[i];
+      for (int j=0; j<slabcount; j++) {
+         slab[j].~ScoreItem();
+      }
+      ::operator delete(slab);
+   }
+   slabs.clear();
+   slab_sizes.clear();
+   used  = 0;
+   count = 0;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemPool::size -- Return the number of items in the pool.
+//
+
+int ScoreItemPool::size(void) const {
+   return count;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemPool::allocate -- Return the memory for the next item,
+//    adding a new slab if the last one is full.  The caller must
+//    construct the item and then increment the used/count variables.
+//
+
+void* ScoreItemPool::allocate(void) {
+   if (slabs.empty() || (used >= slab_sizes.back())) {
+      int slabsize = MIN_SLAB_ITEMS;
+      if (!slab_sizes.empty()) {
+         slabsize = slab_sizes.back() * 2;
+         if (slabsize > MAX_SLAB_ITEMS) {
+            slabsize = MAX_SLAB_ITEMS;
+         }
+      }
+      void* slab = ::operator new(slabsize * sizeof(ScoreItem));
+      SCORE_PROFILE_COUNT(SlabsAllocated, 1);
+      slabs.push_back((ScoreItem*)slab);
+      slab_sizes.push_back(slabsize);
+      used = 0;
+   }
+   SCORE_PROFILE_COUNT(ItemsAllocated, 1);
+   return slabs.back() + used;
+}
+
+
+
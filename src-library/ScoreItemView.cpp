@@ -0,0 +1,276 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 03:41:26 PDT 2026
+// Last Modified: Sun Oct 18 03:41:29 PDT 2026
+// Filename:      ScoreItemView.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreItemView.cpp
+// Syntax:        C++11
+//
+// Description:   A view of a ScoreItem which stores only the changed
+//                fixed parameters (see ScoreItemView.h).
+//
+
+#include "ScoreItemView.h"
+#include "ScorePmxWriter.h"
+#include <stdlib.h>
+
+using namespace std;
+
+static thread_local ScorePmxWriter PmxWriter;
+
+
+//////////////////////////////
+//
+// ScoreItemView::ScoreItemView -- Constructor.
+//
+
+ScoreItemView::ScoreItemView(void) {
+   item = NULL;
+}
+
+
+ScoreItemView::ScoreItemView(ScoreItem* anItem) {
+   item = anItem;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::~ScoreItemView -- Deconstructor.  The viewed item is
+//     not deleted.
+//
+
+ScoreItemView::~ScoreItemView() {
+   item = NULL;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::setItem -- View another item, removing any changes
+//     made to the previous item.
+//
+
+void ScoreItemView::setItem(ScoreItem* anItem) {
+   item = anItem;
+   changes.clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::getItem -- Return the item being viewed.
+//
+
+ScoreItem* ScoreItemView::getItem(void) {
+   return item;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::clear -- Remove the changes, so that the view is the
+//     same as the item.
+//
+
+void ScoreItemView::clear(void) {
+   changes.clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::getChangeCount -- Return the number of fixed parameters
+//     which have been changed in the view.
+//
+
+int ScoreItemView::getChangeCount(void) const {
+   return (int)changes.size();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::getParameter -- Return a fixed parameter of the view,
+//     which is the changed value if it was set in the view, or otherwise
+//     the value of the item.
+//
+
+SCORE_FLOAT ScoreItemView::getParameter(int pindex) {
+   for (auto& it : changes) {
+      if (it.first == pindex) {
+         return it.second;
+      }
+   }
+   if (item == NULL) {
+      return 0.0;
+   }
+   return item->getParameter(pindex);
+}
+
+
+SCORE_FLOAT ScoreItemView::getP(int pindex) {
+   return getParameter(pindex);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::setParameter -- Change a fixed parameter in the view
+//     without changing the item.  Values close to zero are set to zero
+//     in the same way as ScoreItemBase::setParameterNoisy().
+//
+
+void ScoreItemView::setParameter(int pindex, SCORE_FLOAT value) {
+   if ((pindex < P1) || (pindex > ScoreItemBase::SCORE_MAX_FIXED_PARAMETERS)) {
+      cerr << "ERROR: too large an index: " << pindex << endl;
+      exit(1);
+   }
+   if ((value < 0.0001) && (value > -0.0001)) {
+      value = 0;
+   }
+   for (auto& it : changes) {
+      if (it.first == pindex) {
+         it.second = value;
+         return;
+      }
+   }
+   changes.emplace_back(pindex, value);
+}
+
+
+void ScoreItemView::setP(int pindex, SCORE_FLOAT value) {
+   setParameter(pindex, value);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::getFixedParameters -- Fill values (which must have
+//     space for ScoreItemBase::SCORE_MAX_FIXED_PARAMETERS+1 numbers) with
+//     the fixed parameters of the view, starting at values[P1].  Returns
+//     the number of parameters, excluding any trailing zero values (see
+//     ScoreItemBase::getCompactFixedParameterCount()).
+//
+
+int ScoreItemView::getFixedParameters(SCORE_FLOAT* values) {
+   int count = 1;
+   if (item != NULL) {
+      count = item->getCompactFixedParameterCount();
+   }
+   for (auto& it : changes) {
+      if (it.first > count) {
+         count = it.first;
+      }
+   }
+   values[0] = 0.0;
+   for (int i=P1; i<=count; i++) {
+      values[i] = item != NULL ? item->getParameter(i) : 0.0;
+   }
+   for (auto& it : changes) {
+      values[it.first] = it.second;
+   }
+   while ((count > 1) && (values[count] == 0.0)) {
+      count--;
+   }
+   return count;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::getFixedText -- Return the text of the item.
+//
+
+const string& ScoreItemView::getFixedText(void) const {
+   static const string empty;
+   if (item == NULL) {
+      return empty;
+   }
+   return item->getFixedText();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::copyItem -- Make a full copy of the item with the changes
+//     of the view, for when the result needs to be changed further by
+//     functions of ScoreItem.
+//
+
+void ScoreItemView::copyItem(ScoreItem& output) {
+   if (item == NULL) {
+      output.clear();
+   } else {
+      output = *item;
+   }
+   for (auto& it : changes) {
+      output.setParameterNoisy(it.first, it.second);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItemView::printPmx -- Print the view as PMX data, which is the
+//     same as printing a copy of the item with the changed parameters.
+//     If autoQ is false, then named parameters in the auto namespace are
+//     not printed.  printPmxFixedParameters() prints only the line of
+//     fixed parameters (and the text of text items).
+//     Default value: autoQ = 1
+//
+
+ostream& ScoreItemView::printPmx(ostream& out, int autoQ) {
+   if (item == NULL) {
+      return out;
+   }
+   PmxWriter.appendFixedParameters(*this);
+   PmxWriter.appendNamedParameters(*item, autoQ);
+   return PmxWriter.write(out);
+}
+
+
+ostream& ScoreItemView::printPmxFixedParameters(ostream& out) {
+   if (item == NULL) {
+      return out;
+   }
+   PmxWriter.appendFixedParameters(*this);
+   return PmxWriter.write(out);
+}
+
+
+
+//////////////////////////////
+//
+// operator<< -- Print a ScoreItemView as PMX data.
+//
+
+ostream& operator<<(ostream& out, ScoreItemView& view) {
+   return view.printPmx(out, 1);
+}
+
+
+
+//////////////////////////////
+//
+// printNoAuto -- Print a ScoreItemView, excluding any named parameters
+//     in the "auto" namespace.
+//
+
+ostream& printNoAuto(ostream& out, ScoreItemView& view) {
+   return view.printPmx(out, 0);
+}
+
+
+
@@ -10,6 +10,7 @@
 //
 
 #include "ScoreItem.h"
+#include "ScorePageBase.h"
 #include "ScoreUtility.h"
 
 using namespace std;
@@ -22,7 +23,7 @@ using namespace std;
 //
 
 string ScoreItem::getHumdrumPitch(void) {
-   int base40 = getParameterInt(ns_auto, np_base40Pitch);
+   int base40 = getBase40Pitch();
    if (base40 <= 0) {
       return "";
    }
@@ -32,3 +33,248 @@ string ScoreItem::getHumdrumPitch(void) {
 
 
 
+//////////////////////////////
+//
+// ScoreItem::setBase40Pitch -- Store the base-40 pitch of a note,
+//     calculated by ScorePage::analyzePitch().
+//
+
+void ScoreItem::setBase40Pitch(int base40) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setBase40Pitch(this, base40);
+      return;
+   }
+   string base40string = to_string(base40);
+   base40string += "\t(";
+   base40string += SU::base40ToKern(base40);
+   base40string += ")";
+   setParameterNoisy(ns_auto, np_base40Pitch, base40string);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getBase40Pitch -- Return the base-40 pitch of a note, or
+//     0 if the pitch has not been analyzed.
+//
+
+int ScoreItem::getBase40Pitch(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getBase40Pitch(this, output)) {
+      return output;
+   }
+   return getParameterInt(ns_auto, np_base40Pitch);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::setLayer -- Store the layer number of a note, calculated
+//     by ScorePage::analyzeLayers().
+//
+
+void ScoreItem::setLayer(int layer) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setLayer(this, layer);
+      return;
+   }
+   setParameterQuiet(ns_auto, np_layer, layer);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getLayer -- Return the layer number of a note, or 0 if
+//     the layers have not been analyzed.
+//
+
+int ScoreItem::getLayer(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getLayer(this, output)) {
+      return output;
+   }
+   return getParameterInt(ns_auto, np_layer);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::setStaffDuration -- Store the duration of the staff for a
+//     staff item, calculated by ScorePage::analyzeStaffDurations().
+//
+
+void ScoreItem::setStaffDuration(SCORE_FLOAT duration) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setStaffDuration(this, duration);
+      return;
+   }
+   setParameterNoisy(ns_auto, np_staffDuration, duration);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getStaffDuration -- Return the duration of the staff for
+//     a staff item, or 0.0 if it has not been analyzed.
+//
+
+SCORE_FLOAT ScoreItem::getStaffDuration(void) {
+   AnalysisTable* table = getAnalysisTable();
+   SCORE_FLOAT output;
+   if ((table != NULL) && table->getStaffDuration(this, output)) {
+      return output;
+   }
+   return getParameterDouble(ns_auto, np_staffDuration);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::setTiedNextNote -- Store the next note in a tie group
+//     (or the ending note of a tie item).
+//
+
+void ScoreItem::setTiedNextNote(ScoreItem* item) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setTiedNextNote(this, item);
+      return;
+   }
+   setParameterQuiet(ns_auto, np_tiedNextNote, (void*)item);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getTiedNextNote -- Return the next note in a tie group,
+//     or NULL if there is none.
+//
+
+ScoreItem* ScoreItem::getTiedNextNote(void) {
+   AnalysisTable* table = getAnalysisTable();
+   ScoreItem* output;
+   if ((table != NULL) && table->getTiedNextNote(this, output)) {
+      return output;
+   }
+   return (ScoreItem*)getParameterPointer(ns_auto, np_tiedNextNote);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::setTiedLastNote -- Store the previous note in a tie group
+//     (or the starting note of a tie item).
+//
+
+void ScoreItem::setTiedLastNote(ScoreItem* item) {
+   AnalysisTable* table = getAnalysisTable();
+   if (table != NULL) {
+      table->setTiedLastNote(this, item);
+      return;
+   }
+   setParameterQuiet(ns_auto, np_tiedLastNote, (void*)item);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getTiedLastNote -- Return the previous note in a tie group,
+//     or NULL if there is none.
+//
+
+ScoreItem* ScoreItem::getTiedLastNote(void) {
+   AnalysisTable* table = getAnalysisTable();
+   ScoreItem* output;
+   if ((table != NULL) && table->getTiedLastNote(this, output)) {
+      return output;
+   }
+   return (ScoreItem*)getParameterPointer(ns_auto, np_tiedLastNote);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getChordId -- Return the index of the chord on the page
+//     which contains the note, or -1 if the note is not in a chord.
+//
+
+int ScoreItem::getChordId(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getChordId(this, output)) {
+      return output;
+   }
+   return -1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getBeamId -- Return the index of the beam group on the page
+//     which contains the item, or -1 if the item is not in a beam group.
+//
+
+int ScoreItem::getBeamId(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getBeamId(this, output)) {
+      return output;
+   }
+   return -1;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreItem::getTupletId -- Return the index of the tuplet group on the
+//     page which contains the item, or -1 if the item is not in a tuplet.
+//
+
+int ScoreItem::getTupletId(void) {
+   AnalysisTable* table = getAnalysisTable();
+   int output;
+   if ((table != NULL) && table->getTupletId(this, output)) {
+      return output;
+   }
+   return -1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Protected functions:
+//
+
+//////////////////////////////
+//
+// ScoreItem::getAnalysisTable -- Return the analysis table of the page
+//     which owns the item, or NULL if the item is not on a page.
+//
+
+AnalysisTable* ScoreItem::getAnalysisTable(void) {
+   if (page_owner == NULL) {
+      return NULL;
+   }
+   return &((ScorePageBase*)page_owner)->getAnalysisTable();
+}
+
+
+
@@ -558,8 +558,8 @@ bool ScoreItem::inTieGroup(void) {
    if (!isNoteItem()) {
       return false;
    }
-   return getParameterBool(ns_auto, np_tiedLastNote) ||
-          getParameterBool(ns_auto, np_tiedNextNote);
+   return (getTiedLastNote() != NULL) ||
+          (getTiedNextNote() != NULL);
 }
 
 
@@ -573,8 +573,8 @@ bool ScoreItem::isTieGroupStart(void) {
    if (!isNoteItem()) {
       return false;
    }
-   return !getParameterBool(ns_auto, np_tiedLastNote) &&
-          getParameterBool(ns_auto, np_tiedNextNote);
+   return (getTiedLastNote() == NULL) &&
+          (getTiedNextNote() != NULL);
 }
 
 
@@ -588,8 +588,8 @@ bool ScoreItem::isTieGroupMiddle(void) {
    if (!isNoteItem()) {
       return false;
    }
-   return getParameterBool(ns_auto, np_tiedLastNote) &&
-          getParameterBool(ns_auto, np_tiedNextNote);
+   return (getTiedLastNote() != NULL) &&
+          (getTiedNextNote() != NULL);
 }
 
 
@@ -602,8 +602,8 @@ bool ScoreItem::isTieGroupEnd(void) {
    if (!isNoteItem()) {
       return false;
    }
-   return getParameterBool(ns_auto, np_tiedLastNote) &&
-          !getParameterBool(ns_auto, np_tiedNextNote);
+   return (getTiedLastNote() != NULL) &&
+          (getTiedNextNote() == NULL);
 }
 
 
@@ -11,11 +11,19 @@
 //
 
 #include "ScoreItem.h"
+#include "ScorePmxWriter.h"
 
 using namespace std;
 
 
 
+// PmxWriter holds the PMX text of items until it is written, so that
+// a list of items is written to the stream at once (one buffer for each
+// thread, so that its memory is reused).
+static thread_local ScorePmxWriter PmxWriter;
+
+
+
 //////////////////////////////
 //
 // ScoreItem::printNoAuto -- print a ScoreItem, excluding any
@@ -23,10 +31,8 @@ using namespace std;
 //
 
 ostream& ScoreItem::printNoAuto(ostream& out) {
-   auto& si = *this;
-   si.printPmxFixedParameters(out);
-   si.printPmxNamedParametersNoAuto(out);
-   return out;
+   PmxWriter.appendItem(this, 0);
+   return PmxWriter.write(out);
 }
 
 
@@ -38,38 +44,32 @@ ostream& ScoreItem::printNoAuto(ostream& out) {
 //
 
 ostream& printNoAuto(ostream& out, vectorSIp& sipvector) {
-   for (auto& it : sipvector) {
-      it->printNoAuto(out);
-   }
-   return out;
+   PmxWriter.appendItems(sipvector, 0);
+   return PmxWriter.write(out);
 }
 
 
 ostream& printNoAuto(ostream& out, listSIp& siplist) {
-   for (auto& it : siplist) {
-      it->printNoAuto(out);
-   }
-   return out;
+   PmxWriter.appendItems(siplist, 0);
+   return PmxWriter.write(out);
 }
 
 
 ostream& printNoAuto(ostream& out, vectorVSIp& sipvvector) {
    for (auto& it : sipvvector) {
-      printNoAuto(out, it);
+      PmxWriter.appendItems(it, 0);
    }
-   return out;
+   return PmxWriter.write(out);
 }
 
 
 ostream& printNoAuto(ostream& out, ScoreItem* sip) {
-   sip->printNoAuto(out);
-   return out;
+   return sip->printNoAuto(out);
 }
 
 
 ostream& printNoAuto(ostream& out, ScoreItem& si) {
-   si.printNoAuto(out);
-   return out;
+   return si.printNoAuto(out);
 }
 
 
@@ -80,42 +80,43 @@ ostream& printNoAuto(ostream& out, ScoreItem& si) {
 //
 
 ostream& operator<<(ostream& out, ScoreItem& si) {
-   si.printPmxFixedParameters(out);
-   si.printPmxNamedParameters(out);
-   return out;
+   PmxWriter.appendFixedParameters(si);
+   PmxWriter.appendNamedParameters(si);
+   return PmxWriter.write(out);
 }
 
 
 ostream& operator<<(ostream& out, ScoreItem* si) {
-   si->printPmxFixedParameters(out);
-   si->printPmxNamedParameters(out);
-   return out;
+   return out << *si;
 }
 
 
 ostream& operator<<(ostream& out, vectorSIp& sipvector) {
    for (auto& it : sipvector) {
-      out << it;
+      PmxWriter.appendFixedParameters(*it);
+      PmxWriter.appendNamedParameters(*it);
    }
-   return out;
+   return PmxWriter.write(out);
 }
 
 
 ostream& operator<<(ostream& out, listSIp& siplist) {
    for (auto& it : siplist) {
-      out << it;
+      PmxWriter.appendFixedParameters(*it);
+      PmxWriter.appendNamedParameters(*it);
    }
-   return out;
+   return PmxWriter.write(out);
 }
 
 
 ostream& operator<<(ostream& out, vectorVSIp& sipvvector) {
    for (auto& itvv : sipvvector) {
       for (auto& itv : itvv) {
-         out << itv;
+         PmxWriter.appendFixedParameters(*itv);
+         PmxWriter.appendNamedParameters(*itv);
       }
    }
-   return out;
+   return PmxWriter.write(out);
 }
 
 
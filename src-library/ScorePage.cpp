@@ -107,7 +107,7 @@ void ScorePage::sortPageHorizontally  (void) {
            it++, it2++) {
       *it2 = *it;
    }
-   sort(sortlist.begin(), sortlist.end(), SU::sortP3);
+   SU::sortItemsP3(sortlist);
    analysis_info.setValid("notmodified");
    analysis_info.setValid("sorted");
 }
@@ -27,6 +27,8 @@ using namespace std;
 
 ScorePageBase::ScorePageBase(void) {
    pageset_owner = NULL;
+   thread_count = 1;
+   change_count = 0;
    trailer.reserve(8);
    setDefaultPrintParameters();
    clearAnalysisStates();
@@ -36,6 +38,8 @@ ScorePageBase::ScorePageBase(void) {
 
 ScorePageBase::ScorePageBase(const char* filename) {
    pageset_owner = NULL;
+   thread_count = 1;
+   change_count = 0;
    trailer.reserve(8);
    setDefaultPrintParameters();
    clearAnalysisStates();
@@ -46,6 +50,8 @@ ScorePageBase::ScorePageBase(const char* filename) {
 
 ScorePageBase::ScorePageBase(const string& filename) {
    pageset_owner = NULL;
+   thread_count = 1;
+   change_count = 0;
    trailer.reserve(8);
    setDefaultPrintParameters();
    clearAnalysisStates();
@@ -56,6 +62,8 @@ ScorePageBase::ScorePageBase(const string& filename) {
 
 ScorePageBase::ScorePageBase(istream& instream) {
    pageset_owner = NULL;
+   thread_count = 1;
+   change_count = 0;
    trailer.reserve(8);
    setDefaultPrintParameters();
    clearAnalysisStates();
@@ -76,11 +84,14 @@ ScorePageBase::ScorePageBase(const ScorePageBase& apage) {
    ScoreItem* sip;
    for (auto& it : itemlist) {
       if (it != NULL) {
-         sip = new ScoreItem(*it);
+         sip = item_pool.create(*it);
          item_storage.push_back(sip);
+         analysis_table.copyRow(sip, apage.analysis_table, it);
       }
    }
    pageset_owner = NULL;
+   thread_count = apage.thread_count;
+   change_count = 0;
    ppmx_page_style = apage.ppmx_page_style;
 }
 
@@ -104,13 +115,14 @@ ScorePageBase::~ScorePageBase() {
 //
 
 void ScorePageBase::clear(void) {
-   for (auto& it : item_storage) {
-      if (it != NULL) {
-         delete it;
-         it = NULL;
-      }
-   }
+   change_count++;
    item_storage.resize(0);
+   item_pool.clear();
+   analysis_table.clear();
+   chord_database.clear();
+   beam_database.clear();
+   tuplet_database.clear();
+   system_ticks.clear();
 
    for (auto& it : measure_storage) {
       if (it != NULL) {
@@ -132,8 +144,9 @@ void ScorePageBase::clear(void) {
 //
 
 ScoreItem* ScorePageBase::prependItem(ScoreItem& anItem) {
-   ScoreItem* ptr = new ScoreItem(anItem);
+   ScoreItem* ptr = item_pool.create(anItem);
    item_storage.push_front(ptr);
+   change_count++;
    return ptr;
 }
 
@@ -147,15 +160,19 @@ ScoreItem* ScorePageBase::prependItem(ScoreItem& anItem) {
 //
 
 ScoreItem* ScorePageBase::appendItem(ScoreItem& anItem) {
-   ScoreItem* ptr = new ScoreItem(anItem);
+   ScoreItem* ptr = item_pool.create(anItem);
    item_storage.push_back(ptr);
+   change_count++;
+   analysis_info.invalidateModified();
    return ptr;
 }
 
 
 ScoreItem* ScorePageBase::appendItem(const string& itemstring) {
-   ScoreItem* ptr = new ScoreItem(itemstring);
+   ScoreItem* ptr = item_pool.create(itemstring);
    item_storage.push_back(ptr);
+   change_count++;
+   analysis_info.invalidateModified();
    return ptr;
 }
 
@@ -261,7 +278,7 @@ void ScorePageBase::getStaffItemList (vectorVSIp& data) {
 void ScorePageBase::getStaffItemListOrdered(vectorVSIp& data) {
    getStaffItemList(data);
    for (auto& it : data) {
-      sort(it.begin(), it.end(), SU::sortP3P4P1);
+      SU::sortItemsP3P4P1(it);
    }
 }
 
@@ -279,19 +296,111 @@ void ScorePageBase::getStaffItemListOrdered(vectorVSIp& data) {
 //    "named" : a named parameter has been changed.
 //    "text"  : the fixed parameter text field has been changed.
 //
+// The page-level analyses only depend on fixed parameters (named
+// parameters in the auto namespace are their output), so named parameter
+// and text changes do not invalidate any analyses.  A fixed parameter
+// change to a staff or barline item, or a change of item type (P1) or
+// staff (P2), alters the layout of the page, so all analyses are
+// invalidated.  For any other fixed parameter change the item is moved
+// to its new position in the sorted item lists, and only the analyses
+// for the staff of the item (and its system) are invalidated.
+//
+// Fixed parameter and text changes are counted in change_count, since
+// page-set analyses such as lyrics also depend on them.
 //
 
 void ScorePageBase::itemChangeNotification(ScoreItemBase* sitem,
       const string& message ) {
-   analysis_info.invalidateModified();
+   // named parameters and text do not affect the page analyses.
+   if (message == "text") {
+      change_count++;
+   }
 }
 
 void ScorePageBase::itemChangeNotification(ScoreItemBase* sitem,
       const string& message, int index, SCORE_FLOAT oldp, SCORE_FLOAT newp ) {
-   analysis_info.invalidateModified();
-   if (monitor_P3 && (index == P3) && (oldp != newp)) {
-      // move item in sorted P3 list.
+   if (oldp == newp) {
+      return;
+   }
+   change_count++;
+   if (!analysis_info.hasAnalysis()) {
+      // nothing to invalidate.
+      return;
+   }
+   if (!analysis_info.sortedIsValid()) {
+      analysis_info.invalidateModified();
+      return;
+   }
+
+   ScoreItem* item = static_cast<ScoreItem*>(sitem);
+   int itemtype = item->getItemType();
+   int staff = item->getStaffNumber();
+   if ((index == P1) || (index == P2) || (itemtype == P1_Staff) ||
+         (itemtype == P1_Barline)) {
+      analysis_info.invalidateModified();
+      return;
+   }
+
+   // Move the item to its new place in the sorted lists if the
+   // parameter is used to sort them (P3, P4 or a horizontal offset).
+   int resort = monitor_P3 && ((index == P3) || (index == P4) ||
+         (index == P10) || (index == P11) || (index == P14));
+
+   if (resort && !repositionItem(itemlist_P3sorted, item, SU::sortP3)) {
+      analysis_info.invalidateModified();
+      return;
+   }
+
+   if (analysis_info.stavesIsValid()) {
+      if ((staff < 0) || (staff >= (int)itemlist_staffsorted.size())) {
+         analysis_info.invalidateModified();
+         return;
+      }
+      if (resort && !repositionItem(itemlist_staffsorted[staff], item,
+            SU::sortP3)) {
+         analysis_info.invalidateModified();
+         return;
+      }
    }
+
+   if (resort && analysis_info.systemsIsValid()) {
+      vectorI& systemmap = staff_info.systemMap();
+      int sysindex = -1;
+      if (staff < (int)systemmap.size()) {
+         sysindex = systemmap[staff];
+      }
+      if ((sysindex < 0) || (sysindex >= (int)itemlist_systemsorted.size()) ||
+            !repositionItem(itemlist_systemsorted[sysindex], item,
+            SU::sortP3P2P1P4)) {
+         analysis_info.invalidateModified();
+         return;
+      }
+   }
+
+   analysis_info.invalidateStaffContents(staff);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::repositionItem -- Move an item in a sorted list to
+//     its correct position after one of its parameters has changed
+//     (the rest of the list is presumed to be in sorted order).
+//     The item is placed after any items which sort equally with it.
+//     Returns false if the item is not in the list.
+//
+
+int ScorePageBase::repositionItem(vectorSIp& list, ScoreItem* item,
+      bool (*compare)(ScoreItem*, ScoreItem*)) {
+   auto it = std::find(list.begin(), list.end(), item);
+   if (it == list.end()) {
+      return 0;
+   }
+   list.erase(it);
+   auto target = std::upper_bound(list.begin(), list.end(), item, compare);
+   list.insert(target, item);
+   return 1;
 }
 
 
@@ -299,11 +408,15 @@ void ScorePageBase::itemChangeNotification(ScoreItemBase* sitem,
 //////////////////////////////
 //
 // ScorePageBase::clearAnalysisStates -- Set all anlaysis variables to
-//     false.
+//     false, and link the page databases to the item indexes of the
+//     analysis table.
 //
 
 void ScorePageBase::clearAnalysisStates(void) {
    analysis_info.clear();
+   chord_database.setItemIndex(&analysis_table);
+   beam_database.setItemIndex(&analysis_table);
+   tuplet_database.setItemIndex(&analysis_table);
 }
 
 
@@ -314,6 +427,7 @@ void ScorePageBase::clearAnalysisStates(void) {
 //
 
 void ScorePageBase::deleteNamespace(const string& nspace) {
+   exportAnalysisParameters();
    for (auto& it : item_storage) {
       it->deleteNamespace(nspace);
    }
@@ -332,6 +446,7 @@ void ScorePageBase::deleteNamespace(const string& nspace) {
 
 int ScorePageBase::changeNamespace(const string& newspace,
       const string& oldspace, const string& parameter) {
+   exportAnalysisParameters();
    int count = 0;
    for (auto& it : item_storage) {
       if (it->isDefined(oldspace, parameter)) {
@@ -344,6 +459,7 @@ int ScorePageBase::changeNamespace(const string& newspace,
 
 int ScorePageBase::changeNamespace(const string& newspace,
       const string& oldspace, const string& parameter, int itemtype) {
+   exportAnalysisParameters();
    int count = 0;
    for (auto& it : item_storage) {
       if (itemtype != it->getItemType()) {
@@ -408,3 +524,106 @@ void ScorePageBase::setMultipageComment(void) {
 
 
 
+//////////////////////////////
+//
+// ScorePageBase::getAnalysisTable -- Return the table of analysis results
+//     for items on the page.
+//
+
+AnalysisTable& ScorePageBase::getAnalysisTable(void) {
+   return analysis_table;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::exportAnalysisParameters -- Copy any analysis results
+//     which have not yet been stored as named parameters into the auto
+//     namespace of the items (or of only the given item).  This is done
+//     automatically before printing or copying the items, but must be
+//     called before reading the analysis results of the page directly as
+//     named parameters.
+//
+
+void ScorePageBase::exportAnalysisParameters(void) {
+   analysis_table.exportParameters();
+}
+
+
+void ScorePageBase::exportAnalysisParameters(ScoreItemBase* item) {
+   analysis_table.exportParameters((ScoreItem*)item);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::setThreadCount -- Set the number of threads used to
+//    run the per-staff and per-system passes of the page analyses.  A
+//    count of 0 will use one thread for each processor core.  Results
+//    are the same for any number of threads.
+//
+
+void ScorePageBase::setThreadCount(int count) {
+   if (count < 0) {
+      count = 1;
+   }
+   thread_count = count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::getThreadCount -- Return the number of threads used
+//    for the passes of the page analyses.
+//
+
+int ScorePageBase::getThreadCount(void) {
+   return thread_count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::getChangeCount -- Return the number of changes made to
+//    the items of the page: items added or removed, and fixed parameter
+//    or text changes.  The count can be compared to an earlier value to
+//    check if results calculated from the page are still current.
+//
+
+int ScorePageBase::getChangeCount(void) {
+   return change_count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::runAnalysisPasses -- Run pass(0) to pass(count-1) for
+//    the staves or systems of the page, in parallel if the thread count
+//    is not 1.  Before running in parallel, every item is given an index
+//    in the analysis table and the chord, beam and tuplet databases are
+//    given lists for every staff, so that passes which only store results
+//    for the items of their own staves can run at the same time.  Any
+//    analysis needed by the passes must be done before calling.
+//
+
+void ScorePageBase::runAnalysisPasses(int count,
+      const function<void(int)>& pass) {
+   if (SU::getThreadCount(thread_count, count) > 1) {
+      for (auto& it : item_storage) {
+         analysis_table.getItemIndex(it);
+      }
+      int staffcount = (int)MAX_STAFF_COUNT + 1;
+      chord_database.prepareStaves(staffcount);
+      beam_database.prepareStaves(staffcount);
+      tuplet_database.prepareStaves(staffcount);
+   }
+   SU::runParallel(count, thread_count, pass);
+}
+
+
+
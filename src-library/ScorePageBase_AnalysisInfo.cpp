@@ -28,6 +28,7 @@ AnalysisInfo::AnalysisInfo(void) {
 
 
 AnalysisInfo::AnalysisInfo(const AnalysisInfo& info) {
+   initializeDatabase();
    *this = info;
 }
 
@@ -61,8 +62,12 @@ AnalysisInfo& AnalysisInfo::operator=(const AnalysisInfo& info) {
    systempitches  = info.systempitches;
    staffslursties = info.staffslursties;
    chords         = info.chords;
+   beams          = info.beams;
+   tuplets        = info.tuplets;
+   barlines       = info.barlines;
    layers         = info.layers;
    p3             = info.p3;
+   database.copyScopes(info.database);
    return *this;
 }
 
@@ -88,6 +93,7 @@ void AnalysisInfo::clear(void) {
    barlines       = 0;
    layers         = 0;
    p3             = 0;
+   database.clearScopes();
 }
 
 
@@ -103,6 +109,38 @@ void AnalysisInfo::invalidateModified(void) {
 
 
 
+//////////////////////////////
+//
+// AnalysisInfo::invalidateStaffContents -- An item on the given staff
+//     has changed without changing which staff it is on, or the staff
+//     and system layout of the page.  The sorted item lists, staves and
+//     systems remain valid, while the analyses which depend on the items
+//     on the staff are marked as invalid for that staff (and for the
+//     system containing it).
+//
+
+void AnalysisInfo::invalidateStaffContents(int staff) {
+   database.invalidateNode("chords",        staff);
+   database.invalidateNode("duration",      staff);
+   database.invalidateNode("systempitches", staff);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisInfo::hasAnalysis -- Returns true if any analysis is currently
+//     valid.
+//
+
+int AnalysisInfo::hasAnalysis(void) {
+   return notmodified || sorted || staves || duration || systems ||
+         systempitches || staffslursties || chords || beams || tuplets ||
+         barlines || layers || p3;
+}
+
+
+
 //////////////////////////////
 //
 // AnalysisInfo::print --
@@ -157,6 +195,59 @@ void AnalysisInfo::setInvalid(const string& nodename) {
 
 
 
+//////////////////////////////
+//
+// AnalysisInfo::invalidate -- Set to false all variables related to the
+//    given node and its children, but only for the given staff (unless
+//    the analysis is already invalid for the entire page).
+//
+
+void AnalysisInfo::invalidate(const string& nodename, int staff) {
+   database.invalidateNode(nodename, staff);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisInfo::getInvalidStaves -- Returns true if the analysis for
+//    the given node only needs to be redone on some staves, which are
+//    returned in the second parameter.  Returns false if the analysis
+//    is valid or needs to be redone for the entire page.
+//
+
+int AnalysisInfo::getInvalidStaves(const string& nodename, set<int>& staves) {
+   return database.getInvalidScope(nodename, staves);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisInfo::isValid -- Returns true if the analysis for the given
+//    node is valid for the entire page.
+//
+
+int AnalysisInfo::isValid(const string& nodename) {
+   return database.isValid(nodename);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisInfo::getDependencyOrder -- Return the given analyses and all
+//    of the analyses which they depend on, in the order in which they
+//    should be done.
+//
+
+void AnalysisInfo::getDependencyOrder(const vector<string>& nodenames,
+      vector<string>& order) {
+   database.getDependencyOrder(nodenames, order);
+}
+
+
+
 //////////////////////////////
 //
 // AnalysisInfo::validate -- Set to true all variables related
@@ -199,6 +290,7 @@ void AnalysisInfo::initializeDatabase(void) {
    database.addChild("staves",        "chords",          &chords);
    database.addChild("staves",        "duration",        &duration);
    database.addChild("staves",        "systems",         &systems);
+   database.addChild("systems",       "duration",        &duration);
    database.addChild("systems",       "barlines",        &barlines);
    database.addChild("duration",      "barlines",        &barlines);
    database.addChild("systems",       "systempitches",   &systempitches);
@@ -0,0 +1,645 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:50 PDT 2026
+// Last Modified: Sat Oct 17 23:59:53 PDT 2026
+// Filename:      ScorePageBase_AnalysisTable.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePageBase_AnalysisTable.cpp
+// Syntax:        C++11
+//
+// Description:   Support class for storing the results of page analyses
+//                in ScorePageBase.
+//
+
+#include "ScorePageBase_AnalysisTable.h"
+#include "ScoreUtility.h"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// AnalysisTable::AnalysisTable -- Constructor.
+//
+
+AnalysisTable::AnalysisTable(void) {
+   pending = false;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::~AnalysisTable -- Deconstructor.
+//
+
+AnalysisTable::~AnalysisTable() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::clear -- Remove all rows from the table.
+//
+
+void AnalysisTable::clear(void) {
+   items.clear();
+   fields.clear();
+   unexported.clear();
+   base40.clear();
+   staffoffset.clear();
+   staffticks.clear();
+   staffduration.clear();
+   layer.clear();
+   tiednext.clear();
+   tiedlast.clear();
+   chordid.clear();
+   beamid.clear();
+   tupletid.clear();
+   pending = false;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getRowCount -- Return the number of items which have
+//     analysis results in the table.
+//
+
+int AnalysisTable::getRowCount(void) const {
+   return (int)items.size();
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getItemIndex -- Return a dense index for the item on
+//     the page (its row in the table), adding a row for the item if it
+//     does not have one.  Used by the page databases to store item
+//     information in arrays rather than in maps.
+//
+
+int AnalysisTable::getItemIndex(ScoreItem* item) {
+   return getRow(item);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::findItemIndex -- Return the dense index for the item,
+//     or -1 if the item has not been given one.
+//
+
+int AnalysisTable::findItemIndex(ScoreItem* item) const {
+   return findRow(item);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::copyRow -- Copy the analysis results of an item in
+//     another table to an item in this table (used when copying pages).
+//     Links to other items are not copied since they would point to
+//     items on the other page.
+//
+
+void AnalysisTable::copyRow(ScoreItem* item, const AnalysisTable& table,
+      ScoreItem* olditem) {
+   int oldrow = table.findRow(olditem);
+   if (oldrow < 0) {
+      return;
+   }
+   int oldfields = table.fields[oldrow] & ~(FIELD_TIEDNEXT | FIELD_TIEDLAST);
+   if (oldfields == 0) {
+      return;
+   }
+   int row = getRow(item);
+   base40[row]        = table.base40[oldrow];
+   staffoffset[row]   = table.staffoffset[oldrow];
+   staffticks[row]    = table.staffticks[oldrow];
+   staffduration[row] = table.staffduration[oldrow];
+   layer[row]         = table.layer[oldrow];
+   chordid[row]       = table.chordid[oldrow];
+   beamid[row]        = table.beamid[oldrow];
+   tupletid[row]      = table.tupletid[oldrow];
+   fields[row]        = oldfields;
+   unexported[row]    = table.unexported[oldrow] & oldfields;
+   if (unexported[row]) {
+      pending = true;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setBase40Pitch -- Store the base-40 pitch of a note.
+//
+
+void AnalysisTable::setBase40Pitch(ScoreItem* item, int value) {
+   int row = getRow(item);
+   base40[row] = value;
+   markField(row, FIELD_BASE40);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getBase40Pitch --
+//
+
+bool AnalysisTable::getBase40Pitch(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_BASE40)) {
+      return false;
+   }
+   value = base40[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setStaffOffsetDuration -- Store the durational offset
+//     of an item from the start of its staff.
+//
+
+void AnalysisTable::setStaffOffsetDuration(ScoreItem* item,
+      SCORE_FLOAT value) {
+   int row = getRow(item);
+   staffoffset[row] = roundDuration(value);
+   markField(row, FIELD_STAFFOFFSET);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getStaffOffsetDuration --
+//
+
+bool AnalysisTable::getStaffOffsetDuration(ScoreItem* item,
+      SCORE_FLOAT& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_STAFFOFFSET)) {
+      return false;
+   }
+   value = staffoffset[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setStaffOffsetTicks -- Store the durational offset of an
+//     item from the start of its staff as an integer number of ticks (see
+//     ScorePage::getSystemTicksPerQuarter()).  This is not exported to the
+//     auto namespace.
+//
+
+void AnalysisTable::setStaffOffsetTicks(ScoreItem* item, int value) {
+   int row = getRow(item);
+   staffticks[row] = value;
+   markField(row, FIELD_STAFFTICKS);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getStaffOffsetTicks --
+//
+
+bool AnalysisTable::getStaffOffsetTicks(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_STAFFTICKS)) {
+      return false;
+   }
+   value = staffticks[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setStaffDuration -- Store the total duration of the
+//     staff for a staff item.
+//
+
+void AnalysisTable::setStaffDuration(ScoreItem* item,
+      SCORE_FLOAT value) {
+   int row = getRow(item);
+   staffduration[row] = roundDuration(value);
+   markField(row, FIELD_STAFFDURATION);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getStaffDuration --
+//
+
+bool AnalysisTable::getStaffDuration(ScoreItem* item,
+      SCORE_FLOAT& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_STAFFDURATION)) {
+      return false;
+   }
+   value = staffduration[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setLayer -- Store the layer number of a note.
+//
+
+void AnalysisTable::setLayer(ScoreItem* item, int value) {
+   int row = getRow(item);
+   layer[row] = value;
+   markField(row, FIELD_LAYER);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getLayer --
+//
+
+bool AnalysisTable::getLayer(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_LAYER)) {
+      return false;
+   }
+   value = layer[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setTiedNextNote -- Store the note (or tie) which
+//     follows the item in a tie group.
+//
+
+void AnalysisTable::setTiedNextNote(ScoreItem* item,
+      ScoreItem* value) {
+   int row = getRow(item);
+   tiednext[row] = value;
+   markField(row, FIELD_TIEDNEXT);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getTiedNextNote --
+//
+
+bool AnalysisTable::getTiedNextNote(ScoreItem* item,
+      ScoreItem*& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_TIEDNEXT)) {
+      return false;
+   }
+   value = tiednext[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setTiedLastNote -- Store the note (or tie) which
+//     precedes the item in a tie group.
+//
+
+void AnalysisTable::setTiedLastNote(ScoreItem* item,
+      ScoreItem* value) {
+   int row = getRow(item);
+   tiedlast[row] = value;
+   markField(row, FIELD_TIEDLAST);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getTiedLastNote --
+//
+
+bool AnalysisTable::getTiedLastNote(ScoreItem* item,
+      ScoreItem*& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_TIEDLAST)) {
+      return false;
+   }
+   value = tiedlast[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setChordId -- Store the index of the chord which
+//     contains a note.
+//
+
+void AnalysisTable::setChordId(ScoreItem* item, int value) {
+   int row = getRow(item);
+   chordid[row] = value;
+   markField(row, FIELD_CHORD);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getChordId --
+//
+
+bool AnalysisTable::getChordId(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_CHORD)) {
+      return false;
+   }
+   value = chordid[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setBeamId -- Store the index of the beam group which
+//     contains a note, rest or beam.
+//
+
+void AnalysisTable::setBeamId(ScoreItem* item, int value) {
+   int row = getRow(item);
+   beamid[row] = value;
+   markField(row, FIELD_BEAM);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getBeamId --
+//
+
+bool AnalysisTable::getBeamId(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_BEAM)) {
+      return false;
+   }
+   value = beamid[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::setTupletId -- Store the index of the tuplet group
+//     which contains a note, rest or tuplet bracket.
+//
+
+void AnalysisTable::setTupletId(ScoreItem* item, int value) {
+   int row = getRow(item);
+   tupletid[row] = value;
+   markField(row, FIELD_TUPLET);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getTupletId --
+//
+
+bool AnalysisTable::getTupletId(ScoreItem* item, int& value) const {
+   int row = findRow(item);
+   if (!hasField(row, FIELD_TUPLET)) {
+      return false;
+   }
+   value = tupletid[row];
+   return true;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::isExportPending -- Returns true if there are analysis
+//     results which have not been copied into the auto namespace.
+//
+
+bool AnalysisTable::isExportPending(void) const {
+   return pending;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::exportParameters -- Copy any new analysis results into
+//     the auto namespace of their items (or of only the given item), using
+//     the same text as when the analyses stored their results directly as
+//     named parameters.  Group IDs are not exported.
+//
+
+void AnalysisTable::exportParameters(void) {
+   if (!pending) {
+      return;
+   }
+   pending = false;
+   for (int row=0; row<(int)items.size(); row++) {
+      exportRow(row);
+   }
+}
+
+
+void AnalysisTable::exportParameters(ScoreItem* item) {
+   if (!pending) {
+      return;
+   }
+   int row = findRow(item);
+   if (row >= 0) {
+      exportRow(row);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::formatDuration -- Return the text used for durations
+//     in the auto namespace.
+//
+
+string AnalysisTable::formatDuration(SCORE_FLOAT value) {
+   char buffer[32];
+   snprintf(buffer, sizeof(buffer), "%g", value);
+   return buffer;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::roundDuration -- Round a duration to the precision of
+//     its text in the auto namespace (six significant digits).  The
+//     durations used to be read back from the text, and the rounding
+//     keeps offsets at the same position on different staves equal
+//     to each other.
+//
+
+SCORE_FLOAT AnalysisTable::roundDuration(SCORE_FLOAT value) {
+   char buffer[32];
+   snprintf(buffer, sizeof(buffer), "%g", value);
+   return strtod(buffer, NULL);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Protected functions:
+//
+
+//////////////////////////////
+//
+// AnalysisTable::exportRow -- Copy the unexported results of a row into
+//     the auto namespace of its item.
+//
+
+void AnalysisTable::exportRow(int row) {
+   int todo = unexported[row] & FIELD_EXPORTED;
+   unexported[row] = 0;
+   if (todo == 0) {
+      return;
+   }
+   ScoreItem* item = items[row];
+   if (todo & FIELD_BASE40) {
+      string text = to_string(base40[row]);
+      text += "\t(";
+      text += SU::base40ToKern(base40[row]);
+      text += ")";
+      item->setParameterQuiet(ns_auto, np_base40Pitch, text);
+   }
+   if (todo & FIELD_STAFFOFFSET) {
+      item->setParameterQuiet(ns_auto, np_staffOffsetDuration,
+            formatDuration(staffoffset[row]));
+   }
+   if (todo & FIELD_STAFFDURATION) {
+      item->setParameterQuiet(ns_auto, np_staffDuration,
+            formatDuration(staffduration[row]));
+   }
+   if (todo & FIELD_LAYER) {
+      item->setParameterQuiet(ns_auto, np_layer, layer[row]);
+   }
+   if (todo & FIELD_TIEDNEXT) {
+      item->setParameterQuiet(ns_auto, np_tiedNextNote,
+            (void*)tiednext[row]);
+   }
+   if (todo & FIELD_TIEDLAST) {
+      item->setParameterQuiet(ns_auto, np_tiedLastNote,
+            (void*)tiedlast[row]);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::findRow -- Return the row of the table for the item,
+//     or -1 if the item does not have a row.
+//
+
+int AnalysisTable::findRow(ScoreItem* item) const {
+   int row = item->analysis_row;
+   if ((row < 0) || (row >= (int)items.size()) || (items[row] != item)) {
+      return -1;
+   }
+   return row;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::getRow -- Return the row of the table for the item,
+//     adding a row if the item does not have one.
+//
+
+int AnalysisTable::getRow(ScoreItem* item) {
+   int row = findRow(item);
+   if (row >= 0) {
+      return row;
+   }
+   row = (int)items.size();
+   item->analysis_row = row;
+   items.push_back(item);
+   fields.push_back(0);
+   unexported.push_back(0);
+   base40.push_back(0);
+   staffoffset.push_back(0.0);
+   staffticks.push_back(0);
+   staffduration.push_back(0.0);
+   layer.push_back(0);
+   tiednext.push_back(NULL);
+   tiedlast.push_back(NULL);
+   chordid.push_back(-1);
+   beamid.push_back(-1);
+   tupletid.push_back(-1);
+   return row;
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::hasField -- Returns true if the row has a value for
+//     the given field.
+//
+
+bool AnalysisTable::hasField(int row, int field) const {
+   return (row >= 0) && (fields[row] & field);
+}
+
+
+
+//////////////////////////////
+//
+// AnalysisTable::markField -- Record that a field of a row has a new
+//     value.
+//
+
+void AnalysisTable::markField(int row, int field) {
+   fields[row] |= field;
+   if (field & FIELD_EXPORTED) {
+      unexported[row] |= field;
+      pending.store(true, memory_order_relaxed);
+   }
+}
+
+
+
@@ -10,9 +10,13 @@
 //
 
 #include "ScorePageBase.h"
+#include "MappedFile.h"
+#include "ScoreFileType.h"
+#include "ScoreUtility.h"
 #include <fstream>
 #include <string.h>
 #include <sstream>
+#include <iterator>
 
 using namespace std;
 
@@ -55,32 +59,19 @@ void ScorePageBase::readFile(const string& filename, int verboseQ) {
 
 
 void ScorePageBase::readFile(const char* filename, int verboseQ) {
-   int binaryQ = 0;  // to test if reading a binary or PMX data file.
-
-   ifstream testfile(filename);
+   MappedFile infile(filename);
 
-   if (!testfile.is_open()) {
+   if (!infile.isOpen()) {
       cerr << "Error: cannot read the file: " << filename << endl;
       exit(1);
    }
 
    // The last 4 bytes of a binary SCORE file are 00 3c 1c c6 which equals
    // the float value -9999.0.
-   testfile.seekg(-4, ios::end);
-   unsigned char databytes[4] = {0xff};
-   testfile.read((char*)databytes, 4);
-   if (databytes[0] == 0x00 && databytes[1] == 0x3c && databytes[2] == 0x1c &&
-         databytes[3] == 0xc6) {
-      binaryQ = 1;
-   } else {
-      binaryQ = 0;
-   }
-   testfile.seekg(0, ios::beg);
-
-   if (binaryQ) {
-      readBinary(testfile, verboseQ);
+   if (infile.isBinaryScore()) {
+      readBinary(infile.data(), infile.size(), verboseQ);
    } else {
-      readPmx(testfile, verboseQ);
+      readPmx(infile.data(), infile.size(), verboseQ);
    }
    setFilename(filename);
 }
@@ -97,14 +88,10 @@ void ScorePageBase::readStream(istream& testfile, int verboseQ) {
       // The last 4 bytes of a binary SCORE file are 00 3c 1c c6 which equals
       // the float value -9999.0.
       testfile.seekg(-4, ios::end);
-      unsigned char databytes[4] = {0xff};
-      testfile.read((char*)databytes, 4);
-      if (databytes[0] == 0x00 && databytes[1] == 0x3c &&
-            databytes[2] == 0x1c && databytes[3] == 0xc6) {
-         binaryQ = 1;
-      } else {
-         binaryQ = 0;
-      }
+      char databytes[4] = {0};
+      testfile.read(databytes, 4);
+      binaryQ = testfile && ScoreFileType::hasBinaryTrailer(databytes, 4);
+      testfile.clear();
       testfile.seekg(0, ios::beg);
    }
 
@@ -125,16 +112,15 @@ void ScorePageBase::readStream(istream& testfile, int verboseQ) {
 //
 
 void ScorePageBase::readPmx(const char* filename, int verboseQ) {
-   ifstream infile(filename, ios::in);
+   MappedFile infile(filename);
 
-   if (!infile.is_open()) {
+   if (!infile.isOpen()) {
       cerr << "Error: cannot read file: " << filename << endl;
       exit(1);
    }
 
-   readPmx(infile, verboseQ);
+   readPmx(infile.data(), infile.size(), verboseQ);
    setFilename(filename);
-   infile.close();
 }
 
 
@@ -146,18 +132,24 @@ void ScorePageBase::readPmx(const char* filename, int verboseQ) {
 //
 
 void ScorePageBase::readPmx(istream& infile, int verboseQ) {
-   clear();
+   string contents((istreambuf_iterator<char>(infile)),
+         istreambuf_iterator<char>());
+   readPmx(contents.data(), contents.size(), verboseQ);
+}
 
-   ScoreItem* sip = NULL;
-   while (!infile.eof()) {
-      sip = readPmxScoreLine(infile, verboseQ);
-      if (sip != NULL) {
-         // setPageOwner will store the pointer for the ScoreItem
-         // on the given page.  The page will delete it when it
-         // is deconstructed.
-         sip->setPageOwner(this);
-      }
-   }
+
+
+//////////////////////////////
+//
+// ScorePageBase::readPmx --  Read a single SCORE page in the ASCII
+//      PMX data format from a block of memory (such as a memory-mapped
+//      file).
+//
+
+void ScorePageBase::readPmx(const char* data, size_t size, int verboseQ) {
+   SCORE_PROFILE_SCOPE("ScorePageBase::readPmx", 0);
+   clear();
+   addPmxData(data, size, verboseQ);
 }
 
 
@@ -170,90 +162,170 @@ void ScorePageBase::readPmx(istream& infile, int verboseQ) {
 //   fllowing a parameter line which start with an "@" sign will be
 //   read as named parameters for the item.
 //
+//   The istream version reads the lines for one item from the stream
+//   and then parses them with the memory-block version.  The memory-block
+//   version is given a pointer to the start of a line and a pointer to
+//   the end of the data.  The data pointer is moved to the start of the
+//   next unread line.  Lines can be of any length.
+//
 
 ScoreItem* ScorePageBase::readPmxScoreLine(istream& infile, int verboseQ) {
-   char buffer[10001] = {0};
-   infile.getline(buffer, 10000, '\n');
-   if (verboseQ) {
-      cout << "#Read line: " << buffer << endl;
+   string lines;
+   if (!getline(infile, lines)) {
+      return NULL;
+   }
+   lines.push_back('\n');
+
+   // The line following a text item's parameters contains the text:
+   const char* ptr = lines.data();
+   const char* end = ptr + lines.size() - 1;
+   const char* tok;
+   const char* tokend;
+   if (nextPmxToken(ptr, end, tok, tokend) && (tokend - tok == 1) &&
+         (*tok == 't')) {
+      string text;
+      getline(infile, text);
+      lines += text;
+      lines.push_back('\n');
    }
 
-   vectorSF parameters;
+   string named;
+   while (infile.peek() == '@') {
+      getline(infile, named);
+      lines += named;
+      lines.push_back('\n');
+   }
 
-   // parameters.reserve(ScoreItemBase::SCORE_MAX_FIXED_PARAMETERS);
-   parameters.reserve(8);
-   string text;
+   ptr = lines.data();
+   return readPmxScoreLine(ptr, ptr + lines.size(), verboseQ);
+}
 
-   char* ptr = strtok(buffer, "\n\t ");
-   float number = 0.0;
-   if (ptr != NULL) {
-      if (strcmp(ptr, "t") == 0) {
-         // process text parameter
-         number = 16.0;
-         parameters.push_back(number);
-         ptr = strtok(NULL, "\n\t ");
-         while (ptr != NULL) {
-            number = (SCORE_FLOAT)strtod(ptr, NULL);
-            parameters.push_back(number);
-            ptr = strtok(NULL, "\n\t ");
-         }
-         // now read the text line for a text item
-         infile.getline(buffer, 1000, '\n');
-         if (verboseQ) {
-            cout << "#Read text line: " << buffer << endl;
-         }
-         text = buffer;
-         int length = text.size();
-         if (parameters.size() < 13) {
-            parameters.resize(13, 0.0);
-            parameters[12] = (SCORE_FLOAT)length;
-         }
-      } else {
-         // process non-text parameter
-         number = (SCORE_FLOAT)strtod(ptr, NULL);
-         if (number == 0.0) {
-            // P1=0 is not a valid PMX item type
-            return NULL;
-         } else {
-            parameters.push_back(number);
-            ptr = strtok(NULL, "\n\t ");
-            while (ptr != NULL) {
-               number = (SCORE_FLOAT)strtod(ptr, NULL);
-               parameters.push_back(number);
-               ptr = strtok(NULL, "\n\t ");
-            }
-         }
-      }
+
+ScoreItem* ScorePageBase::readPmxScoreLine(const char*& data,
+      const char* end, int verboseQ) {
+   const char* ptr     = data;
+   const char* lineend = findPmxLineEnd(ptr, end);
+   data = lineend < end ? lineend + 1 : end;
+   if (verboseQ) {
+      cout << "#Read line: " << string(ptr, lineend) << endl;
    }
 
-   mapNamespace named_parameters;
-   while (infile.peek() == '@') {
-      infile.getline(buffer, 10000, '\n');
-      if (verboseQ) {
-         cout << "#Read line: " << buffer << endl;
+   const char* tok;
+   const char* tokend;
+   ScoreItem* sip = NULL;
+   if (!nextPmxToken(ptr, lineend, tok, tokend)) {
+      // Empty line: skip any named parameters following it.
+      while ((data < end) && (*data == '@')) {
+         lineend = findPmxLineEnd(data, end);
+         data = lineend < end ? lineend + 1 : end;
       }
-      ScoreItemBase::readNamedParameter(named_parameters, buffer);
-   } 
-
-   if (parameters.size() == 0) {
       return NULL;
    }
 
-   ScoreItem* sip = new ScoreItem(parameters);
-   sip->setPageOwner(this);
-   if (text.size() > 0) {
-      sip->setFixedText(text);
+   // Numbers are stored with the precision of a float, as in
+   // binary SCORE files.
+   float number = 0.0;
+   if ((tokend - tok == 1) && (*tok == 't')) {
+      // process text parameter
+      sip = item_pool.create();
+      vectorSF& fp = sip->fixed_parameters;
+      fp.reserve(16);
+      fp.push_back(0.0);  // 0th index not used
+      fp.push_back(P1_Text);
+      while (nextPmxToken(ptr, lineend, tok, tokend)) {
+         number = (SCORE_FLOAT)SU::parseNumber(tok, tokend);
+         fp.push_back(number);
+      }
+
+      // now read the text line for a text item
+      const char* textstart = data;
+      const char* textend   = findPmxLineEnd(textstart, end);
+      data = textend < end ? textend + 1 : end;
+      if (verboseQ) {
+         cout << "#Read text line: " << string(textstart, textend) << endl;
+      }
+      int length = (int)(textend - textstart);
+      if ((int)fp.size() < P13+1) {
+         fp.resize(P13+1, 0.0);
+         fp[P13] = (SCORE_FLOAT)length;
+      }
+      sip->setPageOwner(this);
+      if (length > 0) {
+         sip->setFixedText(string(textstart, textend));
+      }
+   } else {
+      // process non-text parameter
+      number = (SCORE_FLOAT)SU::parseNumber(tok, tokend);
+      if (number == 0.0) {
+         // P1=0 is not a valid PMX item type
+         return NULL;
+      }
+      sip = item_pool.create();
+      vectorSF& fp = sip->fixed_parameters;
+      fp.reserve(16);
+      fp.push_back(0.0);  // 0th index not used
+      fp.push_back(number);
+      while (nextPmxToken(ptr, lineend, tok, tokend)) {
+         number = (SCORE_FLOAT)SU::parseNumber(tok, tokend);
+         fp.push_back(number);
+      }
+      sip->setPageOwner(this);
    }
-   if (named_parameters.size() > 0) {
-      sip->addNamedParameters(named_parameters);
+
+   while ((data < end) && (*data == '@')) {
+      lineend = findPmxLineEnd(data, end);
+      if (verboseQ) {
+         cout << "#Read line: " << string(data, lineend) << endl;
+      }
+      ScoreItemBase::readNamedParameter(sip->named_parameters, data, lineend);
+      data = lineend < end ? lineend + 1 : end;
    }
- 
+
    item_storage.push_back(sip);
    return sip;
 }
 
 
 
+//////////////////////////////
+//
+// ScorePageBase::findPmxLineEnd -- Return a pointer to the newline at the
+//     end of the line starting at ptr (or end if there is no newline).
+//
+
+const char* ScorePageBase::findPmxLineEnd(const char* ptr, const char* end) {
+   const char* newline = (const char*)memchr(ptr, '\n', end - ptr);
+   return newline ? newline : end;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::nextPmxToken -- Find the next token on a PMX line.  Tokens
+//     are separated by spaces or tabs.  Returns false if there are no
+//     more tokens on the line, otherwise tok and tokend are set to the
+//     start and end of the token, and ptr is moved to the end of the token.
+//
+
+int ScorePageBase::nextPmxToken(const char*& ptr, const char* end,
+      const char*& tok, const char*& tokend) {
+   while ((ptr < end) && ((*ptr == ' ') || (*ptr == '\t'))) {
+      ptr++;
+   }
+   if (ptr >= end) {
+      return 0;
+   }
+   tok = ptr;
+   while ((ptr < end) && (*ptr != ' ') && (*ptr != '\t')) {
+      ptr++;
+   }
+   tokend = ptr;
+   return 1;
+}
+
+
+
 //////////////////////////////
 //
 // ScorePageBase::addPmxData -- Add one or more PMX line of data to the
@@ -267,9 +339,16 @@ void ScorePageBase::addPmxData(istream& data) {
 }
 
 void ScorePageBase::addPmxData(const string& data) {
-   istringstream instream(data);
-   while (!instream.eof()) {
-      readPmxScoreLine(instream);
+   addPmxData(data.data(), data.size());
+}
+
+void ScorePageBase::addPmxData(const char* data, size_t size, int verboseQ) {
+   const char* ptr = data;
+   const char* end = data + size;
+   while (ptr < end) {
+      // readPmxScoreLine will store the item on the page.  The page
+      // will release it when it is cleared or deconstructed.
+      readPmxScoreLine(ptr, end, verboseQ);
    }
 }
 
@@ -283,18 +362,14 @@ void ScorePageBase::addPmxData(const string& data) {
 //
 
 void ScorePageBase::readBinary(const char* filename, int verboseQ) {
-   #ifdef VISUAL
-      fstream infile(filename, ios::in | ios::binary);
-   #else
-      fstream infile(filename, ios::in);
-   #endif
+   MappedFile infile(filename);
 
-   if (!infile.is_open()) {
+   if (!infile.isOpen()) {
       cerr << "Error: cannot open file: " << filename << endl;
       exit(1);
    }
 
-   readBinary(infile, verboseQ);
+   readBinary(infile.data(), infile.size(), verboseQ);
    setFilename(filename);
 }
 
@@ -344,7 +419,7 @@ void ScorePageBase::readBinary(istream& infile, int verboseQ) {
                exit(1);
             }
          }
-         sip = new ScoreItem;
+         sip = item_pool.create();
          sip->readBinary(infile, number);
          readcount += (int)number;
          sip->setPageOwner(this);
@@ -377,6 +452,129 @@ void ScorePageBase::readBinary(istream& infile, int verboseQ) {
 
 
 
+//////////////////////////////
+//
+// ScorePageBase::readBinary -- Read a single SCORE page in the binary
+//      data format from a block of memory (such as a memory-mapped file).
+//      All 4-byte numbers in the data are converted in a single pass
+//      before the items are extracted, rather than reading each number
+//      separately from an input stream.
+//
+
+void ScorePageBase::readBinary(const char* data, size_t size, int verboseQ) {
+   SCORE_PROFILE_SCOPE("ScorePageBase::readBinary", 0);
+   clear();
+
+   if (size < 10) {
+      cerr << "Error: binary data is too short: " << size << " bytes" << endl;
+      return;
+   }
+
+   // first read the count of 4-byte numbers/text chunks in the data file.
+   const unsigned char* udata = (const unsigned char*)data;
+   int numbercount = (udata[1] << 8) | udata[0];
+   int readcount = 0;   // number of 4-byte values which have been read
+   if (verboseQ) {
+      cout << "#NUMBER COUNT OF FILE IS " << numbercount << endl;
+   }
+
+   // The 4-byte numbers start after the initial 2-byte count.
+   int wordcount = (int)((size - 2) / 4);
+   const char* bytes = data + 2;
+   vectorSF values(wordcount);
+   decodeLittleFloats(bytes, wordcount, values.data());
+
+   // now read the count of numbers in the trailer
+   SCORE_FLOAT trailersize;
+   decodeLittleFloats(data + size - 8, 1, &trailersize);
+   int trailerSize = (int)trailersize;
+
+   ScoreItem* sip = NULL;
+   double number = 0.0;
+   int position = 0;    // index of the next 4-byte value to read.
+   // now read each data number and store
+   while (position < wordcount) {
+      if (numbercount - readcount - trailerSize - 1 == 0) {
+         break;
+      } else if (numbercount - readcount - trailerSize - 1< 0) {
+         cout << "Error reading file: data mixes with trailer: "
+              << numbercount - readcount - trailerSize - 1
+              << endl;
+         exit(1);
+      }
+      number = values[position++];
+      readcount++;
+      number = ScoreItemBase::roundFractionDigits(number, 3);
+      if (verboseQ) {
+         if (number - (int)number > 0.0) {
+            cout << "# Error in number parameter count: " << number << endl;
+            exit(1);
+         }
+      }
+      sip = item_pool.create();
+      position += sip->readBinary(values.data() + position,
+            bytes + 4 * position, (int)number, wordcount - position);
+      readcount += (int)number;
+      sip->setPageOwner(this);
+      item_storage.push_back(sip);
+   }
+
+   if (verboseQ) {
+      cout << "#Elements: " << item_storage.size() << endl;
+      cout << "#READING Trailer: " << endl;
+   }
+
+   trailer.clear();
+   trailer.reserve(10);
+   while (number != -9999.0 && position < wordcount) {
+      number = values[position++];
+      trailer.push_back(number);
+      if (verboseQ) {
+         cout << "#TRAILER NUMBER: " << number << endl;
+      }
+      readcount++;
+   }
+
+   if (readcount != numbercount) {
+      cerr << "#Warning: expecting " << numbercount << " numbers in file "
+           << " but read " << readcount << endl;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::decodeLittleFloats -- Convert a sequence of 4-byte
+//      little-endian floats into SCORE_FLOAT values.  On little-endian
+//      computers the loop only widens the values, and it is vectorized
+//      by the compiler.
+//
+
+void ScorePageBase::decodeLittleFloats(const char* bytes, int count,
+      SCORE_FLOAT* output) {
+   int i;
+   #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+      float value;
+      for (i=0; i<count; i++) {
+         memcpy(&value, bytes + 4 * i, 4);
+         output[i] = (SCORE_FLOAT)value;
+      }
+   #else
+      const unsigned char* byteinfo = (const unsigned char*)bytes;
+      union { float f; uint32_t i; } num;
+      for (i=0; i<count; i++) {
+         num.i = byteinfo[4*i+3];
+         num.i = (num.i << 8) | byteinfo[4*i+2];
+         num.i = (num.i << 8) | byteinfo[4*i+1];
+         num.i = (num.i << 8) | byteinfo[4*i];
+         output[i] = (SCORE_FLOAT)num.f;
+      }
+   #endif
+}
+
+
+
 //////////////////////////////
 //
 // ScorePageBase::readLittleShort -- read a short int in little endian form.
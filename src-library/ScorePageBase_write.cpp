@@ -10,8 +10,11 @@
 //
 
 #include "ScorePageBase.h"
+#include "ScorePmxWriter.h"
 #include <fstream>
 #include <sstream>
+#include <cstdint>
+#include <string.h>
 
 using namespace std;
 
@@ -21,9 +24,18 @@ using namespace std;
 // ScorePageBase writing functions.
 //
 
+// PmxWriter holds the PMX text of a page until it is written (one buffer
+// for each thread, so that its memory is reused for each page).
+static thread_local ScorePmxWriter PmxWriter;
+
+
 //////////////////////////////
 //
-// ScorePageBase::printPmx -- Print data as ASCII PMX data.
+// ScorePageBase::printPmx -- Print data as ASCII PMX data.  The text of
+//     the page is made in memory and written to the stream at once.  If
+//     roundQ is true, then numbers are rounded to six significant digits
+//     (as printed by an ostream), otherwise they are written in full
+//     (see ScorePmxWriter).
 //     default value: roundQ   = 1
 //     default value: verboseQ = 0
 //
@@ -33,9 +45,11 @@ ostream& ScorePageBase::printPmx(ostream& out, int roundQ, int verboseQ) {
       cout << "# OBJECTS TO WRITE: " << getItemCount() << endl;
    }
 
+   PmxWriter.setRounding(roundQ);
    for (auto& it : item_storage) {
-      it->printPmx(out);
+      PmxWriter.appendItem(it, 1);
    }
+   PmxWriter.write(out);
 
    out << flush;
    return out;
@@ -55,9 +69,11 @@ ostream& ScorePageBase::printNoAuto(ostream& out, int roundQ, int verboseQ) {
       cout << "# OBJECTS TO WRITE: " << getItemCount() << endl;
    }
 
+   PmxWriter.setRounding(roundQ);
    for (auto& it : item_storage) {
-      it->printNoAuto(out);
+      PmxWriter.appendItem(it, 0);
    }
+   PmxWriter.write(out);
 
    out << flush;
    return out;
@@ -76,9 +92,11 @@ ostream& ScorePageBase::printPmxWithNamedParameters(ostream& out, int roundQ,
       cout << "# OBJECTS TO WRITE: " << getItemCount() << endl;
    }
 
+   PmxWriter.setRounding(roundQ);
    for (auto& it : item_storage) {
-      it->printPmx(out);
+      PmxWriter.appendItem(it, 1);
    }
+   PmxWriter.write(out);
 
    out << flush;
    return out;
@@ -98,9 +116,11 @@ ostream& ScorePageBase::printPmxFixedParameters(ostream& out, int roundQ,
       cout << "# OBJECTS TO WRITE: " << getItemCount() << endl;
    }
 
+   PmxWriter.setRounding(roundQ);
    for (auto& it : item_storage) {
-      it->printPmxFixedParameters(out);
+      PmxWriter.appendFixedParameters(*it);
    }
+   PmxWriter.write(out);
 
    out << flush;
    return out;
@@ -139,22 +159,31 @@ void ScorePageBase::writeBinary(const char* filename) {
 //////////////////////////////
 //
 // ScorePageBase::writeBinary --  Write SCORE data to a binary output stream.
-//     Data is stored in a temporary buffer until all of the items
-//     have been written.  Then the total parameter count (4-byte groupings)
-//     in the file have been written.
+//     The data is encoded into a buffer (see encodeBinary()) and written
+//     to the stream in one write.
 //
 
 ostream& ScorePageBase::writeBinary(ostream& outfile) {
+   static thread_local vector<char> buffer;
+   encodeBinary(buffer);
+   outfile.write(buffer.data(), buffer.size());
+   return outfile;
+}
 
-   stringstream temps;
 
-   int writecount = 0;   // number of 4-byte values which have been written
 
-   for (auto& it : item_storage) {
-      writecount += it->writeBinary(temps);
-   }
+//////////////////////////////
+//
+// ScorePageBase::encodeBinary -- Store the contents of a binary SCORE
+//     file for the page in output.  The number of 4-byte values in the
+//     data is counted first, so that the count which starts the file and
+//     all of the values can be written into one buffer of the final size
+//     without any copying.  The memory of output is reused if it is
+//     large enough.
+//
 
-   // write the trailer, must be at least (6) numbers long:
+void ScorePageBase::encodeBinary(vector<char>& output) {
+   // the trailer, must be at least (6) numbers long:
    // (0) -9999.0
    // (1) size of trailer after and including this number, typically 5.0
    // (2) units
@@ -172,12 +201,11 @@ ostream& ScorePageBase::writeBinary(ostream& outfile) {
    // make sure that the last value in trailer is 0.0:
    trailer.back() = 0.0f;
 
-   // write the trailer
-   vectorF::reverse_iterator itf;
-   for (itf = trailer.rbegin(); itf != trailer.rend(); itf++) {
-      writeLittleFloat(temps, *itf);
-      writecount++;
+   int writecount = 0;   // number of 4-byte values which will be written
+   for (auto& it : item_storage) {
+      writecount += it->getBinaryWordCount();
    }
+   writecount += (int)trailer.size();
 
    int version = trailer[3];
    if ((version < 6.0) && (writecount > 0xffff)) {
@@ -185,28 +213,58 @@ ostream& ScorePageBase::writeBinary(ostream& outfile) {
            << endl;
    }
 
-   // print the number of 4-byte groups in the data:
-   if (writecount < 0xffff) {
-      // write two byte counter
-      unsigned char blo = writecount & 0xff;
-      unsigned char bhi = (writecount >> 8) & 0xff;
-      outfile.write((char*)&blo, 1);
-      outfile.write((char*)&bhi, 1);
-   } else {
-      // write four-byte counter
-      unsigned char bloest = writecount & 0xff;
-      unsigned char bloer  = (writecount >> 8)  & 0xff;
-      unsigned char bhier  = (writecount >> 16) & 0xff;
-      unsigned char bhiest = (writecount >> 24) & 0xff;
-      outfile.write((char*)&bloest, 1);
-      outfile.write((char*)&bloer,  1);
-      outfile.write((char*)&bhier,  1);
-      outfile.write((char*)&bhiest, 1);
+   // The number of 4-byte groups in the data is stored in two bytes, or
+   // in four bytes if it is too large for two.
+   int countsize = writecount < 0xffff ? 2 : 4;
+   output.resize(countsize + 4 * (size_t)writecount);
+   char* ptr = output.data();
+   for (int i=0; i<countsize; i++) {
+      *ptr++ = (char)((writecount >> (8 * i)) & 0xff);
    }
 
-   outfile << temps.rdbuf();
+   for (auto& it : item_storage) {
+      ptr += 4 * it->encodeBinary(ptr);
+   }
 
-   return outfile;
+   // write the trailer (backwards)
+   vectorF::reverse_iterator itf;
+   for (itf = trailer.rbegin(); itf != trailer.rend(); itf++) {
+      SCORE_FLOAT value = *itf;
+      encodeLittleFloats(&value, 1, ptr);
+      ptr += 4;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageBase::encodeLittleFloats -- Convert SCORE_FLOAT values into a
+//      sequence of 4-byte little-endian floats.  On little-endian
+//      computers the loop only narrows the values, and it is vectorized
+//      by the compiler.
+//
+
+void ScorePageBase::encodeLittleFloats(const SCORE_FLOAT* values, int count,
+      char* bytes) {
+   int i;
+   #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+      float value;
+      for (i=0; i<count; i++) {
+         value = (float)values[i];
+         memcpy(bytes + 4 * i, &value, 4);
+      }
+   #else
+      unsigned char* byteinfo = (unsigned char*)bytes;
+      union { float f; uint32_t i; } num;
+      for (i=0; i<count; i++) {
+         num.f = (float)values[i];
+         byteinfo[4*i]   = (unsigned char)( num.i        & 0xff);
+         byteinfo[4*i+1] = (unsigned char)((num.i >> 8)  & 0xff);
+         byteinfo[4*i+2] = (unsigned char)((num.i >> 16) & 0xff);
+         byteinfo[4*i+3] = (unsigned char)((num.i >> 24) & 0xff);
+      }
+   #endif
 }
 
 
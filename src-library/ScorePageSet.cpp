@@ -20,11 +20,18 @@ using namespace std;
 //
 
 ScorePageSet::ScorePageSet(void) {
-   // do nothing
+   thread_count  = 1;
+   cache_hash    = 0;
+   cache_pages   = 0;
+   cache_current = 0;
 }
 
 
 ScorePageSet::ScorePageSet(Options& opts) {
+   thread_count  = 1;
+   cache_hash    = 0;
+   cache_pages   = 0;
+   cache_current = 0;
    read(opts);
 }
 
@@ -54,6 +61,11 @@ void ScorePageSet::clear(void) {
    page_storage.resize(0);
    page_sequence.resize(0);
    clearSegments();
+   analyzed_pages.clear();
+   cache_filename.clear();
+   cache_hash    = 0;
+   cache_pages   = 0;
+   cache_current = 0;
 }
 
 
@@ -193,6 +205,84 @@ void ScorePageSet::setPageOwnerships(void) {
 
 
 
+//////////////////////////////
+//
+// ScorePageSet::setThreadCount -- Set the number of threads used to
+//    parse pages when reading input files and to analyze pages in
+//    analyze().  A count of 0 will use one thread for each processor
+//    core.
+//
+
+void ScorePageSet::setThreadCount(int count) {
+   if (count < 0) {
+      count = 1;
+   }
+   thread_count = count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::getThreadCount -- Return the number of threads used
+//    to read and analyze pages.
+//
+
+int ScorePageSet::getThreadCount(void) {
+   return thread_count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::setProfiling -- Turn on (or off) the recording of the
+//    time spent in each analysis and reading function.  The profile
+//    is shared by all page sets in the program.  Profiling is only
+//    available if the library was compiled with PROFILE=1.
+//
+
+void ScorePageSet::setProfiling(int state) {
+   ScoreProfile::setEnabled(state);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::isProfiling -- Returns true if profiling is turned on.
+//
+
+int ScorePageSet::isProfiling(void) {
+   return ScoreProfile::isEnabled();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::clearProfile -- Erase the recorded profile information.
+//
+
+void ScorePageSet::clearProfile(void) {
+   ScoreProfile::clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::printProfile -- Print the time spent in each analysis
+//    and reading function, the number of items that they processed,
+//    and the allocation and cache counters.
+//
+
+ostream& ScorePageSet::printProfile(ostream& out) {
+   return ScoreProfile::print(out);
+}
+
+
+
 //////////////////////////////
 //
 // ScorePageSet::analyzeStaffDurations -- Calculate durations
@@ -201,6 +291,7 @@ void ScorePageSet::setPageOwnerships(void) {
 //
 
 void ScorePageSet::analyzeStaffDurations(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeStaffDurations", 0);
    for (int i=0; i<getPageCount(); i++) {
       analyzeStaffDurations(i);
    }
@@ -224,6 +315,7 @@ void ScorePageSet::analyzeStaffDurations(int index) {
 //
 
 void ScorePageSet::analyzePageSetDurations() {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzePageSetDurations", 0);
    ScorePage* page;
    double cumulativedur = 0.0;
    double duroffset;
@@ -233,8 +325,7 @@ void ScorePageSet::analyzePageSetDurations() {
       for (j=0; j<page->getSystemCount(); j++) {
          vectorSIp& sitems = page->getSystemItems(j);
          for (k=0; k<(int)sitems.size(); k++) {
-            duroffset = cumulativedur + sitems[k]->getParameterDouble(ns_auto,
-                  np_staffOffsetDuration);
+            duroffset = cumulativedur + sitems[k]->getStaffOffsetDuration();
             sitems[k]->setParameterNoisy(ns_auto, np_pagesetOffsetDuration,
                   duroffset);
          }
@@ -0,0 +1,242 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:02 PDT 2026
+// Last Modified: Sat Oct 17 23:59:05 PDT 2026
+// Filename:      ScorePageSet_analysis.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePageSet_analysis.cpp
+// Syntax:        C++11
+//
+// Description:   Run the page and page-set analyses needed for a list of
+//                requested analyses, with the page analyses of separate
+//                pages done in parallel.
+//
+
+#include "ScorePageSet.h"
+#include "ScoreUtility.h"
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace std;
+
+
+// Analyses which are done across all pages of the set.  They are run
+// after the page analyses which they need have been done on every page.
+class _PageSetAnalysis {
+   public:
+      string          name;
+      vector<string>  parents;    // page-set analyses to do first
+      vector<string>  pagenodes;  // page analyses needed on every page
+};
+
+static const vector<_PageSetAnalysis> PageSetAnalyses = {
+   { "segments",         {},           {"systems"} },
+   { "pagesetdurations", {},           {"systems", "duration"} },
+   { "systembreakties",  {"segments"}, {"duration", "systempitches",
+                                        "chords"} },
+   { "lyrics",           {"segments"}, {"systems"} }
+};
+
+// Named groups of analyses for the conversion programs:
+static const vector<pair<string, vector<string>>> AnalysisGroups = {
+   { "musicxml", {"segments", "systembreakties", "systempitches", "duration",
+                  "chords", "beams", "tuplets", "barlines"} },
+   { "mei",      {"segments", "systempitches", "duration", "chords",
+                  "beams", "barlines"} }
+};
+
+static const _PageSetAnalysis* findPageSetAnalysis(const string& name);
+static void addPageSetAnalysis(const _PageSetAnalysis* analysis,
+      vector<const _PageSetAnalysis*>& order, vector<string>& pagenodes);
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::analyze -- Do the requested analyses, and all of the
+//    analyses which they depend on, for the page set.  Analyses can be
+//    page analyses (the node names in AnalysisInfo, such as "chords" or
+//    "systempitches"), the page-set analyses "segments",
+//    "pagesetdurations", "systembreakties" and "lyrics", or the groups
+//    "musicxml" and "mei", which are the analyses used by the
+//    conversion programs (without lyrics).
+//
+//    The page analyses are done first, with separate pages analyzed in
+//    parallel if the thread count is not 1.  Page analyses which are
+//    already valid are not done again.  Then the page-set analyses are
+//    done in the order of their dependencies.  Segments are only
+//    analyzed (by indent) if the set does not already have segments,
+//    and page-set analyses which have already been done by this
+//    function (or which were read from a cache file) are skipped.
+//    Page-set analyses depend on all pages, so they are only skipped
+//    if no page has been added or changed since they were done;
+//    otherwise they are done again when requested.  Segments which were
+//    made by this function are made again in that case, whether or not
+//    they are requested.
+//
+
+void ScorePageSet::analyze(const vector<string>& analyses) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyze", 0);
+   vector<pair<ScorePage*, int>> pagestates;
+   getPageStates(pagestates);
+   int redosegments = 0;
+   if ((pagestates != analyzed_pages) && !completed_analyses.empty()) {
+      redosegments = find(completed_analyses.begin(),
+            completed_analyses.end(), "segments") != completed_analyses.end();
+      if (redosegments) {
+         clearSegments();
+      }
+      completed_analyses.clear();
+      cache_current = 0;
+   }
+
+   vector<string> requested;
+   if (redosegments) {
+      requested.push_back("segments");
+   }
+   for (auto& it : analyses) {
+      auto group = find_if(AnalysisGroups.begin(), AnalysisGroups.end(),
+            [&](const pair<string, vector<string>>& entry) {
+               return entry.first == it;
+            });
+      if (group == AnalysisGroups.end()) {
+         requested.push_back(it);
+      } else {
+         requested.insert(requested.end(), group->second.begin(),
+               group->second.end());
+      }
+   }
+
+   vector<string> pagenodes;
+   vector<const _PageSetAnalysis*> setorder;
+   for (auto& it : requested) {
+      const _PageSetAnalysis* analysis = findPageSetAnalysis(it);
+      if (analysis) {
+         addPageSetAnalysis(analysis, setorder, pagenodes);
+      } else if (find(pagenodes.begin(), pagenodes.end(), it) ==
+            pagenodes.end()) {
+         pagenodes.push_back(it);
+      }
+   }
+
+   // Page analyses (for all overlays of each page):
+   vector<ScorePage*> pages;
+   for (auto& it : page_sequence) {
+      for (int i=0; i<it->getOverlayCount(); i++) {
+         pages.push_back(&(*it)[i]);
+      }
+   }
+   if (!pagenodes.empty()) {
+      SU::runParallel((int)pages.size(), thread_count,
+         [&](int i) { pages[i]->analyze(pagenodes); });
+   }
+   int completedcount = (int)completed_analyses.size();
+   for (auto& it : pagenodes) {
+      if (find(completed_analyses.begin(), completed_analyses.end(), it) ==
+            completed_analyses.end()) {
+         completed_analyses.push_back(it);
+      }
+   }
+
+   // Page-set analyses:
+   for (auto it : setorder) {
+      if (find(completed_analyses.begin(), completed_analyses.end(),
+            it->name) != completed_analyses.end()) {
+         continue;
+      }
+      if (it->name == "segments") {
+         if (getSegmentCount() == 0) {
+            analyzeSegmentsByIndent();
+         }
+      } else if (it->name == "pagesetdurations") {
+         analyzePageSetDurations();
+      } else if (it->name == "systembreakties") {
+         for (int i=0; i<getSegmentCount(); i++) {
+            getSegment(i).analyzeSystemBreakTies();
+         }
+      } else if (it->name == "lyrics") {
+         analyzeLyrics();
+      }
+      completed_analyses.push_back(it->name);
+   }
+
+   if ((int)completed_analyses.size() != completedcount) {
+      cache_current = 0;
+   }
+   getPageStates(analyzed_pages);
+}
+
+
+void ScorePageSet::analyze(const string& analysis) {
+   vector<string> analyses(1, analysis);
+   analyze(analyses);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::getPageStates -- Return each page of the set (including
+//    overlays) with its change count, which are compared by analyze() to
+//    the pages when the page-set analyses were done.
+//
+
+void ScorePageSet::getPageStates(vector<pair<ScorePage*, int>>& states) {
+   states.clear();
+   for (auto& it : page_sequence) {
+      for (int i=0; i<it->getOverlayCount(); i++) {
+         ScorePage* page = &(*it)[i];
+         states.emplace_back(page, page->getChangeCount());
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// findPageSetAnalysis -- Return the page-set analysis with the given
+//    name, or NULL if it is not a page-set analysis.
+//
+
+static const _PageSetAnalysis* findPageSetAnalysis(const string& name) {
+   for (auto& it : PageSetAnalyses) {
+      if (it.name == name) {
+         return &it;
+      }
+   }
+   return NULL;
+}
+
+
+
+//////////////////////////////
+//
+// addPageSetAnalysis -- Add the page-set analyses which the given
+//    analysis depends on to the order, followed by the analysis itself,
+//    and add the page analyses which they need to the list of page
+//    analyses.
+//
+
+static void addPageSetAnalysis(const _PageSetAnalysis* analysis,
+      vector<const _PageSetAnalysis*>& order, vector<string>& pagenodes) {
+   if (find(order.begin(), order.end(), analysis) != order.end()) {
+      return;
+   }
+   for (auto& it : analysis->parents) {
+      const _PageSetAnalysis* parent = findPageSetAnalysis(it);
+      if (parent == NULL) {
+         cerr << "Unknown page-set analysis: " << it << endl;
+         exit(1);
+      }
+      addPageSetAnalysis(parent, order, pagenodes);
+   }
+   for (auto& it : analysis->pagenodes) {
+      if (find(pagenodes.begin(), pagenodes.end(), it) == pagenodes.end()) {
+         pagenodes.push_back(it);
+      }
+   }
+   order.push_back(analysis);
+}
+
+
+
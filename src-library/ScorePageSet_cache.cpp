@@ -0,0 +1,100 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:41 PDT 2026
+// Last Modified: Sat Oct 17 23:59:44 PDT 2026
+// Filename:      ScorePageSet_cache.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePageSet_cache.cpp
+// Syntax:        C++11
+//
+// Description:   ScorePageSet functions for reading pages from an analysis
+//                cache file, and for writing the cache file after the
+//                pages have been analyzed (see ScoreCache.h).
+//
+
+#include "ScorePageSet.h"
+#include "ScoreCache.h"
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScorePageSet::getCacheFilename -- Return the name of the analysis
+//     cache file for an input file.  The cache file is stored next to
+//     the input file, with the cache name (if any) and ".scache" added
+//     to its name.  Programs use their own cache names, since each
+//     cache file contains the analyses done by the program which
+//     wrote it.
+//
+
+string ScorePageSet::getCacheFilename(const string& filename,
+      const string& cachename) {
+   if (cachename.empty()) {
+      return filename + ".scache";
+   }
+   return filename + "." + cachename + ".scache";
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::appendReadCached -- Read the pages and their analyses
+//     from the analysis cache file of the input files if it matches the
+//     current contents of the files.  Otherwise read the files with
+//     appendRead().  The cache file is named after the first input
+//     file and the cache name (see getCacheFilename()), and it is only
+//     used if the page set is empty.  Returns true if the pages were
+//     read from the cache file.  Call updateCache() after analyzing the
+//     pages to create the cache file or to add new analyses to it.
+//
+
+int ScorePageSet::appendReadCached(const vector<string>& filenames,
+      const string& cachename) {
+   if (!page_sequence.empty() || filenames.empty()) {
+      appendRead(filenames);
+      return 0;
+   }
+
+   cache_filename = getCacheFilename(filenames[0], cachename);
+   cache_hash     = ScoreCache::getSourceHash(filenames);
+   ScoreCache cache;
+   if (cache_hash && cache.read(*this, cache_filename, cache_hash)) {
+      cache_pages   = getPageCount();
+      cache_current = 1;
+      return 1;
+   }
+
+   appendRead(filenames);
+   cache_pages   = getPageCount();
+   cache_current = 0;
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::updateCache -- Write the analysis cache file for the
+//     pages read by appendReadCached(), unless it was read from the
+//     cache file and no new analyses have been done by analyze() since
+//     then.  The cache file is not written if no pages were read by
+//     appendReadCached() or if pages have been added after them.
+//     Returns true if the cache file was written.
+//
+
+int ScorePageSet::updateCache(void) {
+   if (cache_filename.empty() || cache_current ||
+         (getPageCount() != cache_pages)) {
+      return 0;
+   }
+   ScoreCache cache;
+   if (!cache.write(*this, cache_filename, cache_hash)) {
+      return 0;
+   }
+   cache_current = 1;
+   return 1;
+}
+
+
+
@@ -23,6 +23,7 @@ using namespace std;
 //
 
 void ScorePageSet::analyzeLyrics(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeLyrics", 0);
    int scount = getSegmentCount();
    for (unsigned int i=0; (int)i<scount; i++) {
       analyzeLyrics(i);
@@ -47,27 +48,23 @@ void ScorePageSet::analyzeLyrics(int segmentindex) {
 //
 
 void ScorePageSet::analyzeLyrics(int segmentindex, int partindex) {
-   const vectorVASp& systems = getSystemAddresses(segmentindex, partindex);
+   vector<SegmentSystem>& systems = getSegment(segmentindex).getSystems();
    int i, j;
 
-   ScoreSegment& seg = getSegment(segmentindex);
    int systemcount = systems.size();
 
    vectorI p2vals(systemcount);
    fill(p2vals.begin(), p2vals.end(), -1);
 
-   AddressSystem address;
-
    vectorVI verseP4s(systemcount);
    vectorVSF vposes(systemcount);
 
    for (i=0; i<(int)systems.size(); i++) {
-      p2vals[i] = seg.getPageStaffIndex(i, partindex);
+      p2vals[i] = systems[i].getPageStaffIndex(partindex);
       if (p2vals[i] <= 0) {
          continue;
       }
-      address = *systems[i][0];
-      vectorSIp& items = seg.getSystemItems(address);
+      vectorSIp& items = systems[i].getItems();
       identifyLyricsOnStaff(items, p2vals[i], verseP4s[i]);
    }
 
@@ -191,9 +188,7 @@ void ScorePageSet::analyzeLyrics(int segmentindex, int partindex) {
 //
 
 void ScorePageSet::linkLyricsToNotes(int segmentindex, int partindex) {
-   ScoreSegment& seg = getSegment(segmentindex);
-   const vectorVASp& systems = getSystemAddresses(segmentindex, partindex);
-   AddressSystem address;
+   vector<SegmentSystem>& systems = getSegment(segmentindex).getSystems();
    int systemcount = systems.size();
    int i, j, k, m, n;
    int p2;
@@ -215,13 +210,12 @@ void ScorePageSet::linkLyricsToNotes(int segmentindex, int partindex) {
       lyricslist.resize(2000);
       notelist.clear();
       notelist.resize(2000);
-      p2 = seg.getPageStaffIndex(i, partindex);
+      p2 = systems[i].getPageStaffIndex(partindex);
       if (p2 <= 0) {
          continue;
       }
-      address = *systems[i][0];
-      page = getPage(address);
-      vectorSIp& items = seg.getSystemItems(address);
+      page = systems[i].getPage();
+      vectorSIp& items = systems[i].getItems();
       for (auto& it : items) {
          if (p2 != (int)it->getStaffNumber()) {
             continue;
@@ -280,10 +274,7 @@ void ScorePageSet::fillStaffText(vectorVSIp& text, int segmentindex,
       int partindex, int systemindex, vectorI& verses, vectorSF& average,
       int staffindex) {
    ScoreSegment& seg = getSegment(segmentindex);
-   const vectorVASp& systems = getSystemAddresses(segmentindex, partindex);
-   AddressSystem address;
-   address = *systems[systemindex][0];
-   vectorSIp& items = seg.getSystemItems(address);
+   vectorSIp& items = seg.getSystemItems(systemindex);
 
    //vectorVSIp text(2000);
    text.clear();
@@ -347,11 +338,8 @@ int ScorePageSet::identifyExtraVerses(vectorVSIp& text, int segmentindex,
       int staffindex) {
 
    ScoreSegment& seg = getSegment(segmentindex);
-   const vectorVASp& systems = getSystemAddresses(segmentindex, partindex);
-   AddressSystem address;
    int output = 0;
-   address = *systems[systemindex][0];
-   vectorSIp& items = seg.getSystemItems(address);
+   vectorSIp& items = seg.getSystemItems(systemindex);
 
    // Store information about possible lyrics
    int i, j;
@@ -551,8 +539,7 @@ void ScorePageSet::changeVerseLine(vectorVSIp& vertical, int oldnum, int newnum,
 
 void ScorePageSet::stitchLyricsHyphensAcrossSystems(int segmentindex,
       int partindex, int lyriccount) {
-   const vectorVASp& systems = getSystemAddresses(segmentindex, partindex);
-   ScoreSegment& seg = getSegment(segmentindex);
+   vector<SegmentSystem>& systems = getSegment(segmentindex).getSystems();
    int systemcount = systems.size();
    int p2;
 
@@ -561,17 +548,15 @@ void ScorePageSet::stitchLyricsHyphensAcrossSystems(int segmentindex,
    fill(lastlyric.begin(), lastlyric.end(), 0);
    fill(lastsys.begin(), lastsys.end(), 0);
    int p1;
-   AddressSystem address;
    int versenum;
 
    int i;
    for (i=0; i<systemcount; i++) {
-      p2 = seg.getPageStaffIndex(i, partindex);
+      p2 = systems[i].getPageStaffIndex(partindex);
       if (p2 <= 0) {
          continue;
       }
-      address = *systems[i][0];
-      vectorSIp& items = seg.getSystemItems(address);
+      vectorSIp& items = systems[i].getItems();
       for (auto& it : items) {
          if (!it->isDefined(ns_auto, np_verseLine)) {
             continue;
@@ -20,6 +20,7 @@ using namespace std;
 //
 
 void ScorePageSet::analyzePitch(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzePitch", 0);
    ScorePageSet& sps = *this;
    int pcount = getPageCount();
    int ocount;
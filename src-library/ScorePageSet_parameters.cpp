@@ -67,3 +67,20 @@ void ScorePageSet::deleteNamespace(const string& nspace) {
 
 
 
+//////////////////////////////
+//
+// ScorePageSet::exportAnalysisParameters -- Copy the analysis results
+//    of all pages into the auto namespace of their items.
+//
+
+void ScorePageSet::exportAnalysisParameters(void) {
+   for (auto& it : page_storage) {
+      int overlaycount = it->getOverlayCount();
+      for (unsigned int j=0; (int)j<overlaycount; j++) {
+         it->getPage(j)->exportAnalysisParameters();
+      }
+   }
+}
+
+
+
@@ -10,8 +10,12 @@
 //
 
 #include "ScorePageSet.h"
-#include <regex>
-#include <sstream>
+#include "MappedFile.h"
+#include "ScoreUtility.h"
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+#include <ctype.h>
 
 using namespace std;
 
@@ -21,16 +25,42 @@ using namespace std;
 // ScorePageSet::appendReadFromOptionArguments -- Read earch argument
 //    of the option class as a file.  The file may be in binary,
 //    PMX or XML formats, and each file may contain one or more
-//    pages/overlays.
+//    pages/overlays.  If the "threads" option is defined, then
+//    its value will be used to set the number of threads used to
+//    parse the pages.  If the "profile" option is defined and set,
+//    then profiling is turned on before reading, and the profile is
+//    printed to standard error when the program exits.  If the "cache"
+//    option is defined and set, then the files are read with
+//    appendReadCached(), using the name of the program as the cache
+//    name.
 //
 
 void ScorePageSet::appendReadFromOptionArguments(Options& opts) {
+   if (opts.isDefined("threads")) {
+      setThreadCount(opts.getInteger("threads"));
+   }
+   if (opts.isDefined("profile") && opts.getBoolean("profile")) {
+      setProfiling(1);
+      ScoreProfile::printOnExit();
+   }
    if (opts.getArgumentCount() == 0) {
       appendRead(cin, "<stdin>");
       return;
    }
+   vector<string> filenames;
+   filenames.reserve(opts.getArgumentCount());
    for (int i=1; i<=opts.getArgumentCount(); i++) {
-      appendRead(opts.getArgument(i));
+      filenames.push_back(opts.getArgument(i));
+   }
+   if (opts.isDefined("cache") && opts.getBoolean("cache")) {
+      string command = opts.getCommand();
+      size_t slash = command.rfind('/');
+      if (slash != string::npos) {
+         command = command.substr(slash + 1);
+      }
+      appendReadCached(filenames, command);
+   } else {
+      appendRead(filenames);
    }
 
    // setPageOwnerships done in appendRead();
@@ -48,36 +78,39 @@ void ScorePageSet::read(Options& opts) {
 
 //////////////////////////////
 //
-// ScorePageSet::appendRead --
+// ScorePageSet::appendRead -- Read one or more files.  The page
+//     boundaries in each file are found first, then the pages are
+//     parsed (in parallel if the thread count is not 1), and finally
+//     the pages are stored in the order that they occur in the input
+//     files.
 //
 
 void ScorePageSet::appendRead(const string& filename) {
-   int binaryQ = 0;  // to test if reading a binary or PMX data file.
+   vector<string> filenames(1, filename);
+   appendRead(filenames);
+}
 
-   ifstream testfile(filename);
 
-   if (!testfile.is_open()) {
-      cerr << "Error: cannot read the file: " << filename << endl;
-      exit(1);
-   }
+void ScorePageSet::appendRead(const vector<string>& filenames) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::appendRead", 0);
+   vector<MappedFile*> files(filenames.size(), NULL);
+   vector<PageSource> sources;
 
-   // The last 4 bytes of a binary SCORE file are 00 3c 1c c6 which equals
-   // the float value -9999.0.
-   testfile.seekg(-4, ios::end);
-   unsigned char databytes[4] = {0xff};
-   testfile.read((char*)databytes, 4);
-   if (databytes[0] == 0x00 && databytes[1] == 0x3c && databytes[2] == 0x1c &&
-         databytes[3] == 0xc6) {
-      binaryQ = 1;
-   } else {
-      binaryQ = 0;
+   for (int i=0; i<(int)filenames.size(); i++) {
+      files[i] = new MappedFile(filenames[i]);
+      if (!files[i]->isOpen()) {
+         cerr << "Error: cannot read the file: " << filenames[i] << endl;
+         exit(1);
+      }
+      splitFilePages(sources, *files[i], filenames[i]);
    }
-   testfile.seekg(0, ios::beg);
 
-   if (binaryQ) {
-      appendReadBinary(testfile, filename);
-   } else {
-      appendReadPmx(testfile, filename);
+   parsePageSources(sources);
+   appendPageSources(sources);
+
+   for (auto& it : files) {
+      delete it;
+      it = NULL;
    }
    setPageOwnerships();
 }
@@ -103,6 +136,7 @@ void ScorePageSet::appendReadStandardInput(void) {
 //
 
 void ScorePageSet::appendRead(istream& instream, const string& filename) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::appendRead", 0);
    appendReadPmx(instream, filename);
    setPageOwnerships();
 }
@@ -111,7 +145,8 @@ void ScorePageSet::appendRead(istream& instream, const string& filename) {
 
 //////////////////////////////
 //
-// ScorePageSet::appendReadBinary --
+// ScorePageSet::appendReadBinary -- Read a binary SCORE page from an
+//     input stream or from a block of memory.
 //
 
 void ScorePageSet::appendReadBinary(istream& instream, const string& filename) {
@@ -124,10 +159,26 @@ void ScorePageSet::appendReadBinary(istream& instream, const string& filename) {
 
 
 
+void ScorePageSet::appendReadBinary(const char* data, size_t size,
+      const string& filename) {
+   ScorePage* pageptr = new ScorePage;
+   pageptr->readBinary(data, size);
+   pageptr->setFilename(filename);
+   appendPage(pageptr);
+   setPageOwnerships();
+}
+
+
+
 //////////////////////////////
 //
 // ScorePageSet::appendReadPmx -- Read potentially multiple pages and
-//     overlays of ASCII PMX data from an input stream.
+//     overlays of ASCII PMX data from an input stream or a block of
+//     memory.  Page boundaries are given either by RS lines (followed
+//     by an optional "SA filename" line), or by "###ScorePage: filename"
+//     lines.  Overlays are started with "###ScoreOverlay: filename" lines.
+//     The data for each page is given directly to the page parser
+//     without first being copied out of the input buffer.
 //
 //     Default values:
 //     	   pagetype = "page";
@@ -136,189 +187,347 @@ void ScorePageSet::appendReadBinary(istream& instream, const string& filename) {
 
 void ScorePageSet::appendReadPmx(istream& instream, const string& filename,
       const string& pagetype, int informat) {
+   string contents((istreambuf_iterator<char>(instream)),
+         istreambuf_iterator<char>());
+   appendReadPmx(contents.data(), contents.size(), filename, pagetype,
+         informat);
+}
+
+
+void ScorePageSet::appendReadPmx(const char* data, size_t size,
+      const string& filename, const string& pagetype, int informat) {
+   vector<PageSource> sources;
+   splitPmxPages(sources, data, size, filename, pagetype, informat);
+   parsePageSources(sources);
+   appendPageSources(sources);
+   setPageOwnerships();
+}
 
-   int dataQ        = 0;
-   int pagestart    = 0;
-   int overlaystart = 0;
-   int nextpage     = 0;
-   int nextoverlay  = 0;
 
-   if (pagetype == "page") {
-      pagestart = 1;
-   } else if (pagetype == "overlay") {
-      overlaystart = 1;
+
+//////////////////////////////
+//
+// ScorePageSet::splitFilePages -- Find the pages in the contents of an
+//     input file.  A binary SCORE file contains a single page, and PMX
+//     files may contain multiple pages and overlays (see splitPmxPages()).
+//
+
+void ScorePageSet::splitFilePages(vector<PageSource>& sources,
+      MappedFile& infile, const string& filename) {
+   // The last 4 bytes of a binary SCORE file are 00 3c 1c c6 which
+   // equals the float value -9999.0.
+   if (infile.isBinaryScore()) {
+      PageSource source;
+      source.filename = filename;
+      source.overlayQ = 0;
+      source.binaryQ  = 1;
+      source.format   = PPMX_PAGE_MARKER_RS;
+      source.page     = NULL;
+      source.ranges.push_back(make_pair(infile.begin(), infile.end()));
+      sources.push_back(source);
+   } else {
+      splitPmxPages(sources, infile.data(), infile.size(), filename,
+            "page", 0);
    }
+}
 
-   int format = informat;   // 1 = RS method 2 = ###ScorePage: method.
 
-   stringstream data;  // temporary storage of file contents to be parsed
-   string testname;
-   string transfer;
-   string nextfilename = "UNDEFINED";
-   string localtype    = pagetype;
-   string localfile    = filename;
-   regex  pmxdataline  (R"(^\s*[\dtT+-])");
-   regex  startpage1   (  "^[Rr][Ss]");
-   regex  spname1      (R"(^[Rr][Ss]\s+([^\s]+))");
-   regex  spname3      (R"(^[Ss][Aa]\s+([^\s]+))");
-   regex  startpage2   (  "###ScorePage");
-   regex  spname2      (R"(###ScorePage:\s*([^\s]+))");
-   regex  overlaypage  (  "###ScoreOverlay");
-   regex  opname       (R"(###ScoreOverlay:\s*([^\s]+))");
-   smatch match;
-
-   while (getline(instream, transfer)) {
-      if (instream.eof()) {
-         break;
-      }
 
-      if (dataQ == 0) {
-         if (regex_search(transfer, pmxdataline)) {
-            dataQ = 1;
-         }
-      }
+//////////////////////////////
+//
+// ScorePageSet::splitPmxPages -- Find the boundaries of the pages and
+//     overlays in a block of PMX data (see appendReadPmx()).  The pages
+//     are not parsed.
+//
 
-      if (regex_search(transfer, startpage1)) {
-         // READING RS PAGE
+void ScorePageSet::splitPmxPages(vector<PageSource>& sources,
+      const char* data, size_t size, const string& filename,
+      const string& pagetype, int informat) {
 
-         format = PPMX_PAGE_MARKER_RS;
-         if (dataQ) {
-            // Already have PMX data, so store that with the previously
-            // given filename.
-            nextpage    = 1;
-            nextoverlay = 0;
-            nextfilename = testname;
-            break;
-         } else {
-            // Don't have PMX data so store the newly read filename
-            // for the current page.
-            pagestart = 1;
-            overlaystart = 0;
-            localtype = "page";
-            localfile = testname;
-            continue;
+   const char* ptr = data;
+   const char* end = data + size;
+   const char* line;
+   const char* lineend;
+
+   int format = informat;   // 1 = RS method 2 = ###ScorePage: method.
+
+   string localtype = pagetype;
+   string localfile = filename;
+   string testname;
+   string nextfilename;
+
+   // ranges are the byte ranges of the lines which belong to the
+   // current page.  Lines containing page markers are not included,
+   // so there may be more than one range for a page.
+   vector<pair<const char*, const char*>> ranges;
+
+   int dataQ;
+   int pagestart;
+   int overlaystart;
+   int nextpage;
+   int nextoverlay;
+
+   while (1) {
+      dataQ        = 0;
+      pagestart    = (localtype == "page");
+      overlaystart = (localtype == "overlay");
+      nextpage     = 0;
+      nextoverlay  = 0;
+      testname.clear();
+      ranges.clear();
+
+      while (ptr < end) {
+         line    = ptr;
+         lineend = (const char*)memchr(ptr, '\n', end - ptr);
+         if (lineend == NULL) {
+            lineend = end;
          }
-      } else if (regex_search(transfer, startpage2)) {
-         format = PPMX_PAGE_MARKER_COMMENT;
-         regex_search(transfer, match, spname2);
-         if (match.size() >= 2) {
-            testname = match[1].str();
-         } else {
-            testname = "";
+         ptr     = lineend < end ? lineend + 1 : end;
+
+         if (dataQ == 0) {
+            if (isPmxDataLine(line, lineend)) {
+               dataQ = 1;
+            }
          }
 
-         if (dataQ) {
-            // Already have PMX data, so store that with the previously
-            // given filename.
-            nextpage    = 1;
-            nextoverlay = 0;
-            nextfilename = testname;
-            break;
-         } else {
-            // Don't have PMX data so store the newly read filename
-            // for the current page.
-            pagestart = 1;
-            overlaystart = 0;
-            localtype = "page";
-            localfile = testname;
-            continue;
+         if ((lineend - line >= 2) && ((line[0] == 'R') || (line[0] == 'r'))
+               && ((line[1] == 'S') || (line[1] == 's'))) {
+            // READING RS PAGE
+            format = PPMX_PAGE_MARKER_RS;
+            if (dataQ) {
+               // Already have PMX data, so store that with the previously
+               // given filename.
+               nextpage     = 1;
+               nextfilename = testname;
+               break;
+            } else {
+               // Don't have PMX data so store the newly read filename
+               // for the current page.
+               pagestart    = 1;
+               overlaystart = 0;
+               localtype    = "page";
+               localfile    = testname;
+               continue;
+            }
+         } else if (findMarker(line, lineend, "###ScorePage")) {
+            format = PPMX_PAGE_MARKER_COMMENT;
+            getMarkerName(testname, line, lineend, "###ScorePage:");
+            if (dataQ) {
+               nextpage     = 1;
+               nextfilename = testname;
+               break;
+            } else {
+               pagestart    = 1;
+               overlaystart = 0;
+               localtype    = "page";
+               localfile    = testname;
+               continue;
+            }
          }
-      }
 
-      if ((format == PPMX_PAGE_MARKER_RS) && regex_search(transfer, spname3)) {
-         regex_search(transfer, match, spname3);
-         if (match.size() >= 2) {
-            localfile = match[1].str();
-            testname = "";
-         } else {
-            testname = "";
-            localtype = "page";
-            localfile = testname;
+         if ((format == PPMX_PAGE_MARKER_RS) && (lineend - line >= 3) &&
+               ((line[0] == 'S') || (line[0] == 's')) &&
+               ((line[1] == 'A') || (line[1] == 'a')) &&
+               isspace((unsigned char)line[2])) {
+            // "SA filename" line after RS gives the name of the page.
+            string name;
+            getMarkerName(name, line, lineend, "");
+            if (!name.empty()) {
+               localfile = name;
+               testname  = "";
+            }
          }
-      }
 
-      if (regex_search(transfer, overlaypage)) {
-         regex_search(transfer, match, opname);
-         if (match.size() >= 2) {
-            testname = match[1].str();
-         } else {
-            testname = "";
+         if (findMarker(line, lineend, "###ScoreOverlay")) {
+            getMarkerName(testname, line, lineend, "###ScoreOverlay:");
+            if (dataQ) {
+               nextoverlay  = 1;
+               nextfilename = testname;
+               break;
+            } else {
+               overlaystart = 1;
+               pagestart    = 0;
+               localtype    = "overlay";
+               localfile    = testname;
+               continue;
+            }
          }
 
-         if (dataQ) {
-            // Already have PMX data, so store that with the previously
-            // given filename.
-            nextpage    = 0;
-            nextoverlay = 1;
-            nextfilename = testname;
-            break;
+         if (!ranges.empty() && (ranges.back().second == line)) {
+            ranges.back().second = ptr;
          } else {
-            // Don't have PMX data so store the newly read filename
-            // for the current page.
-            overlaystart = 1;
-            pagestart = 0;
-            localtype = "overlay";
-            localfile = testname;
-            continue;
+            ranges.push_back(make_pair(line, ptr));
          }
+      }
 
+      if (pagestart || overlaystart || dataQ) {
+         sources.resize(sources.size() + 1);
+         PageSource& source = sources.back();
+         source.filename = localfile;
+         source.overlayQ = overlaystart && !pagestart;
+         source.binaryQ  = 0;
+         source.format   = format;
+         source.page     = NULL;
+         source.ranges.swap(ranges);
       }
-      data << transfer << "\n";
-   }
 
-   if (pagestart) {
-      ScorePage* pageptr = new ScorePage;
-      pageptr->read(data);
-      pageptr->setFilename(localfile);
-      if (format == PPMX_PAGE_MARKER_COMMENT) {
-         pageptr->setMultipageComment();
+      if (nextpage) {
+         localtype = "page";
+         localfile = nextfilename;
+      } else if (nextoverlay) {
+         localtype = "overlay";
+         localfile = nextfilename;
       } else {
-         pageptr->setMultipageRs();
+         // reached the end of the data.
+         break;
       }
-      appendPage(pageptr);
-      localfile = testname;
-      pagestart = 0;
-   } else if (overlaystart) {
-      ScorePage* pageptr = new ScorePage;
-      pageptr->read(data);
-      pageptr->setFilename(localfile);
-      if (format == PPMX_PAGE_MARKER_COMMENT) {
-         pageptr->setMultipageComment();
-      } else {
-         pageptr->setMultipageRs();
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::parsePageSources -- Create the pages for a list of
+//     page sources.  If the thread count is not 1, then the pages are
+//     parsed in parallel.  Each thread takes the next unparsed page
+//     from the list until all pages have been parsed.
+//
+
+void ScorePageSet::parsePageSources(vector<PageSource>& sources) {
+   SU::runParallel((int)sources.size(), thread_count,
+      [&](int index) { parsePageSource(sources[index]); });
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::parsePageSource -- Create a page from the data of
+//     a page source.
+//
+
+void ScorePageSet::parsePageSource(PageSource& source) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::parsePageSource", 0);
+   ScorePage* pageptr = new ScorePage;
+   if (source.binaryQ) {
+      const char* data = source.ranges[0].first;
+      pageptr->readBinary(data, (size_t)(source.ranges[0].second - data));
+   } else {
+      for (auto& it : source.ranges) {
+         pageptr->addPmxData(it.first, (size_t)(it.second - it.first));
       }
-      appendOverlay(pageptr);
-      localfile = testname;
-      overlaystart = 0;
-   } else if (dataQ) {
-      // catch possible unlabeled page
-      ScorePage* pageptr = new ScorePage;
-      pageptr->read(data);
-      pageptr->setFilename(localfile);
-      if (format == PPMX_PAGE_MARKER_COMMENT) {
+   }
+   pageptr->setFilename(source.filename);
+   if (!source.binaryQ) {
+      if (source.format == PPMX_PAGE_MARKER_COMMENT) {
          pageptr->setMultipageComment();
       } else {
          pageptr->setMultipageRs();
       }
-      appendPage(pageptr);
-      localfile = testname;
-      pagestart = 0;
    }
+   source.page = pageptr;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::appendPageSources -- Store the parsed pages in the
+//     order of the page sources.
+//
 
-   if (nextpage) {
-      localtype = "page";
-      localfile = nextfilename;
-   } else if (nextoverlay) {
-      localtype = "overlay";
-      localfile = nextfilename;
+void ScorePageSet::appendPageSources(vector<PageSource>& sources) {
+   for (auto& it : sources) {
+      if (it.overlayQ) {
+         appendOverlay(it.page);
+      } else {
+         appendPage(it.page);
+      }
+      it.page = NULL;
    }
+}
+
+
 
-   if (!instream.eof()) {
-      appendReadPmx(instream, localfile, localtype, format);
+//////////////////////////////
+//
+// ScorePageSet::isPmxDataLine -- Returns true if the line starts with
+//     a number or a "t" (for text items), ignoring leading spaces.
+//
+
+int ScorePageSet::isPmxDataLine(const char* line, const char* lineend) {
+   while ((line < lineend) && isspace((unsigned char)*line)) {
+      line++;
    }
+   if (line >= lineend) {
+      return 0;
+   }
+   switch (*line) {
+      case 't': case 'T': case '+': case '-':
+         return 1;
+   }
+   return isdigit((unsigned char)*line) ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageSet::findMarker -- Return a pointer to the first occurrence
+//     of the marker text on the line, or NULL if not found.
+//
+
+const char* ScorePageSet::findMarker(const char* line, const char* lineend,
+      const char* marker) {
+   int length = strlen(marker);
+   const char* found = search(line, lineend, marker, marker + length);
+   return found == lineend ? NULL : found;
+}
 
-   setPageOwnerships();
 
+
+//////////////////////////////
+//
+// ScorePageSet::getMarkerName -- Extract the first word which follows
+//     the marker text on the line (such as the filename in the line
+//     "###ScorePage: filename").  If the marker is an empty string, then
+//     the word after the first space on the line is extracted.  The output
+//     is an empty string if no word is found.
+//
+
+string& ScorePageSet::getMarkerName(string& output, const char* line,
+      const char* lineend, const char* marker) {
+   output.clear();
+   int length = strlen(marker);
+   const char* ptr = line;
+   while (ptr < lineend) {
+      if (length > 0) {
+         ptr = findMarker(ptr, lineend, marker);
+         if (ptr == NULL) {
+            break;
+         }
+         ptr += length;
+      } else {
+         while ((ptr < lineend) && !isspace((unsigned char)*ptr)) {
+            ptr++;
+         }
+      }
+      while ((ptr < lineend) && isspace((unsigned char)*ptr)) {
+         ptr++;
+      }
+      const char* word = ptr;
+      while ((ptr < lineend) && !isspace((unsigned char)*ptr)) {
+         ptr++;
+      }
+      if (ptr > word) {
+         output.assign(word, ptr);
+         break;
+      } else if (length == 0) {
+         break;
+      }
+   }
+   return output;
 }
 
 
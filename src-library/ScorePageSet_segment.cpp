@@ -10,8 +10,6 @@
 //
 
 #include "ScorePageSet.h"
-#include "ScoreUtility.h"
-#include <set>
 
 using namespace std;
 
@@ -22,6 +20,7 @@ using namespace std;
 //
 
 void ScorePageSet::analyzeSingleSegment(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeSingleSegment", 0);
    ScorePageSet& pageset = *this;
 
    int pagecount = pageset.getPageCount();
@@ -41,6 +40,7 @@ void ScorePageSet::analyzeSingleSegment(void) {
 
 void ScorePageSet::analyzeSegmentsByIndent(SCORE_FLOAT threshold1,
       SCORE_FLOAT threshold2) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeSegmentsByIndent", 0);
    int p, s;
    ScorePageSet& pageset = *this;
    AddressSystem  lastIndent(0,0,0,0);
@@ -133,6 +133,7 @@ void ScorePageSet::clearSegments(void) {
       it = NULL;
    }
    segment_storage.resize(0);
+   completed_analyses.clear();
 }
 
 
@@ -166,27 +167,12 @@ ScoreSegment& ScorePageSet::getSegment(int index) {
 //    in terms of divisions of a quarter note.  In other words,
 //    quarter notes are the largest duration this function will return,
 //    so even if all notes in the segment are half-notes, this function
-//    will say the smallest rhythm is a quarter note.
+//    will say the smallest rhythm is a quarter note.  This is the tick
+//    resolution of the segment (see ScoreSegment::getTicksPerQuarter()).
 //
 
 int  ScorePageSet::getLCMRhythm(int segmentindex) {
-   ScoreSegment& seg = getSegment(segmentindex);
-   int syscount = seg.getSystemCount();
-   set<int> numbers;
-   int pageindex;
-   int overlayindex;
-   int systemindex;
-
-   for (int i=0; i<syscount; i++) {
-      const AddressSystem& current = seg.getSystemAddress(i);
-      pageindex    = current.getPageIndex();
-      overlayindex = current.getOverlayIndex();
-      systemindex  = current.getSystemIndex();
-      ScorePage* page = this->getPage(pageindex, overlayindex);
-      numbers.insert(page->getSystemLCMRhythm(systemindex));
-   }
-
-   return ScoreUtility::lcm(numbers);
+   return getSegment(segmentindex).getTicksPerQuarter();
 }
 
 
@@ -226,7 +212,8 @@ const vectorVASp& ScorePageSet::getSystemAddresses(int segmentindex,
 ///////////////////////////////
 //
 // ScorePageSet::getPartScale --  Return the P5 scale factor of the
-//     first staff item of the given part in the given segment.
+//     first staff item of the given part in the given segment, or 1.0
+//     if the staff is not on the first system of the segment.
 //
 
 SCORE_FLOAT ScorePageSet::getPartScale(int segmentindex, int partindex) {
@@ -236,7 +223,14 @@ SCORE_FLOAT ScorePageSet::getPartScale(int segmentindex, int partindex) {
    vectorVVSIp& staffitems = page->getStaffItemsBySystem();
    int sysstaffindex       = address.getSystemStaffIndex();
    int systemindex         = address.getSystemIndex();
-   // (Check to see if the index location is valid):
+   if ((systemindex < 0) || (systemindex >= (int)staffitems.size())) {
+      return 1.0;
+   }
+   if ((sysstaffindex < 0) ||
+         (sysstaffindex >= (int)staffitems[systemindex].size()) ||
+         staffitems[systemindex][sysstaffindex].empty()) {
+      return 1.0;
+   }
    return staffitems[systemindex][sysstaffindex][0]->getScale();
 }
 
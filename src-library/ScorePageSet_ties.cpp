@@ -23,6 +23,7 @@ using namespace std;
 //
 
 void ScorePageSet::analyzeTies(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeTies", 0);
    // Need duration offsets and pitch analyses before
    // doing tie analysis.  This should be fixed a bit
    // later (should be automated, but is not for some reason).
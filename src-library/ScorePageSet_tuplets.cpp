@@ -23,6 +23,7 @@ using namespace std;
 //
 
 void ScorePageSet::analyzeTuplets(void) {
+   SCORE_PROFILE_SCOPE("ScorePageSet::analyzeTuplets", 0);
    for (unsigned int i=0; (int)i<getPageCount(); i++) {
       (*this)[i][0].analyzeTuplets();
    }
@@ -0,0 +1,417 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:57 PDT 2026
+// Last Modified: Sat Oct 17 23:59:59 PDT 2026
+// Filename:      ScorePageStream.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePageStream.cpp
+// Syntax:        C++11
+//
+// Description:   Read the pages of a list of input files one at a time
+//                (see ScorePageStream.h).
+//
+
+#include "ScorePageStream.h"
+#include "ScoreUtility.h"
+#include <iterator>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScorePageStream::ScorePageStream -- Constructor.  The Options version
+//     opens the files given as arguments (see openFromOptionArguments()).
+//
+
+ScorePageStream::ScorePageStream(void) {
+   window_before = 0;
+   window_after  = 0;
+   thread_count  = 1;
+   clear();
+}
+
+
+ScorePageStream::ScorePageStream(Options& opts) {
+   window_before = 0;
+   window_after  = 0;
+   thread_count  = 1;
+   clear();
+   openFromOptionArguments(opts);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::~ScorePageStream -- Deconstructor.
+//
+
+ScorePageStream::~ScorePageStream() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::clear -- Delete the pages in the window and close
+//     the input files.  The window size, analyses and thread count are
+//     not changed.
+//
+
+void ScorePageStream::clear(void) {
+   for (auto& it : window) {
+      delete it;
+      it = NULL;
+   }
+   window.clear();
+   for (auto& it : files) {
+      delete it;
+      it = NULL;
+   }
+   files.clear();
+   sources.clear();
+   filenames.clear();
+   next_file      = 0;
+   window_current = -1;
+   page_index     = -1;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::open -- Start reading the pages of one or more files.
+//     The files are opened when their pages are needed.
+//
+
+void ScorePageStream::open(const string& filename) {
+   vector<string> filelist(1, filename);
+   open(filelist);
+}
+
+
+void ScorePageStream::open(const vector<string>& filelist) {
+   clear();
+   filenames = filelist;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::openStandardInput -- Start reading the pages of PMX
+//     data from standard input.  All of the input is read at once, but
+//     the pages are parsed when they are needed.
+//
+
+void ScorePageStream::openStandardInput(void) {
+   clear();
+   StreamFile* infile = new StreamFile;
+   infile->contents.assign(istreambuf_iterator<char>(cin),
+         istreambuf_iterator<char>());
+   vector<ScorePageSet::PageSource> pages;
+   ScorePageSet::splitPmxPages(pages, infile->contents.data(),
+         infile->contents.size(), "<stdin>", "page", 0);
+   addFile(infile, pages);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::openFromOptionArguments -- Start reading the pages
+//     of the files given as arguments, or of standard input if there
+//     are no arguments.  If the "threads" option is defined, then it
+//     sets the number of threads used to parse and analyze the pages.
+//
+
+void ScorePageStream::openFromOptionArguments(Options& opts) {
+   if (opts.isDefined("threads")) {
+      setThreadCount(opts.getInteger("threads"));
+   }
+   if (opts.getArgumentCount() == 0) {
+      openStandardInput();
+      return;
+   }
+   vector<string> filelist;
+   filelist.reserve(opts.getArgumentCount());
+   for (int i=1; i<=opts.getArgumentCount(); i++) {
+      filelist.push_back(opts.getArgument(i));
+   }
+   open(filelist);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::setWindow -- Set the number of pages to keep before
+//     the current page and to read ahead of it.  These pages can be
+//     accessed with getPage().  The default is to keep no pages other
+//     than the current one.
+//
+
+void ScorePageStream::setWindow(int before, int after) {
+   window_before = before < 0 ? 0 : before;
+   window_after  = after  < 0 ? 0 : after;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::setAnalyses -- Set the analyses (see
+//     ScorePage::analyze()) to do on each page and overlay when it is
+//     read.
+//
+
+void ScorePageStream::setAnalyses(const vector<string>& list) {
+   analyses = list;
+}
+
+
+void ScorePageStream::setAnalyses(const string& analysis) {
+   analyses.assign(1, analysis);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::setThreadCount -- Set the number of threads used to
+//     parse and analyze the pages which are read at the same time (the
+//     pages read ahead for the window).  A count of 0 will use one thread
+//     for each processor core.
+//
+
+void ScorePageStream::setThreadCount(int count) {
+   if (count < 0) {
+      count = 1;
+   }
+   thread_count = count;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::next -- Move to the next page, reading it if it is
+//     not already in the window, and deleting the pages which are no
+//     longer in the window.  Returns false if there are no more pages.
+//     The first call moves to the first page.
+//
+
+int ScorePageStream::next(void) {
+   window_current++;
+   while (window_current > window_before) {
+      delete window.front();
+      window.pop_front();
+      window_current--;
+   }
+   int needed = window_current + window_after + 1 - (int)window.size();
+   if (needed > 0) {
+      loadPages(needed);
+   }
+   if (window_current >= (int)window.size()) {
+      return 0;
+   }
+   page_index++;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::hasNext -- Returns true if there is a page after the
+//     current page.  Pages are not parsed to check this, but input files
+//     may be opened to find their pages.
+//
+
+int ScorePageStream::hasNext(void) {
+   if (window_current + 1 < (int)window.size()) {
+      return 1;
+   }
+   while (sources.empty()) {
+      if (!splitNextFile()) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::getPageIndex -- Return the index of the current page
+//     in the stream, or -1 if next() has not been called yet.
+//
+
+int ScorePageStream::getPageIndex(void) {
+   return page_index;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::getCurrent -- Return the current page and its
+//     overlays.
+//
+
+ScorePageOverlay& ScorePageStream::getCurrent(void) {
+   ScorePageOverlay* page = getPage(0);
+   if (page == NULL) {
+      cerr << "Error: no current page in stream" << endl;
+      exit(1);
+   }
+   return *page;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::getPage -- Return a page in the window relative to
+//     the current page (negative offsets for previous pages), or NULL
+//     if the page is not in the window.
+//
+
+ScorePageOverlay* ScorePageStream::getPage(int offset) {
+   int index = window_current + offset;
+   if ((page_index < 0) || (index < 0) || (index >= (int)window.size())) {
+      return NULL;
+   }
+   return window[index];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Private functions:
+//
+
+//////////////////////////////
+//
+// ScorePageStream::splitNextFile -- Open the next input file and find
+//     its pages.  Returns false if there are no more files.
+//
+
+int ScorePageStream::splitNextFile(void) {
+   if (next_file >= (int)filenames.size()) {
+      return 0;
+   }
+   const string& filename = filenames[next_file++];
+   StreamFile* infile = new StreamFile;
+   if (!infile->file.open(filename)) {
+      cerr << "Error: cannot read the file: " << filename << endl;
+      exit(1);
+   }
+   vector<ScorePageSet::PageSource> pages;
+   ScorePageSet::splitFilePages(pages, infile->file, filename);
+   addFile(infile, pages);
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::addFile -- Store an input file and the pages found
+//     in it, which will be parsed when they are needed.
+//
+
+void ScorePageStream::addFile(StreamFile* infile,
+      vector<ScorePageSet::PageSource>& pages) {
+   infile->pending = (int)pages.size();
+   files.push_back(infile);
+   for (auto& it : pages) {
+      StreamSource entry;
+      entry.source = it;
+      entry.file   = infile;
+      sources.push_back(entry);
+   }
+   closeFiles();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::loadPages -- Parse and analyze the next pages (each
+//     with its overlays) and add them to the end of the window.  Returns
+//     the number of pages added, which is less than count at the end of
+//     the input.
+//
+
+int ScorePageStream::loadPages(int count) {
+   // Find the sources for the pages.  An overlay belongs to the page
+   // before it, which may be in a previous file, so the next source after
+   // the last page is checked before stopping.
+   int total = 0;
+   int pages = 0;
+   while (1) {
+      while ((total >= (int)sources.size()) && splitNextFile()) {
+         // find the pages in the next file
+      }
+      if (total >= (int)sources.size()) {
+         break;
+      }
+      if ((total == 0) || !sources[total].source.overlayQ) {
+         if (pages == count) {
+            break;
+         }
+         pages++;
+      }
+      total++;
+   }
+   if (total == 0) {
+      return 0;
+   }
+
+   SU::runParallel(total, thread_count, [&](int index) {
+      ScorePageSet::parsePageSource(sources[index].source);
+   });
+
+   vectorSPp newpages;
+   newpages.reserve(total);
+   for (int i=0; i<total; i++) {
+      StreamSource& it = sources.front();
+      if ((i == 0) || !it.source.overlayQ) {
+         window.push_back(new ScorePageOverlay);
+      }
+      window.back()->appendOverlay(it.source.page);
+      newpages.push_back(it.source.page);
+      it.file->pending--;
+      sources.pop_front();
+   }
+   closeFiles();
+
+   if (!analyses.empty()) {
+      SU::runParallel((int)newpages.size(), thread_count, [&](int index) {
+         newpages[index]->analyze(analyses);
+      });
+   }
+   return pages;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePageStream::closeFiles -- Close the input files whose pages have
+//     all been parsed.
+//
+
+void ScorePageStream::closeFiles(void) {
+   while (!files.empty() && (files.front()->pending == 0)) {
+      delete files.front();
+      files.pop_front();
+   }
+}
+
+
+
@@ -0,0 +1,86 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:58:40 PDT 2026
+// Last Modified: Sat Oct 17 23:58:43 PDT 2026
+// Filename:      ScorePage_analysis.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePage_analysis.cpp
+// Syntax:        C++11
+//
+// Description:   This file contains ScorePage class functions for running
+//                analyses by name in the order of their dependencies.
+//
+
+#include "ScorePage.h"
+#include <stdlib.h>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScorePage::analyze -- Do the named analyses (which are the node names
+//    in AnalysisInfo, such as "chords" or "systempitches"), along with
+//    all of the analyses which they depend on.  Each analysis is done
+//    after its dependencies, and analyses which are already valid are
+//    not done again.
+//
+
+void ScorePage::analyze(const vector<string>& analyses) {
+   vector<string> order;
+   analysis_info.getDependencyOrder(analyses, order);
+   for (auto& it : order) {
+      if (!analysis_info.isValid(it)) {
+         runAnalysis(it);
+      }
+   }
+}
+
+
+void ScorePage::analyze(const string& analysis) {
+   vector<string> analyses(1, analysis);
+   analyze(analyses);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePage::runAnalysis -- Run the analysis function for the given
+//    AnalysisInfo node name.
+//
+
+void ScorePage::runAnalysis(const string& analysis) {
+   if (analysis == "notmodified") {
+      // validated by sorting the page
+   } else if (analysis == "sorted") {
+      sortPageHorizontally();
+   } else if (analysis == "staves") {
+      analyzeStaves();
+   } else if (analysis == "systems") {
+      analyzeSystems();
+   } else if (analysis == "duration") {
+      analyzeStaffDurations();
+   } else if (analysis == "systempitches") {
+      analyzePitch();
+   } else if (analysis == "chords") {
+      analyzeChords();
+   } else if (analysis == "beams") {
+      analyzeBeams();
+   } else if (analysis == "tuplets") {
+      analyzeTuplets();
+   } else if (analysis == "barlines") {
+      analyzeBarlines();
+   } else if (analysis == "layers") {
+      analyzeLayers();
+   } else if (analysis == "p3") {
+      analyzeP3();
+   } else if (analysis == "staffslursties") {
+      analyzeTies();
+   } else {
+      cerr << "Unknown page analysis: " << analysis << endl;
+      exit(1);
+   }
+}
+
+
+
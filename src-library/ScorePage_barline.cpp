@@ -22,6 +22,7 @@ using namespace std;
 //
 
 void ScorePage::analyzeBarlines(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeBarlines", getItemCount());
    if (!analysis_info.stavesIsValid()) {
       analyzeStaves();
    }
@@ -135,11 +136,12 @@ void ScorePage::analyzeBarlines(vectorSMp& sysmeasures, int sysindex) {
    getHorizontallySortedSystemItems(sysitems, sysindex);
 
    // create a new measure and store in system list
-   SystemMeasure* smp = new SystemMeasure;
+   int ticks = getSystemTicksPerQuarter(sysindex);
+   SystemMeasure* smp = new SystemMeasure(ticks);
    mstorage.push_back(smp);
    sysmeasures.push_back(smp);
    int currentbar = 0;
-   SCORE_FLOAT currentdur = 0.0;
+   int currentdur = 0;
    int i;
 
    for (i=0; i<(int)sysitems.size(); i++) {
@@ -148,22 +150,22 @@ void ScorePage::analyzeBarlines(vectorSMp& sysmeasures, int sysindex) {
          continue;
       }
 
-      currentdur = sysmeasures[currentbar]->getDuration();
+      currentdur = sysmeasures[currentbar]->getMeasureTicks();
 
-      if (currentdur > 0.0) {
+      if (currentdur > 0) {
          // add another measure to the list, and start adding barlines
          // (also add barlines to previous measure until a duration
          // item is added.
-         smp = new SystemMeasure;
+         smp = new SystemMeasure(ticks);
          mstorage.push_back(smp);
          sysmeasures.push_back(smp);
-         currentdur = 0.0;
+         currentdur = 0;
          currentbar++;
          sysmeasures[currentbar]->addItem(sysitems[i]);
          continue;
       }
 
-      if ((currentdur <= 0.0) && (currentbar > 0)) {
+      if ((currentdur <= 0) && (currentbar > 0)) {
          // also add to end of last measure
          sysmeasures[currentbar-1]->addItem(sysitems[i]);
       }
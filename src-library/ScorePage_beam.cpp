@@ -21,16 +21,16 @@ using namespace std;
 //
 
 void ScorePage::analyzeBeams(SCORE_FLOAT tolerance) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeBeams", getItemCount());
    if (!analysis_info.chordsIsValid()) {
-      analyzeStaves();
+      analyzeChords();
    }
    analysis_info.invalidate("beams");
 
-   int i;
    int maxstaff = getMaxStaff();
-   for (i=1; i<=maxstaff; i++) {
-      analyzeBeamsOnStaff(i, tolerance);
-   }
+   runAnalysisPasses(maxstaff,
+      [&](int i) { analyzeBeamsOnStaff(i+1, tolerance); });
+   storeBeamIds();
 
    analysis_info.validate("beams");
 }
@@ -152,3 +152,26 @@ void ScorePage::analyzeBeamsOnStaff(int p2index, SCORE_FLOAT tolerance) {
 
 
 
+//////////////////////////////
+//
+// ScorePage::storeBeamIds -- Number the beam groups on the page in the
+//     analysis table.
+//
+
+void ScorePage::storeBeamIds(void) {
+   int id = 0;
+   int staffcount = beam_database.getStaffCount();
+   for (int i=0; i<staffcount; i++) {
+      for (auto& group : beam_database.getGroups(i)) {
+         for (auto& item : group->beams) {
+            analysis_table.setBeamId(item, id);
+         }
+         for (auto& item : group->notes) {
+            analysis_table.setBeamId(item, id);
+         }
+         id++;
+      }
+   }
+}
+
+
@@ -24,16 +24,33 @@ using namespace std;
 //
 
 void ScorePage::analyzeChords(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeChords", getItemCount());
    if (!analysis_info.stavesIsValid()) {
       analyzeStaves();
    }
+
+   set<int> changed;
+   if (analysis_info.getInvalidStaves("chords", changed)) {
+      // Only regroup the notes on staves which have changed.
+      SCORE_PROFILE_COUNT(PartialAnalyses, 1);
+      int maxstaff = getMaxStaff();
+      for (int staff : changed) {
+         if ((staff <= 0) || (staff > maxstaff)) {
+            continue;
+         }
+         analyzeChordsOnStaff(staff);
+      }
+      storeChordIds();
+      analysis_info.validate("chords");
+      return;
+   }
+
    analysis_info.invalidate("chords");
 
-   int i;
    int maxstaff = getMaxStaff();
-   for (i=1; i<=maxstaff; i++) {
-      analyzeChordsOnStaff(i);
-   }
+   runAnalysisPasses(maxstaff,
+      [&](int i) { analyzeChordsOnStaff(i+1); });
+   storeChordIds();
 
    analysis_info.validate("chords");
 }
@@ -73,18 +90,17 @@ void ScorePage::analyzeChordsOnStaff(int p2index) {
       analyzeStaves();
    }
    vectorSIp& staffitems = itemlist_staffsorted[p2index];
-   map<SCORE_FLOAT, vectorSIp> p3list;
-   SCORE_FLOAT p3;
+   DatabaseP3 p3list;
    for (auto& it : staffitems) {
       if (!it->isNoteItem()) {
          continue;
       }
-      p3 = it->getHPos();
-      p3list[p3].push_back(it);
+      p3list.addItem(it);
    }
 
-   for (auto& it : p3list) {
-      analyzeVerticalNoteSet(it.second);
+   int count = p3list.getColumnCount();
+   for (int i=0; i<count; i++) {
+      analyzeVerticalNoteSet(p3list.getColumn(i));
    }
 }
 
@@ -145,3 +161,24 @@ void ScorePage::analyzeVerticalNoteSet(vectorSIp& data) {
 
 
 
+//////////////////////////////
+//
+// ScorePage::storeChordIds -- Number the chords on the page in the
+//     analysis table.  A note which has been regrouped into a later
+//     chord is given the number of the later chord.
+//
+
+void ScorePage::storeChordIds(void) {
+   int id = 0;
+   int staffcount = chord_database.getStaffCount();
+   for (int i=0; i<staffcount; i++) {
+      for (auto& chord : chord_database.getChords(i)) {
+         for (auto& note : chord) {
+            analysis_table.setChordId(note, id);
+         }
+         id++;
+      }
+   }
+}
+
+
@@ -47,7 +47,7 @@ void  ScorePage::getHorizontallySortedStaffItems(vectorVSIp& staffsequence) {
    }
 
    for (auto& it : staffsequence) {
-      sort(it.begin(), it.end(), SU::sortP3);
+      SU::sortItemsP3(it);
     }
 }
 
@@ -87,7 +87,7 @@ void ScorePage::getUnsortedStaffItems(vectorSIp& items, int staffnum) {
 
 void ScorePage::getSortedStaffItems(int staffnum, vectorSIp& items) {
    getUnsortedStaffItems(staffnum, items);
-   sort(items.begin(), items.end(), SU::sortP3);
+   SU::sortItemsP3(items);
 }
 
 // Alias:
@@ -152,7 +152,7 @@ void ScorePage::getUnsortedSystemItems(int sysindex, vectorSIp& sysseq) {
 void ScorePage::getHorizontallySortedSystemItems(vectorSIp& sysseq,
       int sysindex) {
    getUnsortedSystemItems(sysseq, sysindex);
-   sort(sysseq.begin(), sysseq.end(), SU::sortP3);
+   SU::sortItemsP3(sysseq);
 }
 
 // Alias:
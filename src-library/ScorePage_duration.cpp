@@ -11,6 +11,7 @@
 //
 
 #include "ScorePage.h"
+#include "ScoreUtility.h"
 #include <algorithm>
 #include <set>
 
@@ -25,25 +26,80 @@ using namespace std;
 //
 
 void ScorePage::analyzeStaffDurations(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeStaffDurations", getItemCount());
    if (!analysis_info.stavesIsValid()) {
       analyzeStaves();
    }
+   if (!analysis_info.systemsIsValid()) {
+      analyzeSystems();
+   }
+
+   SCORE_FLOAT staffduration;
+   set<int> changed;
+   if (analysis_info.getInvalidStaves("duration", changed) &&
+         ((int)system_ticks.size() == getSystemCount())) {
+      // Only recalculate the staves with items which have changed.  If
+      // the tick resolution of a system changes, then all of the staves
+      // on the system have to be recalculated.
+      SCORE_PROFILE_COUNT(PartialAnalyses, 1);
+      set<int> systems;
+      for (int staff : changed) {
+         int sysindex = getSystemIndex(staff);
+         if (sysindex >= 0) {
+            systems.insert(sysindex);
+         }
+      }
+      vectorVI& sysmap = reverseSystemMap();
+      for (int sysindex : systems) {
+         int ticks = calculateTicksPerQuarter(getSystemItems(sysindex));
+         if (ticks != system_ticks[sysindex]) {
+            system_ticks[sysindex] = ticks;
+            changed.insert(sysmap[sysindex].begin(), sysmap[sysindex].end());
+         }
+      }
+      vectorSIp staffitems;
+      for (int staff : changed) {
+         if (staff <= 0) {
+            continue;
+         }
+         getSortedStaffItems(staff, staffitems);
+         if (staffitems.size() == 0) {
+            continue;
+         }
+         int sysindex = getSystemIndex(staff);
+         int ticks = sysindex < 0 ? calculateTicksPerQuarter(staffitems) :
+               system_ticks[sysindex];
+         staffduration = calculateStaffDuration(staffitems, ticks);
+         setStaffDuration(staff, staffduration);
+         ScoreItem* si = staff_info.getStaffItemsNotConst()[staff][0];
+         si->setStaffDuration(staffduration);
+      }
+      analysis_info.setValid("duration");
+      return;
+   }
+
    analysis_info.setInvalid("duration");
 
+   prepareSystemTicks();
+
    vectorVSIp staffsequence;
    getHorizontallySortedStaffItems(staffsequence);
 
-   SCORE_FLOAT staffduration;
    unsigned int i;
    for (i=1; i<staffsequence.size(); i++) {
       if (staffsequence[i].size() == 0) {
          // nothing on staff
          continue;
       }
-      staffduration = calculateStaffDuration(staffsequence[i]);
+      // Staves which are not on a system (because they have no
+      // barlines) use their own tick resolution.
+      int sysindex = getSystemIndex(i);
+      int ticks = sysindex < 0 ? calculateTicksPerQuarter(staffsequence[i]) :
+            system_ticks[sysindex];
+      staffduration = calculateStaffDuration(staffsequence[i], ticks);
       setStaffDuration(i, staffduration);
       ScoreItem* si = staff_info.getStaffItemsNotConst()[i][0];
-      si->setParameterNoisy(ns_auto, np_staffDuration, staffduration);
+      si->setStaffDuration(staffduration);
    }
 
    analysis_info.setValid("duration");
@@ -57,11 +113,14 @@ void ScorePage::analyzeStaffDurations(void) {
 //      of the note/rest sequence on a staff.  The input is presumed to
 //      be sorted according to P3 (from left to right on the staff).
 //      This function has a side effect which sets the durational offset
-//      of each object from the start of the staff. (Private function
-//      used to analyze the duration on staves).
+//      of each object from the start of the staff, both in quarter notes
+//      and in ticks of the system.  The durations are added as integer
+//      ticks, so offsets of tuplets do not drift from the beats.  (Private
+//      function used to analyze the duration on staves).
 //
 
-SCORE_FLOAT ScorePage::calculateStaffDuration(vectorSIp& staffitems) {
+SCORE_FLOAT ScorePage::calculateStaffDuration(vectorSIp& staffitems,
+      int ticksperquarter) {
 
    // expectedOffset is needed to keep track of multiple streams
    // of notes which may alternate with each other such as two voices
@@ -70,44 +129,54 @@ SCORE_FLOAT ScorePage::calculateStaffDuration(vectorSIp& staffitems) {
    //     voice 2:     Q   Q   Q
    //     composite:   E E E E E E
    //
-   set<SCORE_FLOAT> expectedOffset;
+   // The offsets are kept sorted from earliest to latest, without
+   // duplicates.
+   vectorI expectedOffset;
 
-   unsigned int i;
    const SCORE_FLOAT htolerance = 0.05;  // hpos within this range are equiv.
-   const SCORE_FLOAT rtolerance = 0.003; // rhythms within this range are equiv.
+   const SCORE_FLOAT tpq = ticksperquarter;
    SCORE_FLOAT dur;
+   SCORE_FLOAT lastdur = -1.0;
    SCORE_FLOAT hpos;
-   SCORE_FLOAT nextevent;
    SCORE_FLOAT activeHpos = 0.0;
-   SCORE_FLOAT currentStaffDurOffset = 0.0;
-
-   for (i=0; i<staffitems.size(); i++) {
-      if (!staffitems[i]->hasDuration()) {
-         staffitems[i]->setStaffOffsetDuration(nextevent);
+   int ticks = 0;
+   int nextevent = 0;
+   int currentStaffDurOffset = 0;
+
+   for (auto& item : staffitems) {
+      if (!item->hasDuration()) {
+         item->setStaffOffsetDuration(nextevent / tpq);
+         item->setStaffOffsetTicks(nextevent);
          continue;
       }
-      dur  = staffitems[i]->getDuration();
-      hpos = staffitems[i]->getHPos();
+      dur  = item->getDuration();
+      hpos = item->getHPos();
       if (dur <= 0.0) {
-         staffitems[i]->setStaffOffsetDuration(currentStaffDurOffset);
+         item->setStaffOffsetDuration(currentStaffDurOffset / tpq);
+         item->setStaffOffsetTicks(currentStaffDurOffset);
          continue;
       }
       if (hpos > activeHpos + htolerance) {
          if (expectedOffset.size() == 0) {
-            currentStaffDurOffset = 0.0;
+            currentStaffDurOffset = 0;
          } else {
-            currentStaffDurOffset = *expectedOffset.begin();
+            currentStaffDurOffset = expectedOffset.front();
             expectedOffset.erase(expectedOffset.begin());
          }
          activeHpos = hpos;
       }
-      staffitems[i]->setStaffOffsetDuration(currentStaffDurOffset);
-      nextevent = dur + currentStaffDurOffset;
-      if (fabs(nextevent - (int)(nextevent+rtolerance)) <= rtolerance) {
-         // Compensate for round-off errors related to tuplets at quarter notes:
-         nextevent = (int)(nextevent + rtolerance);
+      item->setStaffOffsetDuration(currentStaffDurOffset / tpq);
+      item->setStaffOffsetTicks(currentStaffDurOffset);
+      if (dur != lastdur) {
+         ticks   = SU::getDurationTicks(dur, ticksperquarter);
+         lastdur = dur;
+      }
+      nextevent = ticks + currentStaffDurOffset;
+      auto it = lower_bound(expectedOffset.begin(), expectedOffset.end(),
+            nextevent);
+      if ((it == expectedOffset.end()) || (*it != nextevent)) {
+         expectedOffset.insert(it, nextevent);
       }
-      expectedOffset.insert(nextevent);
    }
 
    // Maybe assign staff duration offsets to non-durational offsets here.
@@ -115,7 +184,7 @@ SCORE_FLOAT ScorePage::calculateStaffDuration(vectorSIp& staffitems) {
    // There should be one last event in the storage which represents
    // the duration of the system:
    if (expectedOffset.size() > 0) {
-      return *expectedOffset.begin();
+      return expectedOffset.front() / tpq;
    } else {
       return 0.0;
    }
@@ -123,6 +192,50 @@ SCORE_FLOAT ScorePage::calculateStaffDuration(vectorSIp& staffitems) {
 
 
 
+//////////////////////////////
+//
+// ScorePage::calculateTicksPerQuarter -- Return the smallest number of
+//      ticks per quarter note which can represent the durations of all
+//      notes and rests in the list as integers.  (Private function used
+//      to analyze the duration on staves).
+//
+
+int ScorePage::calculateTicksPerQuarter(vectorSIp& items) {
+   int output = 1;
+   SCORE_FLOAT lastdur = -1.0;
+   for (auto& it : items) {
+      if (!it->hasDuration()) {
+         continue;
+      }
+      SCORE_FLOAT dur = it->getDuration();
+      if ((dur <= 0.0) || (dur == lastdur)) {
+         continue;
+      }
+      output  = SU::getTicksPerQuarter(output, dur);
+      lastdur = dur;
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePage::prepareSystemTicks -- Calculate the ticks per quarter note
+//      of each system on the page.  (Private function used to analyze the
+//      duration on staves).
+//
+
+void ScorePage::prepareSystemTicks(void) {
+   int syscount = getSystemCount();
+   system_ticks.resize(syscount);
+   for (int i=0; i<syscount; i++) {
+      system_ticks[i] = calculateTicksPerQuarter(getSystemItems(i));
+   }
+}
+
+
+
 //////////////////////////////
 //
 // ScorePage::setStaffDuration -- Set the duration of the staff in terms
@@ -171,3 +284,27 @@ SCORE_FLOAT ScorePage::getSystemDuration(int sysnum) {
 
 
 
+//////////////////////////////
+//
+// ScorePage::getSystemTicksPerQuarter -- Return the number of ticks per
+//   quarter note for the integer staff offsets of the given system (see
+//   ScoreItem::getStaffOffsetTicks()).  This is also the least common
+//   multiple rhythm of the system (see getSystemLCMRhythm()).
+//
+
+int ScorePage::getSystemTicksPerQuarter(int sysindex) {
+   if (!analysis_info.durationIsValid()) {
+      analyzeStaffDurations();
+   }
+   if ((int)system_ticks.size() != getSystemCount()) {
+      // The duration analysis was read from a cache file.
+      prepareSystemTicks();
+   }
+   if ((sysindex < 0) || (sysindex >= (int)system_ticks.size())) {
+      return 1;
+   }
+   return system_ticks[sysindex];
+}
+
+
+
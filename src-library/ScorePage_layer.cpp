@@ -25,22 +25,47 @@ using namespace std;
 //
 
 int ScorePage::analyzeLayers(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeLayers", getItemCount());
    if (!analysis_info.durationIsValid()) {
       analyzeStaffDurations();
    }
+
+   set<int> changed;
+   if (analysis_info.getInvalidStaves("layers", changed)) {
+      // Only analyze the staves with items which have changed.
+      SCORE_PROFILE_COUNT(PartialAnalyses, 1);
+      vectorSIp staffitems;
+      for (int staff : changed) {
+         if (staff <= 0) {
+            continue;
+         }
+         getSortedStaffItems(staff, staffitems);
+         if (staffitems.size() == 0) {
+            continue;
+         }
+         private_analyzeStaffLayers(staffitems);
+      }
+      analysis_info.setValid("layers");
+      return 1;
+   }
+
    analysis_info.setInvalid("layers");
 
+   // Chords are needed to assign layers to chord notes.
+   if (!analysis_info.chordsIsValid()) {
+      analyzeChords();
+   }
+
    vectorVSIp staffsequence;
    getHorizontallySortedStaffItems(staffsequence);
 
-   unsigned int i;
-   for (i=1; i<staffsequence.size(); i++) {
-      if (staffsequence[i].size() == 0) {
+   runAnalysisPasses((int)staffsequence.size() - 1, [&](int i) {
+      if (staffsequence[i+1].size() == 0) {
          // nothing on staff
-         continue;
+         return;
       }
-      private_analyzeStaffLayers(staffsequence[i]);
-   }
+      private_analyzeStaffLayers(staffsequence[i+1]);
+   });
 
    analysis_info.setValid("layers");
    return 1;
@@ -148,11 +173,11 @@ void ScorePage::setChordLayer(ScoreItem* note, int layer) {
    int i;
    vectorSIp* chordnotes = chordNotes(note);
    if (chordnotes == NULL) {
-      note->setParameterQuiet(ns_auto, np_layer, layer);
+      note->setLayer(layer);
       return;
    }
    for (i=0; i<(int)chordnotes->size(); i++) {
-      (*chordnotes)[i]->setParameterQuiet(ns_auto, np_layer, layer);
+      (*chordnotes)[i]->setLayer(layer);
    }
 }
 
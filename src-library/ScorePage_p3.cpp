@@ -22,17 +22,46 @@ using namespace std;
 //
 
 void ScorePage::analyzeP3(void) {
-   if (!analysis_info.p3IsValid()) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeP3", getItemCount());
+   if (!analysis_info.systemsIsValid()) {
       analyzeSystems();
+   }
+   if (!analysis_info.durationIsValid()) {
       analyzeStaffDurations();
    }
-   analysis_info.setInvalid("p3");
-
    int syscount = getSystemCount();
 
+   set<int> changed;
+   if (analysis_info.getInvalidStaves("p3", changed) &&
+         ((int)p3_database.size() == syscount)) {
+      // Only rebuild the databases of systems which have changed.
+      SCORE_PROFILE_COUNT(PartialAnalyses, 1);
+      set<int> systems;
+      for (int staff : changed) {
+         int sysindex = getSystemIndex(staff);
+         if (sysindex >= 0) {
+            systems.insert(sysindex);
+         }
+      }
+      for (int sysindex : systems) {
+         p3_database[sysindex].clear();
+         p3_database[sysindex].setTicksPerQuarter(
+               getSystemTicksPerQuarter(sysindex));
+         for (auto& it : getSystemItems(sysindex)) {
+            p3_database[sysindex].addItem(it);
+         }
+      }
+      analysis_info.setValid("p3");
+      return;
+   }
+
+   analysis_info.setInvalid("p3");
+
    p3_database.resize(syscount);
 
    for (int i=0; i<syscount; i++) {
+      p3_database[i].clear();
+      p3_database[i].setTicksPerQuarter(getSystemTicksPerQuarter(i));
       for (auto& it : getSystemItems(i)) {
          p3_database[i].addItem(it);
       }
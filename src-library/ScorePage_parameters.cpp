@@ -22,6 +22,7 @@ using namespace std;
 
 void ScorePage::copyParameterOverwrite(const string& newnamespace,
       const string& oldnamespace, const string& parameter) {
+   exportAnalysisParameters();
    for (auto& it : item_storage) {
       it->copyParameterOverwrite(newnamespace, oldnamespace, parameter);
    }
@@ -36,6 +37,7 @@ void ScorePage::copyParameterOverwrite(const string& newnamespace,
 
 void ScorePage::copyParameterNoOverwrite(const string& newnamespace,
       const string& oldnamespace, const string& parameter) {
+   exportAnalysisParameters();
    for (auto& it : item_storage) {
       it->copyParameterNoOverwrite(newnamespace, oldnamespace, parameter);
    }
@@ -30,18 +30,39 @@ using namespace std;
 //
 
 void ScorePage::analyzePitch(void) {
-   if (!analysis_info.systemPitchesIsValid()) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzePitch", getItemCount());
+   if (!analysis_info.systemsIsValid()) {
       analyzeSystems();
    }
-   analysis_info.invalidate("systempitches");
 
    vectorSIp sysseq;
-   int i;
-   for (i=0; i<getSystemCount(); i++) {
-      getHorizontallySortedSystemItems(sysseq, i);
-      analyzeSystemPitch(sysseq);
+   set<int> changed;
+   if (analysis_info.getInvalidStaves("systempitches", changed)) {
+      // Only analyze the systems containing staves which have changed.
+      SCORE_PROFILE_COUNT(PartialAnalyses, 1);
+      set<int> systems;
+      for (int staff : changed) {
+         int sysindex = getSystemIndex(staff);
+         if (sysindex >= 0) {
+            systems.insert(sysindex);
+         }
+      }
+      for (int sysindex : systems) {
+         getHorizontallySortedSystemItems(sysseq, sysindex);
+         analyzeSystemPitch(sysseq);
+      }
+      analysis_info.validate("systempitches");
+      return;
    }
 
+   analysis_info.invalidate("systempitches");
+
+   runAnalysisPasses(getSystemCount(), [&](int i) {
+      vectorSIp systemitems;
+      getHorizontallySortedSystemItems(systemitems, i);
+      analyzeSystemPitch(systemitems);
+   });
+
    analysis_info.validate("systempitches");
 }
 
@@ -56,7 +77,7 @@ void ScorePage::analyzePitch(void) {
 //
 
 void ScorePage::analyzeSystemPitch(vectorSIp& systemitems) {
-   if (!analysis_info.systemPitchesIsValid()) {
+   if (!analysis_info.systemsIsValid()) {
       analyzeSystems();
    }
 
@@ -84,7 +105,6 @@ void ScorePage::analyzeSystemPitch(vectorSIp& systemitems) {
    fill(middleCVpos.begin(), middleCVpos.end(), 1);
    ScoreItem* curr;
    int p2;
-   string base40string;
 
    for (unsigned int i=0; i<systemitems.size(); i++) {
       curr = systemitems[i];
@@ -134,14 +154,7 @@ void ScorePage::analyzeSystemPitch(vectorSIp& systemitems) {
          }
       }
       base40 += accidental;
-      base40string  = to_string(base40);
-
-      // Add a textual pitch name for readability:
-      base40string += "\t(";
-      base40string += SU::base40ToKern(base40);
-      base40string += ")";
-
-      curr->setParameterNoisy(ns_auto, np_base40Pitch, base40string);
+      curr->setBase40Pitch(base40);
    }
 
 }
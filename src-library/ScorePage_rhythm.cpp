@@ -11,9 +11,6 @@
 //
 
 #include "ScorePage.h"
-#include "ScoreUtility.h"
-#include <algorithm>
-#include <set>
 
 using namespace std;
 
@@ -25,36 +22,12 @@ using namespace std;
 //    as integer units of that rhythm.  The return value is in
 //    reference to quarter notes, so if the smallest duration
 //    on the system is a whole note, then return value will be "1"
-//    for quarter notes.
+//    for quarter notes.  This is the tick resolution of the system
+//    calculated by the duration analysis.
 //
 
 int ScorePage::getSystemLCMRhythm(int systemindex) {
-   if (!analysis_info.systemsIsValid()) {
-      analyzeSystems();
-   }
-   if (!analysis_info.durationIsValid()) {
-      analyzeStaffDurations();
-   }
-
-
-   set<int> numbers;
-   RationalNumber rn;
-   RationalNumber rd;
-   vectorSIp& sysitems = this->getSystemItems(systemindex);
-   for (auto& it : sysitems) {
-      if (!it->hasDuration()) {
-         continue;
-      }
-      rn = it->getDurationIncludingDots();
-
-      if (rn <= 0) {
-         continue;
-      }
-      numbers.insert(rn.getDenominator());
-   }
-
-   int output = ScoreUtility::lcm(numbers);
-   return output;
+   return getSystemTicksPerQuarter(systemindex);
 }
 
 
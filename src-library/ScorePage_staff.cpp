@@ -25,6 +25,7 @@ using namespace std;
 //
 
 void ScorePage::analyzeStaves(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeStaves", getItemCount());
    if (!analysis_info.sortedIsValid()) {
       sortPageHorizontally();
    }
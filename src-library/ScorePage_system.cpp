@@ -43,6 +43,7 @@ using namespace std;
 //
 
 int ScorePage::analyzeSystems(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeSystems", getItemCount());
    if (!analysis_info.stavesIsValid()) {
       analyzeStaves();
    }
@@ -206,7 +207,7 @@ void ScorePage::fillSystemScoreItemLists(void) {
          }
       }
 
-      sort(systemlist[i].begin(), systemlist[i].end(), SU::sortP3P2P1P4);
+      SU::sortItemsP3P2P1P4(systemlist[i]);
    }
 }
 
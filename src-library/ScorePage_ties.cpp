@@ -26,6 +26,7 @@ using namespace std;
 //
 
 int ScorePage::analyzeTies(void) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeTies", getItemCount());
    if (!analysis_info.layersIsValid()) {
       analyzeLayers();
    }
@@ -22,16 +22,16 @@ using namespace std;
 //
 
 void ScorePage::analyzeTuplets(SCORE_FLOAT tolerance) {
+   SCORE_PROFILE_SCOPE("ScorePage::analyzeTuplets", getItemCount());
    if (!analysis_info.beamsIsValid()) {
       analyzeBeams();
    }
    analysis_info.invalidate("tuplets");
 
-   int i;
    int maxstaff = getMaxStaff();
-   for (i=1; i<=maxstaff; i++) {
-      analyzeTupletsOnStaff(i, tolerance);
-   }
+   runAnalysisPasses(maxstaff,
+      [&](int i) { analyzeTupletsOnStaff(i+1, tolerance); });
+   storeTupletIds();
 
    analysis_info.validate("tuplets");
 }
@@ -150,3 +150,26 @@ void ScorePage::analyzeTupletsOnStaff(int p2index, SCORE_FLOAT tolerance) {
 
 
 
+//////////////////////////////
+//
+// ScorePage::storeTupletIds -- Number the tuplet groups on the page in
+//     the analysis table.
+//
+
+void ScorePage::storeTupletIds(void) {
+   int id = 0;
+   int staffcount = tuplet_database.getStaffCount();
+   for (int i=0; i<staffcount; i++) {
+      for (auto& group : tuplet_database.getGroups(i)) {
+         for (auto& item : group->brackets) {
+            analysis_table.setTupletId(item, id);
+         }
+         for (auto& item : group->notes) {
+            analysis_table.setTupletId(item, id);
+         }
+         id++;
+      }
+   }
+}
+
+
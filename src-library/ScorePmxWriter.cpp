@@ -0,0 +1,299 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 02:05:37 PDT 2026
+// Last Modified: Sun Oct 18 02:05:40 PDT 2026
+// Filename:      ScorePmxWriter.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScorePmxWriter.cpp
+// Syntax:        C++11
+//
+// Description:   Write SCORE items as PMX text into a memory buffer (see
+//                ScorePmxWriter.h).
+//
+
+#include "ScorePmxWriter.h"
+#include "ScorePageBase.h"
+#include "ScoreUtility.h"
+#include <cmath>
+#include <string.h>
+
+#ifdef SCOREITEMEDIT
+   #include <sstream>
+#endif
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::ScorePmxWriter -- Constructor.  By default numbers are
+//     rounded in the same way as when printing them to an ostream.
+//
+
+ScorePmxWriter::ScorePmxWriter(void) {
+   rounding = 1;
+}
+
+
+ScorePmxWriter::ScorePmxWriter(int roundQ) {
+   rounding = roundQ;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::~ScorePmxWriter -- Deconstructor.
+//
+
+ScorePmxWriter::~ScorePmxWriter() {
+   // do nothing
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::clear -- Remove the text from the buffer, keeping its
+//     memory for the next text.
+//
+
+void ScorePmxWriter::clear(void) {
+   buffer.clear();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::setRounding -- Set to true to round numbers to six
+//     significant digits (giving the same text as ostream printing), or
+//     to false to write the shortest text which reads back as the same
+//     number.
+//
+
+void ScorePmxWriter::setRounding(int roundQ) {
+   rounding = roundQ;
+}
+
+
+int ScorePmxWriter::getRounding(void) const {
+   return rounding;
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendItem -- Add the fixed and named parameters of an
+//     item (see ScoreItemBase::printPmx()).  If autoQ is false, then the
+//     named parameters in the auto namespace are not written (see
+//     ScoreItem::printNoAuto()).  When compiled with SCOREITEMEDIT, the
+//     edit history of the item follows the named parameters.
+//     Default value: autoQ = 1
+//
+
+void ScorePmxWriter::appendItem(ScoreItem* item, int autoQ) {
+   appendFixedParameters(*item);
+   appendNamedParameters(*item, autoQ);
+   #ifdef SCOREITEMEDIT
+      if (autoQ && !item->history_list.empty()) {
+         stringstream history;
+         item->printPmxEditHistory(history);
+         appendText(history.str());
+      }
+   #endif
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendItems -- Add a list of items.
+//     Default value: autoQ = 1
+//
+
+void ScorePmxWriter::appendItems(vectorSIp& items, int autoQ) {
+   for (auto& it : items) {
+      appendItem(it, autoQ);
+   }
+}
+
+
+void ScorePmxWriter::appendItems(listSIp& items, int autoQ) {
+   for (auto& it : items) {
+      appendItem(it, autoQ);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendFixedParameters -- Add the line of fixed
+//     parameters of an item, followed by the text line of text (P1=16)
+//     and EPS (P1=15) items.  A ScoreItemView is written with its changed
+//     parameters in place of those of its item.
+//
+
+void ScorePmxWriter::appendFixedParameters(ScoreItemBase& item) {
+   SCORE_FLOAT values[ScoreItemBase::SCORE_MAX_FIXED_PARAMETERS+1];
+   int count = item.getCompactFixedParameterCount();
+   for (int i=P1; i<=count; i++) {
+      values[i] = item.getParameter(i);
+   }
+   appendFixedValues(values, count, item.getFixedText());
+}
+
+
+void ScorePmxWriter::appendFixedParameters(ScoreItemView& view) {
+   SCORE_FLOAT values[ScoreItemBase::SCORE_MAX_FIXED_PARAMETERS+1];
+   int count = view.getFixedParameters(values);
+   appendFixedValues(values, count, view.getFixedText());
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendFixedValues -- Add a line of fixed parameters
+//     from values[P1] to values[count], and then the text for text and
+//     EPS items.
+//
+
+void ScorePmxWriter::appendFixedValues(const SCORE_FLOAT* values, int count,
+      const string& text) {
+   // print the first number, using "t" if P1
+   SCORE_FLOAT p1 = values[P1];
+   if (((int)p1) == 16) {
+      buffer += 't';
+   } else {
+      appendNumber(p1);
+   }
+   SCORE_FLOAT value;
+   for (int i=P2; i<=count; i++) {
+      value = values[i];
+      if (fabs(value) < 0.000001) {
+         value = 0.0;
+      }
+      buffer += ' ';
+      appendNumber(value);
+   }
+   buffer += '\n';
+   // if P1==15|16, then print the text associated with it here.
+   if ((p1 == 16) | (p1 == 15)) {
+      buffer += text;
+      buffer += '\n';
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendNamedParameters -- Add the named parameters of an
+//     item, one on each line.  Any analysis results of the page which
+//     owns the item are first copied into the auto namespace of the
+//     items, unless autoQ is false, in which case the auto namespace is
+//     not written.
+//     Default value: autoQ = 1
+//
+
+void ScorePmxWriter::appendNamedParameters(ScoreItemBase& item, int autoQ) {
+   if (autoQ && (item.page_owner != NULL)) {
+      ((ScorePageBase*)item.page_owner)->exportAnalysisParameters();
+   }
+   NamedParameterStore& np = item.named_parameters;
+   if (np.empty()) {
+      return;
+   }
+   vector<int> order;
+   np.getSortedParameters(order);
+   for (int i : order) {
+      const string& nspace = np.getNamespace(i);
+      if (!autoQ && (nspace == ns_auto)) {
+         continue;
+      }
+      buffer += '@';
+      if (!nspace.empty()) {
+         buffer += nspace;
+         buffer += '@';
+      }
+      buffer += np.getKey(i);
+      buffer += ":\t";
+      buffer += np.getValue(i);
+      buffer += '\n';
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendNumber -- Add a number, rounded according to
+//     the rounding setting.
+//
+
+void ScorePmxWriter::appendNumber(SCORE_FLOAT value) {
+   char text[32];
+   int length = SU::formatNumber(text, value, rounding);
+   buffer.append(text, length);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::appendText -- Add text to the buffer without any
+//     changes.
+//
+
+void ScorePmxWriter::appendText(const string& text) {
+   buffer += text;
+}
+
+
+void ScorePmxWriter::appendText(const char* text, size_t length) {
+   buffer.append(text, length);
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::data -- Return the text in the buffer.
+//
+
+const char* ScorePmxWriter::data(void) const {
+   return buffer.data();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::size -- Return the number of bytes in the buffer.
+//
+
+size_t ScorePmxWriter::size(void) const {
+   return buffer.size();
+}
+
+
+
+//////////////////////////////
+//
+// ScorePmxWriter::write -- Write the text in the buffer to an output
+//     stream in one write, and then clear the buffer.  The stream is not
+//     flushed.
+//
+
+ostream& ScorePmxWriter::write(ostream& out) {
+   if (!buffer.empty()) {
+      out.write(buffer.data(), buffer.size());
+   }
+   buffer.clear();
+   return out;
+}
+
+
+
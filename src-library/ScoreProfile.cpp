@@ -0,0 +1,219 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:40 PDT 2026
+// Last Modified: Sat Oct 17 23:59:43 PDT 2026
+// Filename:      ScoreProfile.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreProfile.cpp
+// Syntax:        C++11
+//
+// Description:   Timing and event counters for the analysis and reading
+//                functions of the library.
+//
+
+#include "ScoreProfile.h"
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+atomic<bool> ScoreProfile::enabled(false);
+
+// Timing information for a named function:
+class _ProfileEntry {
+   public:
+      long    calls = 0;
+      long    items = 0;
+      double  milliseconds = 0.0;
+};
+
+static mutex                     ProfileMutex;
+static map<string, _ProfileEntry> ProfileEntries;
+static atomic<long>              ProfileCounters[ScoreProfile::CounterCount];
+
+static const char* ProfileCounterNames[ScoreProfile::CounterCount] = {
+   "items allocated",
+   "item slabs allocated",
+   "parameter cache hits",
+   "parameter cache misses",
+   "partial analyses"
+};
+
+
+//////////////////////////////
+//
+// ScoreProfile::isCompiled -- Returns true if the library was compiled
+//    with profiling counters.
+//
+
+int ScoreProfile::isCompiled(void) {
+#ifdef SCORELIB_PROFILE
+   return 1;
+#else
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::setEnabled -- Turn the recording of profile information
+//    on or off.
+//
+
+void ScoreProfile::setEnabled(int state) {
+   enabled = state ? true : false;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::isEnabled -- Returns true if profile information is
+//    being recorded.
+//
+
+int ScoreProfile::isEnabled(void) {
+   return enabled.load(memory_order_relaxed);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::clear -- Erase all recorded profile information.
+//
+
+void ScoreProfile::clear(void) {
+   lock_guard<mutex> lock(ProfileMutex);
+   ProfileEntries.clear();
+   for (int i=0; i<CounterCount; i++) {
+      ProfileCounters[i] = 0;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::addTime -- Add a call of the given function to the
+//     profile, along with the number of items that it processed.
+//
+
+void ScoreProfile::addTime(const char* name, double milliseconds,
+      long items) {
+   lock_guard<mutex> lock(ProfileMutex);
+   _ProfileEntry& entry = ProfileEntries[name];
+   entry.calls++;
+   entry.items += items;
+   entry.milliseconds += milliseconds;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::count -- Add to one of the event counters.
+//
+
+void ScoreProfile::count(int counter, long amount) {
+   if (!isEnabled()) {
+      return;
+   }
+   ProfileCounters[counter].fetch_add(amount, memory_order_relaxed);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::print -- Print the recorded times and counters.  Times
+//     of functions include the times of any other functions that they
+//     call.
+//
+
+ostream& ScoreProfile::print(ostream& out) {
+   if (!isCompiled()) {
+      out << "# Profiling is not compiled into this library:" << endl;
+      out << "# recompile the library with \"make library PROFILE=1\"."
+          << endl;
+      return out;
+   }
+
+   lock_guard<mutex> lock(ProfileMutex);
+   out << "#function\tcalls\tms\titems\n";
+   for (auto& it : ProfileEntries) {
+      out << it.first << "\t" << it.second.calls << "\t"
+          << fixed << setprecision(3) << it.second.milliseconds << "\t"
+          << it.second.items << "\n";
+   }
+   out.unsetf(ios::floatfield);
+   out << setprecision(6);
+   out << "#counter\tcount\n";
+   for (int i=0; i<CounterCount; i++) {
+      out << ProfileCounterNames[i] << "\t" << ProfileCounters[i] << "\n";
+   }
+   return out;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfile::printOnExit -- Print the profile to standard error
+//     when the program exits (including calls to exit()).  Only the
+//     first call has an effect.
+//
+
+static void printProfileAtExit(void) {
+   ScoreProfile::print(cerr);
+}
+
+void ScoreProfile::printOnExit(void) {
+   static once_flag registered;
+   call_once(registered, []() { atexit(printProfileAtExit); });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// ScoreProfileTimer --
+//
+
+//////////////////////////////
+//
+// ScoreProfileTimer::ScoreProfileTimer -- Start timing if profiling is
+//    enabled.
+//
+
+ScoreProfileTimer::ScoreProfileTimer(const char* aName, long itemcount) {
+   name   = aName;
+   items  = itemcount;
+   active = ScoreProfile::isEnabled();
+   if (active) {
+      start = chrono::steady_clock::now();
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ScoreProfileTimer::~ScoreProfileTimer -- Store the elapsed time.
+//
+
+ScoreProfileTimer::~ScoreProfileTimer() {
+   if (!active) {
+      return;
+   }
+   auto stop = chrono::steady_clock::now();
+   ScoreProfile::addTime(name, chrono::duration<double, milli>(stop -
+         start).count(), items);
+}
+
+
+
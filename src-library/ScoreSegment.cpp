@@ -12,6 +12,7 @@
 
 #include "ScoreSegment.h"
 #include "SegmentPart.h"
+#include "ScoreUtility.h"
 #include <set>
 #include <algorithm>
 
@@ -75,6 +76,7 @@ void ScoreSegment::clearPartStorage(void) {
       part_storage[i] = 0;
    }
    part_storage.resize(0);
+   system_table.clear();
 }
 
 
@@ -311,6 +313,9 @@ int ScoreSegment::getSystemStaffIndex(int systemindex, int partindex,
 
 int ScoreSegment::getPageStaffIndex(int systemindex, int partindex,
       int subpartindex) {
+   if (subpartindex == 0) {
+      return getSystem(systemindex).getPageStaffIndex(partindex);
+   }
    return part_storage[partindex]->getPageStaffIndex(systemindex,
       subpartindex);
 }
@@ -516,8 +521,82 @@ vectorSIp& ScoreSegment::getSystemItems(const AddressSystem& address) {
 
 
 vectorSIp& ScoreSegment::getSystemItems(int sysindex) {
-   const AddressSystem& address = getSystemAddress(sysindex);
-   return getSystemItems(address);
+   return getSystem(sysindex).getItems();
+}
+
+
+
+//////////////////////////////
+//
+// ScoreSegment::getSystem -- Return the page and part staff numbers of
+//     a system in the segment.  getSystems() returns all of the systems
+//     in order, which can be walked without looking up the system
+//     addresses of the segment.
+//
+
+SegmentSystem& ScoreSegment::getSystem(int sysindex) {
+   if (system_table.empty()) {
+      prepareSystemTable();
+   }
+   return system_table[sysindex];
+}
+
+
+vector<SegmentSystem>& ScoreSegment::getSystems(void) {
+   if (system_table.empty()) {
+      prepareSystemTable();
+   }
+   return system_table;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreSegment::getTicksPerQuarter -- Return the smallest number of
+//     ticks per quarter note which can represent all durations in the
+//     segment as integers: the least common multiple of the tick
+//     resolutions of its systems, which are calculated by the duration
+//     analysis of the pages.
+//
+
+int ScoreSegment::getTicksPerQuarter(void) {
+   int output = 1;
+   for (auto& system : getSystems()) {
+      int ticks = system.getTicksPerQuarter();
+      if (output % ticks != 0) {
+         output = SU::lcm(output, ticks);
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreSegment::prepareSystemTable -- Look up the page of each system in
+//     the segment, and the page staff number of each part on the system.
+//
+
+void ScoreSegment::prepareSystemTable(void) {
+   system_table.clear();
+   if (pageset_owner == NULL) {
+      cerr << "Error: cannot access NULL scoreset." << endl;
+      exit(1);
+   }
+   int syscount  = getSystemCount();
+   int partcount = getPartCount();
+   system_table.reserve(syscount);
+   for (int i=0; i<syscount; i++) {
+      const AddressSystem& address = getSystemAddress(i);
+      ScorePage* page = pageset_owner->getPage(address);
+      system_table.emplace_back(page, address.getSystemIndex());
+      SegmentSystem& system = system_table.back();
+      for (int j=0; j<partcount; j++) {
+         system.appendPageStaffIndex(part_storage[j]->getPageStaffIndex(i, 0));
+      }
+   }
 }
 
 
@@ -0,0 +1,198 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 13:40:05 PDT 2026
+// Last Modified: Sat Oct 17 13:40:08 PDT 2026
+// Filename:      ScoreUtility_number.cpp
+// URL:           https://github.com/craigsapp/scorelib/master/src-library/ScoreUtility_number.cpp
+// Syntax:        C++11
+//
+// Description:   Conversion between numbers and text.
+//
+
+#include "ScoreUtility.h"
+#include <stdlib.h>
+#include <string.h>
+#include <cstdint>
+#include <cmath>
+#include <stdio.h>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScoreUtility::parseNumber -- Convert the text between start and end
+//     into a floating-point number, giving the same result as strtod()
+//     but without needing a null-terminated string.  Plain decimal
+//     numbers with up to 15 significant digits are converted directly,
+//     which is exact since both the digits and the power of ten are
+//     representable as doubles.  Anything else (exponents, hexadecimal
+//     numbers, "inf", or long digit strings) is passed on to strtod().
+//
+
+double ScoreUtility::parseNumber(const char* start, const char* end) {
+   static const double powers[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+      1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+      1e22
+   };
+
+   const char* ptr = start;
+   int negative = 0;
+   if (ptr < end) {
+      if (*ptr == '-') {
+         negative = 1;
+         ptr++;
+      } else if (*ptr == '+') {
+         ptr++;
+      }
+   }
+
+   uint64_t mantissa = 0;
+   int digits   = 0;  // count of digits in the number
+   int fraction = 0;  // count of digits after the decimal point
+   int overflow = 0;  // true if mantissa is too large for exact conversion
+
+   while ((ptr < end) && (*ptr >= '0') && (*ptr <= '9')) {
+      mantissa = mantissa * 10 + (*ptr - '0');
+      if (mantissa > 999999999999999ULL) {
+         overflow = 1;
+      }
+      digits++;
+      ptr++;
+   }
+   if ((ptr < end) && (*ptr == '.')) {
+      ptr++;
+      while ((ptr < end) && (*ptr >= '0') && (*ptr <= '9')) {
+         mantissa = mantissa * 10 + (*ptr - '0');
+         if (mantissa > 999999999999999ULL) {
+            overflow = 1;
+         }
+         digits++;
+         fraction++;
+         ptr++;
+      }
+   }
+
+   int simple = (digits > 0) && !overflow && (fraction <= 22);
+   if (simple && (ptr < end)) {
+      switch (*ptr) {
+         case 'e': case 'E':  // exponent
+         case 'x': case 'X':  // hexadecimal number
+            simple = 0;
+      }
+   }
+
+   if (simple) {
+      double value = (double)mantissa / powers[fraction];
+      return negative ? -value : value;
+   }
+
+   // Use strtod() for everything else:
+   char buffer[64];
+   int length = (int)(end - start);
+   if (length < (int)sizeof(buffer)) {
+      memcpy(buffer, start, length);
+      buffer[length] = '\0';
+      return strtod(buffer, NULL);
+   }
+   string text(start, end);
+   return strtod(text.c_str(), NULL);
+}
+
+
+
+//////////////////////////////
+//
+// ScoreUtility::formatNumber -- Write a number as text into output,
+//     which must have room for at least 32 characters.  Returns the
+//     length of the text (which is also terminated with a null).  If
+//     roundQ is true, then the number is rounded to six significant
+//     digits, giving the same text as printing the number to an ostream
+//     with the default settings.  Otherwise the shortest text which reads
+//     back as the same number is written.  Numbers which are exact to
+//     six decimal places (as most SCORE parameters are) are converted
+//     directly, and anything else is passed on to snprintf().
+//     Default value: roundQ = 1
+//
+
+int ScoreUtility::formatNumber(char* output, double value, int roundQ) {
+   if (value == 0.0) {
+      return signbit(value) ? sprintf(output, "-0") : sprintf(output, "0");
+   }
+
+   // The number is written directly if it is the closest double to a
+   // decimal with six or fewer places.  Rounding is then only needed if
+   // the decimal has more than six significant digits, and numbers under
+   // 0.0001 or over 999999 are printed with exponents when rounding.
+   double magnitude = fabs(value);
+   int    maxdigits = roundQ ? 6 : 15;
+   if ((magnitude < (roundQ ? 1e6 : 1e9)) &&
+         (!roundQ || (magnitude >= 1e-4))) {
+      uint64_t scaled = (uint64_t)(magnitude * 1e6 + 0.5);
+      if ((scaled > 0) && ((double)scaled / 1e6 == magnitude)) {
+         int decimals = 6;
+         while ((decimals > 0) && (scaled % 10 == 0)) {
+            scaled /= 10;
+            decimals--;
+         }
+         char digits[24];
+         int count = 0;
+         do {
+            digits[count++] = '0' + (char)(scaled % 10);
+            scaled /= 10;
+         } while (scaled > 0);
+
+         if (count <= maxdigits) {
+            char* ptr = output;
+            int i;
+            if (value < 0.0) {
+               *ptr++ = '-';
+            }
+            if (count <= decimals) {
+               *ptr++ = '0';
+               *ptr++ = '.';
+               for (i=count; i<decimals; i++) {
+                  *ptr++ = '0';
+               }
+               for (i=count-1; i>=0; i--) {
+                  *ptr++ = digits[i];
+               }
+            } else {
+               for (i=count-1; i>=decimals; i--) {
+                  *ptr++ = digits[i];
+               }
+               if (decimals > 0) {
+                  *ptr++ = '.';
+                  for (i=decimals-1; i>=0; i--) {
+                     *ptr++ = digits[i];
+                  }
+               }
+            }
+            *ptr = '\0';
+            return (int)(ptr - output);
+         }
+      }
+   }
+
+   if (roundQ) {
+      return snprintf(output, 32, "%g", value);
+   }
+   // Find the smallest precision which reads back as the same number
+   // (17 digits are always enough for a double).
+   int low  = 1;
+   int high = 17;
+   while (low < high) {
+      int precision = (low + high) / 2;
+      snprintf(output, 32, "%.*g", precision, value);
+      if (strtod(output, NULL) == value) {
+         high = precision;
+      } else {
+         low = precision + 1;
+      }
+   }
+   return snprintf(output, 32, "%.*g", low, value);
+}
+
+
+
@@ -11,54 +11,115 @@
 
 #include "ScoreUtility.h"
 #include <iostream>
+#include <math.h>
 
 using namespace std;
 
+// The largest number of ticks per quarter note used for integer durations.
+// This is enough for the LCM of the common tuplets (64*3*5*7*9 = 60480),
+// and keeps the ticks of a system well within the range of an int.
+static const int MaxTicksPerQuarter = 1 << 16;
+
+
+//////////////////////////////
+//
+// ScoreUtility::getDurationDenominator -- Return the denominator of the
+//   simplest fraction which is equal to the duration (in quarter notes),
+//   allowing for the rounding of tuplet durations in P7 to three
+//   decimal places.  For example 0.167 returns 6 and 0.75 returns 4.
+//   Durations which have no simple fraction return the denominator of
+//   the closest one found with a denominator no larger than 1000.
+//
+
+int ScoreUtility::getDurationDenominator(double duration) {
+   const double tolerance = 0.002;
+   const long long maxdenominator = 1000;
+   if (duration < 0.0) {
+      duration = -duration;
+   }
+
+   // Walk through the convergents h/k of the continued fraction
+   // of the duration until one is close enough to it:
+   double x = duration;
+   long long h1 = 1;
+   long long h2 = 0;
+   long long k1 = 0;
+   long long k2 = 1;
+   int output = 1;
+   for (int i=0; i<32; i++) {
+      double a = floor(x);
+      long long h = (long long)a * h1 + h2;
+      long long k = (long long)a * k1 + k2;
+      if (k > maxdenominator) {
+         break;
+      }
+      output = (int)k;
+      if (fabs(duration - (double)h / (double)k) <= tolerance) {
+         break;
+      }
+      double fraction = x - a;
+      if (fraction < 1.0e-9) {
+         break;
+      }
+      x  = 1.0 / fraction;
+      h2 = h1;
+      h1 = h;
+      k2 = k1;
+      k1 = k;
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreUtility::getDurationTicks -- Convert a duration in quarter notes
+//   to an integer number of ticks.  If the ticks per quarter note are a
+//   multiple of the denominator of the duration, then the result is
+//   exact even if the duration was rounded (such as 0.167 for 1/6);
+//   otherwise the nearest tick is returned.
+//
+
+int ScoreUtility::getDurationTicks(double duration, int ticksperquarter) {
+   int sign = 1;
+   if (duration < 0.0) {
+      duration = -duration;
+      sign = -1;
+   }
+   int denominator = getDurationDenominator(duration);
+   if (ticksperquarter % denominator == 0) {
+      int numerator = (int)(duration * denominator + 0.5);
+      return sign * numerator * (ticksperquarter / denominator);
+   }
+   return sign * (int)(duration * ticksperquarter + 0.5);
+}
+
+
 
 //////////////////////////////
 //
-// ScoreUtility::increaseDurationPrecision -- Give more precision to 
-//   tuplet durations.  Won't work for tuplets containing large prime
-//   numbers.
+// ScoreUtility::getTicksPerQuarter -- Return the smallest number of ticks
+//   per quarter note which is a multiple of ticksperquarter and which can
+//   also represent the duration exactly.  The result is limited to
+//   MaxTicksPerQuarter, in which case durations which do not fit are
+//   rounded to the nearest tick.
 //
 
-double ScoreUtility::increaseDurationPrecision(double duration) {
-   return duration;
-   int dint = (int)duration;
-   double fraction = duration - dint;
-   int firstthree = (int)(fraction * 1000.0 + 0.5);
-   switch (firstthree) {
-      case   0: return dint;
-      case 500: return dint + 1.0/2.0;
-      case 250: return dint + 1.0/4.0;
-      case 750: return dint + 3.0/4.0;
-      case 333: return dint + 1.0/3.0;
-      case 667: return dint + 2.0/3.0;
-      case 666: return dint + 2.0/3.0;
-      case 167: return dint + 1.0/6.0;
-      case 166: return dint + 1.0/6.0;
-      case 833: return dint + 5.0/6.0;
-      case 143: return dint + 1.0/7.0;
-      case 286: return dint + 2.0/7.0;
-      case 429: return dint + 3.0/7.0;
-      case 571: return dint + 4.0/7.0;
-      case 714: return dint + 5.0/7.0;
-      case 857: return dint + 6.0/7.0;
-      case 111: return dint + 1.0/9.0;
-      case 222: return dint + 2.0/9.0;
-      case 444: return dint + 4.0/9.0;
-      case 556: return dint + 5.0/9.0;
-      case 778: return dint + 7.0/9.0;
-      case 888: return dint + 8.0/9.0;
-      case 999: return dint + 1.0;
+int ScoreUtility::getTicksPerQuarter(int ticksperquarter, double duration) {
+   if (ticksperquarter < 1) {
+      ticksperquarter = 1;
    }
-   if (fraction > 0.999) {
-      return dint + 1.0;
+   int denominator = getDurationDenominator(duration);
+   if (ticksperquarter % denominator == 0) {
+      return ticksperquarter;
    }
-   if (fraction < 0.001) {
-      return (double)dint;
+   long long output = (long long)ticksperquarter / gcd(ticksperquarter,
+         denominator) * denominator;
+   if (output > MaxTicksPerQuarter) {
+      return ticksperquarter;
    }
-   return duration;
+   return (int)output;
 }
 
 
@@ -11,9 +11,64 @@
 
 #include "ScoreUtility.h"
 #include "ScoreItem.h"
+#include <algorithm>
 
 using namespace std;
 
+// Sort keys for the key-extraction sorting functions.  The parameters
+// used by a comparison function are copied from each item into a
+// contiguous array so that sorting does not need to access the
+// parameters of the items.
+
+class _SortKeyP3 {
+   public:
+      void load(ScoreItem* anItem) {
+         p3     = anItem->getHorizontalPosition();
+         offset = anItem->getHorizontalOffset();
+         item   = anItem;
+      }
+      SCORE_FLOAT  p3;
+      SCORE_FLOAT  offset;
+      ScoreItem*   item;
+};
+
+class _SortKeyP3P4P1 {
+   public:
+      void load(ScoreItem* anItem) {
+         p3     = anItem->getHorizontalPosition();
+         p4     = anItem->getVerticalPosition();
+         p1     = anItem->getPInt(P1);
+         offset = anItem->getHorizontalOffset();
+         item   = anItem;
+      }
+      SCORE_FLOAT  p3;
+      SCORE_FLOAT  p4;
+      SCORE_FLOAT  p1;
+      SCORE_FLOAT  offset;
+      ScoreItem*   item;
+};
+
+class _SortKeyP3P2P1P4 {
+   public:
+      void load(ScoreItem* anItem) {
+         p3     = anItem->getHorizontalPosition();
+         p2     = anItem->getStaffNumber();
+         p1     = anItem->getItemType();
+         p4     = anItem->getVerticalPosition();
+         offset = anItem->getHorizontalOffset();
+         item   = anItem;
+      }
+      SCORE_FLOAT  p3;
+      unsigned int p2;
+      int          p1;
+      SCORE_FLOAT  p4;
+      SCORE_FLOAT  offset;
+      ScoreItem*   item;
+};
+
+template <class KEY, class COMPARE>
+static void sortItemsByKey(vectorSIp& items, COMPARE compare);
+
 
 //////////////////////////////
 //
@@ -333,3 +388,117 @@ bool ScoreUtility::sortP3P2P1P4(ScoreItem* a, ScoreItem* b) {
 
 
 
+//////////////////////////////
+//
+// ScoreUtility::sortItemsP3 -- Sort a list of items in the same order
+//     as sort() with ScoreUtility::sortP3, but by first extracting the
+//     sort keys of the items.  Use for long lists of items such as all
+//     items on a page.
+//
+
+void ScoreUtility::sortItemsP3(vectorSIp& items) {
+   sortItemsByKey<_SortKeyP3>(items,
+      [](const _SortKeyP3& a, const _SortKeyP3& b) {
+         SCORE_FLOAT diff = b.p3 - a.p3;
+         if (fabs(diff) > 0.0001) {
+            return diff > 0 ? true : false;
+         }
+         return a.offset < b.offset ? true : false;
+      });
+}
+
+
+
+//////////////////////////////
+//
+// ScoreUtility::sortItemsP3P4P1 -- Key-extraction equivalent of sort()
+//     with ScoreUtility::sortP3P4P1.
+//
+
+void ScoreUtility::sortItemsP3P4P1(vectorSIp& items) {
+   sortItemsByKey<_SortKeyP3P4P1>(items,
+      [](const _SortKeyP3P4P1& a, const _SortKeyP3P4P1& b) {
+         if (a.p3 < b.p3) {
+            return true;
+         } else if (a.p3 > b.p3) {
+            return false;
+         }
+         if (a.p4 < b.p4) {
+            return true;
+         } else if (a.p4 > b.p4) {
+            return false;
+         }
+         if (a.p1 < b.p1) {
+            return true;
+         }
+         return a.offset < b.offset ? true : false;
+      });
+}
+
+
+
+//////////////////////////////
+//
+// ScoreUtility::sortItemsP3P2P1P4 -- Key-extraction equivalent of sort()
+//     with ScoreUtility::sortP3P2P1P4.
+//
+
+void ScoreUtility::sortItemsP3P2P1P4(vectorSIp& items) {
+   sortItemsByKey<_SortKeyP3P2P1P4>(items,
+      [](const _SortKeyP3P2P1P4& a, const _SortKeyP3P2P1P4& b) {
+         if (a.p3 < b.p3) {
+            return true;
+         } else if (a.p3 > b.p3) {
+            return false;
+         }
+         if (a.p2 < b.p2) {
+            return true;
+         } else if (a.p2 > b.p2) {
+            return false;
+         }
+         if (a.p1 < b.p1) {
+            return true;
+         } else if (a.p1 > b.p1) {
+            return false;
+         }
+         if (a.p4 < b.p4) {
+            return true;
+         } else if (a.p4 > b.p4) {
+            return false;
+         }
+         return a.offset < b.offset ? true : false;
+      });
+}
+
+
+
+//////////////////////////////
+//
+// sortItemsByKey -- Load the sort keys for a list of items, sort the
+//     keys, and then store the items in the sorted order of their keys.
+//     The key comparison function must give the same results as the
+//     comparison function of the items that it replaces, so that sort()
+//     makes the same moves as it would when sorting the item list
+//     directly (items with equal keys keep the same relative order as
+//     they would otherwise have, since sort() is not stable).
+//
+
+template <class KEY, class COMPARE>
+static void sortItemsByKey(vectorSIp& items, COMPARE compare) {
+   int count = (int)items.size();
+   if (count < 2) {
+      return;
+   }
+   vector<KEY> keys(count);
+   int i;
+   for (i=0; i<count; i++) {
+      keys[i].load(items[i]);
+   }
+   sort(keys.begin(), keys.end(), compare);
+   for (i=0; i<count; i++) {
+      items[i] = keys[i].item;
+   }
+}
+
+
+
@@ -15,14 +15,23 @@
 using namespace std;
 
 
+#define XML_ESCAPED_CHARS "&\"'<>"
+
+
 //////////////////////////////
 //
-// ScoreItemBase::printXmlTextEscapedUTF8 --
+// ScoreItemBase::printXmlTextEscapedUTF8 -- Text which does not need to
+//     be escaped (most text) is written directly to the output without
+//     making a copy of it.
 //
 
 ostream& ScoreUtility::printXmlTextEscapedUTF8(ostream& out,
       const string& text) {
-   out << SU::getTextNoFontXmlEscapedUTF8(text);
+   if (text.find_first_of(XML_ESCAPED_CHARS) == string::npos) {
+      out.write(text.data(), text.size());
+   } else {
+      out << SU::getTextNoFontXmlEscapedUTF8(text);
+   }
    return out;
 }
 
@@ -33,8 +42,11 @@ ostream& ScoreUtility::printXmlTextEscapedUTF8(ostream& out,
 //
 
 string ScoreUtility::getTextNoFontXmlEscapedUTF8(const string& text) {
+   if (text.find_first_of(XML_ESCAPED_CHARS) == string::npos) {
+      return text;
+   }
    string output;
-   output.reserve(output.size()*2);
+   output.reserve(text.size() + 16);
 
    int length = text.size();
    char ch;
@@ -0,0 +1,102 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:57:12 PDT 2026
+// Last Modified: Sat Oct 17 23:57:15 PDT 2026
+// Filename:      ScoreUtility_thread.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/ScoreUtility_thread.cpp
+// Syntax:        C++11
+//
+// Description:   ScoreUtility functions for running tasks in parallel.
+//
+
+#include "ScoreUtility.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// ScoreUtility::getThreadCount -- Return the number of threads to use
+//    for the given number of tasks.  A requested thread count of 0 means
+//    one thread for each processor core.
+//
+
+int ScoreUtility::getThreadCount(int requested, int tasks) {
+   int threads = requested;
+   if (threads == 0) {
+      threads = thread::hardware_concurrency();
+   }
+   if (threads > tasks) {
+      threads = tasks;
+   }
+   if (threads < 1) {
+      threads = 1;
+   }
+   return threads;
+}
+
+
+
+//////////////////////////////
+//
+// ScoreUtility::runParallel -- Run task(0) to task(count-1) using the
+//    requested number of threads (0 for one thread per processor core).
+//    Each thread takes the next task which has not been started until
+//    all tasks have been run, so tasks which take longer than others
+//    do not hold up the remaining tasks.  The calling thread runs tasks
+//    as well, and the function returns when all tasks are finished.
+//    With one thread the tasks are run in order.
+//
+//    If a task throws an exception, no more tasks are started, and the
+//    first exception is thrown again in the calling thread after the
+//    tasks which are running have finished (as when running serially).
+//
+
+void ScoreUtility::runParallel(int count, int threads,
+      const function<void(int)>& task) {
+   threads = getThreadCount(threads, count);
+   if (threads <= 1) {
+      for (int i=0; i<count; i++) {
+         task(i);
+      }
+      return;
+   }
+
+   atomic<int> next(0);
+   exception_ptr error;
+   mutex errorlock;
+   auto worker = [&]() {
+      int index;
+      while ((index = next++) < count) {
+         try {
+            task(index);
+         } catch (...) {
+            lock_guard<mutex> guard(errorlock);
+            if (!error) {
+               error = current_exception();
+            }
+            next = count;
+         }
+      }
+   };
+
+   vector<thread> workers;
+   workers.reserve(threads - 1);
+   for (int i=1; i<threads; i++) {
+      workers.push_back(thread(worker));
+   }
+   worker();
+   for (auto& it : workers) {
+      it.join();
+   }
+   if (error) {
+      rethrow_exception(error);
+   }
+}
+
+
+
@@ -11,6 +11,7 @@
 
 #include "ScoreUtility.h"
 #include "ScoreItem.h"
+#include "ScorePageBase_AnalysisTable.h"
 
 using namespace std;
 
@@ -148,14 +149,18 @@ void ScoreUtility::identifySlurStartStopOffsets(int index,
    int endQ   = 0;
 
    for (i=0; i<(int)notes.size(); i++) {
+      if (notes[i].empty()) {
+         // The first rhythm cell is empty if the staff does not
+         // start with a note.
+         continue;
+      }
       lasthpos = hpos;
       hpos = notes[i][0]->getHPos();
 
       // search for the starting position of the slur
       if (!startQ) {
          if (hpos == starthpos) {
-            startoffset = notes[i][0]->getParameterDouble(ns_auto,
-                     np_staffOffsetDuration);
+            startoffset = notes[i][0]->getStaffOffsetDuration();
             startQ = 1;
             startindex = i;
          } else if (hpos > starthpos) {
@@ -163,13 +168,11 @@ void ScoreUtility::identifySlurStartStopOffsets(int index,
             diff2 = starthpos - lasthpos;
 
             if (diff1 < diff2) {
-               startoffset = notes[i][0]->getParameterDouble(ns_auto,
-                     np_staffOffsetDuration);
+               startoffset = notes[i][0]->getStaffOffsetDuration();
                startQ = 1;
                startindex = i;
             } else if (i > 0) {
-               startoffset = notes[i-1][0]->getParameterDouble(ns_auto,
-                     np_staffOffsetDuration);
+               startoffset = notes[i-1][0]->getStaffOffsetDuration();
                startQ = 1;
                startindex = i;
             } else {
@@ -183,10 +186,9 @@ void ScoreUtility::identifySlurStartStopOffsets(int index,
       // search for the ending position of the slur
       if (!endQ) {
          if (hpos == endhpos) {
+            endoffset = notes[i][0]->getStaffOffsetDuration();
             sip->setParameterQuiet(ns_auto, np_staffOffsetRight,
-               notes[i][0]->getParameter(ns_auto, np_staffOffsetDuration));
-            endoffset = notes[i][0]->getParameterDouble(ns_auto,
-                  np_staffOffsetDuration);
+                  AnalysisTable::formatDuration(endoffset));
             endQ = 1;
             endindex = i;
          } else if (hpos > endhpos) {
@@ -194,17 +196,15 @@ void ScoreUtility::identifySlurStartStopOffsets(int index,
             diff2 = endhpos - lasthpos;
 
             if (diff1 < diff2) {
+               endoffset = notes[i][0]->getStaffOffsetDuration();
                sip->setParameterQuiet(ns_auto, np_staffOffsetRight,
-                  notes[i][0]->getParameter(ns_auto, np_staffOffsetDuration));
-               endoffset = notes[i][0]->getParameterDouble(ns_auto,
-                     np_staffOffsetDuration);
+                     AnalysisTable::formatDuration(endoffset));
                endQ = 1;
                endindex = i;
             } else if (i > 0) {
+               endoffset = notes[i-1][0]->getStaffOffsetDuration();
                sip->setParameterQuiet(ns_auto, np_staffOffsetRight,
-                  notes[i-1][0]->getParameter(ns_auto, np_staffOffsetDuration));
-               endoffset = notes[i-1][0]->getParameterDouble(ns_auto,
-                  np_staffOffsetDuration);
+                     AnalysisTable::formatDuration(endoffset));
                endQ = 1;
                endindex = i;
             } else {
@@ -374,25 +374,19 @@ void ScoreUtility::linkNotesByTie(ScoreItem* startslur,  SCORE_FLOAT slurdur,
          }
 
          // Link the two notes together:
-         leftnotes[i]->setParameterQuiet(ns_auto, np_tiedNextNote,
-            rightnotes[j]);
-         rightnotes[j]->setParameterQuiet(ns_auto, np_tiedLastNote,
-            leftnotes[i]);
+         leftnotes[i]->setTiedNextNote(rightnotes[j]);
+         rightnotes[j]->setTiedLastNote(leftnotes[i]);
 
          // Link the notes to the ties:
          leftnotes[i]->setParameterQuiet(ns_auto, np_tieLast, startslur);
          rightnotes[j]->setParameterQuiet(ns_auto, np_tieNext, endslur);
 
          // Link the ties to the notes:
-         startslur->setParameterQuiet(ns_auto, np_tiedLastNote,
-            leftnotes[i]);
-         startslur->setParameterQuiet(ns_auto, np_tiedNextNote,
-            rightnotes[j]);
+         startslur->setTiedLastNote(leftnotes[i]);
+         startslur->setTiedNextNote(rightnotes[j]);
          if (endslur != startslur) {
-            endslur->setParameterQuiet(ns_auto, np_tiedLastNote,
-               leftnotes[i]);
-            endslur->setParameterQuiet(ns_auto, np_tiedNextNote,
-               rightnotes[j]);
+            endslur->setTiedLastNote(leftnotes[i]);
+            endslur->setTiedNextNote(rightnotes[j]);
          }
 
          // Need to check the pitches a bit to make sure that these
@@ -404,8 +398,7 @@ void ScoreUtility::linkNotesByTie(ScoreItem* startslur,  SCORE_FLOAT slurdur,
          // This particular case is needed tied notes across barlines:
          // (C# | C), where the second C has an implicit sharp from the
          // first note of the tie.
-         rightnotes[j]->setParameterQuiet(ns_auto, np_base40Pitch,
-            leftnotes[i]->getParameter(ns_auto, np_base40Pitch));
+         rightnotes[j]->setBase40Pitch(leftnotes[i]->getBase40Pitch());
 
          // store addresses for linked items (for readability of
          // data when written, not used internally).
@@ -0,0 +1,146 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 04:31:08 PDT 2026
+// Last Modified: Sun Oct 18 04:31:11 PDT 2026
+// Filename:      SegmentSystem.cpp
+// URL:           https://github.com/craigsapp/scorelib/blob/master/src-library/SegmentSystem.cpp
+// Syntax:        C++11
+//
+// Description:   One system of a ScoreSegment (see SegmentSystem.h).
+//
+
+#include "SegmentSystem.h"
+#include "ScorePage.h"
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// SegmentSystem::SegmentSystem -- Constructor.
+//
+
+SegmentSystem::SegmentSystem(void) {
+   page = NULL;
+   system_index = -1;
+}
+
+
+SegmentSystem::SegmentSystem(ScorePage* apage, int sysindex) {
+   page = apage;
+   system_index = sysindex;
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::~SegmentSystem -- Deconstructor.  The page is owned by
+//     the ScorePageSet, so it is not deleted.
+//
+
+SegmentSystem::~SegmentSystem() {
+   clear();
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::clear --
+//
+
+void SegmentSystem::clear(void) {
+   page = NULL;
+   system_index = -1;
+   page_staves.clear();
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getPage -- Return the page which contains the system.
+//
+
+ScorePage* SegmentSystem::getPage(void) const {
+   return page;
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getSystemIndex -- Return the index of the system on
+//     its page.
+//
+
+int SegmentSystem::getSystemIndex(void) const {
+   return system_index;
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getItems -- Return the items of the system, sorted in
+//     the same way as ScorePage::getSystemItems().
+//
+
+vectorSIp& SegmentSystem::getItems(void) {
+   return page->getSystemItems(system_index);
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getTicksPerQuarter -- Return the tick resolution of the
+//     system (see ScorePage::getSystemTicksPerQuarter()).
+//
+
+int SegmentSystem::getTicksPerQuarter(void) {
+   return page->getSystemTicksPerQuarter(system_index);
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getPartCount -- Return the number of parts for which
+//     page staff numbers are stored.
+//
+
+int SegmentSystem::getPartCount(void) const {
+   return (int)page_staves.size();
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::getPageStaffIndex -- Return the P2 staff number of the
+//     given part on the system, or -1 if the part is not on the system.
+//
+
+int SegmentSystem::getPageStaffIndex(int partindex) const {
+   if ((partindex < 0) || (partindex >= (int)page_staves.size())) {
+      return -1;
+   }
+   return page_staves[partindex];
+}
+
+
+
+//////////////////////////////
+//
+// SegmentSystem::appendPageStaffIndex -- Store the P2 staff number of the
+//     next part on the system.
+//
+
+void SegmentSystem::appendPageStaffIndex(int p2) {
+   page_staves.push_back(p2);
+}
+
+
+
@@ -22,8 +22,16 @@ using namespace std;
 //
 
 SystemMeasure::SystemMeasure(void) {
-   measure_duration  = -1.0;
-   system_offset     = -1.0;
+   measure_ticks     = -1;
+   system_offset     = -1;
+   ticks_per_quarter = 1;
+}
+
+
+SystemMeasure::SystemMeasure(int ticksperquarter) {
+   measure_ticks     = -1;
+   system_offset     = -1;
+   ticks_per_quarter = ticksperquarter < 1 ? 1 : ticksperquarter;
 }
 
 
@@ -48,29 +56,34 @@ void SystemMeasure::clear(void) {
    start_bars.resize(0);
    end_bars.resize(0);
    measure_items.resize(0);
-   measure_duration = -1.0;
-   system_offset    = -1.0;
+   measure_ticks    = -1;
+   system_offset    = -1;
 }
 
 
 
 //////////////////////////////
 //
-// SystemMeasure::addItem --
+// SystemMeasure::addItem -- Add an item to the measure, extending the
+//    duration of the measure to the end of the item.  The durations are
+//    added as integer ticks of the system (the staff offsets in ticks
+//    calculated by ScorePage::analyzeStaffDurations()).
 //
 
 void SystemMeasure::addItem(ScoreItem* item) {
-   SCORE_FLOAT offset = item->getStaffOffsetDuration();
-   if (system_offset < 0.0) {
+   int offset = item->getStaffOffsetTicks();
+   if (offset < 0) {
+      offset = SU::getDurationTicks(item->getStaffOffsetDuration(),
+            ticks_per_quarter);
+   }
+   if (system_offset < 0) {
       system_offset = offset;
    }
 
-   SCORE_FLOAT idur   = item->getDuration();
-   idur = SU::increaseDurationPrecision(idur);
-   SCORE_FLOAT curdur = (offset + idur) - system_offset;
-   if (measure_duration < curdur) {
-      measure_duration = curdur;
-      measure_duration = SU::increaseDurationPrecision(measure_duration);
+   int idur   = SU::getDurationTicks(item->getDuration(), ticks_per_quarter);
+   int curdur = (offset + idur) - system_offset;
+   if (measure_ticks < curdur) {
+      measure_ticks = curdur;
    }
 
    if (!item->isBarlineItem()) {
@@ -78,7 +91,7 @@ void SystemMeasure::addItem(ScoreItem* item) {
       return;
    }
 
-   if (curdur == 0.0) {
+   if (curdur == 0) {
       start_bars.push_back(item);
       measure_items.push_back(item);
    } else {
@@ -94,7 +107,10 @@ void SystemMeasure::addItem(ScoreItem* item) {
 //
 
 SCORE_FLOAT SystemMeasure::getSystemOffsetDuration(void) {
-   return system_offset;
+   if (system_offset < 0) {
+      return -1.0;
+   }
+   return (SCORE_FLOAT)system_offset / ticks_per_quarter;
 }
 
 
@@ -105,10 +121,10 @@ SCORE_FLOAT SystemMeasure::getSystemOffsetDuration(void) {
 //
 
 SCORE_FLOAT SystemMeasure::getMeasureDuration(void) {
-   if (measure_duration - (int)measure_duration < 0.0001) {
-      measure_duration = (int)measure_duration;
+   if (measure_ticks < 0) {
+      return -1.0;
    }
-   return measure_duration;
+   return (SCORE_FLOAT)measure_ticks / ticks_per_quarter;
 }
 
 //
@@ -121,6 +137,43 @@ SCORE_FLOAT SystemMeasure::getDuration(void) {
 
 
 
+//////////////////////////////
+//
+// SystemMeasure::getSystemOffsetTicks -- Return the start of the measure
+//    within the system in ticks, or -1 if there are no items in the
+//    measure.
+//
+
+int SystemMeasure::getSystemOffsetTicks(void) {
+   return system_offset;
+}
+
+
+
+//////////////////////////////
+//
+// SystemMeasure::getMeasureTicks -- Return the duration of the measure
+//    in ticks, or -1 if there are no items in the measure.
+//
+
+int SystemMeasure::getMeasureTicks(void) {
+   return measure_ticks;
+}
+
+
+
+//////////////////////////////
+//
+// SystemMeasure::getTicksPerQuarter -- Return the number of ticks per
+//    quarter note used for the measure durations.
+//
+
+int SystemMeasure::getTicksPerQuarter(void) {
+   return ticks_per_quarter;
+}
+
+
+
 //////////////////////////////
 //
 // SystemMeasure::getStartBarlines --
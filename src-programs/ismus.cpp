@@ -8,30 +8,40 @@
 // Syntax:        C++ 11
 //
 // Description:   Identifies if input files are binary SCORE files.
+//                The --type option prints the type of each file
+//                instead: binary, pmx, ppmx (PMX starting with a page
+//                marker) or other.  Directories given with the -r option
+//                are searched and the files are checked with the number
+//                of threads given by the --threads option.
 //
 
-#include "Options.h"
-#include "stdlib.h"
-#include <fstream>
+#include "scorelib.h"
+#include <algorithm>
 #include <iostream>
 #include <sys/stat.h>
-#include <dirent.h>
 #include <sys/types.h>
 
 using namespace std;
 
-int    checkFile            (const string& filename);
 void   processOptions       (Options& opts, int argc, char** argv);
-int    isFile               (string name);
-int    isDirectory          (string name);
-void   printResult          (int result, const string& filename);
-void   recursiveCheck       (const string& name);
+int    isDirectory          (const string& name);
+void   printResult          (int type, const string& filename);
+void   checkFiles           (const vector<string>& files);
 
 // Interface variables:
 Options options;
 int badQ       = 0;         // used with -b option
 int goodQ      = 0;         // used with -g option
 int recursiveQ = 0;         // used with -r option
+int typeQ      = 0;         // used with --type option
+int threads    = 1;         // used with -t option
+
+// Number of files checked at a time.  The results of each block are
+// printed before the next block is checked.
+#define FILE_BLOCK_SIZE 1024
+
+// Set to true if any file cannot be read.
+int errorQ = 0;
 
 
 ///////////////////////////////////////////////////////////////////////////
@@ -41,85 +51,47 @@ int main(int argc, char** argv) {
 
    int filecount = options.getArgCount();
 
-   int result;
+   vector<string> files;
    for (int i=1; i<=filecount; i++) {
-      if (recursiveQ) {
-         recursiveCheck(options.getArgument(i));
+      if (recursiveQ && isDirectory(options.getArgument(i))) {
+         checkFiles(files);
+         files.clear();
+         ScoreFileType::findFiles(options.getArgument(i), files, threads);
+         checkFiles(files);
+         files.clear();
       } else {
-         result = checkFile(options.getArgument(i));
-         printResult(result, options.getArgument(i));
-
+         files.push_back(options.getArgument(i));
       }
    }
+   checkFiles(files);
 
-   return 0;
+   return errorQ;
 }
 
 ///////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////
 //
-// printResult --
-//
-
-void printResult(int result, const string& filename) {
-   if (goodQ) {
-      if (result) {
-         cout << filename << endl;
-      }
-   } else if (badQ) {
-      if (!result) {
-         cout << filename << endl;
-      }
-   } else {
-      if (result) {
-         cout << "YES";
-      } else {
-         cout << "NO";
-      }
-      cout << "\t" << filename << endl;
-   }
-}
-
-
-
-//////////////////////////////
-//
-// recursiveCheck --
+// checkFiles -- Check a list of files in blocks, printing the results of
+//     each block in the order of the list.  Files which cannot be read
+//     are reported to standard error.
 //
 
-void recursiveCheck(const string& name) {
-   int result, i;
-   if (isFile(name)) {
-      result = checkFile(name);
-      printResult(result, name);
-   } else if (isDirectory(name)) {
-      vector<string> dirs;
-      DIR *dir;
-      struct dirent *ent;
-      string filename;
-      if ((dir = opendir(name.data())) != NULL) {
-         while ((ent = readdir(dir)) != NULL) {
-            if (ent->d_name[0] == '.') {
-               continue;
-            }
-            filename = name;
-            if (filename[filename.size()-1] != '/') {
-               filename += "/";
-            } 
-            filename += ent->d_name;
-            if (isFile(filename)) {
-               result = checkFile(filename);
-               printResult(result, filename);
-               continue;
-            } else if (isDirectory(filename)) {
-               dirs.push_back(filename);
-            }
-         }
-         closedir(dir);
-         for (i=0; i<(int)dirs.size(); i++) {
-            recursiveCheck(dirs[i]);
+void checkFiles(const vector<string>& files) {
+   vector<string> block;
+   vector<int> types;
+   for (int i=0; i<(int)files.size(); i+=FILE_BLOCK_SIZE) {
+      int count = min((int)files.size() - i, FILE_BLOCK_SIZE);
+      block.assign(files.begin() + i, files.begin() + i + count);
+      ScoreFileType::classifyFiles(block, types, threads);
+      for (int j=0; j<count; j++) {
+         if (types[j] == ScoreFileType::FILE_UNREADABLE) {
+            cout << flush;
+            cerr << "Error: cannot read the file: " << block[j] << endl;
+            errorQ = 1;
+            continue;
          }
+         printResult(types[j], block[j]);
       }
    }
 }
@@ -128,48 +100,28 @@ void recursiveCheck(const string& name) {
 
 //////////////////////////////
 //
-// checkFile --
+// printResult --
 //
 
-int checkFile(const string& filename) {
-   ifstream testfile(filename.data());
-
-   if (!testfile.is_open()) {
-      cerr << "Error: cannot read the file: " << filename << endl;
-      exit(1);
-   }
-
-   testfile.seekg(-4, ios::end);
-
-   unsigned char databytes[4] = {0xff};
-   testfile.read((char*)databytes, 4);
-   if (databytes[0] == 0x00 && databytes[1] == 0x3c && databytes[2] == 0x1c &&
-         databytes[3] == 0xc6) {
-      return 1;
+void printResult(int type, const string& filename) {
+   int result = (type == ScoreFileType::FILE_BINARY);
+   if (goodQ) {
+      if (result) {
+         cout << filename << "\n";
+      }
+   } else if (badQ) {
+      if (!result) {
+         cout << filename << "\n";
+      }
+   } else if (typeQ) {
+      cout << ScoreFileType::getTypeName(type) << "\t" << filename << "\n";
    } else {
-      return 0;
-   }
-}
-
-
-
-//////////////////////////////
-//
-// isFile -- returns true if filename is a file.
-//
-
-int isFile(string name) {
-   struct stat s;
-   if (stat(name.data(), &s) == 0) {
-      if (s.st_mode & S_IFDIR) {
-         return 0; // directory
-      } else if (s.st_mode & S_IFREG) {
-         return 1; // file
+      if (result) {
+         cout << "YES";
       } else {
-         return 0;
+         cout << "NO";
       }
-   } else {
-      return 0;
+      cout << "\t" << filename << "\n";
    }
 }
 
@@ -180,16 +132,10 @@ int isFile(string name) {
 // isDirectory -- returns true if filename is a directory.
 //
 
-int isDirectory(string name) {
+int isDirectory(const string& name) {
    struct stat s;
    if (stat(name.data(), &s) == 0) {
-      if (s.st_mode & S_IFDIR) {
-         return 1; // directory
-      } else if (s.st_mode & S_IFREG) {
-         return 0; // file
-      } else {
-         return 0;
-      }
+      return S_ISDIR(s.st_mode) ? 1 : 0;
    } else {
       return 0;
    }
@@ -203,17 +149,23 @@ int isDirectory(string name) {
 //
 
 void processOptions(Options& opts, int argc, char** argv) {
-   opts.define("g|good|y|yes=b", 
+   opts.define("g|good|y|yes=b",
          "Print only names of files which have binary SCORE data");
-   opts.define("b|bad|n|no=b", 
+   opts.define("b|bad|n|no=b",
          "Print only names of files which do not have binary SCORE data");
-   opts.define("r|recursive=b", 
+   opts.define("r|recursive=b",
          "Recursively check subdirectories");
+   opts.define("type=b",
+         "Print the type of each file (binary, pmx, ppmx or other)");
+   opts.define("t|threads=i:1",
+         "Number of threads (0 for one per core)");
    opts.process(argc, argv);
 
    badQ       = opts.getBoolean("bad");
    goodQ      = opts.getBoolean("good");
    recursiveQ = opts.getBoolean("recursive");
+   typeQ      = opts.getBoolean("type");
+   threads    = opts.getInteger("threads");
    if (goodQ) {
       badQ = 0;
    }
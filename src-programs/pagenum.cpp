@@ -19,12 +19,12 @@ using namespace std;
 
 // function declarations:
 void   processOptions       (Options& opts, int argc, char** argv);
-void   identifyPageNumbers  (ScorePageSet& infiles);
-void   identifyPageNumbers  (ScorePage& infile, int pageindex, int pagecount);
+void   identifyPageNumbers  (ScorePageStream& infiles);
+void   identifyPageNumbers  (ScorePage& infile, int pageindex, int lastQ);
 void   identifyPageNumbers  (vectorSIp& items, int pageindex, int direction, 
-                             int pagecount);
+                             int lastQ);
 int    onlyHasNumbers       (ScoreItem* sip);
-void   identifyPageNumber   (ScoreItem* item, int pageindex, int pagecount);
+void   identifyPageNumber   (ScoreItem* item, int pageindex, int lastQ);
 
 // user-interface variables:
 Options options;
@@ -41,11 +41,8 @@ int LastPage = -1;     // used for identifing breaks in page number sequence
 
 int main(int argc, char** argv) {
    processOptions(options, argc, argv);
-   ScorePageSet infiles(options);
+   ScorePageStream infiles(options);
    identifyPageNumbers(infiles);
-   if (labelQ) {
-      cout << infiles;
-   }
    return 0;
 }
 
@@ -54,31 +51,41 @@ int main(int argc, char** argv) {
 
 //////////////////////////////
 //
-// identifyPageNumbers --
+// identifyPageNumbers -- Process the pages one at a time, printing
+//     each page after its page number has been labeled (-l option).
 //
 
-void  identifyPageNumbers(ScorePageSet& infiles) {
-   int pagecount = infiles.getPageCount();
-   for (int i=0; i<pagecount; i++) {
-      identifyPageNumbers(infiles[i][0], i, pagecount);
+void  identifyPageNumbers(ScorePageStream& infiles) {
+   int rsQ = 1;
+   while (infiles.next()) {
+      ScorePageOverlay& page = infiles.getCurrent();
+      int pageindex = infiles.getPageIndex();
+      identifyPageNumbers(page[0], pageindex, !infiles.hasNext());
+      if (labelQ) {
+         if ((pageindex > 0) && !rsQ) {
+            cout << "\n";
+         }
+         cout << page;
+         rsQ = page[0].isMultipageAsRs();
+      }
    }
 }
 
 
-void identifyPageNumbers(ScorePage& infile, int pageindex, int pagecount) {
+void identifyPageNumbers(ScorePage& infile, int pageindex, int lastQ) {
    int syscount = infile.getSystemCount();
    if (aboveQ) {
-      identifyPageNumbers(infile.getSystemItems(0), pageindex, 1, pagecount);
+      identifyPageNumbers(infile.getSystemItems(0), pageindex, 1, lastQ);
    }
    if (belowQ) {
       identifyPageNumbers(infile.getSystemItems(syscount-1), pageindex, -1, 
-            pagecount);
+            lastQ);
    }
 }
 
 
 void  identifyPageNumbers(vectorSIp& items, int pageindex, int direction, 
-      int pagecount) {
+      int lastQ) {
    vectorSIp foundlist;
    int minstaff = 1000;
    int maxstaff = -1000;
@@ -145,13 +152,13 @@ void  identifyPageNumbers(vectorSIp& items, int pageindex, int direction,
       }
       if (direction == 1) {
          // choose highest item
-         identifyPageNumber(foundlist[highest], pageindex, pagecount);
+         identifyPageNumber(foundlist[highest], pageindex, lastQ);
       } else if (direction == -1) {
          // chose lowest item
-         identifyPageNumber(foundlist[lowest], pageindex, pagecount);
+         identifyPageNumber(foundlist[lowest], pageindex, lastQ);
       }
    } else if (foundlist.size() == 1) {
-      identifyPageNumber(foundlist[0], pageindex, pagecount);
+      identifyPageNumber(foundlist[0], pageindex, lastQ);
    }
 
 
@@ -164,7 +171,7 @@ void  identifyPageNumbers(vectorSIp& items, int pageindex, int direction,
 // identifyPageNumber -- Mark or print page number.
 //
 
-void identifyPageNumber(ScoreItem* item, int pageindex, int pagecount) {
+void identifyPageNumber(ScoreItem* item, int pageindex, int lastQ) {
    int pagenum = 0;
 
    if (labelQ) {
@@ -197,10 +204,9 @@ void identifyPageNumber(ScoreItem* item, int pageindex, int pagecount) {
          }
       }
       cout << "}";
-      if (pageindex < pagecount - 1) {
+      if (!lastQ) {
          cout << ",";
-      }
-      if (pageindex == pagecount - 1) {
+      } else {
          cout << ']';
       }
       cout << endl;
@@ -7,18 +7,26 @@
 // Documentation: https://github.com/craigsapp/scorelib/wiki/score2mei
 // Syntax:        C++ 11
 //
-// Description:   Converts a ScorePageSet into MEI.
+// Description:   Converts a ScorePageSet into MEI.  With the --batch
+//                option, a list of works is converted to separate files
+//                (see ScoreBatch.h).
 //
 
 #include "scorelib.h"
 #include <chrono>
 #include <ctime>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
 void     processData                (ScorePageSet& infiles, Options& opts);
+void     processBatch               (Options& opts);
+void     analyzeInput               (ScorePageSet& infiles);
+int      convertWork                (ScorePageSet& infiles, ostream& out,
+                                     Options& opts);
 ostream& convertSingleSegment       (ostream& out, ScorePageSet& infiles,
                                      int segment, int indent);
 ostream& convertAllSegmentsToMdivs  (ostream& out, ScorePageSet& infiles);
@@ -125,6 +133,7 @@ int      systemBreaksQ    = 1;
 int      pageBreaksQ      = 1;
 int      StartTempo       = -1;
 int      dufayQ           = 0;
+int      Threads          = 1;
 
 ///////////////////////////////////////////////////////////////////////////
 
@@ -143,6 +152,11 @@ int main(int argc, char** argv) {
    opts.define("no-system-breaks=b", "Don't print system break information");
    opts.define("no-page-breaks=b", "Don't print page break information");
    opts.define("dufay=b", "Use default options for Dufay translations");
+   opts.define("profile=b", "Print time spent in analyses to stderr");
+   opts.define("threads=i:1", "Threads for reading and analyzing pages");
+   opts.define("cache=b", "Store analyses in a cache file next to input");
+   opts.define("batch=s", "Convert works in a manifest file or directory");
+   opts.define("outdir=s", "Directory for the output files of --batch");
    opts.process(argc, argv);
 
    locationQ        = !opts.getBoolean("no-location");
@@ -154,6 +168,7 @@ int main(int argc, char** argv) {
    systemBreaksQ    = !opts.getBoolean("no-system-breaks");
    pageBreaksQ      = !opts.getBoolean("no-page-breaks");
    dufayQ           =  opts.getBoolean("dufay");
+   Threads          =  opts.getInteger("threads");
    if (dufayQ) {
       rhythmicScalingQ = 1;
       Scaling          = 1;
@@ -161,9 +176,18 @@ int main(int argc, char** argv) {
       StartTempo       = 525;
    }
 
-   ScorePageSet infiles(opts);
+   if (opts.getBoolean("batch")) {
+      processBatch(opts);
+      return 0;
+   }
 
-   processData(infiles, opts);
+   ScorePageSet infiles(opts);
+   try {
+      processData(infiles, opts);
+   } catch (const exception& error) {
+      cerr << "Error: " << error.what() << endl;
+      exit(1);
+   }
 
    return 0;
 }
@@ -177,40 +201,117 @@ int main(int argc, char** argv) {
 //
 
 void processData(ScorePageSet& infiles, Options& opts) {
-   infiles.analyzeSegmentsByIndent();
-   infiles.analyzePitch();
+   analyzeInput(infiles);
+
+   if (opts.getBoolean("filebase") && !opts.getBoolean("segment") &&
+         (infiles.getSegmentCount() != 1)) {
+      string filebase = opts.getString("filebase");
+      convertAllSegmentsToSeparateFiles(infiles, filebase);
+   } else if (!convertWork(infiles, cout, opts)) {
+      cerr << "Error: there is no segment " << opts.getInteger("segment")
+           << endl;
+      exit(1);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// processBatch -- Convert each work listed in the manifest file (or
+//     each data file in the directory) given by the --batch option to
+//     its own MEI file, using the number of threads given by the
+//     --threads option.
+//
+
+void processBatch(Options& opts) {
+   ScoreBatch batch;
+   batch.setOutputExtension(".mei");
+   if (!batch.setOutputDirectory(opts.getString("outdir"))) {
+      cerr << "Error: cannot create directory " << opts.getString("outdir")
+           << endl;
+      exit(1);
+   }
+   batch.setThreadCount(Threads);
+   if (opts.getBoolean("cache")) {
+      batch.setCacheName(opts.getCommand());
+   }
+   if (!batch.read(opts.getString("batch"))) {
+      cerr << "Error: cannot read " << opts.getString("batch") << endl;
+      exit(1);
+   }
+   batch.setReport(cout);
+   batch.run([&](ScorePageSet& infiles, ostream& out, string& error) {
+      analyzeInput(infiles);
+      if (!convertWork(infiles, out, opts)) {
+         error = "there is no segment " + to_string(opts.getInteger("segment"));
+         return 0;
+      }
+      return 1;
+   });
+   batch.printSummary(cerr);
+   if (batch.getFailureCount()) {
+      exit(1);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// analyzeInput -- Do the analyses needed for converting the input.
+//
+
+void analyzeInput(ScorePageSet& infiles) {
+   vector<string> analyses(1, "mei");
    if (lyricsQ) {
-      infiles.analyzeLyrics();
+      analyses.push_back("lyrics");
    }
+   infiles.analyze(analyses);
+   infiles.updateCache();
+}
+
+
+
+//////////////////////////////
+//
+// convertWork -- Convert the analyzed input to a single MEI file: the
+//     segment given by the -s option, or the only segment, or all
+//     segments as mdivs.  Returns false if there is no such segment.
+//
 
+int convertWork(ScorePageSet& infiles, ostream& out, Options& opts) {
    if (opts.getBoolean("segment")) {
       // Segment on command line is indexed to 1, but in
       // ScorePageSet, it is indexed to 0, so subtracting one.
       int segment = opts.getInteger("segment") - 1;
-      convertSingleSegment(cout, infiles, segment, 0);
+      if ((segment < 0) || (segment >= infiles.getSegmentCount())) {
+         return 0;
+      }
+      convertSingleSegment(out, infiles, segment, 0);
    } else if (infiles.getSegmentCount() == 1) {
-      convertSingleSegment(cout, infiles, 0, 0);
-   } else if (opts.getBoolean("filebase")) {
-      string filebase = opts.getString("filebase");
-      convertAllSegmentsToSeparateFiles(infiles, filebase);
+      convertSingleSegment(out, infiles, 0, 0);
    } else {
-      convertAllSegmentsToMdivs(cout, infiles);
+      convertAllSegmentsToMdivs(out, infiles);
    }
+   return 1;
 }
 
 
 
 //////////////////////////////
 //
-// convertAllSegmentsToSeparateFiles --
+// convertAllSegmentsToSeparateFiles -- The segments are independent
+//     after the analyses have been done, so they are printed in
+//     parallel with the number of threads given by the --threads option.
 //
 
 void convertAllSegmentsToSeparateFiles(ScorePageSet& infiles,
       string& filebase) {
    int segmentcount =  infiles.getSegmentCount();
-   for (int i=0; i<segmentcount; i++) {
+   SU::runParallel(segmentcount, Threads, [&](int i) {
       printToFile(infiles, i, filebase);
-   }
+   });
 }
 
 
@@ -220,7 +321,9 @@ void convertAllSegmentsToSeparateFiles(ScorePageSet& infiles,
 // printToFile -- Print each segment in the input data into a separate
 //      file, indexed according to the segment number.  Segment numbers
 //      are indexed by 0 in the ScorePageSet object, but indexed by 1
-//      in the filenames.
+//      in the filenames.  The file is written to a temporary file which
+//      is renamed when the segment has been converted, so that a failed
+//      conversion does not leave a partial file.
 //
 
 void printToFile(ScorePageSet& infiles, int segment, string& filebase) {
@@ -229,11 +332,23 @@ void printToFile(ScorePageSet& infiles, int segment, string& filebase) {
    if (segment < 10)  { filename += "0"; }
    filename += to_string(segment);
    filename += ".pmx";
-   ofstream outfile(filename);
+   string tempname = filename + ".tmp";
+   ofstream outfile(tempname);
    if (!outfile.is_open()) {
       cerr << "Error: cannot write to " << filename << endl;
    }
-   convertSingleSegment(outfile, infiles, segment, 0);
+   try {
+      convertSingleSegment(outfile, infiles, segment, 0);
+   } catch (...) {
+      outfile.close();
+      remove(tempname.c_str());
+      throw;
+   }
+   outfile.close();
+   if (rename(tempname.c_str(), filename.c_str()) != 0) {
+      cerr << "Error: cannot write to " << filename << endl;
+      remove(tempname.c_str());
+   }
 }
 
 
@@ -276,8 +391,16 @@ ostream& convertSingleSegment(ostream& out, ScorePageSet& infiles,
 
    map<string, ScoreItem*> infoText;
 
-   infoText["title"] = getTitle(infiles, segment);
-   infoText["composer"] = getComposer(infiles, segment);
+   // Only store the title and composer if they were found, since
+   // printFileDescElement() checks for their presence with count().
+   ScoreItem* title = getTitle(infiles, segment);
+   ScoreItem* composer = getComposer(infiles, segment);
+   if (title != NULL) {
+      infoText["title"] = title;
+   }
+   if (composer != NULL) {
+      infoText["composer"] = composer;
+   }
 
    printMeiHeadElement(out, infiles, segment, indent, infoText);
 
@@ -1044,9 +1167,9 @@ ostream& printMeasureElement(ostream& out, ScorePageSet& infiles,
       vectorSF& staffsizes, int partcount) {
 
    ScoreSegment& seg = infiles.getSegment(segment);
-   const AddressSystem& sys = seg.getSystemAddress(systemindex);
-   ScorePage* page = infiles.getPage(sys);
-   int sysindex = sys.getSystemIndex();
+   SegmentSystem& system = seg.getSystem(systemindex);
+   ScorePage* page = system.getPage();
+   int sysindex = system.getSystemIndex();
    int barcount = page->getSystemBarCount(sysindex);
    AddressSystem partaddress;
    partaddress = seg.getPartAddress(systemindex, 0);
@@ -1107,7 +1230,7 @@ ostream&  printStaffElement(ostream& out, ScorePageSet& infiles,
       int segmentindex, int partcount, int partindex) {
 
    ScoreSegment& seg = infiles.getSegment(segmentindex);
-   AddressSystem partaddress = seg.getPartAddress(systemindex, partindex);
+   SegmentSystem& system = seg.getSystem(systemindex);
 
    printIndent(out, indent++, "<staff n=\"");
    out << (partcount-partindex);
@@ -1124,7 +1247,7 @@ ostream&  printStaffElement(ostream& out, ScorePageSet& infiles,
    ScoreItem* nexttime = NULL;
 
    // double measuredur = measureitems.getDuration();
-   int partstaff = page.getPageStaffIndex(partaddress);
+   int partstaff = system.getPageStaffIndex(partindex);
 
    SCORE_FLOAT measureP3 = measureitems.getP3();
 
@@ -1334,7 +1457,7 @@ ostream&  printNoteElement(ostream& out, ScoreItem* si, int partstaff,
       out << dur << "\"\n";
    }
 
-   int  base40 = si->getParameterInt(ns_auto, np_base40Pitch);
+   int  base40 = si->getBase40Pitch();
    char step   = SU::base40ToLCDiatonicLetter(base40);
    int  alter  = SU::base40ToChromaticAlteration(base40);
    if (si->hasEditorialAccidental()) {
@@ -1360,7 +1483,7 @@ ostream&  printNoteElement(ostream& out, ScoreItem* si, int partstaff,
 
    // note@stem
    if (si->hasStem()) {
-      if (si->stemUp()) {
+      if (si->hasStem() > 0) {
          printIndent(out, indent, "stem.dir=\"up\"\n");
       } else {
          printIndent(out, indent, "stem.dir=\"down\"\n");
@@ -1571,10 +1694,11 @@ string getDurAttributeValue(ScoreItem* si) {
 //
 
 ostream& my_put_time(ostream& out) {
-   struct tm *current;
+   struct tm result;
+   struct tm *current = &result;
    time_t now;
    time(&now);
-   current = localtime(&now);
+   localtime_r(&now, current);
    out << current->tm_year + 1900;
    out << '-';
    if (current->tm_mon < 10) {
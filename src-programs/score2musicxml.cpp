@@ -9,28 +9,51 @@
 //
 // Description:   Converts a ScorePageSet into MusicXML.  If there is one
 //                segment <score-partwise> will be used.  If there are more
-//                than one segment to process <opus> will be used.
+//                than one segment to process <opus> will be used.  With
+//                the --batch option, a list of works is converted to
+//                separate files (see ScoreBatch.h).
 //
 
 #include "scorelib.h"
 #include <chrono>
 #include <ctime>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 #include <algorithm>
 
 using namespace std;
 
+// SegmentMeasure is a measure of a segment, which is printed once for
+// each part in the segment.
+struct SegmentMeasure {
+   int             systemindex;   // index of the system in the segment
+   int             sysindex;      // index of the system on its page
+   int             measureindex;  // index of the measure on the system
+   ScorePage*      page;
+   SystemMeasure*  items;
+};
+
 void     processData                (ScorePageSet& infiles, Options& opts);
+void     processBatch               (Options& opts);
+void     analyzeInput               (ScorePageSet& infiles);
+int      convertWork                (ScorePageSet& infiles, ostream& out,
+                                     Options& opts);
 ostream& convertSingleSegment       (ostream& out, ScorePageSet& infiles,
                                      int segment, int indent);
 ostream& convertAllSegmentsToOpus   (ostream& out, ScorePageSet& infiles);
-ostream& printIndent                (ostream& out, int indent, string text);
-void     printIndent                (stringstream& out, int indent,
-                                     string text);
+ostream& printIndent                (ostream& out, int indent,
+                                     const char* text);
+void     resetBuffer                (stringstream& buffer);
 ostream& printPart                  (ostream& out, ScorePageSet& infiles,
-                                     int segment, int part, int indent);
+                                     int segment, int part, int indent,
+                                     vector<SegmentMeasure>& measures,
+                                     int divisions);
+void     getSegmentMeasures         (vector<SegmentMeasure>& measures,
+                                     ScorePageSet& infiles, int segment);
 ostream& printPartList              (ostream& out, ScorePageSet& infiles,
                                      int segment, int indent);
 void     printToFile                (ScorePageSet& infiles, int segment,
@@ -49,14 +72,7 @@ ostream& printPartInfo              (ostream& out, ScorePageSet& infiles,
                                      int segment, int part, int indent,
                                      int partcount);
 ostream& printXml                   (ostream& out, const string& text);
-void     printSystem                (vector<stringstream*>& partouts,
-                                     ScorePageSet& infiles, int segment,
-                                     int systemindex, int indent,
-                                     vectorVSIp& curclef, vectorVSIp& curkey,
-                                     vectorVSIp& curtime, int& mcounter,
-                                     int divisions, vectorSF& staffsizes,
-                                     vectorI& partVisible);
-void     printPartMeasure           (stringstream& out, ScorePageSet& infiles,
+void     printPartMeasure           (ostream& out, ScorePageSet& infiles,
                                      ScorePage& page,
                                      AddressSystem& partaddress,
                                      SystemMeasure& measureitems,
@@ -145,6 +161,7 @@ int      pageBreaksQ      = 1;
 int      StartTempo       = -1;
 int      movementQ        = 0;
 int      dufayQ           = 0;
+int      Threads          = 1;
 
 ///////////////////////////////////////////////////////////////////////////
 
@@ -172,6 +189,16 @@ int main(int argc, char** argv) {
          "Treat entire input as a single movment");
    opts.define("D|dufay=b",
          "Use default options for Dufay translations");
+   opts.define("profile=b",
+         "Print time spent in analyses to stderr");
+   opts.define("threads=i:1",
+         "Number of threads for reading and analyzing pages");
+   opts.define("cache=b",
+         "Store analyses in a cache file next to the first input file");
+   opts.define("batch=s",
+         "Convert each work in a manifest file or directory to its own file");
+   opts.define("outdir=s",
+         "Directory for the output files of --batch");
    opts.process(argc, argv);
 
    locationQ        = !opts.getBoolean("no-location");
@@ -184,6 +211,13 @@ int main(int argc, char** argv) {
    pageBreaksQ      = !opts.getBoolean("no-page-breaks");
    movementQ        =  opts.getBoolean("movement");
    dufayQ           =  opts.getBoolean("dufay");
+   Threads          =  opts.getInteger("threads");
+   if (movementQ && opts.getBoolean("cache")) {
+      // The segments are stored in the cache file.
+      cerr << "Error: the --cache option cannot be used with --movement"
+           << endl;
+      exit(1);
+   }
    if (dufayQ) {
       rhythmicScalingQ = 1;
       Scaling          = 1;
@@ -191,8 +225,18 @@ int main(int argc, char** argv) {
       StartTempo       = 525;
    }
 
+   if (opts.getBoolean("batch")) {
+      processBatch(opts);
+      return 0;
+   }
+
    ScorePageSet infiles(opts);
-   processData(infiles, opts);
+   try {
+      processData(infiles, opts);
+   } catch (const exception& error) {
+      cerr << "Error: " << error.what() << endl;
+      exit(1);
+   }
 
    return 0;
 }
@@ -206,48 +250,124 @@ int main(int argc, char** argv) {
 //
 
 void processData(ScorePageSet& infiles, Options& opts) {
+   analyzeInput(infiles);
+
+   if (opts.getBoolean("filebase") && !opts.getBoolean("segment") &&
+         (infiles.getSegmentCount() != 1)) {
+      string filebase = opts.getString("filebase");
+      convertAllSegmentsToSeparateFiles(infiles, filebase);
+   } else if (!convertWork(infiles, cout, opts)) {
+      cerr << "Error: there is no segment " << opts.getInteger("segment")
+           << endl;
+      exit(1);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// processBatch -- Convert each work listed in the manifest file (or
+//     each data file in the directory) given by the --batch option to
+//     its own MusicXML file.  The works are converted with the number
+//     of threads given by the --threads option, and each work is
+//     reported as it is finished.
+//
+
+void processBatch(Options& opts) {
+   ScoreBatch batch;
+   batch.setOutputExtension(".xml");
+   if (!batch.setOutputDirectory(opts.getString("outdir"))) {
+      cerr << "Error: cannot create directory " << opts.getString("outdir")
+           << endl;
+      exit(1);
+   }
+   batch.setThreadCount(Threads);
+   if (opts.getBoolean("cache")) {
+      batch.setCacheName(opts.getCommand());
+   }
+   if (!batch.read(opts.getString("batch"))) {
+      cerr << "Error: cannot read " << opts.getString("batch") << endl;
+      exit(1);
+   }
+   batch.setReport(cout);
+   batch.run([&](ScorePageSet& infiles, ostream& out, string& error) {
+      analyzeInput(infiles);
+      if (!convertWork(infiles, out, opts)) {
+         error = "there is no segment " + to_string(opts.getInteger("segment"));
+         return 0;
+      }
+      return 1;
+   });
+   batch.printSummary(cerr);
+   if (batch.getFailureCount()) {
+      exit(1);
+   }
+}
+
+
 
+//////////////////////////////
+//
+// analyzeInput -- Do the analyses needed for converting the input.
+//
+
+void analyzeInput(ScorePageSet& infiles) {
    if (movementQ) {
       infiles.analyzeSingleSegment();
-   } else {
-      infiles.analyzeSegmentsByIndent();
    }
 
-   // infiles.analyzePitch();
-   infiles.analyzeTies();
-   infiles.analyzeTuplets();
+   // Segments by indent (unless a single movement), pitch, ties across
+   // system breaks, tuplets, etc.:
+   vector<string> analyses(1, "musicxml");
    if (lyricsQ) {
-      infiles.analyzeLyrics();
+      analyses.push_back("lyrics");
    }
+   infiles.analyze(analyses);
+   infiles.updateCache();
+}
+
+
+
+//////////////////////////////
+//
+// convertWork -- Convert the analyzed input to a single MusicXML file:
+//     the segment given by the -s option, or the only segment, or all
+//     segments as an opus.  Returns false if there is no such segment.
+//
 
+int convertWork(ScorePageSet& infiles, ostream& out, Options& opts) {
    if (opts.getBoolean("segment")) {
       // Segment on command line is indexed to 1, but in
       // ScorePageSet, it is indexed to 0, so subtracting one.
       int segment = opts.getInteger("segment") - 1;
-      convertSingleSegment(cout, infiles, segment, 0);
+      if ((segment < 0) || (segment >= infiles.getSegmentCount())) {
+         return 0;
+      }
+      convertSingleSegment(out, infiles, segment, 0);
    } else if (infiles.getSegmentCount() == 1) {
-      convertSingleSegment(cout, infiles, 0, 0);
-   } else if (opts.getBoolean("filebase")) {
-      string filebase = opts.getString("filebase");
-      convertAllSegmentsToSeparateFiles(infiles, filebase);
+      convertSingleSegment(out, infiles, 0, 0);
    } else {
-      convertAllSegmentsToOpus(cout, infiles);
+      convertAllSegmentsToOpus(out, infiles);
    }
+   return 1;
 }
 
 
 
 //////////////////////////////
 //
-// convertAllSegmentsToSeparateFiles --
+// convertAllSegmentsToSeparateFiles -- The segments are independent
+//     after the analyses have been done, so they are printed in
+//     parallel with the number of threads given by the --threads option.
 //
 
 void convertAllSegmentsToSeparateFiles(ScorePageSet& infiles,
       string& filebase) {
    int segmentcount =  infiles.getSegmentCount();
-   for (int i=0; i<segmentcount; i++) {
+   SU::runParallel(segmentcount, Threads, [&](int i) {
       printToFile(infiles, i, filebase);
-   }
+   });
 }
 
 
@@ -257,7 +377,9 @@ void convertAllSegmentsToSeparateFiles(ScorePageSet& infiles,
 // printToFile -- Print each segment in the input data into a separate
 //      file, indexed according to the segment number.  Segment numbers
 //      are indexed by 0 in the ScorePageSet object, but indexed by 1
-//      in the filenames.
+//      in the filenames.  The file is written to a temporary file which
+//      is renamed when the segment has been converted, so that a failed
+//      conversion does not leave a partial file.
 //
 
 void printToFile(ScorePageSet& infiles, int segment, string& filebase) {
@@ -266,11 +388,23 @@ void printToFile(ScorePageSet& infiles, int segment, string& filebase) {
    if (segment < 10)  { filename += "0"; }
    filename += to_string(segment);
    filename += ".pmx";
-   ofstream outfile(filename);
+   string tempname = filename + ".tmp";
+   ofstream outfile(tempname);
    if (!outfile.is_open()) {
       cerr << "Error: cannot write to " << filename << endl;
    }
-   convertSingleSegment(outfile, infiles, segment, 0);
+   try {
+      convertSingleSegment(outfile, infiles, segment, 0);
+   } catch (...) {
+      outfile.close();
+      remove(tempname.c_str());
+      throw;
+   }
+   outfile.close();
+   if (rename(tempname.c_str(), filename.c_str()) != 0) {
+      cerr << "Error: cannot write to " << filename << endl;
+      remove(tempname.c_str());
+   }
 }
 
 
@@ -313,62 +447,18 @@ ostream& convertSingleSegment(ostream& out, ScorePageSet& infiles,
    // <part-list>
    printPartList(out, infiles, segment, indent);
 
-   ScoreSegment& seg = infiles.getSegment(segment);
-   int partcount = seg.getPartCount();
-   vector<stringstream*> partoutput;
-   partoutput.resize(partcount);
-   fill(partoutput.begin(), partoutput.end(), (stringstream*)NULL);
-
-   int systemcount = seg.getSystemCount();
-
-   int i;
-   string tempstring;
-
-   for (i=0; i<partcount; i++) {
-      partoutput[i] = new stringstream;
-      *partoutput[i] << endl;
-      printIndent(*partoutput[i], indent, "<part id=\"P");
-      tempstring = to_string(i+1);
-      *partoutput[i] << tempstring << "\">\n";
-   }
-
-   vectorVSIp current_clef(partcount);
-   vectorVSIp current_keysig(partcount);
-   vectorVSIp current_timesig(partcount);
-   for (i=0; i<partcount; i++) {
-      current_clef[i].push_back(NULL);
-      current_keysig[i].push_back(NULL);
-      current_timesig[i].push_back(NULL);
-   }
-
-
-   int measure_counter = 1;
-
-   vectorSF staffsizes(partcount);
-   fill(staffsizes.begin(), staffsizes.end(), 1.0);
-
-   vectorI partVisible(partcount);
-   fill(partVisible.begin(), partVisible.end(), 1);
-
-   for (i=0; i<systemcount; i++) {
-      printSystem(partoutput, infiles, segment, i, indent+1, current_clef,
-            current_keysig, current_timesig, measure_counter, divisions,
-            staffsizes, partVisible);
-   }
-
-   for (i=0; i<partcount; i++) {
-      printIndent(*partoutput[i], indent, "</part>\n");
-      out << partoutput[i]->str();
+   // <part>*
+   // Each part is written directly to the output in one pass over the
+   // measures of the segment, which are found before printing the parts.
+   vector<SegmentMeasure> measures;
+   getSegmentMeasures(measures, infiles, segment);
+   int partcount = infiles.getSegment(segment).getPartCount();
+   for (int i=0; i<partcount; i++) {
+      printPart(out, infiles, segment, i, indent, measures, divisions);
    }
 
    printIndent(out, --indent, "</score-partwise>\n");
 
-   for (i=0; i<partcount; i++) {
-      delete partoutput[i];
-      partoutput[i] = NULL;
-   }
-   partoutput.resize(0);
-
    return out;
 }
 
@@ -442,7 +532,7 @@ ostream& printCredits(ostream& out, map<string, ScoreItem*>& credits,
       out << " font-size=\"" << fontsize << "\"";
       out << ">";
 
-      out << SU::getTextNoFontXmlEscapedUTF8(text);
+      SU::printXmlTextEscapedUTF8(out, text);
       out << "</credit-words>\n";
 
       printIndent(out, --indent, "</credit>\n");
@@ -462,8 +552,7 @@ void printDufayCredits(ostream& out, ScorePageSet& infiles, int segment,
       int indent) {
    map<string, ScoreItem*> credits;
 
-   ScoreSegment& seg = infiles.getSegment(segment);
-   const vectorVASp& addresses = seg.getSystemAddresses(0);
+   vector<SegmentSystem>& systems = infiles.getSegment(segment).getSystems();
    ScorePage* page;
    int sysindex;
    int p2, targetp2;
@@ -475,9 +564,9 @@ void printDufayCredits(ostream& out, ScorePageSet& infiles, int segment,
    string teststr;
 
    // process page headers
-   for (i=0; i<(int)addresses.size(); i++) {
-      page = infiles.getPage(*addresses[i][0]);
-      sysindex = addresses[i][0]->getSystemIndex();
+   for (i=0; i<(int)systems.size(); i++) {
+      page = systems[i].getPage();
+      sysindex = systems[i].getSystemIndex();
       if (sysindex != 0) {
          continue;
       }
@@ -508,9 +597,9 @@ void printDufayCredits(ostream& out, ScorePageSet& infiles, int segment,
    }
 
    // process page footers
-   for (i=0; i<(int)addresses.size(); i++) {
-      page = infiles.getPage(*addresses[i][0]);
-      sysindex = addresses[i][0]->getSystemIndex();
+   for (i=0; i<(int)systems.size(); i++) {
+      page = systems[i].getPage();
+      sysindex = systems[i].getSystemIndex();
       vectorVVSIp& staves = page->getStaffItemsBySystem();
       if (sysindex != (int)staves.size() - 1) {
          continue;
@@ -766,7 +855,7 @@ ScoreItem* printTitle(ostream& out, ScorePageSet& infiles, int segment,
    candidate->setParameterQuiet(ns_auto, np_function, "title");
    printIndent(out, indent, "<movement-title>");
    string name = candidate->getTextWithoutInitialFontCode();
-   out << SU::getTextNoFontXmlEscapedUTF8(name);
+   SU::printXmlTextEscapedUTF8(out, name);
    out << "</movement-title>\n";
 
    return candidate;
@@ -828,7 +917,7 @@ ScoreItem* printComposer(ostream& out, ScorePageSet& infiles, int segment,
    candidate->setParameterQuiet(ns_auto, np_function, "composer");
    printIndent(out, indent, "<creator type=\"composer\">");
    string name = candidate->getTextWithoutInitialFontCode();
-   out << SU::getTextNoFontXmlEscapedUTF8(name);
+   SU::printXmlTextEscapedUTF8(out, name);
    out << "</creator>\n";
 
    return candidate;
@@ -1038,63 +1127,109 @@ ostream& convertAllSegmentsToOpus(ostream& out, ScorePageSet& infiles) {
 
 //////////////////////////////
 //
-// printIndent --
+// printIndent -- Print the indentation for a line followed by the text.
+//     The indentation is written from a string of indent strings, which
+//     is lengthened when a deeper indentation is needed.
 //
 
-ostream& printIndent(ostream& out, int indent, string text) {
-   for (int i=0; i<indent; i++) {
-      out << INDENT_STRING;
+ostream& printIndent(ostream& out, int indent, const char* text) {
+   static thread_local string indentation;
+   static const int length = strlen(INDENT_STRING);
+   if (indent > 0) {
+      while ((int)indentation.size() < indent * length) {
+         indentation += INDENT_STRING;
+      }
+      out.write(indentation.data(), indent * length);
    }
    out << text;
    return out;
 }
 
 
-void printIndent(stringstream& out, int indent, string text) {
-   for (int i=0; i<indent; i++) {
-      out << INDENT_STRING;
+
+//////////////////////////////
+//
+// resetBuffer -- Empty a stringstream which is reused for each
+//     measure or note, keeping its allocated memory.  The reused
+//     buffers are thread_local so that segments can be printed in
+//     parallel.
+//
+
+void resetBuffer(stringstream& buffer) {
+   buffer.str("");
+   buffer.clear();
+}
+
+
+
+//////////////////////////////
+//
+// getSegmentMeasures -- Make a list of the measures in a segment which
+//     are printed for each part (all measures with a duration).
+//
+
+void getSegmentMeasures(vector<SegmentMeasure>& measures,
+      ScorePageSet& infiles, int segment) {
+   measures.clear();
+   vector<SegmentSystem>& systems = infiles.getSegment(segment).getSystems();
+   for (int i=0; i<(int)systems.size(); i++) {
+      ScorePage* page = systems[i].getPage();
+      int sysindex = systems[i].getSystemIndex();
+      int barcount = page->getSystemBarCount(sysindex);
+      for (int j=0; j<barcount; j++) {
+         SystemMeasure& measureitems = page->getSystemMeasure(sysindex, j);
+         if (measureitems.getDuration() == 0.0) {
+            continue;
+         }
+         SegmentMeasure measure;
+         measure.systemindex  = i;
+         measure.sysindex     = sysindex;
+         measure.measureindex = j;
+         measure.page         = page;
+         measure.items        = &measureitems;
+         measures.push_back(measure);
+      }
    }
-   out << text;
 }
 
 
 
 //////////////////////////////
 //
-// printSystem -- print all parts on the given system.
+// printPart -- print all measures of a part in the given segment.
 //
 
-void printSystem(vector<stringstream*>& partouts, ScorePageSet& infiles,
-      int segment, int systemindex, int indent, vectorVSIp& curclef,
-      vectorVSIp& curkey, vectorVSIp& curtime, int& mcounter, int divisions,
-      vectorSF& staffsizes, vectorI& partVisible) {
-
+ostream& printPart(ostream& out, ScorePageSet& infiles, int segment,
+      int part, int indent, vector<SegmentMeasure>& measures, int divisions) {
    ScoreSegment& seg = infiles.getSegment(segment);
-   const AddressSystem& sys = seg.getSystemAddress(systemindex);
-   ScorePage* page = infiles.getPage(sys);
-   int sysindex = sys.getSystemIndex();
-   int barcount = page->getSystemBarCount(sysindex);
-   int partcount = partouts.size();
+   int partcount = seg.getPartCount();
+
+   out << "\n";
+   printIndent(out, indent, "<part id=\"P");
+   out << part+1 << "\">\n";
+
+   // Only the entries for this part are used (see printPartMeasure()).
+   vectorVSIp current_clef(partcount, vectorSIp(1, NULL));
+   vectorVSIp current_keysig(partcount, vectorSIp(1, NULL));
+   vectorVSIp current_timesig(partcount, vectorSIp(1, NULL));
+   vectorI partVisible(partcount, 1);
+   SCORE_FLOAT staffsize = 1.0;
+
    AddressSystem partaddress;
-   int i, j;
-   for (i=0; i<barcount; i++) {
-      SystemMeasure& measureitems = page->getSystemMeasure(sysindex, i);
-      if (measureitems.getDuration() == 0.0) {
-         continue;
-      }
-      for (j=0; j<partcount; j++) {
-         partaddress = seg.getPartAddress(systemindex, j);
-         printPartMeasure(*partouts[j], infiles, *page, partaddress,
-               measureitems, sysindex, i, j, curclef, curkey, curtime,
-               mcounter, indent, divisions, systemindex, staffsizes[j],
-               segment, partVisible);
-      }
-      for (j=0; j<partcount; j++) {
-         printIndent(*partouts[j], indent,
-            "<!--=======================================================-->\n");
-      }
-      mcounter++;
-   }
+   int measure_counter = 1;
+   for (auto& it : measures) {
+      partaddress = seg.getPartAddress(it.systemindex, part);
+      printPartMeasure(out, infiles, *it.page, partaddress, *it.items,
+            it.sysindex, it.measureindex, part, current_clef,
+            current_keysig, current_timesig, measure_counter, indent+1,
+            divisions, it.systemindex, staffsize, segment, partVisible);
+      printIndent(out, indent+1,
+         "<!--=======================================================-->\n");
+      measure_counter++;
+   }
+
+   printIndent(out, indent, "</part>\n");
+   return out;
 }
 
 
@@ -1104,7 +1239,7 @@ void printSystem(vector<stringstream*>& partouts, ScorePageSet& infiles,
 // printPartMeasure -- print a single measure for the given part
 //
 
-void printPartMeasure(stringstream& out, ScorePageSet& infiles,
+void printPartMeasure(ostream& out, ScorePageSet& infiles,
       ScorePage& page, AddressSystem& partaddress, SystemMeasure& measureitems,
       int sysindex, int measureindex, int partindex, vectorVSIp& curclef,
       vectorVSIp& curkey, vectorVSIp& curtime, int mcounter, int indent,
@@ -1130,7 +1265,9 @@ void printPartMeasure(stringstream& out, ScorePageSet& infiles,
    } else if (measuredur - (int)measuredur > 0.9999) {
       measuredur = (int)measuredur + 1;
    }
-   int partstaff = page.getPageStaffIndex(partaddress);
+   SegmentSystem& system = infiles.getSegment(segmentindex).getSystem(
+         systemindex);
+   int partstaff = system.getPageStaffIndex(partindex);
 
    SCORE_FLOAT width = measureitems.getP3Width();
    width = width * 5.0 * 6.0 / 7.0;
@@ -1164,7 +1301,8 @@ void printPartMeasure(stringstream& out, ScorePageSet& infiles,
 
    // <print>
 
-   stringstream layout;
+   static thread_local stringstream layout;
+   resetBuffer(layout);
    printSystemLayout(layout, page, partaddress, indent+1);
    printStaffLayout(layout, page, partaddress, indent+1);
 
@@ -1438,7 +1576,8 @@ void printSystemLayout(stringstream& out,
    int sysstaffindex   = system.getSystemStaffIndex();
    vectorVVSIp& staves = page.getStaffItemsBySystem();
 
-   stringstream out2;
+   static thread_local stringstream out2;
+   resetBuffer(out2);
 
    int staffcount = staves[sysindex].size();
    if (staffcount <= 0) {
@@ -2174,12 +2313,18 @@ void printMeasureAttributes(ostream& out, vectorSIp& items, int index,
       int divisions, int indent, ScoreItem* currkey, ScoreItem* currtime,
       ScoreItem* currclef, SCORE_FLOAT& laststaffsize, vectorI& partVisible) {
 
-   stringstream divisionstream;
-   stringstream keystream;
-   stringstream timestream;
-   stringstream clefstream;
-   stringstream staffsizestream;
-   stringstream hiddenstream;
+   static thread_local stringstream divisionstream;
+   static thread_local stringstream keystream;
+   static thread_local stringstream timestream;
+   static thread_local stringstream clefstream;
+   static thread_local stringstream staffsizestream;
+   static thread_local stringstream hiddenstream;
+   resetBuffer(divisionstream);
+   resetBuffer(keystream);
+   resetBuffer(timestream);
+   resetBuffer(clefstream);
+   resetBuffer(staffsizestream);
+   resetBuffer(hiddenstream);
 
    indent++;
    int printing = 0;
@@ -2491,7 +2636,8 @@ void printRest(ostream& out, ScoreItem* si, int partstaff, int indent,
    // <type>
    string resttype = getRestType(si);
    if (resttype.size() > 0) {
-      printIndent(out, indent, "<type>" + resttype + "</type>\n");
+      printIndent(out, indent, "<type>");
+      out << resttype << "</type>\n";
    }
 
    // <dot>
@@ -2519,7 +2665,8 @@ void printRest(ostream& out, ScoreItem* si, int partstaff, int indent,
 
 void printNoteNotations(ostream& out, ScoreItem* si, int indent,
       string& notetype) {
-   stringstream notations;
+   static thread_local stringstream notations;
+   resetBuffer(notations);
 
    // <accidental-mark> ///////////////////////////////////////////////////
    // <arpeggiate> ////////////////////////////////////////////////////////
@@ -2610,7 +2757,7 @@ void printNote(ostream& out, ScoreItem* si, int partstaff, int indent,
       printIndent(out, indent, "<chord/>\n");
    }
 
-   int  base40 = si->getParameterInt(ns_auto, np_base40Pitch);
+   int  base40 = si->getBase40Pitch();
    char step   = SU::base40ToUCDiatonicLetter(base40);
    int  alter  = SU::base40ToChromaticAlteration(base40);
    if (si->hasEditorialAccidental()) {
@@ -2659,7 +2806,8 @@ void printNote(ostream& out, ScoreItem* si, int partstaff, int indent,
    // <type> /////////////////////////////////////////////////////////////
    string notetype = getNoteType(si);
    if (notetype.size() > 0) {
-      printIndent(out, indent, "<type>" + notetype + "</type>\n");
+      printIndent(out, indent, "<type>");
+      out << notetype << "</type>\n";
    }
 
    // <dot> ///////////////////////////////////////////////////////////////
@@ -2701,7 +2849,7 @@ void printNote(ostream& out, ScoreItem* si, int partstaff, int indent,
    // <stem> //////////////////////////////////////////////////////////////
    if (si->hasStem()) {
       printIndent(out, indent, "<stem");
-      if (si->stemUp()) {
+      if (si->hasStem() > 0) {
          out << ">up";
       } else {
          out << ">down";
@@ -2882,7 +3030,8 @@ void printLyrics(ostream& out, ScoreItem* si, int indent) {
             out << " font-weight=\"bold\"";
          }
          out << ">";
-         out << verses[i][j]->getTextNoFontXmlEscapedUTF8();
+         SU::printXmlTextEscapedUTF8(out,
+               verses[i][j]->getTextWithoutInitialFontCode());
          out << "</text>\n";
 
          if (j<(int)verses[i].size()-1) {
@@ -2997,10 +3146,11 @@ string getRestType(ScoreItem* si) {
 //
 
 ostream& my_put_time(ostream& out) {
-   struct tm *current;
+   struct tm result;
+   struct tm *current = &result;
    time_t now;
    time(&now);
-   current = localtime(&now);
+   localtime_r(&now, current);
    out << current->tm_year + 1900;
    out << '-';
    if (current->tm_mon < 10) {
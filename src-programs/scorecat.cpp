@@ -15,9 +15,10 @@
 
 using namespace std;
 
-void    printBySystem                 (ScorePageSet& infiles, int extra);
+void    printPages                    (ScorePageStream& infiles);
+void    printBySystem                 (ScorePageStream& infiles, int extra);
 void    printPageBySystem             (ScorePage& page, int extra);
-void    printBySystemWithBarlines     (ScorePageSet& infiles, int extra);
+void    printBySystemWithBarlines     (ScorePageStream& infiles, int extra);
 void    printPageBySystemWithBarlines (ScorePage& page, int extra);
 
 // User interface variables:
@@ -36,6 +37,7 @@ int main(int argc, char** argv) {
    opts.define("b|m|barline|measure=b", "indicate measures");
    opts.define("z|0|zero-indexing=b", "index from zero instead of one");
    opts.define("c|comment=b", "encode multipage info as comments");
+   opts.define("threads=i:1", "number of threads for reading pages");
    opts.process(argc, argv);
 
    if (opts.getBoolean("zero-indexing")) {
@@ -48,7 +50,8 @@ int main(int argc, char** argv) {
       autoQ = 0;
    }
 
-   ScorePageSet infiles(opts);
+   // Pages are read, printed and deleted one at a time.
+   ScorePageStream infiles(opts);
 
    if (opts.getBoolean("system")) {
       if (opts.getBoolean("measure")) {
@@ -57,11 +60,7 @@ int main(int argc, char** argv) {
          printBySystem(infiles, !opts.getBoolean("S"));
       }
    } else {
-      if (autoQ) {
-         cout << infiles;
-      } else {
-         printNoAuto(cout, infiles);
-      }
+      printPages(infiles);
    }
 
    return 0;
@@ -70,31 +69,56 @@ int main(int argc, char** argv) {
 ///////////////////////////////////////////////////////////////////////////
 
 
+//////////////////////////////
+//
+// printPages -- print each page/overlay as multi-page PMX data.
+//
+
+void printPages(ScorePageStream& infiles) {
+   int rsQ = 1;
+   while (infiles.next()) {
+      ScorePageOverlay& page = infiles.getCurrent();
+      if ((infiles.getPageIndex() > 0) && !rsQ) {
+         cout << "\n";
+      }
+      if (autoQ) {
+         cout << page;
+      } else {
+         printNoAuto(cout, page);
+      }
+      rsQ = page[0].isMultipageAsRs();
+   }
+}
+
+
+
+
 //////////////////////////////
 //
 // printBySystemWithBarlines -- print each page/overlay by system
 //      (top to bottom of page).
 //
 
-void printBySystemWithBarlines(ScorePageSet& infiles, int extra) {
-   int i, j;
-   for (i=0; i<infiles.getPageCount(); i++) {
+void printBySystemWithBarlines(ScorePageStream& infiles, int extra) {
+   int j;
+   while (infiles.next()) {
+      ScorePageOverlay& page = infiles.getCurrent();
       if (commentQ) {
-         if (i>0) {
+         if (infiles.getPageIndex() > 0) {
             cout << "\n";
          }
-         cout << "###ScorePage:\t" << infiles[i][0].getFilenameBase() << endl;
+         cout << "###ScorePage:\t" << page[0].getFilenameBase() << endl;
       } else {
          cout << "RS" << endl;
-         cout << "SA " << infiles[i][0].getFilenameBase() << endl;
+         cout << "SA " << page[0].getFilenameBase() << endl;
       }
       cout << endl;
-      for (j=0; j<infiles[i].getOverlayCount(); j++) {
+      for (j=0; j<page.getOverlayCount(); j++) {
          if (j>0) {
             cout << "\n###ScoreOverlay:\t"
-                 << infiles[i][j].getFilenameBase() << endl;
+                 << page[j].getFilenameBase() << endl;
          }
-         printPageBySystemWithBarlines(infiles[i][j], extra);
+         printPageBySystemWithBarlines(page[j], extra);
       }
       if (!commentQ) {
          cout << "\nSM\n";
@@ -109,20 +133,21 @@ void printBySystemWithBarlines(ScorePageSet& infiles, int extra) {
 // printBySystem -- print each page/overlay by system (top to bottom of page).
 //
 
-void printBySystem(ScorePageSet& infiles, int extra) {
-   int i, j;
-   for (i=0; i<infiles.getPageCount(); i++) {
-      if (i>0) {
+void printBySystem(ScorePageStream& infiles, int extra) {
+   int j;
+   while (infiles.next()) {
+      ScorePageOverlay& page = infiles.getCurrent();
+      if (infiles.getPageIndex() > 0) {
          cout << "\n";
       }
-      cout << "###ScorePage:\t" << infiles[i][0].getFilenameBase() << endl;
+      cout << "###ScorePage:\t" << page[0].getFilenameBase() << endl;
       cout << "\n";
-      for (j=0; j<infiles[i].getOverlayCount(); j++) {
+      for (j=0; j<page.getOverlayCount(); j++) {
          if (j>0) {
             cout << "\n###ScoreOverlay:\t"
-                 << infiles[i][j].getFilenameBase() << endl;
+                 << page[j].getFilenameBase() << endl;
          }
-         printPageBySystem(infiles[i][j], extra);
+         printPageBySystem(page[j], extra);
       }
    }
 }
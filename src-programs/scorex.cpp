@@ -58,6 +58,8 @@ int main(int argc, char** argv) {
    opts.define("pag=b", "Extract pages into binary .PAG files");
    opts.define("pmx=b", "Extract pages into ASCII .PMX files");
    opts.define("txt=b", "Extract pages into ASCII .TXT files");
+   opts.define("profile=b", "Print time spent in analyses to stderr");
+   opts.define("cache=b", "Store analyses in a cache file next to input");
    opts.process(argc, argv);
 
    autoQ     = !opts.getBoolean("no-auto");
@@ -67,7 +69,8 @@ int main(int argc, char** argv) {
 
    if (opts.getBoolean("count")) {
       cout << "Pages:\t\t" << infiles.getPageCount() << endl;
-      infiles.analyzeSegmentsByIndent();
+      infiles.analyze("segments");
+      infiles.updateCache();
       cout << "Segments:\t" << infiles.getSegmentCount() << endl;
       exit(0);
    } else if (opts.getBoolean("mus") || opts.getBoolean("pag")) {
@@ -80,7 +83,8 @@ int main(int argc, char** argv) {
       cout << infiles.getPageCount() << endl;
       exit(0);
    } else if (opts.getBoolean("segment-count")) {
-      infiles.analyzeSegmentsByIndent();
+      infiles.analyze("segments");
+      infiles.updateCache();
       cout << infiles.getSegmentCount() << endl;
       exit(0);
    } else if (opts.getBoolean("extract-systems")) {
@@ -371,7 +375,9 @@ void extractSingleMeasure(ScorePageSet& infiles, int page, int system,
    double leftpos   = sysm[measure]->getHPosLeft();
    double rightpos  = sysm[measure]->getHPosRight();
 
-   ScoreItem sitem;
+   // Staves and slurs are printed through a view so that only the
+   // changed parameters are stored rather than a copy of each item.
+   ScoreItemView sitem;
 
    vectorSIp& mitems = sysm[measure]->getItems();
 
@@ -382,9 +388,9 @@ void extractSingleMeasure(ScorePageSet& infiles, int page, int system,
       if (!mitems[i]->isStaffItem()) {
          continue;
       }
-      sitem = *mitems[i];
-      sitem.setP3N(leftpos);
-      sitem.setP6N(rightpos);
+      sitem.setItem(mitems[i]);
+      sitem.setP(P3, leftpos);
+      sitem.setP(P6, rightpos);
       cout << sitem;
       staffcount++;
    }
@@ -399,9 +405,9 @@ void extractSingleMeasure(ScorePageSet& infiles, int page, int system,
          if (!zitems[i]->isStaffItem()) {
             continue;
          }
-         sitem = *zitems[i];
-         sitem.setP3N(leftpos);
-         sitem.setP6N(rightpos);
+         sitem.setItem(zitems[i]);
+         sitem.setP(P3, leftpos);
+         sitem.setP(P6, rightpos);
          cout << sitem;
          staffcount++;
       }
@@ -453,28 +459,28 @@ void extractSingleMeasure(ScorePageSet& infiles, int page, int system,
          vislen = visright - leftpos;
          slen = visright - visleft;
          p14 = 1.0 - vislen / slen;
-         sitem = *sysitems[i];
-         sitem.setP14N(p14);
+         sitem.setItem(sysitems[i]);
+         sitem.setP(P14, p14);
          cout << sitem;
       } else if ((visleft >= leftpos) && (visright > rightpos)) {
          // starts in measure; ends after measure
          vislen = rightpos - visleft;
          slen = visright - visleft;
          p15 = vislen / slen;
-         sitem = *sysitems[i];
-         sitem.setP15N(p15);
+         sitem.setItem(sysitems[i]);
+         sitem.setP(P15, p15);
          cout << sitem;
       } else if ((visleft < leftpos) && (visright > rightpos)) {
          // starts before measure; ends after measure
-         sitem = *sysitems[i];
+         sitem.setItem(sysitems[i]);
          vislen = visright - leftpos;
          slen   = visright - visleft;
          p14    = 1.0 - vislen / slen;
-         sitem.setP14N(p14);
+         sitem.setP(P14, p14);
          vislen = rightpos - visleft;
          slen = visright - visleft;
          p15   = vislen / slen;
-         sitem.setP15N(p15);
+         sitem.setP(P15, p15);
          cout << sitem;
       }
    }
@@ -499,13 +505,12 @@ void extractSingleMeasure(ScorePageSet& infiles, int page, int system,
 //
 
 void printBarlineEdge(ScoreItem* item, double left, double right) {
-   ScoreItem newitem;
+   ScoreItemView newitem(item);
    double p3 = item->getP3();
    switch (item->getP5Int()) {
       case 3:  // left-pointing repeat marks
          if (p3 == left) {
-            newitem = *item;
-            newitem.setP5N(0);
+            newitem.setP(P5, 0);
             cout << newitem;
          } else {
             cout << item;
@@ -513,8 +518,7 @@ void printBarlineEdge(ScoreItem* item, double left, double right) {
          break;
       case 4:  // right-pointing repeat marks
          if (p3 == right) {
-            newitem = *item;
-            newitem.setP5N(0);
+            newitem.setP(P5, 0);
             cout << newitem;
          } else {
             cout << item;
@@ -523,8 +527,7 @@ void printBarlineEdge(ScoreItem* item, double left, double right) {
       case 5:  // double repeat marks, three lines
       case 6:  // double repeat marks, two lines
          if ((p3 == left) || (p3 == right)) {
-            newitem = *item;
-            newitem.setP5N(0);
+            newitem.setP(P5, 0);
             cout << newitem;
          } else {
             cout << item;
@@ -630,6 +633,10 @@ void extractBinaryPages(ScorePageSet& infiles, Options& opts) {
    int pages = infiles.getPageCount();
    ScorePage* infile;
    string filename;
+   ofstream outfile;
+   // The binary data of each page is stored in buffer, which is reused
+   // for the next page.
+   vector<char> buffer;
    for (int i=0; i<pages; i++) {
       infile = infiles.getPage(i);
       filename = infile->getFilename();
@@ -644,7 +651,14 @@ void extractBinaryPages(ScorePageSet& infiles, Options& opts) {
       } else if (opts.getBoolean("pag")) {
          filename += ".pag";
       }
-      infile->writeBinary(filename);
+      infile->encodeBinary(buffer);
+      outfile.open(filename.data(), ios::out | ios::binary);
+      if (!outfile.is_open()) {
+         cerr << "Error: cannot write file: " << filename << endl;
+         exit(1);
+      }
+      outfile.write(buffer.data(), buffer.size());
+      outfile.close();
    }
 }
 
@@ -55,10 +55,12 @@ int main(int argc, char** argv) {
       addIndexNumbers(infiles);
       cout << infiles;
       return 0;
-   } else if (replaceQ || abbreviatedQ) {
-      addIndexNumbers(infiles);
    }
    prepareWebScore(infiles);
+   if (replaceQ || abbreviatedQ) {
+      addIndexNumbers(infiles);
+   }
+   printSystemSet(infiles);
    return 0;
 }
 
@@ -86,16 +88,14 @@ void addIndexNumbers(ScorePageSet& infiles) {
 
 //////////////////////////////
 //
-// prepareWebScore --
+// prepareWebScore -- Analyze the durations of the pages, and store
+//     them in the cache file if the --cache option is used (before
+//     the index numbers are added, so that they are not cached).
 //
 
 void prepareWebScore(ScorePageSet& infiles) {
-   // Currently .analyzeStaffDurations() needs to be done before
-   // calculating .analyzePageSetDurations().  This will be
-   // automated in the future.
-   infiles.analyzeStaffDurations();
-   infiles.analyzePageSetDurations();
-   printSystemSet(infiles);
+   infiles.analyze("pagesetdurations");
+   infiles.updateCache();
 }
 
 
@@ -256,10 +256,12 @@ void printAbbreviatedItems(ScorePage& page, int sysindex) {
            continue;
         }
 
+        // print through a view so that the page is not changed
+        ScoreItemView view(sitems[i]);
         if (sitems[i]->isTextItem()) {
            if (sitems[i]->getP8() != 0.0) {
               // convert non-standard fonts to normal ones
-              sitems[i]->setP8N(0.0);
+              view.setP(P8, 0.0);
            }
         }
 
@@ -275,7 +277,7 @@ void printAbbreviatedItems(ScorePage& page, int sysindex) {
               cout << "_99%" << index << endl;
            }
 
-           sitems[i]->printPmxFixedParameters(cout);
+           view.printPmxFixedParameters(cout);
 
            if (allabbrQ) {
               cout << "T ";
@@ -287,7 +289,7 @@ void printAbbreviatedItems(ScorePage& page, int sysindex) {
               cout << "_99%." << endl;
             }
         } else {
-           sitems[i]->printPmxFixedParameters(cout);
+           view.printPmxFixedParameters(cout);
         }
         continue;
       }
@@ -331,10 +333,12 @@ void printSystemItems(ScorePage& page, int sysindex) {
    string id;
    for (i=0; i<(int)sitems.size(); i++) {
       if (!sitems[i]->isNoteItem()) {
+        // print through a view so that the page is not changed
+        ScoreItemView view(sitems[i]);
         if (sitems[i]->isTextItem()) {
            if (sitems[i]->getP8() != 0.0) {
               // convert non-standard fonts to normal ones
-              sitems[i]->setP8N(0.0);
+              view.setP(P8, 0.0);
            }
         }
         if (sitems[i]->hasParameter("index")) {
@@ -348,7 +352,7 @@ void printSystemItems(ScorePage& page, int sysindex) {
            cout << endl;
            cout << "_99%svg%<g id=\"i" << index << "\">" << endl;
 
-           sitems[i]->printPmxFixedParameters(cout);
+           view.printPmxFixedParameters(cout);
 
            cout << "T ";
            cout << sitems[i]->getP2() << " ";
@@ -359,7 +363,7 @@ void printSystemItems(ScorePage& page, int sysindex) {
            cout << "_99%svg%<\\g>" << endl;
 
         } else {
-           sitems[i]->printPmxFixedParameters(cout);
+           view.printPmxFixedParameters(cout);
         }
         continue;
       }
@@ -527,6 +531,8 @@ void processOptions(Options& opts, int argc, char** argv) {
    opts.define("s|system-offset=i:0", "index of first system");
    opts.define("p|part=b", "indicate part number in class tags");
    opts.define("R|no-round=b", "do not round quarter-note timestamps");
+   opts.define("profile=b", "print time spent in analyses to stderr");
+   opts.define("cache=b", "store analyses in a cache file next to input");
    opts.process(argc, argv);
 
    Separator     =  opts.getString("separator");
@@ -542,6 +548,11 @@ void processOptions(Options& opts, int argc, char** argv) {
    partQ         =  options.getBoolean("part");
    roundQ        = !options.getBoolean("no-round");
    fixfontQ      = !options.getBoolean("plain-fonts");
+   if (indexQ && opts.getBoolean("cache")) {
+      // The cached pages contain the duration analyses.
+      cerr << "Error: the --cache option cannot be used with --index" << endl;
+      exit(1);
+   }
 }
 
 
@@ -0,0 +1,108 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:41:08 PDT 2026
+// Last Modified: Sat Oct 17 23:41:11 PDT 2026
+// Filename:      analysisbench.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/analysisbench.cpp
+// Syntax:        C++11
+//
+// Description:   Measure the time taken by each of the page-level staff
+//                and system analyses.  Compile once against the debug
+//                library and once against the release library to compare
+//                bounds-checked and unchecked vectors:
+//                   make library-debug;   (cd tests; make analysisbench)
+//                   make library-release; (cd tests; make analysisbench BUILD=release)
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+void   runAnalyses     (const string& filename, vector<double>& times);
+
+// The analyses to time, in order of dependency:
+vector<string> Stages = {
+   "read", "staves", "systems", "durations", "layers",
+   "pitch", "chords", "beams"
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:20", "number of times to analyze each file");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   vector<double> times(Stages.size(), 0.0);
+   for (int n=0; n<count; n++) {
+      for (int i=1; i<=opts.getArgCount(); i++) {
+         runAnalyses(opts.getArg(i), times);
+      }
+   }
+
+#ifdef UseBoundVector
+   cout << "#build:\tdebug (bounds-checked vectors)\n";
+#else
+   cout << "#build:\trelease (unchecked vectors)\n";
+#endif
+   cout << "#stage\tms\n";
+   double total = 0.0;
+   for (int i=0; i<(int)Stages.size(); i++) {
+      cout << Stages[i] << "\t" << times[i] << "\n";
+      if (i > 0) {
+         total += times[i];
+      }
+   }
+   cout << "#analysis\t" << total << "\n";
+
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// runAnalyses -- Read a page and run each analysis on it, adding the time
+//     taken by each stage to times.
+//
+
+void runAnalyses(const string& filename, vector<double>& times) {
+   ScorePage page;
+   vector<steady_clock::time_point> mark;
+
+   mark.push_back(steady_clock::now());
+   page.readFile(filename);
+   mark.push_back(steady_clock::now());
+   page.analyzeStaves();
+   mark.push_back(steady_clock::now());
+   page.analyzeSystems();
+   mark.push_back(steady_clock::now());
+   page.analyzeStaffDurations();
+   mark.push_back(steady_clock::now());
+   page.analyzeLayers();
+   mark.push_back(steady_clock::now());
+   page.analyzePitch();
+   mark.push_back(steady_clock::now());
+   page.analyzeChords();
+   mark.push_back(steady_clock::now());
+   page.analyzeBeams();
+   mark.push_back(steady_clock::now());
+
+   for (int i=1; i<(int)mark.size(); i++) {
+      times[i-1] += duration<double, milli>(mark[i] - mark[i-1]).count();
+   }
+}
+
+
+
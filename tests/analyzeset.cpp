@@ -0,0 +1,158 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:18 PDT 2026
+// Last Modified: Sat Oct 17 23:59:21 PDT 2026
+// Filename:      analyzeset.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/analyzeset.cpp
+// Syntax:        C++11
+//
+// Description:   Compare the analyses needed for MusicXML conversion done
+//                by ScorePageSet::analyze("musicxml") (with the pages
+//                analyzed in parallel, -t option) to the same analyses
+//                done by calling the separate analysis functions.  The
+//                input files are read into one page set (each file read
+//                several times with the -r option), and the times taken
+//                by both methods are printed.  The scheduled analyses
+//                are also checked after pages are added to an analyzed
+//                page set and notes on it are edited: analyzing the set
+//                again must give the same results as analyzing a set
+//                with the same changes once.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include "itemcompare.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+void   readFiles       (ScorePageSet& infiles, Options& opts, int replicate);
+int    compareResults  (ScorePageSet& seta, ScorePageSet& setb);
+void   editNotes       (ScorePageSet& infiles);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("t|threads=i:0",   "number of threads (0 for one per core)");
+   opts.define("r|replicate=i:1", "number of times to read each file");
+   opts.process(argc, argv);
+
+   int replicate = opts.getInteger("replicate");
+   if (replicate < 1) {
+      replicate = 1;
+   }
+
+   ScorePageSet separate;
+   ScorePageSet scheduled;
+   readFiles(separate, opts, replicate);
+   readFiles(scheduled, opts, replicate);
+   scheduled.setThreadCount(opts.getInteger("threads"));
+
+   auto start = steady_clock::now();
+   separate.analyzeSegmentsByIndent();
+   separate.analyzeTies();
+   separate.analyzeTuplets();
+   separate.analyzeLyrics();
+   auto stop = steady_clock::now();
+   double separatetime = duration<double, milli>(stop - start).count();
+
+   start = steady_clock::now();
+   vector<string> analyses = {"musicxml", "lyrics"};
+   scheduled.analyze(analyses);
+   stop = steady_clock::now();
+   double scheduledtime = duration<double, milli>(stop - start).count();
+
+   int diffs = compareResults(separate, scheduled);
+
+   ScorePageSet changed;
+   ScorePageSet fresh;
+   readFiles(changed, opts, replicate);
+   changed.setThreadCount(opts.getInteger("threads"));
+   changed.analyze(analyses);
+   readFiles(changed, opts, replicate);
+   editNotes(changed);
+   changed.analyze(analyses);
+   readFiles(fresh, opts, replicate);
+   readFiles(fresh, opts, replicate);
+   editNotes(fresh);
+   fresh.analyze(analyses);
+   int changediffs = compareResults(changed, fresh);
+
+   cout << "pages:\t\t\t"        << separate.getPageCount()  << "\n";
+   cout << "segments:\t\t"       << scheduled.getSegmentCount() << "\n";
+   cout << "separate (ms):\t\t"  << separatetime  << "\n";
+   cout << "scheduled (ms):\t\t" << scheduledtime << "\n";
+   cout << "differences:\t\t"    << diffs         << "\n";
+   cout << "after changes:\t\t"  << changediffs   << "\n";
+
+   return (diffs || changediffs) ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// readFiles -- Read the input files into the page set.
+//
+
+void readFiles(ScorePageSet& infiles, Options& opts, int replicate) {
+   vector<string> filenames;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      for (int j=0; j<replicate; j++) {
+         filenames.push_back(opts.getArg(i));
+      }
+   }
+   infiles.appendRead(filenames);
+}
+
+
+
+//////////////////////////////
+//
+// editNotes -- Move the notes on odd-numbered staves of the first page
+//    up by one step.
+//
+
+void editNotes(ScorePageSet& infiles) {
+   if (infiles.getPageCount() == 0) {
+      return;
+   }
+   vectorSIp items;
+   getPageItems(infiles[0][0], items);
+   for (auto item : items) {
+      if (item->isNoteItem() && (item->getStaffNumber() % 2 == 1)) {
+         item->setParameterNoisy(P4, item->getP(P4) + 1.0);
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// compareResults -- Return the number of items which were given different
+//    analysis results in the two page sets.
+//
+
+int compareResults(ScorePageSet& seta, ScorePageSet& setb) {
+   if (seta.getSegmentCount() != setb.getSegmentCount()) {
+      return 1;
+   }
+
+   vectorSIp itemsa;
+   vectorSIp itemsb;
+   getSetItems(seta, itemsa);
+   getSetItems(setb, itemsb);
+   return compareItems(itemsa, itemsb, [](ScoreItem* a, ScoreItem* b) {
+      return sameAnalysis(a, b, COMPARE_PITCH | COMPARE_OFFSET |
+            COMPARE_TIES | COMPARE_BEAMS | COMPARE_TUPLETS | COMPARE_LYRICS);
+   });
+}
+
+
+
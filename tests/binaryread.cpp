@@ -0,0 +1,133 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 11:02:18 PDT 2026
+// Last Modified: Sat Oct 17 11:02:21 PDT 2026
+// Filename:      binaryread.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/binaryread.cpp
+// Syntax:        C++11
+//
+// Description:   Compare the speed of reading binary SCORE files with
+//                input streams and with memory-mapped files.  Also checks
+//                that both methods generate the same data.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.mus
+//
+
+#include "ScorePageBase.h"
+#include "MappedFile.h"
+#include "Options.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+double  readWithStream   (const string& filename, int count);
+double  readWithMapping  (const string& filename, int count);
+int     compareMethods   (const string& filename);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:200", "number of times to read each file");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   double streamtotal  = 0.0;
+   double mappingtotal = 0.0;
+   int errors = 0;
+
+   cout << "#file\tstream(ms)\tmmap(ms)\tspeedup\n";
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      const string& filename = opts.getArg(i);
+      MappedFile test(filename);
+      if (!test.isBinaryScore()) {
+         continue;
+      }
+      if (!compareMethods(filename)) {
+         cerr << "Error: data mismatch in file " << filename << endl;
+         errors++;
+      }
+      double streamtime  = readWithStream(filename, count);
+      double mappingtime = readWithMapping(filename, count);
+      streamtotal  += streamtime;
+      mappingtotal += mappingtime;
+      cout << filename << "\t" << streamtime << "\t" << mappingtime
+           << "\t" << streamtime / mappingtime << "\n";
+   }
+   if (mappingtotal > 0.0) {
+      cout << "#total\t" << streamtotal << "\t" << mappingtotal
+           << "\t" << streamtotal / mappingtotal << "\n";
+   }
+
+   return errors ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// readWithStream -- Read a binary file count times with an input stream.
+//     Returns the total time in milliseconds.
+//
+
+double readWithStream(const string& filename, int count) {
+   ScorePageBase page;
+   auto start = steady_clock::now();
+   for (int i=0; i<count; i++) {
+      ifstream infile(filename);
+      page.readBinary(infile);
+   }
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// readWithMapping -- Read a binary file count times with a memory-mapped
+//     file.  Returns the total time in milliseconds.
+//
+
+double readWithMapping(const string& filename, int count) {
+   ScorePageBase page;
+   auto start = steady_clock::now();
+   for (int i=0; i<count; i++) {
+      page.readFile(filename);
+   }
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// compareMethods -- Returns true if reading the file with either method
+//     produces the same PMX data.
+//
+
+int compareMethods(const string& filename) {
+   ScorePageBase page1;
+   ScorePageBase page2;
+   ifstream infile(filename);
+   page1.readBinary(infile);
+   page2.readFile(filename);
+   stringstream out1;
+   stringstream out2;
+   out1 << page1;
+   out2 << page2;
+   return out1.str() == out2.str();
+}
+
+
+
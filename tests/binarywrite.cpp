@@ -0,0 +1,267 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 03:02:44 PDT 2026
+// Last Modified: Sun Oct 18 03:02:47 PDT 2026
+// Filename:      binarywrite.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/binarywrite.cpp
+// Syntax:        C++11
+//
+// Description:   Benchmark for writing binary SCORE data.  The pages of
+//                the input files are encoded (-n times) by writing each
+//                number into a temporary stringstream which is then
+//                copied after the count of numbers, as the library used
+//                to do, and with ScorePageBase::encodeBinary(), which
+//                counts the numbers first and writes them into one
+//                buffer.  The throughput of both methods is printed in
+//                MB/s.  The data of both methods is checked to be the
+//                same, and the pages are read again from the data to
+//                check that they have the same parameters.  Pages are
+//                not read again if the P12 of a text item is not the
+//                length of its text, since the reader uses P12 to find
+//                the size of the text.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -n 10 ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+void   writeLegacy     (string& output, ScorePage& page,
+                        const string& trailer);
+string getTrailer      (ScorePage& page);
+void   writeFloat      (ostream& out, SCORE_FLOAT number);
+double timeEncode      (ScorePageSet& infiles, int count, int legacyQ,
+                        vector<string>& trailers, size_t& bytes);
+int    compareReread   (ScorePage& page, vector<char>& data);
+int    textSizesMatch  (ScorePage& page);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:1", "number of times to encode the pages");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles(opts);
+   vector<string> trailers;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      trailers.push_back(getTrailer(infiles[i][0]));
+   }
+
+   vector<string> names = {"stringstream", "encodeBinary"};
+   for (int i=0; i<(int)names.size(); i++) {
+      size_t bytes = 0;
+      double ms = timeEncode(infiles, count, i == 0, trailers, bytes);
+      double rate = ms > 0.0 ? bytes / 1048576.0 / (ms / 1000.0) : 0.0;
+      cout << names[i] << " (MB/s):\t" << rate << "\t(" << bytes
+           << " bytes in " << ms << " ms)\n";
+   }
+
+   int diffs = 0;
+   int skipped = 0;
+   string legacy;
+   vector<char> data;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      ScorePage& page = infiles[i][0];
+      writeLegacy(legacy, page, trailers[i]);
+      page.encodeBinary(data);
+      if (legacy != string(data.begin(), data.end())) {
+         diffs++;
+      }
+      if (textSizesMatch(page)) {
+         diffs += compareReread(page, data);
+      } else {
+         skipped++;
+      }
+   }
+   cout << "pages not reread:\t" << skipped << "\n";
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// timeEncode -- Encode the pages count times with one of the methods.
+//    Returns the time taken in milliseconds, and bytes is set to the
+//    number of bytes encoded.
+//
+
+double timeEncode(ScorePageSet& infiles, int count, int legacyQ,
+      vector<string>& trailers, size_t& bytes) {
+   string legacy;
+   vector<char> data;
+   bytes = 0;
+   auto start = steady_clock::now();
+   for (int n=0; n<count; n++) {
+      for (int i=0; i<infiles.getPageCount(); i++) {
+         ScorePage& page = infiles[i][0];
+         if (legacyQ) {
+            writeLegacy(legacy, page, trailers[i]);
+            bytes += legacy.size();
+         } else {
+            page.encodeBinary(data);
+            bytes += data.size();
+         }
+      }
+   }
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// writeLegacy -- Encode a page by writing the items into a stringstream
+//    one number at a time and copying it after the count of numbers, as
+//    ScorePageBase::writeBinary() did before using encodeBinary().  The
+//    trailer is given as the bytes at the end of the page's data.
+//
+
+void writeLegacy(string& output, ScorePage& page, const string& trailer) {
+   stringstream temps;
+   int writecount = 0;
+   for (auto& it : page.lowLevelDataAccess()) {
+      int fixedcount = it->getCompactFixedParameterCount();
+      if (fixedcount < 1) {
+         continue;
+      }
+      fixedcount = max(fixedcount, 3);
+      if ((it->getPInt(P1) == P1_ImportedEPSGraphic) ||
+            (it->getPInt(P1) == P1_Text)) {
+         const string& text = it->getFixedText();
+         int pad = (4 - text.size() % 4) % 4;
+         int wordsize = 13 + (text.size() + pad) / 4;
+         writeFloat(temps, wordsize);
+         for (int i=1; i<=13; i++) {
+            writeFloat(temps, it->getP(i));
+         }
+         temps << text << string(pad, ' ');
+         writecount += wordsize + 1;
+      } else {
+         writeFloat(temps, fixedcount);
+         for (int i=1; i<=fixedcount; i++) {
+            writeFloat(temps, it->getP(i));
+         }
+         writecount += fixedcount + 1;
+      }
+   }
+
+   temps << trailer;
+   writecount += trailer.size() / 4;
+
+   stringstream out;
+   int countsize = writecount < 0xffff ? 2 : 4;
+   for (int i=0; i<countsize; i++) {
+      out << (char)((writecount >> (8 * i)) & 0xff);
+   }
+   out << temps.rdbuf();
+   output = out.str();
+}
+
+
+
+//////////////////////////////
+//
+// getTrailer -- Return the bytes of the trailer at the end of the binary
+//    data of a page.  The second to last number is the number of values
+//    in the trailer before it.
+//
+
+string getTrailer(ScorePage& page) {
+   vector<char> data;
+   page.encodeBinary(data);
+   float size;
+   memcpy(&size, data.data() + data.size() - 8, 4);
+   int count = 4 * ((int)size + 1);
+   return string(data.end() - count, data.end());
+}
+
+
+
+//////////////////////////////
+//
+// writeFloat -- Write a 4-byte little-endian float.
+//
+
+void writeFloat(ostream& out, SCORE_FLOAT number) {
+   union { float f; uint32_t i; } num;
+   num.f = (float)number;
+   char byteinfo[4];
+   byteinfo[0] = (char)( num.i        & 0xff);
+   byteinfo[1] = (char)((num.i >> 8)  & 0xff);
+   byteinfo[2] = (char)((num.i >> 16) & 0xff);
+   byteinfo[3] = (char)((num.i >> 24) & 0xff);
+   out.write(byteinfo, 4);
+}
+
+
+
+//////////////////////////////
+//
+// compareReread -- Read a page from its binary data, and return the
+//    number of items whose parameters are not the same as the page's
+//    parameters stored as floats.
+//
+
+int compareReread(ScorePage& page, vector<char>& data) {
+   ScorePage copy;
+   copy.readBinary(data.data(), data.size());
+   listSIp& itemsa = page.lowLevelDataAccess();
+   listSIp& itemsb = copy.lowLevelDataAccess();
+   if (itemsa.size() != itemsb.size()) {
+      return max(itemsa.size(), itemsb.size());
+   }
+   int output = 0;
+   auto itb = itemsb.begin();
+   for (auto& ita : itemsa) {
+      int count = ita->getCompactFixedParameterCount();
+      for (int j=P1; j<=count; j++) {
+         if ((float)ita->getParameter(j) != (float)(*itb)->getParameter(j)) {
+            output++;
+            break;
+         }
+      }
+      itb++;
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// textSizesMatch -- Return true if the P12 of each text item on the
+//    page is the length of its text.
+//
+
+int textSizesMatch(ScorePage& page) {
+   for (auto& it : page.lowLevelDataAccess()) {
+      if (!it->isTextItem()) {
+         continue;
+      }
+      if (it->getPInt(P12) != (int)it->getFixedText().size()) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+
+
@@ -0,0 +1,126 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:51 PDT 2026
+// Last Modified: Sat Oct 17 23:59:54 PDT 2026
+// Filename:      cachetest.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/cachetest.cpp
+// Syntax:        C++11
+//
+// Description:   Read and analyze the input files for MusicXML conversion,
+//                writing an analysis cache file for them, and then read
+//                the pages again from the cache file.  The times taken
+//                with and without the cache are printed, and the items
+//                and analysis results of the two page sets are checked
+//                to be the same.  The cache file is removed afterwards
+//                unless the -k option is given.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+
+#include "scorelib.h"
+#include "itemcompare.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+using namespace std::chrono;
+
+double readAnalyzed    (ScorePageSet& infiles, const vector<string>& filenames,
+                        int& cached);
+int    compareResults  (ScorePageSet& seta, ScorePageSet& setb);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("k|keep=b", "do not remove the cache file");
+   opts.process(argc, argv);
+
+   vector<string> filenames;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      filenames.push_back(opts.getArg(i));
+   }
+   if (filenames.empty()) {
+      cerr << "Usage: " << opts.getCommand() << " files" << endl;
+      exit(1);
+   }
+   string cachefile = ScorePageSet::getCacheFilename(filenames[0],
+         "cachetest");
+   remove(cachefile.c_str());
+
+   int freshcached = 0;
+   int cachedcached = 0;
+   ScorePageSet fresh;
+   ScorePageSet cached;
+   double freshtime  = readAnalyzed(fresh, filenames, freshcached);
+   double cachedtime = readAnalyzed(cached, filenames, cachedcached);
+
+   int diffs = compareResults(fresh, cached);
+   if (freshcached || !cachedcached) {
+      diffs++;
+   }
+   if (!opts.getBoolean("keep")) {
+      remove(cachefile.c_str());
+   }
+
+   cout << "pages:\t\t\t"          << fresh.getPageCount() << "\n";
+   cout << "segments:\t\t"         << fresh.getSegmentCount() << "\n";
+   cout << "read from cache:\t"    << cachedcached << "\n";
+   cout << "without cache (ms):\t" << freshtime    << "\n";
+   cout << "with cache (ms):\t"    << cachedtime   << "\n";
+   cout << "differences:\t\t"      << diffs        << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// readAnalyzed -- Read the input files with the analysis cache, do the
+//    analyses for MusicXML conversion and update the cache file.
+//    Returns the time taken in milliseconds, and cached is set to true
+//    if the pages were read from the cache file.
+//
+
+double readAnalyzed(ScorePageSet& infiles, const vector<string>& filenames,
+      int& cached) {
+   auto start = steady_clock::now();
+   cached = infiles.appendReadCached(filenames, "cachetest");
+   vector<string> analyses = {"musicxml", "lyrics"};
+   infiles.analyze(analyses);
+   infiles.updateCache();
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// compareResults -- Return the number of items which are different or
+//    were given different analysis results in the two page sets.
+//
+
+int compareResults(ScorePageSet& seta, ScorePageSet& setb) {
+   if ((seta.getPageCount() != setb.getPageCount()) ||
+       (seta.getSegmentCount() != setb.getSegmentCount())) {
+      return 1;
+   }
+
+   vectorSIp itemsa;
+   vectorSIp itemsb;
+   getSetItems(seta, itemsa);
+   getSetItems(setb, itemsb);
+   return compareItems(itemsa, itemsb, [](ScoreItem* a, ScoreItem* b) {
+      return sameAnalysis(a, b, COMPARE_TEXT | COMPARE_PITCH |
+            COMPARE_LAYER | COMPARE_OFFSET | COMPARE_TIES | COMPARE_BEAMS |
+            COMPARE_TUPLETS | COMPARE_LYRICS);
+   });
+}
+
+
+
@@ -0,0 +1,179 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 05:41:26 PDT 2026
+// Last Modified: Sun Oct 18 05:41:29 PDT 2026
+// Filename:      durationticks.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/durationticks.cpp
+// Syntax:        C++11
+//
+// Description:   Check the integer staff offsets of the items on each
+//                system of the input pages: the tick resolution of each
+//                system must represent the durations of its items, the
+//                staff offsets in ticks must match the staff offsets in
+//                quarter notes, and the measures of the system must follow
+//                each other without gaps.  Systems whose staves have
+//                barlines at different offsets (such as in the Densmore
+//                songs, where a new song can start in the middle of a
+//                system) have no common measures, so their measures are
+//                only counted and not checked.  The tick resolution of
+//                each system is printed, and whether its barlines are
+//                unaligned.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/chopin-preludes/*.pmx
+//
+
+#include "scorelib.h"
+#include <map>
+#include <math.h>
+#include <set>
+
+using namespace std;
+
+int    checkSystem     (ScorePage& page, int sysindex);
+int    checkMeasures   (ScorePage& page, int sysindex);
+int    hasAlignedBarlines(ScorePage& page, int sysindex);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("q|quiet=b", "do not print the tick resolution of systems");
+   opts.process(argc, argv);
+
+   ScorePageSet infiles(opts);
+
+   int diffs = 0;
+   int unaligned = 0;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      ScorePage& page = infiles[i][0];
+      page.analyzeStaffDurations();
+      for (int j=0; j<page.getSystemCount(); j++) {
+         int alignedQ = hasAlignedBarlines(page, j);
+         if (!opts.getBoolean("quiet")) {
+            cout << infiles[i][0].getFilename() << "\tsystem " << j + 1
+                 << "\tticks " << page.getSystemTicksPerQuarter(j);
+            if (!alignedQ) {
+               cout << "\tunaligned barlines";
+            }
+            cout << "\n";
+         }
+         diffs += checkSystem(page, j);
+         if (alignedQ) {
+            diffs += checkMeasures(page, j);
+         } else {
+            unaligned++;
+         }
+      }
+   }
+   cout << "unaligned systems:\t" << unaligned << "\n";
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// checkSystem -- Return the number of items on the system whose
+//    durations cannot be represented by the tick resolution of the system,
+//    or whose staff offsets in ticks and in quarter notes differ (the
+//    offsets in quarter notes are rounded to six significant digits).
+//
+
+int checkSystem(ScorePage& page, int sysindex) {
+   int tpq = page.getSystemTicksPerQuarter(sysindex);
+   int output = 0;
+   for (auto& it : page.getSystemItems(sysindex)) {
+      SCORE_FLOAT duration = it->getDuration();
+      if (duration > 0.0) {
+         int ticks = SU::getDurationTicks(duration, tpq);
+         if (fabs((double)ticks / tpq - duration) > 0.002) {
+            cerr << "Duration " << duration << " is not " << ticks
+                 << " ticks at " << tpq << " ticks per quarter:\t" << *it;
+            output++;
+            continue;
+         }
+      }
+      int offset = it->getStaffOffsetTicks();
+      if (offset < 0) {
+         continue;
+      }
+      if (fabs((double)offset / tpq - it->getStaffOffsetDuration()) > 0.0001) {
+         cerr << "Staff offset " << it->getStaffOffsetDuration()
+              << " is not " << offset << " ticks at " << tpq
+              << " ticks per quarter:\t" << *it;
+         output++;
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// checkMeasures -- Return the number of measures on the system which do
+//    not start at the end of the previous measure, or which do not use the
+//    tick resolution of the system.
+//
+
+int checkMeasures(ScorePage& page, int sysindex) {
+   int tpq = page.getSystemTicksPerQuarter(sysindex);
+   int output = 0;
+   int expected = 0;
+   vectorSMp& measures = page.getSystemMeasures(sysindex);
+   for (int i=0; i<(int)measures.size(); i++) {
+      SystemMeasure* measure = measures[i];
+      if ((measure->getTicksPerQuarter() != tpq) ||
+            (measure->getSystemOffsetTicks() != expected)) {
+         cerr << page.getFilename() << " system " << sysindex + 1
+              << " measure " << i + 1 << ": starts at "
+              << measure->getSystemOffsetTicks() << "/"
+              << measure->getTicksPerQuarter() << " instead of "
+              << expected << "/" << tpq << endl;
+         output++;
+      }
+      if (measure->getMeasureTicks() < 0) {
+         break;
+      }
+      expected = measure->getSystemOffsetTicks() + measure->getMeasureTicks();
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// hasAlignedBarlines -- Returns true if all staves of the system which
+//    contain barlines have them at the same staff offsets.  A barline is
+//    counted on each of the staves which it spans (P4).
+//
+
+int hasAlignedBarlines(ScorePage& page, int sysindex) {
+   map<int, set<int>> offsets;
+   for (auto& it : page.getSystemItems(sysindex)) {
+      if (!it->isBarlineItem()) {
+         continue;
+      }
+      int span = it->getP4Int();
+      if (span < 1) {
+         span = 1;
+      }
+      for (int i=0; i<span; i++) {
+         offsets[it->getStaffNumber() + i].insert(it->getStaffOffsetTicks());
+      }
+   }
+   for (auto& it : offsets) {
+      if (it.second != offsets.begin()->second) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+
+
@@ -0,0 +1,146 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:58:12 PDT 2026
+// Last Modified: Sat Oct 17 23:58:15 PDT 2026
+// Filename:      editinvalidate.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/editinvalidate.cpp
+// Syntax:        C++11
+//
+// Description:   Edit the vertical positions of notes on every other staff
+//                of an analyzed page and then analyze the page again, so
+//                that only the edited staves are re-analyzed.  The results
+//                are compared to a copy of the page which was edited before
+//                being analyzed, and the time taken for the re-analysis is
+//                compared to the time for a full analysis of the page.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include "itemcompare.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+void   analyzePage     (ScorePage& page);
+void   editPage        (ScorePage& page);
+int    compareResults  (ScorePage& edited, ScorePage& fresh);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:20", "number of times to edit each file");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   double fulltime   = 0.0;
+   double edittime   = 0.0;
+   int    mismatches = 0;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      for (int n=0; n<count; n++) {
+         ScorePage edited;
+         ScorePage fresh;
+         edited.readFile(opts.getArg(i));
+         fresh.readFile(opts.getArg(i));
+
+         auto start = steady_clock::now();
+         analyzePage(edited);
+         auto stop = steady_clock::now();
+         fulltime += duration<double, milli>(stop - start).count();
+
+         editPage(edited);
+         start = steady_clock::now();
+         analyzePage(edited);
+         stop = steady_clock::now();
+         edittime += duration<double, milli>(stop - start).count();
+
+         if (n == 0) {
+            editPage(fresh);
+            analyzePage(fresh);
+            int diffs = compareResults(edited, fresh);
+            if (diffs) {
+               cerr << opts.getArg(i) << ": " << diffs
+                    << " differences after editing" << endl;
+               mismatches += diffs;
+            }
+         }
+      }
+   }
+
+   cout << "full analysis (ms):\t" << fulltime   << "\n";
+   cout << "re-analysis (ms):\t"   << edittime   << "\n";
+   cout << "differences:\t\t"      << mismatches << "\n";
+
+   return mismatches ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// analyzePage -- Run the analyses which can be redone for only the
+//    staves that were edited.
+//
+
+void analyzePage(ScorePage& page) {
+   page.analyzeStaffDurations();
+   page.analyzeLayers();
+   page.analyzePitch();
+   page.analyzeChords();
+   page.analyzeP3();
+}
+
+
+
+//////////////////////////////
+//
+// editPage -- Move the notes on odd-numbered staves up by one step.
+//
+
+void editPage(ScorePage& page) {
+   vectorSIp items;
+   getPageItems(page, items);
+   for (auto item : items) {
+      if (!item->isNoteItem()) {
+         continue;
+      }
+      if (item->getStaffNumber() % 2 == 0) {
+         continue;
+      }
+      item->setParameterNoisy(P4, item->getP(P4) + 1.0);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// compareResults -- Return the number of items which were given different
+//    analysis results on the two pages.
+//
+
+int compareResults(ScorePage& edited, ScorePage& fresh) {
+   vectorSIp itemsa;
+   vectorSIp itemsb;
+   getPageItems(edited, itemsa);
+   getPageItems(fresh, itemsb);
+   return compareItems(itemsa, itemsb, [&](ScoreItem* a, ScoreItem* b) {
+      vectorSIp* chorda = edited.chordNotes(a);
+      vectorSIp* chordb = fresh.chordNotes(b);
+      int chordsizea = chorda ? (int)chorda->size() : 0;
+      int chordsizeb = chordb ? (int)chordb->size() : 0;
+      return sameAnalysis(a, b, COMPARE_OFFSET | COMPARE_PITCH |
+            COMPARE_LAYER | COMPARE_DURATION) && (chordsizea == chordsizeb);
+   });
+}
+
+
+
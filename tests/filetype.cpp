@@ -0,0 +1,121 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 01:44:05 PDT 2026
+// Last Modified: Sun Oct 18 01:44:08 PDT 2026
+// Filename:      filetype.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/filetype.cpp
+// Syntax:        C++11
+//
+// Description:   Classify the input files (and the files in input
+//                directories) with ScoreFileType, reading only the start
+//                and end of each file, and check that the same types are
+//                given when the complete contents of the files are
+//                classified.  Directories are searched both serially and
+//                in parallel (-t option) to check that the same files are
+//                found in the same order.  The number of files of each
+//                type is printed.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -t 4 ../data
+//
+
+#include "scorelib.h"
+#include "MappedFile.h"
+#include <map>
+#include <sys/stat.h>
+
+using namespace std;
+
+int    checkDirectory  (const string& directory, int threads,
+                        vector<string>& files);
+int    checkFile       (const string& filename, map<string, int>& counts);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("t|threads=i:4", "number of threads (0 for one per core)");
+   opts.process(argc, argv);
+
+   if (opts.getArgCount() == 0) {
+      cerr << "Usage: " << opts.getCommand() << " files/directories" << endl;
+      exit(1);
+   }
+   int threads = opts.getInteger("threads");
+
+   vector<string> files;
+   int diffs = 0;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      string name = opts.getArg(i);
+      struct stat info;
+      if ((stat(name.c_str(), &info) == 0) && S_ISDIR(info.st_mode)) {
+         diffs += checkDirectory(name, threads, files);
+      } else {
+         files.push_back(name);
+      }
+   }
+
+   map<string, int> counts;
+   for (auto& it : files) {
+      diffs += checkFile(it, counts);
+   }
+
+   cout << "files:\t\t\t" << files.size() << "\n";
+   for (auto& it : counts) {
+      cout << it.first << ":\t\t\t" << it.second << "\n";
+   }
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// checkDirectory -- Find the files in a directory serially and in
+//    parallel, adding them to the list.  Returns 1 if the lists are
+//    different.
+//
+
+int checkDirectory(const string& directory, int threads,
+      vector<string>& files) {
+   vector<string> serial;
+   vector<string> parallel;
+   ScoreFileType::findFiles(directory, serial, 1);
+   ScoreFileType::findFiles(directory, parallel, threads);
+   files.insert(files.end(), serial.begin(), serial.end());
+   return serial == parallel ? 0 : 1;
+}
+
+
+
+//////////////////////////////
+//
+// checkFile -- Classify a file from its start and end, and from its
+//    complete contents.  Returns 1 if the types are different, or if a
+//    binary file is not identified by MappedFile::isBinaryScore().
+//
+
+int checkFile(const string& filename, map<string, int>& counts) {
+   int type = ScoreFileType::classify(filename);
+   counts[ScoreFileType::getTypeName(type)]++;
+
+   MappedFile infile(filename);
+   if (!infile.isOpen()) {
+      return type == ScoreFileType::FILE_UNREADABLE ? 0 : 1;
+   }
+   int fulltype = ScoreFileType::classify(infile.data(), infile.size());
+   int binaryQ = (type == ScoreFileType::FILE_BINARY);
+   if ((type != fulltype) || (binaryQ != infile.isBinaryScore())) {
+      cerr << "Different types for " << filename << ": "
+           << ScoreFileType::getTypeName(type) << " and "
+           << ScoreFileType::getTypeName(fulltype) << endl;
+      return 1;
+   }
+   return 0;
+}
+
+
+
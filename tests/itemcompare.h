@@ -0,0 +1,199 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:58:40 PDT 2026
+// Last Modified: Sun Oct 18 00:00:11 PDT 2026
+// Filename:      itemcompare.h
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/itemcompare.h
+// Syntax:        C++11
+//
+// Description:   Functions shared by the test programs which analyze two
+//                copies of the same input in different ways and check
+//                that each item was given the same analysis results in
+//                both copies.  The items are compared in the order in
+//                which they were read (the unsorted staff items), which
+//                is the same for both copies even if the sorted order
+//                differs.
+//
+
+#ifndef _ITEMCOMPARE_H_INCLUDED
+#define _ITEMCOMPARE_H_INCLUDED
+
+#include "scorelib.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+using namespace std;
+
+// ItemCompare selects the analysis results compared by sameAnalysis().
+enum ItemCompare {
+   COMPARE_OFFSET   = 1 << 0,  // staff offset duration
+   COMPARE_PITCH    = 1 << 1,  // base-40 pitch
+   COMPARE_LAYER    = 1 << 2,  // layer number
+   COMPARE_DURATION = 1 << 3,  // staff duration
+   COMPARE_TIES     = 1 << 4,  // tied to the next or previous note
+   COMPARE_BEAMS    = 1 << 5,  // in a beam group
+   COMPARE_TUPLETS  = 1 << 6,  // in a tuplet group
+   COMPARE_LYRICS   = 1 << 7,  // size of the lyrics group
+   COMPARE_TEXT     = 1 << 8   // parameters, without the auto namespace
+};
+
+typedef function<int(ScoreItem* a, ScoreItem* b)> ItemPredicate;
+
+void   getPageItems    (ScorePage& page, vectorSIp& items);
+void   getSetItems     (ScorePageSet& infiles, vectorSIp& items);
+int    compareItems    (vectorSIp& itemsa, vectorSIp& itemsb,
+                        const ItemPredicate& same);
+int    sameAnalysis    (ScoreItem* a, ScoreItem* b, int fields);
+int    getGroupIndex   (vectorSIp* notes, ScoreItem* item);
+string getItemText     (ScoreItem* item);
+
+
+//////////////////////////////
+//
+// getPageItems -- Return the items on the staves of the page in the
+//    order in which they were read.
+//
+
+inline void getPageItems(ScorePage& page, vectorSIp& items) {
+   items.clear();
+   vectorSIp staffitems;
+   int maxstaff = page.getMaxStaff();
+   for (int i=1; i<=maxstaff; i++) {
+      page.getUnsortedStaffItems(i, staffitems);
+      items.insert(items.end(), staffitems.begin(), staffitems.end());
+   }
+}
+
+
+
+//////////////////////////////
+//
+// getSetItems -- Return the items on the staves of all pages in the
+//    order in which they were read.
+//
+
+inline void getSetItems(ScorePageSet& infiles, vectorSIp& items) {
+   items.clear();
+   vectorSIp pageitems;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      getPageItems(infiles[i][0], pageitems);
+      items.insert(items.end(), pageitems.begin(), pageitems.end());
+   }
+}
+
+
+
+//////////////////////////////
+//
+// compareItems -- Return the number of item pairs in the two lists for
+//    which same() is false, or the size of the longer list if the lists
+//    do not have the same size.
+//
+
+inline int compareItems(vectorSIp& itemsa, vectorSIp& itemsb,
+      const ItemPredicate& same) {
+   if (itemsa.size() != itemsb.size()) {
+      return (int)max(itemsa.size(), itemsb.size());
+   }
+   int output = 0;
+   for (int i=0; i<(int)itemsa.size(); i++) {
+      if (!same(itemsa[i], itemsb[i])) {
+         output++;
+      }
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// sameAnalysis -- Returns true if the two items have the same analysis
+//    results for the given fields (see ItemCompare).
+//
+
+inline int sameAnalysis(ScoreItem* a, ScoreItem* b, int fields) {
+   if ((fields & COMPARE_OFFSET) &&
+         (a->getStaffOffsetDuration() != b->getStaffOffsetDuration())) {
+      return 0;
+   }
+   if ((fields & COMPARE_PITCH) &&
+         (a->getBase40Pitch() != b->getBase40Pitch())) {
+      return 0;
+   }
+   if ((fields & COMPARE_LAYER) && (a->getLayer() != b->getLayer())) {
+      return 0;
+   }
+   if ((fields & COMPARE_DURATION) &&
+         (a->getStaffDuration() != b->getStaffDuration())) {
+      return 0;
+   }
+   if (fields & COMPARE_TIES) {
+      if (((a->getTiedNextNote() != NULL) != (b->getTiedNextNote() != NULL)) ||
+          ((a->getTiedLastNote() != NULL) != (b->getTiedLastNote() != NULL))) {
+         return 0;
+      }
+   }
+   if ((fields & COMPARE_BEAMS) && (a->inBeamGroup() != b->inBeamGroup())) {
+      return 0;
+   }
+   if ((fields & COMPARE_TUPLETS) &&
+         (a->inTupletGroup() != b->inTupletGroup())) {
+      return 0;
+   }
+   if (fields & COMPARE_LYRICS) {
+      vectorSIp* lyricsa = a->getLyricsGroup();
+      vectorSIp* lyricsb = b->getLyricsGroup();
+      int sizea = lyricsa ? (int)lyricsa->size() : 0;
+      int sizeb = lyricsb ? (int)lyricsb->size() : 0;
+      if (sizea != sizeb) {
+         return 0;
+      }
+   }
+   if ((fields & COMPARE_TEXT) && (getItemText(a) != getItemText(b))) {
+      return 0;
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// getGroupIndex -- Return the position of the item in a list of notes
+//    (such as a chord, beam or tuplet group), or -1 if there is no list.
+//
+
+inline int getGroupIndex(vectorSIp* notes, ScoreItem* item) {
+   if (notes == NULL) {
+      return -1;
+   }
+   for (int i=0; i<(int)notes->size(); i++) {
+      if ((*notes)[i] == item) {
+         return i;
+      }
+   }
+   return (int)notes->size();
+}
+
+
+
+//////////////////////////////
+//
+// getItemText -- Return the PMX data of the item, without the analysis
+//    results exported to the auto namespace (which contain addresses).
+//
+
+inline string getItemText(ScoreItem* item) {
+   stringstream text;
+   item->printPmxFixedParameters(text);
+   item->printPmxNamedParametersNoAuto(text);
+   return text.str();
+}
+
+
+#endif  /* _ITEMCOMPARE_H_INCLUDED */
+
+
+
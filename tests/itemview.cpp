@@ -0,0 +1,201 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 04:02:13 PDT 2026
+// Last Modified: Sun Oct 18 04:02:16 PDT 2026
+// Filename:      itemview.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/itemview.cpp
+// Syntax:        C++11
+//
+// Description:   Change a few fixed parameters of each item on the input
+//                pages both in a copy of the item and in a ScoreItemView
+//                of it (as scorex does when extracting a measure), and
+//                check that both print the same PMX data and that the
+//                items on the pages are not changed by the views.  The
+//                time taken to make the changed items -n times with each
+//                method is also printed.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -n 10 ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+void   changeCopy      (ScoreItem& copy, ScoreItem* item, int variant);
+void   changeView      (ScoreItemView& view, ScoreItem* item, int variant);
+double timeChange      (ScorePageSet& infiles, int count, int viewQ,
+                        SCORE_FLOAT& sum);
+int    checkPage       (ScorePage& page);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:1", "number of times to change the items");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles(opts);
+
+   vector<string> names = {"copy", "view"};
+   for (int i=0; i<(int)names.size(); i++) {
+      SCORE_FLOAT sum = 0.0;
+      double ms = timeChange(infiles, count, i, sum);
+      cout << names[i] << " (ms):\t\t" << ms << "\t(sum " << sum << ")\n";
+   }
+
+   int diffs = 0;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      diffs += checkPage(infiles[i][0]);
+   }
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// changeCopy -- Copy an item and change some of its fixed parameters.
+//    The variant selects which parameters are changed, including ones
+//    past the end of the item's parameters and ones set to zero.
+//
+
+void changeCopy(ScoreItem& copy, ScoreItem* item, int variant) {
+   copy = *item;
+   switch (variant % 4) {
+      case 0:
+         copy.setP3N(item->getP3() + 1.5);
+         copy.setP6N(item->getP3() + 10.25);
+         break;
+      case 1:
+         copy.setP14N(0.375);
+         copy.setP15N(0.625);
+         break;
+      case 2:
+         copy.setP5N(0);
+         copy.setP8N(0);
+         break;
+      case 3:
+         copy.setP20N(0.00001);
+         copy.setP4N(item->getP4() - 1);
+         break;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// changeView -- Make the same changes as changeCopy() in a view.
+//
+
+void changeView(ScoreItemView& view, ScoreItem* item, int variant) {
+   view.setItem(item);
+   switch (variant % 4) {
+      case 0:
+         view.setP(P3, item->getP3() + 1.5);
+         view.setP(P6, item->getP3() + 10.25);
+         break;
+      case 1:
+         view.setP(P14, 0.375);
+         view.setP(P15, 0.625);
+         break;
+      case 2:
+         view.setP(P5, 0);
+         view.setP(P8, 0);
+         break;
+      case 3:
+         view.setP(P20, 0.00001);
+         view.setP(P4, item->getP4() - 1);
+         break;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// timeChange -- Make changed versions of all items count times, either
+//    as copies or views, adding their changed parameters to the sum.
+//    Returns the time in milliseconds.
+//
+
+double timeChange(ScorePageSet& infiles, int count, int viewQ,
+      SCORE_FLOAT& sum) {
+   ScoreItem copy;
+   ScoreItemView view;
+   auto start = steady_clock::now();
+   for (int n=0; n<count; n++) {
+      for (int i=0; i<infiles.getPageCount(); i++) {
+         int variant = 0;
+         for (auto& it : infiles[i][0].lowLevelDataAccess()) {
+            if (viewQ) {
+               changeView(view, it, variant++);
+               sum += view.getP(P3) + view.getP(P14) + view.getP(P4);
+            } else {
+               changeCopy(copy, it, variant++);
+               sum += copy.getP3() + copy.getP14() + copy.getP4();
+            }
+         }
+      }
+   }
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// checkPage -- Return the number of items on the page whose views do not
+//    print the same as their changed copies, plus one if the page is
+//    changed by the views.
+//
+
+int checkPage(ScorePage& page) {
+   stringstream before;
+   before << page;
+
+   int output = 0;
+   int variant = 0;
+   ScoreItem copy;
+   ScoreItemView view;
+   for (auto& it : page.lowLevelDataAccess()) {
+      for (int j=0; j<4; j++) {
+         changeCopy(copy, it, variant + j);
+         changeView(view, it, variant + j);
+         stringstream a;
+         stringstream b;
+         a << copy;
+         b << view;
+         printNoAuto(a, copy);
+         printNoAuto(b, view);
+         if (a.str() != b.str()) {
+            output++;
+            break;
+         }
+      }
+      variant++;
+   }
+
+   stringstream after;
+   after << page;
+   if (before.str() != after.str()) {
+      output++;
+   }
+   return output;
+}
+
+
+
@@ -0,0 +1,74 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 21:05:44 PDT 2026
+// Last Modified: Sat Oct 17 21:05:47 PDT 2026
+// Filename:      pagealloc.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/pagealloc.cpp
+// Syntax:        C++11
+//
+// Description:   Measure the time to load many pages into memory and
+//                to free them again, as well as the peak memory usage
+//                (resident set size) of the process.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -n 20 ../data/*/*.mus ../data/*/*.pmx
+//
+
+#include "ScorePage.h"
+#include "Options.h"
+#include <chrono>
+#include <sys/resource.h>
+
+using namespace std;
+using namespace std::chrono;
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:10", "number of copies of each page to load");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   vector<ScorePage*> pages;
+   pages.reserve(count * opts.getArgCount());
+   long items = 0;
+
+   auto start = steady_clock::now();
+   for (int i=0; i<count; i++) {
+      for (int j=1; j<=opts.getArgCount(); j++) {
+         ScorePage* page = new ScorePage;
+         page->readFile(opts.getArg(j));
+         items += page->getItemCount();
+         pages.push_back(page);
+      }
+   }
+   auto loaded = steady_clock::now();
+   for (auto& it : pages) {
+      delete it;
+      it = NULL;
+   }
+   auto freed = steady_clock::now();
+
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+
+   cout << "pages:\t\t"   << pages.size() << "\n";
+   cout << "items:\t\t"   << items << "\n";
+   cout << "load (ms):\t" << duration<double, milli>(loaded - start).count()
+        << "\n";
+   cout << "free (ms):\t" << duration<double, milli>(freed - loaded).count()
+        << "\n";
+   cout << "peak RSS (kB):\t" << usage.ru_maxrss << "\n";
+
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+
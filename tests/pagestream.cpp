@@ -0,0 +1,129 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 00:09:12 PDT 2026
+// Last Modified: Sun Oct 18 00:09:15 PDT 2026
+// Filename:      pagestream.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/pagestream.cpp
+// Syntax:        C++11
+//
+// Description:   Read the input files with a ScorePageStream, keeping a
+//                window of pages before and after the current page (-b
+//                and -a options), and check that the pages in the window
+//                match the pages of the same files read into a
+//                ScorePageSet.  The largest number of pages stored by
+//                the stream at one time is printed.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <sstream>
+
+using namespace std;
+
+int    comparePages    (ScorePageOverlay* streampage, ScorePageSet& infiles,
+                        int pageindex, int windowQ);
+string getPageText     (ScorePageOverlay& page);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("b|before=i:1", "number of pages to keep before current page");
+   opts.define("a|after=i:1",  "number of pages to read after current page");
+   opts.define("t|threads=i:1", "number of threads (0 for one per core)");
+   opts.process(argc, argv);
+
+   int before = opts.getInteger("before");
+   int after  = opts.getInteger("after");
+
+   ScorePageSet infiles(opts);
+   ScorePageStream stream(opts);
+   stream.setWindow(before, after);
+   stream.setAnalyses("systempitches");
+
+   int pages   = 0;
+   int maximum = 0;
+   int diffs   = 0;
+   while (stream.next()) {
+      int index = stream.getPageIndex();
+      int stored = 0;
+      for (int i=-before-1; i<=after+1; i++) {
+         ScorePageOverlay* page = stream.getPage(i);
+         if (page) {
+            stored++;
+         }
+         int windowQ = (i >= -before) && (i <= after);
+         diffs += comparePages(page, infiles, index + i, windowQ);
+      }
+      if (stream.hasNext() != (index + 1 < infiles.getPageCount())) {
+         diffs++;
+      }
+      maximum = max(maximum, stored);
+      pages++;
+   }
+   if (pages != infiles.getPageCount()) {
+      diffs++;
+   }
+
+   cout << "pages:\t\t\t"   << pages   << "\n";
+   cout << "window:\t\t\t"  << maximum << "\n";
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// getPageText -- Return the PMX data of the items on the staves of a
+//    page and its overlays, without the auto namespace parameters.
+//
+
+string getPageText(ScorePageOverlay& page) {
+   stringstream text;
+   vectorSIp items;
+   for (int i=0; i<page.getOverlayCount(); i++) {
+      int maxstaff = page[i].getMaxStaff();
+      for (int j=1; j<=maxstaff; j++) {
+         page[i].getUnsortedStaffItems(j, items);
+         for (auto& it : items) {
+            it->printPmxFixedParameters(text);
+            it->printPmxNamedParametersNoAuto(text);
+         }
+      }
+   }
+   return text.str();
+}
+
+
+
+//////////////////////////////
+//
+// comparePages -- Return 1 if a page in the window of the stream is
+//    different from the page in the page set or is missing, or if a
+//    page outside of the window is still stored by the stream.
+//
+
+int comparePages(ScorePageOverlay* streampage, ScorePageSet& infiles,
+      int pageindex, int windowQ) {
+   if (!windowQ || (pageindex < 0) || (pageindex >= infiles.getPageCount())) {
+      return streampage ? 1 : 0;
+   }
+   if (streampage == NULL) {
+      return 1;
+   }
+   if (streampage->getOverlayCount() != infiles[pageindex].getOverlayCount()) {
+      return 1;
+   }
+   if (getPageText(*streampage) != getPageText(infiles[pageindex])) {
+      return 1;
+   }
+   return 0;
+}
+
+
+
@@ -0,0 +1,112 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:02:44 PDT 2026
+// Last Modified: Sat Oct 17 23:02:47 PDT 2026
+// Filename:      paramaccess.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/paramaccess.cpp
+// Syntax:        C++11
+//
+// Description:   Measure the time taken to run the analyses which store
+//                their results in the auto namespace, and then the time
+//                to read back those results as strings, integers and
+//                floating-point numbers.  The same results are also read
+//                from the typed analysis tables of the pages, without
+//                going through the named parameters.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx
+//
+
+#include "scorelib.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:100", "number of times to read the parameters");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles(opts);
+
+   auto start = steady_clock::now();
+   infiles.analyzeSingleSegment();
+   infiles.analyzePitch();
+   infiles.analyzeTies();
+   infiles.analyzeLyrics();
+   infiles.analyzeStaffDurations();
+   auto stop = steady_clock::now();
+   double analysistime = duration<double, milli>(stop - start).count();
+
+   start = steady_clock::now();
+   infiles.exportAnalysisParameters();
+   stop = steady_clock::now();
+   double exporttime = duration<double, milli>(stop - start).count();
+
+   vectorSIp items;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      for (int j=0; j<infiles[i].getOverlayCount(); j++) {
+         ScorePage& page = infiles[i][j];
+         for (int k=0; k<page.getItemCount(); k++) {
+            items.push_back(page.getItem(k));
+         }
+      }
+   }
+
+   // Read the parameters which the analyses use most often:
+   long   checksum = 0;
+   double dsum     = 0.0;
+   start = steady_clock::now();
+   for (int n=0; n<count; n++) {
+      for (auto sip : items) {
+         checksum += sip->getParameterInt(ns_auto, np_layer);
+         checksum += sip->getParameterInt(ns_auto, np_base40Pitch);
+         checksum += sip->getParameter(ns_lyrics, np_verseLine).size();
+         checksum += sip->isDefined(ns_auto, np_tiedNextNote);
+         dsum     += sip->getParameterDouble(ns_auto, np_staffOffsetDuration);
+         dsum     += sip->getParameterDouble(ns_auto, np_staffDuration);
+      }
+   }
+   stop = steady_clock::now();
+   double accesstime = duration<double, milli>(stop - start).count();
+
+   // Read the same results from the analysis tables:
+   long   typedsum  = 0;
+   double typeddsum = 0.0;
+   start = steady_clock::now();
+   for (int n=0; n<count; n++) {
+      for (auto sip : items) {
+         typedsum  += sip->getLayer();
+         typedsum  += sip->getBase40Pitch();
+         typedsum  += sip->getParameter(ns_lyrics, np_verseLine).size();
+         typedsum  += (sip->getTiedNextNote() != NULL);
+         typeddsum += sip->getStaffOffsetDuration();
+         typeddsum += sip->getStaffDuration();
+      }
+   }
+   stop = steady_clock::now();
+   double typedtime = duration<double, milli>(stop - start).count();
+
+   cout << "items:\t\t"       << items.size()   << "\n";
+   cout << "analysis (ms):\t"   << analysistime << "\n";
+   cout << "export (ms):\t"     << exporttime   << "\n";
+   cout << "access (ms):\t"     << accesstime   << "\n";
+   cout << "typed (ms):\t"      << typedtime    << "\n";
+   cout << "checksum:\t"        << checksum << "\t" << dsum << "\n";
+   cout << "typed checksum:\t"  << typedsum << "\t" << typeddsum << "\n";
+
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+
@@ -0,0 +1,84 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 14:21:37 PDT 2026
+// Last Modified: Sat Oct 17 14:21:40 PDT 2026
+// Filename:      pmxread.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/pmxread.cpp
+// Syntax:        C++11
+//
+// Description:   Measure the throughput (in megabytes per second) of
+//                parsing single-page PMX files.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx
+//
+
+#include "ScorePageBase.h"
+#include "Options.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:200", "number of times to read each file");
+   opts.define("s|stream=b", "read from a string stream instead of a file");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+   int streamQ = opts.getBoolean("stream");
+
+   double totalbytes = 0.0;
+   double totaltime  = 0.0;
+   int    items      = 0;
+
+   cout << "#file\tbytes\titems\tms\tMB/s\n";
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      const string& filename = opts.getArg(i);
+      ifstream infile(filename);
+      stringstream buffer;
+      buffer << infile.rdbuf();
+      string contents = buffer.str();
+
+      ScorePageBase page;
+      auto start = steady_clock::now();
+      for (int j=0; j<count; j++) {
+         if (streamQ) {
+            istringstream instream(contents);
+            page.readPmx(instream);
+         } else {
+            page.readFile(filename);
+         }
+      }
+      auto stop = steady_clock::now();
+
+      double ms    = duration<double, milli>(stop - start).count();
+      double bytes = (double)contents.size() * count;
+      totalbytes  += bytes;
+      totaltime   += ms;
+      items       += page.getItemCount();
+      cout << filename << "\t" << contents.size() << "\t"
+           << page.getItemCount() << "\t" << ms << "\t"
+           << bytes / ms / 1000.0 << "\n";
+   }
+   if (totaltime > 0.0) {
+      cout << "#total\t" << (long)(totalbytes / count) << "\t" << items
+           << "\t" << totaltime << "\t" << totalbytes / totaltime / 1000.0
+           << "\n";
+   }
+
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+
@@ -0,0 +1,206 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 02:31:12 PDT 2026
+// Last Modified: Sun Oct 18 02:31:15 PDT 2026
+// Filename:      pmxwrite.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/pmxwrite.cpp
+// Syntax:        C++11
+//
+// Description:   Benchmark for writing PMX data.  The pages of the input
+//                files are written (-n times) to /dev/null item by item
+//                with ostream formatting and a flush at the end of each
+//                line as the library used to do, with ScorePageBase::
+//                printPmx() (which uses ScorePmxWriter) rounding numbers
+//                to six significant digits, and with printPmx() writing
+//                the shortest numbers which read back exactly.  The
+//                throughput of each method is printed in MB/s.  The
+//                rounded output is checked to be the same as the ostream
+//                output, and the pages of the unrounded output are read
+//                again to check that all parameters are the same.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -n 10 ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+void   printLegacy     (ostream& out, ScorePage& page);
+double timeWrite       (ScorePageSet& infiles, int count, int method,
+                        size_t& bytes);
+void   writePages      (ostream& out, ScorePageSet& infiles, int method);
+int    compareReread   (ScorePageSet& infiles);
+
+enum { METHOD_STREAM = 0, METHOD_ROUNDED = 1, METHOD_SHORTEST = 2 };
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:1", "number of times to write the pages");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles(opts);
+
+   vector<string> names = {"ostream", "rounded", "shortest"};
+   for (int i=0; i<(int)names.size(); i++) {
+      size_t bytes = 0;
+      double ms = timeWrite(infiles, count, i, bytes);
+      double rate = ms > 0.0 ? bytes / 1048576.0 / (ms / 1000.0) : 0.0;
+      cout << names[i] << " (MB/s):\t" << rate << "\t(" << bytes
+           << " bytes in " << ms << " ms)\n";
+   }
+
+   stringstream legacy;
+   stringstream rounded;
+   writePages(legacy,  infiles, METHOD_STREAM);
+   writePages(rounded, infiles, METHOD_ROUNDED);
+   int diffs = legacy.str() == rounded.str() ? 0 : 1;
+   diffs += compareReread(infiles);
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// timeWrite -- Write the pages to /dev/null count times with the given
+//    method.  Returns the time taken in milliseconds, and bytes is set
+//    to the number of bytes written.
+//
+
+double timeWrite(ScorePageSet& infiles, int count, int method,
+      size_t& bytes) {
+   stringstream sizer;
+   writePages(sizer, infiles, method);
+   bytes = sizer.str().size() * count;
+
+   ofstream out("/dev/null");
+   auto start = steady_clock::now();
+   for (int i=0; i<count; i++) {
+      writePages(out, infiles, method);
+   }
+   out.flush();
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// writePages -- Write the pages (without overlays) with one of the
+//    methods.
+//
+
+void writePages(ostream& out, ScorePageSet& infiles, int method) {
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      ScorePage& page = infiles[i][0];
+      switch (method) {
+         case METHOD_STREAM:   printLegacy(out, page);   break;
+         case METHOD_ROUNDED:  page.printPmx(out, 1);    break;
+         case METHOD_SHORTEST: page.printPmx(out, 0);    break;
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// printLegacy -- Print the items of a page with ostream formatting of
+//    each number and a flush after each line of named parameters, as
+//    ScoreItemBase::printPmx() did before using ScorePmxWriter.
+//
+
+void printLegacy(ostream& out, ScorePage& page) {
+   for (auto& it : page.lowLevelDataAccess()) {
+      int count = it->getCompactFixedParameterCount();
+      SCORE_FLOAT p1 = it->getP1();
+      if (((int)p1) == 16) {
+         out << 't';
+      } else {
+         out << p1;
+      }
+      for (int i=P2; i<=count; i++) {
+         SCORE_FLOAT value = it->getParameter(i);
+         if (fabs(value) < 0.000001) {
+            value = 0.0;
+         }
+         out << ' ' << value;
+      }
+      out << '\n';
+      if ((p1 == 16) | (p1 == 15)) {
+         out << it->getFixedText() << '\n';
+      }
+      stringstream named;
+      it->printPmxNamedParameters(named);
+      string line;
+      while (getline(named, line)) {
+         out << line << endl;
+      }
+   }
+   out << flush;
+}
+
+
+
+//////////////////////////////
+//
+// compareReread -- Write each page without rounding, read it back and
+//    return the number of items whose parameters are not exactly the same.
+//
+
+int compareReread(ScorePageSet& infiles) {
+   int output = 0;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      ScorePage& page = infiles[i][0];
+      stringstream text;
+      page.printPmx(text, 0);
+      string contents = text.str();
+      ScorePage copy;
+      copy.readPmx(contents.data(), contents.size());
+
+      listSIp& itemsa = page.lowLevelDataAccess();
+      listSIp& itemsb = copy.lowLevelDataAccess();
+      if (itemsa.size() != itemsb.size()) {
+         output += max(itemsa.size(), itemsb.size());
+         continue;
+      }
+      auto itb = itemsb.begin();
+      for (auto& ita : itemsa) {
+         int count = ita->getCompactFixedParameterCount();
+         if (count != (*itb)->getCompactFixedParameterCount()) {
+            output++;
+         } else {
+            for (int j=P1; j<=count; j++) {
+               SCORE_FLOAT a = ita->getParameter(j);
+               SCORE_FLOAT b = (*itb)->getParameter(j);
+               if ((a != b) && !((fabs(a) < 0.000001) && (b == 0.0))) {
+                  output++;
+                  break;
+               }
+            }
+         }
+         itb++;
+      }
+   }
+   return output;
+}
+
+
+
@@ -0,0 +1,378 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:59:21 PDT 2026
+// Last Modified: Sat Oct 17 23:59:24 PDT 2026
+// Filename:      scorebench.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/scorebench.cpp
+// Syntax:        C++11
+//
+// Description:   Benchmark driver for the library analyses.  Each input
+//                file is read into its own ScorePageSet (optionally
+//                replicated several times to simulate a large score), and
+//                the time taken by each stage of processing is measured
+//                separately.  The MusicXML and MEI export stages time the
+//                score2musicxml and score2mei programs on the same input,
+//                and also record the size of their output, the output
+//                throughput and the peak memory use of the programs.  Use
+//                the --bin option to compare the export programs of two
+//                builds.  Results are printed as JSON so that they can be compared
+//                between versions of the library.  Run "make bench" in
+//                the base directory to benchmark the data directory.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace std::chrono;
+
+class ExportResult {
+   public:
+      double          ms      = 0.0;  // total time of all runs
+      long            bytes   = 0;    // total output size of all runs
+      long            peakrss = 0;    // largest maximum resident set (KB)
+};
+
+class BenchResult {
+   public:
+      string               filename;
+      int                  pages = 0;
+      int                  items = 0;
+      vector<double>       times;
+      vector<ExportResult> exports;  // one for each export program
+};
+
+void   benchmarkFile    (BenchResult& result, const string& filename,
+                         int replicate);
+double timeCommand      (ExportResult& result, const string& program,
+                         const string& filename, int replicate);
+void   printJson        (ostream& out, vector<BenchResult>& results);
+void   printTimes       (ostream& out, vector<double>& times,
+                         const string& indent);
+void   printExports     (ostream& out, vector<ExportResult>& exports,
+                         const string& indent);
+string jsonString       (const string& text);
+
+// Processing stages, in the order that they are run:
+vector<string> Stages = {
+   "parse", "staves", "systems", "pitch", "segments", "ties", "beams",
+   "tuplets", "lyrics", "musicxml", "mei"
+};
+
+enum { STAGE_MUSICXML = 9, STAGE_MEI = 10 };
+
+// Export programs, which are timed for the stages after STAGE_MUSICXML:
+vector<string> Exports = { "score2musicxml", "score2mei" };
+
+// Options:
+int    Replicate = 1;      // -r: number of copies of each file to read
+int    Count     = 1;      // -n: number of times to process each file
+int    ExportQ   = 1;      // used with -X option
+string BinDir    = "../bin";
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("r|replicate=i:1", "number of copies of each file in a set");
+   opts.define("n|count=i:1",     "number of times to process each file");
+   opts.define("X|no-export=b",   "do not time the export programs");
+   opts.define("bin=s:../bin",    "directory of the export programs");
+   opts.process(argc, argv);
+
+   Replicate = opts.getInteger("replicate");
+   Count     = opts.getInteger("count");
+   ExportQ   = !opts.getBoolean("no-export");
+   BinDir    = opts.getString("bin");
+   if (Replicate < 1) {
+      Replicate = 1;
+   }
+   if (Count < 1) {
+      Count = 1;
+   }
+
+   vector<BenchResult> results(opts.getArgCount());
+   for (int i=0; i<(int)results.size(); i++) {
+      results[i].times.resize(Stages.size(), 0.0);
+      results[i].exports.resize(Exports.size());
+      for (int n=0; n<Count; n++) {
+         benchmarkFile(results[i], opts.getArg(i+1), Replicate);
+      }
+   }
+
+   printJson(cout, results);
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// benchmarkFile -- Read the given file into a ScorePageSet and run each
+//     analysis stage on it, adding the time taken by each stage to the
+//     result.
+//
+
+void benchmarkFile(BenchResult& result, const string& filename,
+      int replicate) {
+   ScorePageSet infiles;
+   vector<string> filenames(replicate, filename);
+   vector<steady_clock::time_point> mark;
+   int i;
+
+   mark.push_back(steady_clock::now());
+   infiles.appendRead(filenames);
+   mark.push_back(steady_clock::now());
+
+   int pagecount = infiles.getPageCount();
+   for (i=0; i<pagecount; i++) {
+      infiles[i][0].analyzeStaves();
+   }
+   mark.push_back(steady_clock::now());
+   for (i=0; i<pagecount; i++) {
+      infiles[i][0].analyzeSystems();
+   }
+   mark.push_back(steady_clock::now());
+   infiles.analyzePitch();
+   mark.push_back(steady_clock::now());
+   infiles.analyzeSegmentsByIndent();
+   mark.push_back(steady_clock::now());
+   infiles.analyzeTies();
+   mark.push_back(steady_clock::now());
+   for (i=0; i<pagecount; i++) {
+      infiles[i][0].analyzeBeams();
+   }
+   mark.push_back(steady_clock::now());
+   infiles.analyzeTuplets();
+   mark.push_back(steady_clock::now());
+   infiles.analyzeLyrics();
+   mark.push_back(steady_clock::now());
+
+   for (i=1; i<(int)mark.size(); i++) {
+      result.times[i-1] += duration<double, milli>(mark[i] - mark[i-1]).count();
+   }
+
+   if (ExportQ) {
+      for (i=0; i<(int)Exports.size(); i++) {
+         result.times[STAGE_MUSICXML + i] += timeCommand(result.exports[i],
+               Exports[i], filename, replicate);
+      }
+   }
+
+   result.filename = filename;
+   result.pages    = pagecount;
+   result.items    = 0;
+   for (i=0; i<pagecount; i++) {
+      result.items += infiles[i][0].getItemCount();
+   }
+}
+
+
+
+//////////////////////////////
+//
+// timeCommand -- Run an export program on the given file (repeated for
+//     the number of replications).  Its output is counted and discarded,
+//     and the time taken, output size and peak memory use of the program
+//     are added to the result.  Returns the time taken in milliseconds,
+//     or 0.0 if the program failed.
+//
+
+double timeCommand(ExportResult& result, const string& program,
+      const string& filename, int replicate) {
+   string command = BinDir + "/" + program;
+   vector<string> args(1, command);
+   args.insert(args.end(), replicate, filename);
+   vector<char*> argv;
+   for (auto& it : args) {
+      argv.push_back(const_cast<char*>(it.c_str()));
+   }
+   argv.push_back(NULL);
+
+   int output[2];
+   if (pipe(output) != 0) {
+      cerr << "Warning: cannot run " << program << endl;
+      return 0.0;
+   }
+
+   auto start = steady_clock::now();
+   pid_t pid = fork();
+   if (pid == 0) {
+      int devnull = open("/dev/null", O_WRONLY);
+      dup2(output[1], 1);
+      dup2(devnull, 2);
+      close(output[0]);
+      close(output[1]);
+      close(devnull);
+      execv(command.c_str(), argv.data());
+      _exit(127);
+   }
+   close(output[1]);
+   long bytes = 0;
+   char buffer[1 << 16];
+   ssize_t count;
+   while ((count = read(output[0], buffer, sizeof(buffer))) > 0) {
+      bytes += count;
+   }
+   close(output[0]);
+
+   int status = -1;
+   struct rusage usage;
+   if ((pid < 0) || (wait4(pid, &status, 0, &usage) != pid) ||
+         !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+      cerr << "Warning: " << program << " failed on " << filename << endl;
+      return 0.0;
+   }
+   auto stop = steady_clock::now();
+
+   double ms = duration<double, milli>(stop - start).count();
+   result.ms     += ms;
+   result.bytes  += bytes;
+   result.peakrss = max(result.peakrss, (long)usage.ru_maxrss);
+   return ms;
+}
+
+
+
+//////////////////////////////
+//
+// printJson -- Print the benchmark results, with stage times in
+//     milliseconds for each file and totals for all files.
+//
+
+void printJson(ostream& out, vector<BenchResult>& results) {
+   vector<double> totals(Stages.size(), 0.0);
+   vector<ExportResult> exports(Exports.size());
+   int pages = 0;
+   int items = 0;
+   for (auto& it : results) {
+      for (int i=0; i<(int)totals.size(); i++) {
+         totals[i] += it.times[i];
+      }
+      for (int i=0; i<(int)exports.size(); i++) {
+         exports[i].ms     += it.exports[i].ms;
+         exports[i].bytes  += it.exports[i].bytes;
+         exports[i].peakrss = max(exports[i].peakrss, it.exports[i].peakrss);
+      }
+      pages += it.pages;
+      items += it.items;
+   }
+
+   out << "{\n";
+#ifdef UseBoundVector
+   out << "\t\"build\": \"debug\",\n";
+#else
+   out << "\t\"build\": \"release\",\n";
+#endif
+   out << "\t\"replicate\": " << Replicate << ",\n";
+   out << "\t\"count\": "     << Count     << ",\n";
+   out << "\t\"export\": "    << (ExportQ ? "true" : "false") << ",\n";
+   out << "\t\"pages\": "     << pages     << ",\n";
+   out << "\t\"items\": "     << items     << ",\n";
+   out << "\t\"total_ms\": {\n";
+   printTimes(out, totals, "\t\t");
+   out << "\t},\n";
+   if (ExportQ) {
+      out << "\t\"exports\": {\n";
+      printExports(out, exports, "\t\t");
+      out << "\t},\n";
+   }
+   out << "\t\"files\": [\n";
+   for (int i=0; i<(int)results.size(); i++) {
+      out << "\t\t{\n";
+      out << "\t\t\t\"file\": "  << jsonString(results[i].filename) << ",\n";
+      out << "\t\t\t\"pages\": " << results[i].pages << ",\n";
+      out << "\t\t\t\"items\": " << results[i].items << ",\n";
+      out << "\t\t\t\"ms\": {\n";
+      printTimes(out, results[i].times, "\t\t\t\t");
+      if (ExportQ) {
+         out << "\t\t\t},\n";
+         out << "\t\t\t\"exports\": {\n";
+         printExports(out, results[i].exports, "\t\t\t\t");
+      }
+      out << "\t\t\t}\n";
+      out << "\t\t}";
+      if (i < (int)results.size() - 1) {
+         out << ",";
+      }
+      out << "\n";
+   }
+   out << "\t]\n";
+   out << "}\n";
+}
+
+
+
+//////////////////////////////
+//
+// printTimes -- Print the stage names and times as JSON object members.
+//
+
+void printTimes(ostream& out, vector<double>& times, const string& indent) {
+   for (int i=0; i<(int)Stages.size(); i++) {
+      out << indent << "\"" << Stages[i] << "\": " << times[i];
+      if (i < (int)Stages.size() - 1) {
+         out << ",";
+      }
+      out << "\n";
+   }
+}
+
+
+
+//////////////////////////////
+//
+// printExports -- Print the output size (bytes), throughput (megabytes
+//     of output per second) and peak memory use (kilobytes) of each
+//     export program as JSON object members.
+//
+
+void printExports(ostream& out, vector<ExportResult>& exports,
+      const string& indent) {
+   for (int i=0; i<(int)Exports.size(); i++) {
+      ExportResult& it = exports[i];
+      double throughput = 0.0;
+      if (it.ms > 0.0) {
+         throughput = it.bytes / 1000.0 / it.ms;
+      }
+      out << indent << "\"" << Exports[i] << "\": {"
+          << "\"bytes\": " << it.bytes << ", "
+          << "\"mb_per_s\": " << throughput << ", "
+          << "\"peak_rss_kb\": " << it.peakrss << "}";
+      if (i < (int)Exports.size() - 1) {
+         out << ",";
+      }
+      out << "\n";
+   }
+}
+
+
+
+//////////////////////////////
+//
+// jsonString -- Return the text as a quoted JSON string.
+//
+
+string jsonString(const string& text) {
+   string output = "\"";
+   for (auto ch : text) {
+      if ((ch == '"') || (ch == '\\')) {
+         output += '\\';
+      }
+      output += ch;
+   }
+   output += "\"";
+   return output;
+}
+
+
+
@@ -0,0 +1,149 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sun Oct 18 04:58:20 PDT 2026
+// Last Modified: Sun Oct 18 04:58:23 PDT 2026
+// Filename:      segmentsystems.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/segmentsystems.cpp
+// Syntax:        C++11
+//
+// Description:   Check that the systems of each segment given by
+//                ScoreSegment::getSystems() have the same pages, items
+//                and part staff numbers as found from the system
+//                addresses of the segment parts.  The time taken to look
+//                up the items and staff of all parts on all systems (-n
+//                times) through the addresses and through the system
+//                table is printed.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -n 1000 ../data/chopin-preludes/*.pmx
+//
+
+#include "scorelib.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+int    checkSegment    (ScorePageSet& infiles, int segment);
+double timeWalk        (ScorePageSet& infiles, int count, int tableQ,
+                        size_t& items);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("n|count=i:1", "number of times to walk the systems");
+   opts.process(argc, argv);
+
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles(opts);
+   infiles.analyzeSegmentsByIndent();
+
+   int diffs = 0;
+   for (int i=0; i<infiles.getSegmentCount(); i++) {
+      diffs += checkSegment(infiles, i);
+   }
+
+   vector<string> names = {"addresses", "table"};
+   for (int i=0; i<(int)names.size(); i++) {
+      size_t items = 0;
+      double ms = timeWalk(infiles, count, i, items);
+      cout << names[i] << " (ms):\t\t" << ms << "\t(" << items
+           << " items)\n";
+   }
+   cout << "differences:\t\t" << diffs << "\n";
+
+   return diffs ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// checkSegment -- Return the number of systems in the segment whose
+//    table entries are not the same as the values found from the system
+//    addresses of the parts.
+//
+
+int checkSegment(ScorePageSet& infiles, int segment) {
+   ScoreSegment& seg = infiles.getSegment(segment);
+   vector<SegmentSystem>& systems = seg.getSystems();
+   int output = 0;
+   if ((int)systems.size() != seg.getSystemCount()) {
+      return 1;
+   }
+   for (int i=0; i<(int)systems.size(); i++) {
+      const AddressSystem& address = seg.getSystemAddress(i);
+      int diffQ = 0;
+      if (systems[i].getPage() != infiles.getPage(address)) {
+         diffQ = 1;
+      }
+      if (systems[i].getSystemIndex() != address.getSystemIndex()) {
+         diffQ = 1;
+      }
+      if (&systems[i].getItems() != &infiles.getSystemItems(address)) {
+         diffQ = 1;
+      }
+      for (int j=0; j<seg.getPartCount(); j++) {
+         AddressSystem partaddress = seg.getPartAddress(i, j);
+         ScorePage* page = infiles.getPage(partaddress);
+         if (systems[i].getPageStaffIndex(j) !=
+               page->getPageStaffIndex(partaddress)) {
+            diffQ = 1;
+         }
+      }
+      output += diffQ;
+   }
+   return output;
+}
+
+
+
+//////////////////////////////
+//
+// timeWalk -- Look up the items and the page staff of each part on each
+//    system of all segments count times, either from the system addresses
+//    or from the system table.  Returns the time in milliseconds, and
+//    items is set to the total size of the item lists of the systems on
+//    which the parts are found.
+//
+
+double timeWalk(ScorePageSet& infiles, int count, int tableQ,
+      size_t& items) {
+   items = 0;
+   auto start = steady_clock::now();
+   for (int n=0; n<count; n++) {
+      for (int s=0; s<infiles.getSegmentCount(); s++) {
+         ScoreSegment& seg = infiles.getSegment(s);
+         int partcount = seg.getPartCount();
+         for (int p=0; p<partcount; p++) {
+            if (tableQ) {
+               for (auto& system : seg.getSystems()) {
+                  if (system.getPageStaffIndex(p) > 0) {
+                     items += system.getItems().size();
+                  }
+               }
+            } else {
+               const vectorVASp& addresses = seg.getSystemAddresses(p);
+               for (int i=0; i<(int)addresses.size(); i++) {
+                  AddressSystem address = *addresses[i][0];
+                  ScorePage* page = infiles.getPage(address);
+                  if (page->getPageStaffIndex(address) > 0) {
+                     items += infiles.getSystemItems(address).size();
+                  }
+               }
+            }
+         }
+      }
+   }
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
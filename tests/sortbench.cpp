@@ -0,0 +1,118 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:56:02 PDT 2026
+// Last Modified: Sat Oct 17 23:56:05 PDT 2026
+// Filename:      sortbench.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/sortbench.cpp
+// Syntax:        C++11
+//
+// Description:   Compare sorting item lists with the ScoreUtility comparison
+//                functions to sorting them with the key-extraction sorting
+//                functions.  The items of all pages of the input files
+//                (read several times with the -r option) are sorted as one
+//                list to simulate a very large page, and the two sorting
+//                methods are checked to give the same item order.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+typedef bool (*ItemCompare)(ScoreItem* a, ScoreItem* b);
+typedef void (*ItemSort)(vectorSIp& items);
+
+int    benchmarkSort   (const string& name, vectorSIp& items,
+                        ItemCompare compare, ItemSort keysort, int count);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("r|replicate=i:10", "number of times to read each file");
+   opts.define("n|count=i:10",     "number of times to sort the items");
+   opts.process(argc, argv);
+
+   int replicate = opts.getInteger("replicate");
+   int count     = opts.getInteger("count");
+   if (replicate < 1) {
+      replicate = 1;
+   }
+   if (count < 1) {
+      count = 1;
+   }
+
+   ScorePageSet infiles;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      vector<string> filenames(replicate, opts.getArg(i));
+      infiles.appendRead(filenames);
+   }
+
+   vectorSIp items;
+   vectorSIp staffitems;
+   for (int i=0; i<infiles.getPageCount(); i++) {
+      ScorePage& page = infiles[i][0];
+      int maxstaff = page.getMaxStaff();
+      for (int j=0; j<=maxstaff; j++) {
+         page.getUnsortedStaffItems(j, staffitems);
+         items.insert(items.end(), staffitems.begin(), staffitems.end());
+      }
+   }
+
+   cout << "items:\t" << items.size() << "\n";
+   cout << "#sort\tcompare (ms)\tkeys (ms)\tsame order\n";
+   int mismatches = 0;
+   mismatches += benchmarkSort("P3", items, SU::sortP3,
+         SU::sortItemsP3, count);
+   mismatches += benchmarkSort("P3P4P1", items, SU::sortP3P4P1,
+         SU::sortItemsP3P4P1, count);
+   mismatches += benchmarkSort("P3P2P1P4", items, SU::sortP3P2P1P4,
+         SU::sortItemsP3P2P1P4, count);
+
+   return mismatches ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// benchmarkSort -- Sort copies of the item list with the comparison
+//    function and with the key-extraction function, and print the
+//    times taken.  Returns 1 if the sorted orders differ.
+//
+
+int benchmarkSort(const string& name, vectorSIp& items, ItemCompare compare,
+      ItemSort keysort, int count) {
+   vectorSIp sorta;
+   vectorSIp sortb;
+   double timea = 0.0;
+   double timeb = 0.0;
+
+   for (int i=0; i<count; i++) {
+      sorta = items;
+      auto start = steady_clock::now();
+      sort(sorta.begin(), sorta.end(), compare);
+      auto stop = steady_clock::now();
+      timea += duration<double, milli>(stop - start).count();
+
+      sortb = items;
+      start = steady_clock::now();
+      keysort(sortb);
+      stop = steady_clock::now();
+      timeb += duration<double, milli>(stop - start).count();
+   }
+
+   int same = (sorta == sortb);
+   cout << name << "\t" << timea << "\t" << timeb << "\t"
+        << (same ? "yes" : "no") << "\n";
+   return same ? 0 : 1;
+}
+
+
+
@@ -0,0 +1,131 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 23:57:31 PDT 2026
+// Last Modified: Sat Oct 17 23:57:34 PDT 2026
+// Filename:      staffthreads.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/staffthreads.cpp
+// Syntax:        C++11
+//
+// Description:   Analyze the chords, beams, tuplets, layers and pitches
+//                of each page serially and with the per-staff and
+//                per-system passes run in parallel (-t option, default
+//                one thread per processor core).  The times taken are
+//                printed, and the results are checked to be the same
+//                for each item on the page.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b ../data/*/*.pmx ../data/*/*.mus
+//
+
+#include "scorelib.h"
+#include "itemcompare.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+double analyzePage     (ScorePage& page);
+int    compareResults  (ScorePage& serial, ScorePage& parallel);
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("t|threads=i:0", "number of threads (0 for one per core)");
+   opts.define("n|count=i:5",   "number of times to analyze each file");
+   opts.process(argc, argv);
+
+   int threads = opts.getInteger("threads");
+   int count   = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   double serialtime   = 0.0;
+   double paralleltime = 0.0;
+   int    mismatches   = 0;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      for (int n=0; n<count; n++) {
+         ScorePage serial;
+         ScorePage parallel;
+         serial.readFile(opts.getArg(i));
+         parallel.readFile(opts.getArg(i));
+         parallel.setThreadCount(threads);
+
+         serialtime   += analyzePage(serial);
+         paralleltime += analyzePage(parallel);
+
+         if (n == 0) {
+            int diffs = compareResults(serial, parallel);
+            if (diffs) {
+               cerr << opts.getArg(i) << ": " << diffs
+                    << " differences with threads" << endl;
+               mismatches += diffs;
+            }
+         }
+      }
+   }
+
+   cout << "threads:\t\t"       << SU::getThreadCount(threads, 1000) << "\n";
+   cout << "serial (ms):\t\t"   << serialtime   << "\n";
+   cout << "parallel (ms):\t\t" << paralleltime << "\n";
+   cout << "differences:\t\t"   << mismatches   << "\n";
+
+   return mismatches ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// analyzePage -- Run the analyses which have per-staff or per-system
+//    passes, after doing the analyses which they depend on.  Returns
+//    the time in milliseconds for the analyses with passes.
+//
+
+double analyzePage(ScorePage& page) {
+   page.analyzeStaves();
+   page.analyzeSystems();
+   page.analyzeStaffDurations();
+
+   auto start = steady_clock::now();
+   page.analyzeChords();
+   page.analyzeBeams();
+   page.analyzeTuplets();
+   page.analyzeLayers();
+   page.analyzePitch();
+   auto stop = steady_clock::now();
+   return duration<double, milli>(stop - start).count();
+}
+
+
+
+//////////////////////////////
+//
+// compareResults -- Return the number of items which were given different
+//    analysis results on the two pages.
+//
+
+int compareResults(ScorePage& serial, ScorePage& parallel) {
+   vectorSIp itemsa;
+   vectorSIp itemsb;
+   getPageItems(serial, itemsa);
+   getPageItems(parallel, itemsb);
+   return compareItems(itemsa, itemsb, [&](ScoreItem* a, ScoreItem* b) {
+      BeamGroup*   beama   = serial.beamInfo(a);
+      BeamGroup*   beamb   = parallel.beamInfo(b);
+      TupletGroup* tupleta = serial.tupletInfo(a);
+      TupletGroup* tupletb = parallel.tupletInfo(b);
+      return sameAnalysis(a, b, COMPARE_PITCH | COMPARE_LAYER) &&
+            (getGroupIndex(serial.chordNotes(a), a) ==
+             getGroupIndex(parallel.chordNotes(b), b)) &&
+            (getGroupIndex(beama ? &beama->notes : NULL, a) ==
+             getGroupIndex(beamb ? &beamb->notes : NULL, b)) &&
+            (getGroupIndex(tupleta ? &tupleta->notes : NULL, a) ==
+             getGroupIndex(tupletb ? &tupletb->notes : NULL, b));
+   });
+}
+
+
+
@@ -0,0 +1,98 @@
+//
+// Programmer:    Craig Stuart Sapp <craig@ccrma.stanford.edu>
+// Creation Date: Sat Oct 17 20:31:12 PDT 2026
+// Last Modified: Sat Oct 17 20:31:15 PDT 2026
+// Filename:      threadread.cpp
+// URL: 	  https://github.com/craigsapp/scorelib/blob/master/tests/threadread.cpp
+// Syntax:        C++11
+//
+// Description:   Measure how the time to read a set of files into a
+//                ScorePageSet scales with the number of threads used to
+//                parse the pages.  Also checks that the pages are stored
+//                in the same order for every thread count.
+//
+// $Smake:		rm %b; make %b
+// $Smake-corpus:	./%b -t 8 ../data/*/*.mus ../data/*/*.pmx
+//
+
+#include "ScorePageSet.h"
+#include "Options.h"
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace std::chrono;
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   Options opts;
+   opts.define("t|max-threads=i:0", "largest thread count to test");
+   opts.define("n|count=i:10", "number of times to read the files");
+   opts.process(argc, argv);
+
+   int maxthreads = opts.getInteger("max-threads");
+   if (maxthreads <= 0) {
+      maxthreads = thread::hardware_concurrency();
+   }
+   if (maxthreads <= 0) {
+      maxthreads = 1;
+   }
+   int count = opts.getInteger("count");
+   if (count < 1) {
+      count = 1;
+   }
+
+   vector<string> filenames;
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      filenames.push_back(opts.getArg(i));
+   }
+
+   string reference;
+   double serialtime = 0.0;
+   int errors = 0;
+
+   cout << "#cores: " << thread::hardware_concurrency() << "\n";
+   cout << "#threads\tpages\tms\tspeedup\n";
+   for (int t=1; t<=maxthreads; t++) {
+      ScorePageSet check;
+      check.setThreadCount(t);
+      check.appendRead(filenames);
+      int pages = check.getPageCount();
+      stringstream output;
+      for (int i=0; i<pages; i++) {
+         for (int j=0; j<check.getOverlayCount(i); j++) {
+            output << check.getPage(i, j)->getFilename() << "\n";
+            output << *check.getPage(i, j);
+         }
+      }
+      if (t == 1) {
+         reference = output.str();
+      } else if (output.str() != reference) {
+         cerr << "Error: page data differs for " << t << " threads" << endl;
+         errors++;
+      }
+
+      auto start = steady_clock::now();
+      for (int j=0; j<count; j++) {
+         ScorePageSet infiles;
+         infiles.setThreadCount(t);
+         infiles.appendRead(filenames);
+      }
+      auto stop = steady_clock::now();
+      double ms = duration<double, milli>(stop - start).count() / count;
+      if (t == 1) {
+         serialtime = ms;
+      }
+      cout << t << "\t" << pages << "\t" << ms << "\t"
+           << serialtime / ms << "\n";
+   }
+
+   return errors ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
+
+